@@ -0,0 +1,64 @@
+#ifndef CHAT_INGEST_H
+# define CHAT_INGEST_H
+
+/*
+** Chat ingest (LIVE): UN seul thread lit chat.log et publie chaque ligne
+** dans un ring buffer partage. Les parsers (chasse, globals) sont des
+** abonnes avec chacun leur curseur.
+**
+** - Le thread d'ingest demarre avec le 1er abonne et s'arrete avec le dernier.
+** - Tailing: fs_watch (inotify / polling) + detection de rotation.
+** - Backpressure: si le ring est plein, l'ingest attend l'abonne le plus lent
+**   (aucune ligne n'est perdue).
+** - Les lignes sont publiees completes (avec '\n'), jamais coupees en deux
+**   si le jeu est en train d'ecrire.
+*/
+
+# define CHAT_INGEST_RING 1024
+# define CHAT_INGEST_LINE_MAX 2048
+# define CHAT_INGEST_MAX_SUBS 4
+
+typedef struct s_chat_ingest_sub	t_chat_ingest_sub;
+
+typedef struct s_chat_ingest_sub_stats
+{
+	char				name[16];
+	unsigned long long	consumed;
+	unsigned long long	lag;      /* lignes publiees non encore lues */
+	unsigned long long	lag_max;
+	unsigned long long	stalls;   /* fois ou l'ingest a attendu cet abonne */
+}	t_chat_ingest_sub_stats;
+
+typedef struct s_chat_ingest_stats
+{
+	int						running;
+	int						ring_capacity;
+	unsigned long long		lines;
+	unsigned long long		bytes;
+	unsigned long long		truncated; /* lignes > CHAT_INGEST_LINE_MAX */
+	unsigned long long		stalls;    /* publications bloquees (ring plein) */
+	unsigned long long		stall_ms;
+	int						subs_count;
+	t_chat_ingest_sub_stats	subs[CHAT_INGEST_MAX_SUBS];
+}	t_chat_ingest_stats;
+
+/*
+ * Registers a consumer starting at the current end of chat.log.
+ * Starts the ingest thread if needed ('chatlog_path' is only used then).
+ * Returns NULL if chat.log cannot be opened or all slots are taken.
+ */
+t_chat_ingest_sub	*chat_ingest_subscribe(const char *chatlog_path,
+						const char *name);
+void				chat_ingest_unsubscribe(t_chat_ingest_sub *sub);
+
+/*
+ * Next line for this consumer (zero-copy, NUL-terminated, '\n' included).
+ * The pointer stays valid until the next call for the same 'sub'.
+ * Returns NULL if nothing arrived within 'timeout_ms'.
+ */
+const char			*chat_ingest_next(t_chat_ingest_sub *sub, int timeout_ms);
+
+/* UI thread: consistent snapshot. */
+void				chat_ingest_get_stats(t_chat_ingest_stats *out);
+
+#endif
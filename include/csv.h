@@ -13,6 +13,7 @@
 #ifndef CSV_H
 # define CSV_H
 
+# include <stddef.h>
 # include <stdio.h>
 
 /*
@@ -31,8 +32,11 @@ int		csv_split_n_strict(char *line, char **out, int n);
 int		csv_split_n_sep(char *line, char **out, int n, char sep);
 /* Strict: exactly n columns for the given separator. */
 int		csv_split_n_strict_sep(char *line, char **out, int n, char sep);
-void	csv_write_field(FILE *f, const char *s);
-void	csv_write_field_sep(FILE *f, const char *s, char sep);
+/* Returns the number of bytes written (quotes included). */
+size_t	csv_write_field(FILE *f, const char *s);
+size_t	csv_write_field_sep(FILE *f, const char *s, char sep);
+/* Same bytes as csv_write_field_sep(), into dst (2 * strlen(s) + 2 max, no NUL). */
+size_t	csv_format_field_sep(char *dst, const char *s, char sep);
 /* Generic row writer (n fields). */
 void	csv_write_row(FILE *f, const char **fields, int n);
 void	csv_write_row_sep(FILE *f, const char **fields, int n, char sep);
@@ -10,7 +10,7 @@
  * Index file path: <csv_path>.idx
  *
  * File format (text, UTF-8):
- *   #csv_index_v1 stride=<N>
+ *   #csv_index_v2 stride=<N>
  *   row_index,timestamp,byte_offset
  */
 
@@ -87,6 +87,19 @@ int		csv_index_lookup_offset_ex(const char *csv_path,
 						unsigned long long *out_checkpoint_row,
 						CsvIndexReport *out_report);
 
+/*
+ * Finds the checkpoint with the highest row_index <= target data row.
+ * The caller then scans forward at most *out_stride rows from *out_offset.
+ * Returns 1 on success, 0 if no index or no checkpoint found.
+ */
+int		csv_index_lookup_row_ex(const char *csv_path,
+						unsigned long long row_index,
+						unsigned long long *out_offset,
+						long long *out_checkpoint_ts,
+						unsigned long long *out_checkpoint_row,
+						size_t *out_stride,
+						CsvIndexReport *out_report);
+
 int		csv_index_remove(const char *csv_path);
 
 #endif
@@ -11,16 +11,75 @@
 
 # include <stdint.h>
 
+/*
+** Screens are immediate-mode (everything redrawn by each frame), so a frame
+** with no input and no new data would draw the same pixels again. It is
+** still drawn every FL_IDLE_REDRAW_MS for clocks and status lines.
+*/
+# define FL_IDLE_REDRAW_MS 250
+
+/*
+** Adaptive pacing: target_ms while something changed during the last
+** FL_ACTIVE_HOLD_MS, then one frame per FL_IDLE_REDRAW_MS (4 fps). Idle
+** waits return early on window input or window_wake() (parser threads).
+*/
+# define FL_ACTIVE_HOLD_MS 500
+
+/* Frame cost (drawn frames): <=1, <=4, <=8, <=16, <=33, >33 ms. */
+/* Frame period (start to start): <=17, <=34, <=100, <=250, <=500, >500 ms. */
+# define FL_HIST_BUCKETS 6
+
 typedef struct s_frame_limiter
 {
 	int		target_ms;
 	uint64_t	frame_start_ms;
+	uint64_t	frame_start_us;
+	uint64_t	last_draw_ms;   /* 0 = draw the next frame */
+	uint64_t	last_change_ms; /* 0 = idle */
+	int		settle;         /* changed frame: draw the next one too */
+	int		drawn;          /* this frame was drawn */
 }   t_frame_limiter;
 
+/* All limiters together (UI thread only), for the Health page. */
+typedef struct s_fl_stats
+{
+	unsigned long long	frames;
+	unsigned long long	drawn;
+	unsigned long long	idle_waits;
+	unsigned long long	woken;          /* idle waits cut short */
+	int					active;         /* last frame paced at target_ms */
+	unsigned long long	cost_hist[FL_HIST_BUCKETS];
+	unsigned long long	period_hist[FL_HIST_BUCKETS];
+	uint64_t			cost_max_us;
+}   t_fl_stats;
+
+/* Zeroes the limiter; the first frame is always drawn. */
+void	fl_init(t_frame_limiter *fl, int target_ms);
+
 /* Start of a frame: records current time. */
 void	fl_begin(t_frame_limiter *fl);
 
-/* End of a frame: sleeps the remaining time (if any). */
+/*
+** Loops that draw every frame: reports input / new data so the limiter
+** stays at target_ms (fl_should_draw() does it too).
+*/
+void	fl_mark(t_frame_limiter *fl, int changed);
+
+/*
+** After input polling / cache refresh: 1 if the frame must be drawn
+** (changed != 0: input or new data, first frame, idle period elapsed),
+** 0 if drawing can be skipped. The frame after a changed one is drawn too:
+** a click handled mid-frame often shows on the next frame only.
+** window_present() stays cheap to call on skipped frames (nothing to send).
+*/
+int		fl_should_draw(t_frame_limiter *fl, int changed);
+
+/*
+** End of a frame: sleeps the rest of target_ms when active, otherwise
+** waits for input / window_wake() up to the idle period.
+*/
 void	fl_end_sleep(t_frame_limiter *fl);
 
+void	fl_get_stats(t_fl_stats *out);
+
 #endif
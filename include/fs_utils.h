@@ -14,6 +14,9 @@ int		fs_ensure_dir(const char *dir);
 long	fs_file_size(const char *path);
 int		fs_file_exists(const char *path);
 
+/* Size + modification time (ns when available). 0 = ok, -1 = missing. */
+int		fs_file_stat(const char *path, long long *size, long long *mtime);
+
 /* Best-effort file truncate (used for crash recovery of partial CSV lines). */
 int		fs_truncate_fp(FILE *f, long new_size);
 
@@ -23,4 +26,36 @@ int		fs_get_exe_dir(char *out, size_t outsz, const char *argv0);
 int		fs_path_parent(char *out, size_t outsz, const char *path);
 int		fs_path_join(char *out, size_t outsz, const char *a, const char *b);
 
+/*
+** Dernieres lignes d'un fichier (flux live hunt/globals/sessions).
+** Lecture a reculons depuis la fin par blocs de FS_TAIL_BLOCK octets,
+** jusqu'a avoir max_lines lignes: le cout depend du nombre de lignes
+** affichees, pas de la taille du fichier. Le resultat est garde en cache
+** par (taille, mtime): fichier inchange => aucune lecture.
+** Lignes sans fin de ligne, tronquees a FS_TAIL_LINE_MAX - 1 octets; une
+** derniere ligne sans '\n' est incluse. Une ligne plus longue que
+** FS_TAIL_SCAN_MAX arrete la remontee (lignes plus anciennes ignorees).
+*/
+# define FS_TAIL_MAX_LINES 64
+# define FS_TAIL_LINE_MAX  1024
+# define FS_TAIL_BLOCK     4096
+# define FS_TAIL_SCAN_MAX  (1L << 20)
+
+typedef struct s_fs_tail
+{
+	long long	size;       /* cle du cache */
+	long long	mtime;
+	int			max_lines;
+	int			n;          /* lignes valides, la plus ancienne en premier */
+	int			at_start;   /* lines[0] est la 1re ligne du fichier */
+	char		(*lines)[FS_TAIL_LINE_MAX];  /* NULL = jamais lu */
+}	t_fs_tail;
+
+/*
+** max_lines <= FS_TAIL_MAX_LINES. t mis a zero avant le 1er appel.
+** 1 = relu, 0 = cache inchange, -1 = fichier illisible (n = 0).
+*/
+int		fs_tail_read(t_fs_tail *t, const char *path, int max_lines);
+void	fs_tail_free(t_fs_tail *t);
+
 #endif
@@ -0,0 +1,51 @@
+#ifndef FS_WATCH_H
+# define FS_WATCH_H
+
+/*
+** Surveillance d'un fichier en append (chat.log) pour le mode LIVE.
+**
+** Backends:
+**  - inotify (Linux) : reveil immediat quand le fichier grossit, est tronque
+**                      ou recree (rotation). Surveille le dossier parent.
+**  - polling         : fallback portable (Windows, inotify indisponible).
+**                      Attente bornee, l'appelant re-verifie la taille.
+**
+** Override: TM_FS_WATCH=poll force le backend polling.
+*/
+
+# define FS_WATCH_POLL_MS 200
+
+typedef enum e_fs_watch_backend
+{
+	FS_WATCH_BACKEND_POLL = 0,
+	FS_WATCH_BACKEND_INOTIFY
+}	t_fs_watch_backend;
+
+/* fs_watch_wait() results */
+# define FS_WATCH_TIMEOUT 0
+# define FS_WATCH_CHANGED 1
+
+typedef struct s_fs_watch
+{
+	t_fs_watch_backend	backend;
+	int					fd;
+	int					wd;
+	char				name[256]; /* basename filtre sur les events dossier */
+}	t_fs_watch;
+
+/* Always succeeds: falls back to polling if no event backend is usable. */
+void		fs_watch_open(t_fs_watch *w, const char *path);
+void		fs_watch_close(t_fs_watch *w);
+
+/*
+ * Blocks until the watched file changes or 'max_wait_ms' elapsed.
+ * Polling backend: sleeps min(FS_WATCH_POLL_MS, max_wait_ms) and returns
+ * FS_WATCH_CHANGED (caller must re-check size, as before).
+ */
+int			fs_watch_wait(t_fs_watch *w, int max_wait_ms);
+
+/* 1 when a timeout means "nothing changed" (no need to stat the file). */
+int			fs_watch_is_event_driven(const t_fs_watch *w);
+const char	*fs_watch_backend_name(const t_fs_watch *w);
+
+#endif
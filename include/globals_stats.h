@@ -15,6 +15,8 @@
 
 # include <stddef.h>
 
+# include "stats_table.h"
+
 # define GLOBALS_TOP_MAX 10
 
 typedef struct s_globals_top
@@ -48,7 +50,27 @@ typedef struct s_globals_stats
     size_t			top_rares_count;
 }	t_globals_stats;
 
+/*
+ * * Agregats par nom (tops), partages par le calcul complet et le cache live
+ ** (globals_stats_live). Mise a zero = vide.
+ */
+typedef struct s_globals_acc
+{
+    t_stats_table	mobs;
+    t_stats_table	crafts;
+    t_stats_table	rares;
+}	t_globals_acc;
+
 int	globals_stats_compute(const char *csv_path, long start_line,
                           t_globals_stats *out);
 
+/* 1 si 'line' est l'en-tete de globals.csv (1re ligne seulement). */
+int		globals_stats_is_header(const char *line);
+/* Ajoute une ligne de donnees (deja sans fin de ligne). */
+void	globals_stats_add_line(t_globals_stats *out, t_globals_acc *acc,
+            const char *line);
+/* Recopie les tops de acc dans out (tas borne, pas de tri complet). */
+void	globals_stats_fill_tops(t_globals_stats *out, const t_globals_acc *acc);
+void	globals_stats_acc_free(t_globals_acc *acc);
+
 #endif
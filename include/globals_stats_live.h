@@ -0,0 +1,38 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   globals_stats_live.h                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/21                                #+#    #+#             */
+/*   Updated: 2026/02/21                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef GLOBALS_STATS_LIVE_H
+# define GLOBALS_STATS_LIVE_H
+
+# include "globals_stats.h"
+
+/*
+ * Live incremental cache for logs/globals.csv (same idea as tracker_stats_live).
+ *
+ *  - Remembers the byte position reached, each tick only folds in the
+ *    complete lines appended since (a partial last line waits).
+ *  - File shorter than that position, or first bytes changed (rotation):
+ *    full rebuild from the start.
+ *  - Same result as globals_stats_compute(path, 0, ...).
+ *
+ * NOTE: updated from the UI thread only.
+ */
+
+void					globals_stats_live_force_reset(void);
+
+/* Tick: reads the lines appended to globals.csv since the last tick. */
+void					globals_stats_live_tick(void);
+
+/* Cached stats, NULL if globals.csv could not be read. */
+const t_globals_stats	*globals_stats_live_get(void);
+
+#endif
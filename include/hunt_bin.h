@@ -0,0 +1,161 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   hunt_bin.h                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                   +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/20                                #+#    #+#             */
+/*   Updated: 2026/02/20                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef HUNT_BIN_H
+# define HUNT_BIN_H
+
+/*
+** Journal binaire "colonnes fixes" a cote de hunt_log.csv (optionnel).
+**
+** Le CSV reste la verite. Le sidecar n'est qu'une copie pre-parsee pour les
+** lecteurs (stats, series): pas de strtoll ni de strcmp sur event_type.
+**
+** Fichiers:
+**   <csv_path>.bin   : en-tete 16 octets puis 1 record fixe par ligne de
+**                      donnees du CSV (record i = ligne de donnees i, en-tete
+**                      CSV exclu, lignes illisibles incluses => HUNT_BIN_INVALID)
+**   <csv_path>.names : noms internes, 1 par ligne (id = numero de ligne)
+**
+** En-tete .bin: magic, version, taille d'un record, generation (u32).
+**
+** Ecrit par le parser (append_event). A l'ouverture, si le sidecar ne
+** correspond plus au CSV (fin du dernier record != taille du CSV), il est
+** reconstruit en une passe depuis le CSV, avec une nouvelle generation:
+** les ids de .names ne valent que pour une generation.
+**
+** TM_HUNT_BIN=0 desactive l'ecriture (les lecteurs retombent sur le CSV).
+*/
+
+# include <stdint.h>
+# include <stddef.h>
+# include <stdio.h>
+
+# include "hunt_csv.h"
+
+# define HUNT_BIN_SUFFIX       ".bin"
+# define HUNT_BIN_NAMES_SUFFIX ".names"
+# define HUNT_BIN_MAGIC        "TLHB"
+# define HUNT_BIN_VERSION      2u
+# define HUNT_BIN_HEADER_SIZE  16
+# define HUNT_BIN_NO_NAME      0xFFFFFFFFu
+
+/* t_hunt_bin_rec.bits */
+# define HUNT_BIN_HIT          0x01u   /* SHOT touche (raw "You inflicted") */
+
+typedef enum e_hunt_bin_type
+{
+	HUNT_BIN_INVALID = 0,
+	HUNT_BIN_SHOT,
+	HUNT_BIN_KILL,
+	HUNT_BIN_LOOT_ITEM,
+	HUNT_BIN_SWEAT,
+	HUNT_BIN_RECEIVED_OTHER,
+	HUNT_BIN_GLOBAL,
+	HUNT_BIN_HOF,
+	HUNT_BIN_ATH,
+	HUNT_BIN_OTHER      /* type libre: texte dans type_name_id */
+}	t_hunt_bin_type;
+
+/* 56 octets, little-endian natif (fichier local, jamais echange). */
+typedef struct s_hunt_bin_rec
+{
+	int64_t		ts_unix;
+	int64_t		value_uPED;
+	int64_t		kill_id;
+	int64_t		csv_off;       /* debut de la ligne dans le CSV */
+	int32_t		qty;
+	uint32_t	name_id;       /* HUNT_BIN_NO_NAME si vide */
+	uint32_t	flags;         /* colonne flags du CSV */
+	uint32_t	type_name_id;  /* HUNT_BIN_OTHER seulement */
+	uint32_t	csv_len;       /* longueur de la ligne ('\n' inclus) */
+	uint8_t		type;          /* t_hunt_bin_type */
+	uint8_t		has_value;
+	uint8_t		bits;          /* HUNT_BIN_HIT, ... */
+	uint8_t		reserved;
+}	t_hunt_bin_rec;
+
+typedef struct s_hunt_bin_names
+{
+	char		**v;
+	uint32_t	n;
+	uint32_t	cap;
+	long		file_pos;   /* lecteur: octets deja charges de .names */
+}	t_hunt_bin_names;
+
+typedef struct s_hunt_bin_writer
+{
+	FILE				*bin;
+	FILE				*names;
+	t_hunt_bin_names	tab;
+	uint32_t			*slots;     /* hash nom -> id + 1 (0 = libre) */
+	uint32_t			nslots;
+	int64_t				csv_pos;    /* offset CSV de la prochaine ligne */
+	int					lagging;    /* ligne multi-lignes: relire le CSV au flush */
+	char				csv_path[512];
+}	t_hunt_bin_writer;
+
+typedef struct s_hunt_bin_reader
+{
+	FILE				*bin;
+	FILE				*csv;
+	t_hunt_bin_names	tab;
+	char				names_path[512];
+	t_hunt_bin_rec		*buf;
+	size_t				buf_cap;
+	uint32_t			gen;        /* generation de tab (0 = aucune) */
+}	t_hunt_bin_reader;
+
+/* Nom texte d'un type ("SHOT", ...). "" pour INVALID/OTHER. */
+const char	*hunt_bin_type_name(t_hunt_bin_type type);
+t_hunt_bin_type	hunt_bin_type_from_str(const char *type);
+
+/*
+ * Writer. csv_out = flux CSV du parser, deja flush et positionne en fin.
+ * 0 = ok, -1 = sidecar indisponible (w reste inactif, appels sans effet).
+ */
+int		hunt_bin_writer_open(t_hunt_bin_writer *w, const char *csv_path,
+			FILE *csv_out);
+/*
+ * row = champs formates par hunt_csv_format_v2(), row_len = sa valeur de
+ * retour.
+ */
+int		hunt_bin_writer_append(t_hunt_bin_writer *w,
+			const t_hunt_csv_row_view *row, int row_len);
+/* Apres le flush du CSV (le sidecar n'est jamais en avance sur le CSV). */
+void	hunt_bin_writer_flush(t_hunt_bin_writer *w);
+/* Apres fclose() du CSV. */
+void	hunt_bin_writer_close(t_hunt_bin_writer *w);
+
+/*
+ * Reader (thread UI). Lecture par blocs de records, a la vitesse memoire.
+ * r doit etre mis a zero avant le 1er open. open/close ne touchent qu'aux
+ * fichiers (a rouvrir a chaque tick, comme le CSV); la table des noms reste
+ * chargee jusqu'a hunt_bin_reader_free().
+ * hunt_bin_reader_count(): nombre de records complets, -1 si le sidecar est
+ * absent ou ne correspond pas au CSV (le lecteur doit alors lire le CSV).
+ */
+int			hunt_bin_reader_open(t_hunt_bin_reader *r, const char *csv_path);
+void		hunt_bin_reader_close(t_hunt_bin_reader *r);
+void		hunt_bin_reader_free(t_hunt_bin_reader *r);
+long long	hunt_bin_reader_count(t_hunt_bin_reader *r);
+/* Lit jusqu'a 'max' records a partir de 'first'. Retourne le nombre lu. */
+size_t		hunt_bin_reader_read(t_hunt_bin_reader *r, unsigned long long first,
+				size_t max, const t_hunt_bin_rec **out);
+/* Nom interne (charge la suite de .names si besoin). "" si inconnu. */
+const char	*hunt_bin_reader_name(t_hunt_bin_reader *r, uint32_t id);
+/*
+ * Generation du sidecar vu au dernier open (la table des noms est videe
+ * quand elle change). Les caches par id de l'appelant sont a vider aussi.
+ */
+uint32_t	hunt_bin_reader_generation(const t_hunt_bin_reader *r);
+
+#endif
@@ -0,0 +1,106 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   hunt_bus.h                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                   +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/21                                #+#    #+#             */
+/*   Updated: 2026/02/21                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef HUNT_BUS_H
+# define HUNT_BUS_H
+
+/*
+** Bus d'evenements LIVE: parser -> caches UI (stats, serie), en memoire.
+**
+** Le parser LIVE publie chaque ligne ecrite dans hunt_log.csv, deja decodee,
+** avant meme le flush du CSV. Chaque abonne a son propre ring SPSC sans
+** verrou (1 producteur = le parser, 1 consommateur = le thread UI).
+**
+** Le CSV reste la verite: un evenement porte l'offset/longueur de sa ligne
+** dans le CSV et n'est applique que s'il commence exactement a la position
+** du lecteur. Ring plein (evenement perdu), ligne multi-lignes (non publiee)
+** ou redemarrage du parser: trou => le lecteur relit le CSV comme avant,
+** puis reprend le bus quand les offsets se rejoignent.
+**
+** REPLAY ne publie pas (debit trop eleve, le CSV est relu en fin de toute
+** facon).
+*/
+
+# include <stdint.h>
+
+# include "hunt_csv.h"
+# include "tm_money.h"
+
+# define HUNT_BUS_RING 512   /* puissance de 2 */
+
+typedef enum e_hunt_bus_sub
+{
+	HUNT_BUS_STATS = 0,
+	HUNT_BUS_SERIES,
+	HUNT_BUS_SUBS
+}	t_hunt_bus_sub;
+
+/* Meme contenu qu'une ligne V2 relue depuis le CSV. */
+typedef struct s_hunt_bus_event
+{
+	long long	csv_off;       /* debut de la ligne dans le CSV */
+	uint32_t	csv_len;       /* longueur ('\n' inclus) */
+	uint32_t	gen;           /* run du parser (hunt_bus_begin) */
+	int64_t		ts_unix;
+	tm_money_t	value_uPED;
+	int64_t		kill_id;
+	long		qty;
+	uint32_t	flags;
+	int			has_value;
+	char		type[32];
+	char		name[256];
+	char		raw[1024];
+}	t_hunt_bus_event;
+
+typedef struct s_hunt_bus_stats
+{
+	int					active;
+	unsigned long long	published;
+	unsigned long long	applied[HUNT_BUS_SUBS];
+	unsigned long long	dropped[HUNT_BUS_SUBS];   /* ring plein */
+}	t_hunt_bus_stats;
+
+/*
+** Producteur (thread parser LIVE).
+** begin: nouveau run, csv_end = taille du CSV a l'ouverture.
+** publish: row = champs formates par hunt_csv_format_v2(), len = sa valeur
+** de retour; la ligne commence a csv_off.
+*/
+void				hunt_bus_begin(long long csv_end);
+void				hunt_bus_publish(const t_hunt_csv_row_view *row,
+						long long csv_off, int len);
+void				hunt_bus_end(void);
+
+/*
+** Consommateurs (thread UI).
+** drain: evenements avant *pos ignores (deja lus du CSV), celui a *pos est
+** passe a fn puis *pos avance d'une ligne; s'arrete au premier trou (garde
+** l'evenement pour plus tard). Retourne le nombre de lignes appliquees.
+*/
+typedef void		(*t_hunt_bus_apply)(void *ctx,
+						const t_hunt_csv_row_view *row, long long csv_off);
+
+int					hunt_bus_drain(t_hunt_bus_sub sub, long *pos,
+						t_hunt_bus_apply fn, void *ctx);
+
+/*
+** Vrai si pos (> taille du CSV sur disque) est couvert par des lignes deja
+** publiees mais pas encore flushees: ce n'est pas une troncature.
+*/
+int					hunt_bus_covers(long long pos);
+
+/* Compteur de publications (sonde "nouvelles lignes" sans stat()). */
+unsigned long long	hunt_bus_version(void);
+
+void				hunt_bus_get_stats(t_hunt_bus_stats *out);
+
+#endif
@@ -32,6 +32,7 @@
 # include <stdio.h>
 
 # include "tm_money.h"
+# include "line_reader.h"
 
 typedef struct s_hunt_csv_row_view
 {
@@ -59,6 +60,85 @@ int		hunt_csv_repair_trailing_partial_line(FILE *f);
 /* Parse one CSV line (in-place). Returns 1 on success, 0 otherwise. */
 int         hunt_csv_parse_row_inplace(char *line, t_hunt_csv_row_view *out);
 
+/* Read-side fixups applied by the parser (ex: SWEAT value from qty). */
+void        hunt_csv_row_normalize(t_hunt_csv_row_view *row);
+
+/* SHOT: 1 if the raw chat line is a hit ("You inflicted ..."), 0 if missed. */
+int         hunt_csv_raw_is_hit(const char *raw);
+
+/*
+ * Row cursor for full-range scans (stats / series rebuilds, session bounds).
+ *
+ * - Linux: the file is mmap()ed once; lines are found with memchr and handed
+ *   out straight from the mapping (no fgets copy, no ftell per line).
+ * - Windows (or mmap failure): block-buffered stdio fallback (line_reader).
+ *
+ * Both modes stop at the last '\n' seen at open time: a partial last line
+ * (writer mid-append) is not a row yet, and tell() never points inside it.
+ *
+ * The header line (if any) is consumed by open (has_header = 1).
+ * Lines are never split (unlike fgets with a fixed buffer).
+ */
+typedef struct s_hunt_csv_cursor
+{
+	const char			*map;      /* NULL in stdio mode */
+	size_t				map_len;
+	size_t				size;      /* usable bytes (up to the last '\n') */
+	size_t				pos;
+	size_t				data_off;  /* first data line (after the header) */
+	FILE				*f;
+	t_line_reader		lr;
+	char				*work;     /* NUL-terminated copy for in-place parse */
+	size_t				work_cap;
+	int					has_header;
+	unsigned long long	row;       /* data row index of the next line */
+	unsigned long long	line_off;  /* byte offset of the last line returned */
+	char				path[512]; /* for csv_index lookups */
+}	t_hunt_csv_cursor;
+
+/* 0 on success, -1 if the file cannot be opened. */
+int					hunt_csv_cursor_open(t_hunt_csv_cursor *c, const char *path);
+void				hunt_csv_cursor_close(t_hunt_csv_cursor *c);
+
+/*
+ * Next raw data line ('\n' included, NOT NUL-terminated in mmap mode).
+ * Returns 1, or 0 at end of file.
+ */
+int					hunt_csv_cursor_next(t_hunt_csv_cursor *c,
+						const char **line, size_t *len);
+
+/* Next data line parsed as a V2 row: 1 = ok, 0 = malformed (consumed), -1 = EOF. */
+int					hunt_csv_cursor_next_row(t_hunt_csv_cursor *c,
+						t_hunt_csv_row_view *row);
+
+/* Skips up to n data lines (memchr only). Returns the number skipped. */
+unsigned long long	hunt_csv_cursor_skip(t_hunt_csv_cursor *c,
+						unsigned long long n);
+
+/*
+ * Jumps to a known line start (ex: session anchor, index checkpoint).
+ * byte_off must follow a '\n' (or be the first data line) and lie within the
+ * usable size; 'row' becomes the data row index of that line.
+ * 0 = ok, -1 = not a line start (cursor unchanged).
+ */
+int					hunt_csv_cursor_seek(t_hunt_csv_cursor *c,
+						unsigned long long byte_off, unsigned long long row);
+
+/*
+ * Positions the cursor on data row 'row', in order of preference:
+ *  1. byte_hint (-1 = none): expected start of that row (session anchor),
+ *     if it is a valid line start;
+ *  2. the nearest <csv>.idx checkpoint at or below 'row' (verified against
+ *     the row it claims to index), then at most one stride of skipped rows;
+ *  3. skipping rows from the current position.
+ * Returns the data row index reached (< row if the file is shorter).
+ */
+unsigned long long	hunt_csv_cursor_goto(t_hunt_csv_cursor *c,
+						unsigned long long row, long long byte_hint);
+
+/* Byte offset of the next line (== file size consumed at EOF). */
+unsigned long long	hunt_csv_cursor_tell(const t_hunt_csv_cursor *c);
+
 /* Timestamp conversions */
 int         hunt_csv_ts_text_to_unix(const char *ts_text, int64_t *out_unix);
 void        hunt_csv_format_ts_local(char *dst, size_t cap, int64_t ts_unix);
@@ -66,8 +146,13 @@ void        hunt_csv_format_ts_local(char *dst, size_t cap, int64_t ts_unix);
 /* Best-effort scan of last chunk to resume kill_id. */
 int64_t     hunt_csv_tail_max_kill_id(const char *path);
 
-/* Write one V2 row. Returns 0 on success, -1 on error. */
-int         hunt_csv_write_v2(FILE *f, int64_t ts_unix,
+/*
+ * One V2 row, formatted in memory (no NUL), '\n' included. dst must hold
+ * hunt_csv_v2_row_max() bytes. Returns the row length, -1 if cap too small.
+ */
+size_t      hunt_csv_v2_row_max(const char *type, const char *name,
+					const char *raw);
+int         hunt_csv_format_v2(char *dst, size_t cap, int64_t ts_unix,
 					const char *type, const char *name,
 					long qty, tm_money_t value_uPED,
 					int64_t kill_id, uint32_t flags,
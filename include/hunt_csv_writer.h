@@ -0,0 +1,90 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   hunt_csv_writer.h                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                   +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/22                                #+#    #+#             */
+/*   Updated: 2026/02/22                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef HUNT_CSV_WRITER_H
+# define HUNT_CSV_WRITER_H
+
+/*
+** Ecriture de hunt_log.csv par lots ("group commit").
+**
+** Les lignes V2 sont formatees dans un buffer memoire, puis le lot entier
+** part en un seul write() sur le descripteur du FILE ouvert par le parser
+** (mode "ab+", donc O_APPEND). Le FILE ne doit plus etre ecrit ensuite.
+**
+** Politiques (quand le lot est committe):
+**   latency    : ligne critique (KILL / LOOT_ITEM), 64 lignes, 64 Kio ou
+**                plus vieille ligne >= 1 s. Defaut LIVE.
+**   throughput : 1 Mio ou plus vieille ligne >= 1 s. Defaut REPLAY.
+**   fsync[:ms] : write() + fsync() quand la plus vieille ligne a >= ms
+**                (defaut 200) ou 1 Mio. Durabilite bornee dans le temps.
+**
+** TM_CSV_FLUSH=latency|throughput|fsync[:ms] force la politique (LIVE et
+** REPLAY). Chaque commit alimente monitor_health (lignes, octets, latence).
+*/
+
+# include <stddef.h>
+# include <stdint.h>
+# include <stdio.h>
+
+# include "tm_money.h"
+
+typedef enum e_csv_flush_policy
+{
+	CSV_FLUSH_LATENCY = 0,
+	CSV_FLUSH_THROUGHPUT,
+	CSV_FLUSH_FSYNC
+}	t_csv_flush_policy;
+
+typedef struct s_hunt_csv_writer
+{
+	FILE				*out;
+	int					fd;
+	char				*buf;
+	size_t				len;
+	size_t				cap;
+	size_t				batch_max;   /* commit des que len l'atteint */
+	int					rows;        /* lignes dans buf */
+	uint64_t			first_ms;    /* arrivee de la plus vieille ligne */
+	uint64_t			max_age_ms;
+	t_csv_flush_policy	policy;
+	int					err;         /* write()/fsync() en echec */
+}	t_hunt_csv_writer;
+
+const char	*hunt_csv_flush_policy_name(t_csv_flush_policy p);
+
+/*
+** Prend la main sur out (deja positionne en fin, en-tete ecrit): fflush,
+** puis tout passe par le buffer. def = politique sans TM_CSV_FLUSH.
+*/
+int			hunt_csv_writer_open(t_hunt_csv_writer *w, FILE *out,
+				t_csv_flush_policy def);
+
+/*
+** Ajoute une ligne V2 (formatee par hunt_csv_format_v2()); retourne sa
+** longueur, -1 si erreur. N'ecrit rien: voir hunt_csv_writer_due().
+*/
+int			hunt_csv_writer_append(t_hunt_csv_writer *w, int64_t ts_unix,
+				const char *type, const char *name, long qty,
+				tm_money_t value_uPED, int64_t kill_id, uint32_t flags,
+				const char *raw);
+
+/* Vrai si le lot doit partir maintenant (critical: KILL / LOOT_ITEM). */
+int			hunt_csv_writer_due(const t_hunt_csv_writer *w, uint64_t now_ms,
+				int critical);
+
+/* Ecrit le lot (+ fsync selon la politique). 0 ok, -1 erreur. */
+int			hunt_csv_writer_commit(t_hunt_csv_writer *w);
+
+/* Commit final et liberation; out reste a fermer par l'appelant. */
+void		hunt_csv_writer_close(t_hunt_csv_writer *w);
+
+#endif
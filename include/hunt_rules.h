@@ -21,7 +21,18 @@ typedef struct s_hunt_event
 
 void hunt_rules_set_player_name(const char *name);
 
+/*
+** Construit l'automate des patterns (une fois). A appeler avant de lancer
+** des threads de parsing; sinon construit au 1er usage.
+** -1 = echec d'allocation: les lignes sont alors classees par strstr()
+** (meme resultat, plus lent).
+*/
+int	hunt_rules_init(void);
 
+/*
+** Filtre de canal seul. Le parsing n'en a pas besoin: hunt_decode_line()
+** applique le meme filtre sur sa propre passe (d->ignored).
+*/
 int	hunt_should_ignore_line(const char *line);
 
 /*
@@ -30,10 +41,79 @@ int	hunt_should_ignore_line(const char *line);
 **  - retourne:
 **      0 : 1 évènement prêt (ev)
 **      1 : 1 évènement prêt (ev) + un évènement "pending" à récupérer
+**      2 : ligne ignoree (canal filtre, ligne vide): pas d'evenement,
+**          pas une erreur
 **     -1 : ligne non reconnue / erreur
 */
 int	hunt_parse_line(const char *line, t_hunt_event *ev);
 
+/*
+** Parsing en 2 etapes (utilise par le REPLAY parallele):
+**  - hunt_decode_line()  : reconnaissance des patterns, SANS etat global
+**                          => appelable depuis plusieurs threads.
+**  - hunt_apply_decoded(): regles dependant de l'ordre des lignes
+**                          (kill deduit d'un loot, groupes de loot, dedup KILL).
+**                          Meme retour que hunt_parse_line().
+** hunt_parse_line() == hunt_decode_line() + hunt_apply_decoded().
+** Une seule passe de l'automate par ligne, filtre de canal compris.
+*/
+typedef enum e_hunt_line_kind
+{
+	HUNT_LINE_NONE = 0,
+	HUNT_LINE_SHOT,
+	HUNT_LINE_RECEIVED, /* LOOT_ITEM / RECEIVED_OTHER */
+	HUNT_LINE_SWEAT,
+	HUNT_LINE_KILL
+}	t_hunt_line_kind;
+
+typedef struct s_hunt_decoded
+{
+	t_hunt_line_kind	kind;
+	int					ignored; /* canal filtre: kind NONE, pas une erreur */
+	long long			t;   /* chat timestamp (local time_t), 0 si absent */
+	t_hunt_event		ev;
+}	t_hunt_decoded;
+
+void	hunt_decode_line(const char *line, t_hunt_decoded *d);
+int		hunt_apply_decoded(t_hunt_decoded *d);
+
+/*
+** Classification seule (1 passe, sans construire l'evenement):
+** NONE (ignoree / non reconnue), SHOT, RECEIVED (loot, sweat, autre) ou KILL.
+*/
+t_hunt_line_kind	hunt_classify_line(const char *line);
+
+/*
+** Contexte de parsing explicite (reentrant).
+**
+** Tout l'etat dependant de l'ordre des lignes (kill "pending", nom du joueur,
+** derniers combat / loot / kill) vit dans un t_hunt_rules_ctx: plusieurs
+** parsers peuvent tourner en parallele (REPLAY + LIVE, 2e personnage...),
+** un contexte chacun, jamais partage entre threads.
+**
+** Les fonctions sans contexte (hunt_parse_line, hunt_apply_decoded,
+** hunt_pending_pop, hunt_rules_set_player_name) utilisent un contexte
+** par defaut interne.
+*/
+typedef struct s_hunt_rules_ctx
+{
+	int				has_pending;
+	t_hunt_event	pending;
+	char			player_name[128];
+	char			last_kill_ts[32];
+	long long		last_loot_t;          /* time_t, 0 = aucun */
+	long long		last_combat_t;
+	long long		last_explicit_kill_t;
+}	t_hunt_rules_ctx;
+
+void	hunt_rules_ctx_init(t_hunt_rules_ctx *c);
+void	hunt_rules_ctx_set_player_name(t_hunt_rules_ctx *c, const char *name);
+/* Memes retours que hunt_parse_line() / hunt_apply_decoded() / hunt_pending_pop(). */
+int		hunt_rules_ctx_parse_line(t_hunt_rules_ctx *c, const char *line,
+			t_hunt_event *ev);
+int		hunt_rules_ctx_apply(t_hunt_rules_ctx *c, t_hunt_decoded *d);
+int		hunt_rules_ctx_pending_pop(t_hunt_rules_ctx *c, t_hunt_event *ev);
+
 /*
 ** Permet de récupérer un évènement supplémentaire produit par hunt_parse_line()
 ** (ex: LOOT_ITEM + KILL dédupliqué).
@@ -4,6 +4,7 @@
 # include <time.h>
 # include <stdint.h>
 # include "tm_money.h"
+# include "hunt_bin.h"
 
 /*
  * Hunt time-series helper used by the LIVE graph screen.
@@ -16,11 +17,14 @@
 
 /*
  * Capacity targets (RCE-safe):
- * - Buckets: 60s buckets for ~11.4 days @ 16384
- * - Events: 262k loot packets / kills / shots (intensive hunts)
+ * - Buckets: 60s buckets for ~11.4 days @ 16384 (sliding window), grown
+ *   on demand
+ * - Events: no cap, one column chunk (HS_EV_CHUNK events) allocated at a
+ *   time, so memory follows the session size
  */
 # define HS_MAX_POINTS 16384
-# define HS_MAX_EVENTS 262144
+# define HS_EV_CHUNK_SHIFT 12
+# define HS_EV_CHUNK (1 << HS_EV_CHUNK_SHIFT)
 
 typedef enum e_hs_metric
 {
@@ -40,12 +44,33 @@ typedef struct s_hs_bucket
 	tm_money_t	expense_uPED;
 } 	t_hs_bucket;
 
+/*
+ * One event column (struct-of-arrays): fixed chunks of HS_EV_CHUNK
+ * elements, allocated lazily and never moved (no copy on growth).
+ */
+typedef struct s_hs_col
+{
+	void	**chunk;
+	int		nchunk;     /* allocated chunks */
+	int		slots;      /* size of chunk[] */
+} 	t_hs_col;
+
+/*
+ * A t_hunt_series must start zeroed (static or calloc); it owns heap
+ * storage, released by hunt_series_free().
+ */
 typedef struct s_hunt_series
 {
 	int		initialized;
 	long		start_offset;
+	/* Byte offset of start_offset in the CSV if known (session anchor), else -1. */
+	long long	start_byte;
 	int		bucket_sec;
 	long		file_pos;
+	/* Data row index at file_pos (header excluded): next sidecar record. */
+	long		data_idx;
+	/* <csv>.bin reader, opened per update (names kept until free). */
+	t_hunt_bin_reader	bin;
 
 	time_t		t0;
 	time_t		last_t;
@@ -59,43 +84,60 @@ typedef struct s_hunt_series
 
 	long		first_bucket; /* absolute bucket index */
 	int		count;        /* number of buckets stored */
-	t_hs_bucket	buckets[HS_MAX_POINTS];
+	int		bucket_cap;   /* allocated buckets (<= HS_MAX_POINTS) */
+	t_hs_bucket	*buckets;
 
 	/* Event list (relative seconds since t0), used for 1 point per kill, etc. */
 	int		kill_ev_count;
-	int		kill_ev_sec[HS_MAX_EVENTS];
+	t_hs_col	kill_ev_sec;          /* int */
 
 	/* Hits per kill (1 point per kill). */
 	int		hits_ev_count;
-	int		hits_ev_sec[HS_MAX_EVENTS];
-	int		hits_ev_hits[HS_MAX_EVENTS];
+	t_hs_col	hits_ev_sec;          /* int */
+	t_hs_col	hits_ev_hits;         /* int */
 	long		hits_since_kill;
 
 	/* Shots per kill (1 point per kill). Stores both shots and hits for hit-rate. */
 	int		shots_ev_count;
-	int		shots_ev_sec[HS_MAX_EVENTS];
-	int		shots_ev_shots[HS_MAX_EVENTS];
-	int		shots_ev_hits[HS_MAX_EVENTS];
+	t_hs_col	shots_ev_sec;         /* int */
+	t_hs_col	shots_ev_shots;       /* int */
+	t_hs_col	shots_ev_hits;        /* int */
 	long		shots_since_kill;
 
 	/* Loot packets (1 point per loot packet / kill) */
 	int		loot_ev_count;
-	int		loot_ev_sec[HS_MAX_EVENTS];
-	tm_money_t	loot_ev_uPED[HS_MAX_EVENTS];
+	t_hs_col	loot_ev_sec;          /* int */
+	t_hs_col	loot_ev_uPED;         /* tm_money_t */
 	/* How many CSV rows were aggregated into this loot packet (for UI marker ×N). */
-	int		loot_ev_group_count[HS_MAX_EVENTS];
-	unsigned char	loot_ev_has_kill[HS_MAX_EVENTS];
+	t_hs_col	loot_ev_group_count;  /* int */
+	t_hs_col	loot_ev_has_kill;     /* unsigned char */
 	time_t		last_loot_ev_t;
 	int64_t		last_loot_ev_kill_id;
 
 	/* Incremented when new rows are successfully integrated (UI caches). */
 	uint32_t	version;
+	/*
+	 * Changes (never back to an earlier value, never 0) when rows already
+	 * plotted may have been rewritten: reset, window slide, row landing in an
+	 * older bucket, a filter that flips for the whole history. While it holds,
+	 * a plot built with last_minutes/last_n_buckets = 0 only grows at its
+	 * end: points [0, n - 1) of the previous build are unchanged, the last
+	 * one may still move (open bucket, loot packet regrouped).
+	 */
+	uint32_t	append_gen;
 } 	t_hunt_series;
 
+/* Empties the series (storage released, reallocated on demand). */
 void	hunt_series_reset(t_hunt_series *s, long start_offset, int bucket_sec);
 
+/* Releases the storage; s stays valid (empty) and can be reset again. */
+void	hunt_series_free(t_hunt_series *s);
+
 /*
- * Incrementally updates the series by reading newly appended CSV rows.
+ * Incrementally updates the series by reading newly appended CSV rows
+ * (from the <csv>.bin sidecar when it holds them, see hunt_bin.h).
+ * Also consumes the HUNT_BUS_SERIES ring (rows the LIVE parser has not
+ * flushed yet): meant for the single live series (hunt_series_live).
  * Returns 1 on success (even if no new data), 0 on error.
  */
 int		hunt_series_update(t_hunt_series *s, const char *csv_path);
@@ -228,6 +270,8 @@ int		hunt_series_sanity_check(const t_hunt_series *s);
  * - start_line/end_line are DATA-line indices (0-based, header ignored)
  * - end_line is exclusive; use -1 for "until EOF"
  * - bucket_sec: size of aggregation buckets in seconds (default 60)
+ * - rows mirrored in the <csv>.bin sidecar are read from it, the CSV only
+ *   for the rest
  *
  * Used to display graphs when the user loads an exported session range.
  */
@@ -237,4 +281,12 @@ int		hunt_series_rebuild_range(t_hunt_series *s,
 					long end_line,
 					int bucket_sec);
 
+/* Same, start_byte = byte offset of start_line when known (-1 = scan). */
+int		hunt_series_rebuild_range_at(t_hunt_series *s,
+					const char *csv_path,
+					long start_line,
+					long long start_byte,
+					long end_line,
+					int bucket_sec);
+
 #endif
@@ -0,0 +1,48 @@
+#ifndef LINE_READER_H
+# define LINE_READER_H
+
+/*
+** Lecteur de lignes par blocs (REPLAY de gros chat.log).
+**
+** - Lit le fichier par gros blocs (fread), cherche les '\n' avec memchr.
+** - Rend des vues "zero-copy" directement dans le buffer interne.
+** - Aucune limite de longueur: le buffer grandit si une ligne ne tient pas
+**   (une ligne longue n'est jamais coupee en deux, contrairement a fgets).
+**
+** La vue inclut le '\n' final (comme fgets) et est terminee par NUL.
+** Elle reste valide jusqu'au prochain appel a line_reader_next().
+*/
+
+# include <stddef.h>
+# include <stdio.h>
+
+# define LINE_READER_BLOCK (1 << 20)
+
+typedef struct s_line_view
+{
+	const char	*ptr;
+	size_t		len;
+}	t_line_view;
+
+typedef struct s_line_reader
+{
+	FILE				*f;
+	char				*buf;
+	size_t				cap;     /* usable bytes (buf has cap + 1) */
+	size_t				start;   /* next unread byte */
+	size_t				end;     /* end of valid data */
+	size_t				nul_pos; /* byte overwritten by the view NUL */
+	char				nul_saved;
+	int					nul_active;
+	int					eof;
+	unsigned long long	bytes;   /* bytes handed out so far */
+}	t_line_reader;
+
+/* 'block' = initial buffer size (0 => LINE_READER_BLOCK). Returns 0 on success. */
+int		line_reader_init(t_line_reader *r, FILE *f, size_t block);
+void	line_reader_free(t_line_reader *r);
+
+/* Returns 1 with a line in 'out', 0 at end of file, -1 on error. */
+int		line_reader_next(t_line_reader *r, t_line_view *out);
+
+#endif
@@ -14,6 +14,9 @@
 # define MARKUP_H
 
 # include <stddef.h>
+# include <stdint.h>
+
+# include "tm_money.h"
 
 typedef enum e_markup_type
 {
@@ -26,13 +29,22 @@ typedef struct s_markup_rule
     char			name[128];
     t_markup_type	type;
     double			value;
+    /* Pre-calcul (markup_rule_prepare): pas de double par ligne */
+    int64_t			mul_1e4;    /* percent: 10000 = x1.0000 */
+    tm_money_t		add_uPED;   /* tt_plus */
 }	t_markup_rule;
 
+/*
+ * * items[] garde l'ordre du fichier; slots[] = index hash nom -> i + 1
+ ** (0 = libre), reconstruit par markup_db_reindex().
+ */
 typedef struct s_markup_db
 {
     t_markup_rule	*items;
     size_t			count;
     size_t			cap;
+    uint32_t		*slots;
+    size_t			nslots;
 }	t_markup_db;
 
 void	markup_db_init(t_markup_db *db);
@@ -49,6 +61,17 @@ int		markup_db_load(t_markup_db *db, const char *path);
 /* Save whole db back to an INI file (rewrite file). Returns 0 on success. */
 int		markup_db_save(const t_markup_db *db, const char *path);
 
+/*
+ * * A appeler apres une modification directe de items[] (menu config):
+ ** recalcule mul_1e4/add_uPED et l'index. Retourne 0, -1 si alloc.
+ */
+int		markup_db_reindex(t_markup_db *db);
+
+/*
+ * * Index de la règle 'item_name' dans items[] (hash, O(1)), -1 si absente.
+ */
+long	markup_db_find(const t_markup_db *db, const char *item_name);
+
 /*
  * * Recherche une règle par nom exact.
  ** Retourne 1 si trouvé, 0 sinon.
@@ -63,6 +86,16 @@ int		markup_db_get(const t_markup_db *db, const char *item_name,
  */
 double	markup_apply(const t_markup_rule *r, double tt_value);
 
+/*
+ * * Remplit mul_1e4/add_uPED depuis type/value (percent <= 0 => x1).
+ */
+void	markup_rule_prepare(t_markup_rule *r);
+
+/*
+ * * Meme regle en uPED, arithmetique entiere (tm_money_mul_mu).
+ */
+tm_money_t	markup_rule_apply_money(const t_markup_rule *r, tm_money_t tt);
+
 /*
  * * Fallback rule (percent 1.00)
  */
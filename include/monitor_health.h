@@ -23,6 +23,22 @@ typedef struct s_health_error
 	char		msg[HEALTH_ERR_MSG];
 } 	t_health_error;
 
+/* CSV writer commit latency buckets: <=100us, 1ms, 10ms, 100ms, 1s, more. */
+#define HEALTH_LAT_BUCKETS 6
+
+typedef struct s_health_csv_writer
+{
+	char		policy[16];          /* "" = no writer yet */
+	long long	rows;
+	long long	bytes;
+	long long	commits;             /* write() batches */
+	long long	syncs;               /* fsync() */
+	int		rows_per_sec;        /* avg 10s (snapshot only) */
+	long long	bytes_per_sec;       /* avg 10s (snapshot only) */
+	int		lat_hist[HEALTH_LAT_BUCKETS];
+	int		lat_max_us;
+} 	t_health_csv_writer;
+
 typedef struct s_monitor_health
 {
 	uint64_t	now_ms;
@@ -47,6 +63,24 @@ typedef struct s_monitor_health
 	HealthLevel	io_level;
 	HealthLevel	lag_level;
 
+	/* chat.log watch (LIVE tailing) */
+	char		watch_backend[16];   /* "inotify" / "polling" */
+	long long	watch_wakeups;       /* change notifications (or polls) */
+	long long	watch_timeouts;      /* idle waits without change */
+	long long	watch_size_checks;   /* chat.log size probes */
+	int		watch_latency_ms;    /* last wakeup -> new lines drained */
+	int		watch_latency_max_ms;
+
+	/* REPLAY throughput */
+	long long	replay_bytes;
+	long long	replay_ms;
+	int		replay_done;
+	int		replay_mbps_x100;    /* MiB/s * 100 */
+	int		replay_threads;      /* decode threads (1 = sequential) */
+
+	/* CSV writer (group commit) */
+	t_health_csv_writer	csv_writer;
+
 	/* Ring buffer */
 	t_health_error	errors[HEALTH_ERR_RING];
 	int		errors_count;
@@ -58,11 +92,44 @@ void	monitor_health_reset(const char *chat_path, const char *csv_path);
 /* Parser thread hooks */
 void	monitor_health_on_event(uint64_t now_ms);
 void	monitor_health_on_flush(uint64_t now_ms, int ok, int err_no, int ferror_code);
+/* Number of CSV flushes so far (monotonic): cheap "hunt_log changed" probe. */
+unsigned long long	monitor_health_csv_version(void);
+
+/*
+ * CSV writer hooks. set_csv_policy() starts a new writer (counters reset);
+ * on_csv_commit(): one batch of 'rows' rows / 'bytes' bytes written in
+ * 'latency_us' (write + fsync if any).
+ */
+void	monitor_health_set_csv_policy(const char *name);
+void	monitor_health_on_csv_commit(uint64_t now_ms, int rows, long long bytes,
+							uint64_t latency_us, int synced);
 void	monitor_health_on_io_error(const char *ctx, int err_no, int ferror_code);
 void	monitor_health_on_parse_error(const char *ctx);
+/* Same, for 'n' errors at once (parallel REPLAY batches): one ring entry. */
+void	monitor_health_on_parse_errors(const char *ctx, long long n);
 void	monitor_health_update_io(uint64_t now_ms, long chat_size, long chat_pos,
 							long csv_size, int rotated);
 
+/* Split updates: chat.log side (ingest thread) / CSV side (parser). */
+void	monitor_health_update_chat(uint64_t now_ms, long chat_size, long chat_pos,
+							int rotated);
+void	monitor_health_update_csv(long csv_size);
+
+/*
+ * LIVE tailing (fs_watch) hooks.
+ * set_watch_backend() starts a new watch session (counters reset); the
+ * counters survive monitor_health_reset() since the tail may outlive a parser.
+ */
+void	monitor_health_set_watch_backend(const char *name);
+void	monitor_health_on_watch_wait(int changed);
+void	monitor_health_on_watch_check(void);
+void	monitor_health_on_watch_drain(uint64_t latency_ms);
+
+/* REPLAY hook: bytes of chat.log consumed so far (done=1 at the end). */
+void	monitor_health_on_replay_progress(long long bytes, uint64_t elapsed_ms,
+							int done);
+void	monitor_health_set_replay_threads(int threads);
+
 /* UI thread: consistent snapshot (lock-free). */
 void	monitor_health_snapshot(MonitorHealth *out, uint64_t now_ms);
 
@@ -0,0 +1,58 @@
+#ifndef PATTERN_SET_H
+# define PATTERN_SET_H
+
+/*
+** Recherche multi-motifs (Aho-Corasick compile en automate deterministe).
+**
+** Construit une fois a partir d'une table de motifs, puis chaque ligne est
+** parcourue en UNE passe (1 acces table par octet) au lieu d'un strstr()
+** par motif.
+**
+** Le scan rend, pour chaque motif present, sa PREMIERE occurrence (meme
+** resultat que strstr(line, motif)).
+**
+** Table compacte: les octets sont regroupes en classes (un octet absent de
+** tous les motifs = classe 0), et chaque transition stocke directement le
+** debut de ligne de l'etat suivant + un bit "etat acceptant" => 1 seul
+** acces memoire par octet. Limite: etats * classes <= PATTERN_SET_MAX_CELLS.
+** A la racine, les octets qui ne commencent aucun motif sont sautes sans
+** passer par l'automate (first-byte dispatch): preferer des motifs dont le
+** 1er octet est rare (pas d'espace en tete).
+*/
+
+# include <stddef.h>
+# include <stdint.h>
+
+# define PATTERN_SET_MAX 64
+# define PATTERN_SET_MAX_CELLS 0x7FFF
+
+typedef struct s_pattern_set
+{
+	uint8_t		cls[256];   /* octet -> classe */
+	uint8_t		first[256]; /* 1 = un motif commence par cet octet */
+	uint16_t	*delta;   /* [nstates][nclass]: row(next) | PS_ACCEPT */
+	uint64_t	*out;     /* [nstates] motifs finissant ici (liens suffixes inclus) */
+	size_t		*len;     /* [npats] */
+	size_t		npats;
+	size_t		nstates;
+	size_t		nclass;
+}	t_pattern_set;
+
+typedef struct s_pattern_match
+{
+	uint64_t	found;                   /* bit i = motif i present */
+	const char	*at[PATTERN_SET_MAX];    /* valide seulement si bit i */
+}	t_pattern_match;
+
+/* npats <= PATTERN_SET_MAX, motifs non vides. 0 = ok, -1 = erreur. */
+int		pattern_set_build(t_pattern_set *ps, const char *const *pats,
+			size_t npats);
+void	pattern_set_free(t_pattern_set *ps);
+
+void	pattern_set_scan(const t_pattern_set *ps, const char *s,
+			t_pattern_match *m);
+
+/* Premiere occurrence du motif 'id' (NULL si absent), comme strstr(). */
+const char	*pattern_match_at(const t_pattern_match *m, size_t id);
+
+#endif
@@ -0,0 +1,85 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   refresh_sched.h                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/21                                #+#    #+#             */
+/*   Updated: 2026/02/21                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef REFRESH_SCHED_H
+# define REFRESH_SCHED_H
+
+# include <stdint.h>
+
+/*
+ * Change-driven refresh of the UI caches.
+ *
+ *  - Each data source registers a cheap probe returning a signature
+ *    (file size/mtime, parser flush counter...) and a refresh callback.
+ *  - On each period, every probe runs; only the sources whose signature
+ *    moved are refreshed (miss), the others are skipped (hit).
+ *  - Sources are refreshed in registration order.
+ *  - A producer that knows better (event bus) can mark a source dirty: it
+ *    is refreshed on the next tick, without waiting for the period.
+ *
+ * NOTE: UI thread only.
+ */
+
+# define REFRESH_SCHED_MAX 8
+
+typedef uint64_t	(*t_refresh_probe)(void *ctx);
+typedef void		(*t_refresh_fn)(void *ctx);
+
+typedef struct s_refresh_source
+{
+	const char			*name;
+	t_refresh_probe		probe;
+	t_refresh_fn		refresh;
+	void				*ctx;
+	uint64_t			sig;
+	int					dirty;      /* refresh on next tick whatever sig */
+	unsigned long long	hits;       /* unchanged: skipped */
+	unsigned long long	misses;     /* changed: refreshed */
+	uint64_t			last_us;    /* last refresh cost */
+	uint64_t			max_us;
+	uint64_t			total_us;
+}	t_refresh_source;
+
+typedef struct s_refresh_sched
+{
+	t_refresh_source	src[REFRESH_SCHED_MAX];
+	int					n;
+	uint64_t			period_ms;
+	uint64_t			last_ms;    /* 0 = tick now */
+	int					pending;    /* marked sources, before the period */
+	uint64_t			probe_us;   /* cost of the last probe pass */
+}	t_refresh_sched;
+
+void		refresh_sched_init(t_refresh_sched *s, uint64_t period_ms);
+
+/* Index of the new source (dirty until its first refresh), -1 if full. */
+int			refresh_sched_add(t_refresh_sched *s, const char *name,
+				t_refresh_probe probe, t_refresh_fn refresh, void *ctx);
+
+/* Marks every source dirty and runs the next tick without waiting. */
+void		refresh_sched_invalidate(t_refresh_sched *s);
+
+/* Source idx refreshed on the next tick, even within the period. */
+void		refresh_sched_mark(t_refresh_sched *s, int idx);
+
+/* Probes (once per period) and refreshes the dirty sources; returns how many. */
+int			refresh_sched_tick(t_refresh_sched *s, uint64_t now_ms);
+
+/*
+ * Signature helpers: fold (size, mtime) of a file into h (FNV-1a),
+ * a missing file folds as its own value.
+ */
+uint64_t	refresh_sig_begin(void);
+uint64_t	refresh_sig_u64(uint64_t h, uint64_t v);
+uint64_t	refresh_sig_file(uint64_t h, const char *path);
+
+#endif
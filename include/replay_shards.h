@@ -0,0 +1,56 @@
+#ifndef REPLAY_SHARDS_H
+# define REPLAY_SHARDS_H
+
+/*
+** REPLAY parallele (gros chat.log).
+**
+** Le fichier est lu par lots; chaque lot est coupe en "shards" sur des
+** frontieres de ligne et chaque shard est decode par un thread.
+** Les enregistrements produits sont ensuite rendus DANS L'ORDRE du fichier
+** au thread appelant (callback apply), qui garde donc seul l'etat dependant
+** de l'ordre (kill_id, rattachement des loots, groupes de loot...).
+**
+** - decode(): appele depuis les threads => ne doit toucher AUCUN etat global.
+**   La ligne est terminee par NUL et inclut le '\n' final (comme fgets).
+**   Retour: 1 = garder 'rec', 0 = ignorer, -1 = ligne rejetee (comptee).
+** - apply():  appele sur le thread appelant, dans l'ordre des lignes.
+** - progress(): optionnel, apres chaque lot (octets lus, rejets du lot).
+*/
+
+# include <stdatomic.h>
+# include <stddef.h>
+# include <stdio.h>
+
+# define REPLAY_SHARDS_MAX_THREADS 8
+# define REPLAY_SHARD_BYTES (256 * 1024)
+
+typedef int		(*t_shard_decode_fn)(void *ctx, const char *line, size_t len,
+					void *rec);
+typedef void	(*t_shard_apply_fn)(void *ctx, void *rec);
+typedef void	(*t_shard_progress_fn)(void *ctx, unsigned long long bytes,
+					long long rejected);
+
+typedef struct s_replay_shards_cfg
+{
+	int					threads;     /* 0 => replay_shards_default_threads() */
+	size_t				shard_bytes; /* 0 => REPLAY_SHARD_BYTES */
+	size_t				rec_size;
+	t_shard_decode_fn	decode;
+	void				*decode_ctx;
+	t_shard_apply_fn	apply;
+	void				*apply_ctx;
+	t_shard_progress_fn	progress;
+	void				*progress_ctx;
+}	t_replay_shards_cfg;
+
+/*
+** Nombre de threads de decodage: TM_REPLAY_THREADS si defini (1 = REPLAY
+** sequentiel historique), sinon nombre de CPU (max REPLAY_SHARDS_MAX_THREADS).
+*/
+int		replay_shards_default_threads(void);
+
+/* Lit 'in' jusqu'a EOF (ou stop_flag). 0 = ok, -1 = erreur (memoire/thread). */
+int		replay_shards_run(FILE *in, const t_replay_shards_cfg *cfg,
+			atomic_int *stop_flag);
+
+#endif
@@ -8,6 +8,39 @@
 long	session_load_offset(const char *path);
 int		session_save_offset(const char *path, long offset);
 
+/*
+** Ancre de session: ligne de donnees + position octet de cette ligne dans le
+** CSV + taille du CSV a l'ecriture + empreinte (FNV-1a des
+** SESSION_ANCHOR_FP_LEN octets qui precedent l'ancre, '\n' final inclus).
+** Format fichier offset: "<line> <byte_offset> <file_size> <fingerprint>"
+** (les anciens fichiers restent lisibles: sans empreinte, l'ancre est
+** ignoree et la ligne est recherchee dans le CSV).
+** Le CSV etant append-only, l'octet reste valable tant que la taille
+** actuelle >= file_size et que les octets precedents sont les memes (un CSV
+** vide puis re-rempli au-dela de file_size est ainsi detecte).
+*/
+# define SESSION_ANCHOR_FP_LEN 64
+
+typedef struct s_session_anchor
+{
+	long		line;
+	long long	byte_offset;  /* -1 = inconnu */
+	long long	file_size;
+	long long	fingerprint;  /* -1 = inconnu */
+}	t_session_anchor;
+
+/* Calcule l'ancre de 'line' dans csv_path (O(1) si line = fin du CSV). */
+int			session_anchor_locate(const char *csv_path, long line,
+				t_session_anchor *out);
+/* Octet de debut de a->line, ou -1 si l'empreinte ne correspond plus. */
+long long	session_anchor_resolve(const char *csv_path,
+				const t_session_anchor *a);
+
+int		session_load_offset_anchor(const char *path, t_session_anchor *out);
+/* Comme session_save_offset(), avec l'ancre octet calculee sur csv_path. */
+int		session_save_offset_ex(const char *path, const char *csv_path,
+			long offset);
+
 /*
 ** Optional: session "range" (start,end) in data-line indices (0-based, header ignored).
 ** If end is -1, it means "until EOF".
@@ -15,6 +48,11 @@ int		session_save_offset(const char *path, long offset);
 */
 int		session_load_range(const char *path, long *out_start, long *out_end);
 int		session_save_range(const char *path, long start, long end);
+/* Format etendu: "<start> <end> <start_byte> <file_size> <fingerprint>". */
+int		session_load_range_anchor(const char *path, t_session_anchor *out_start,
+			long *out_end);
+int		session_save_range_ex(const char *path, const char *csv_path,
+			long start, long end);
 int		session_clear_range(const char *path);
 
 /*
@@ -0,0 +1,75 @@
+#ifndef STATS_TABLE_H
+# define STATS_TABLE_H
+
+/*
+** Agregats par nom (mobs tues, items lootes, globals) pour les stats.
+**
+** Table de hachage a adressage ouvert (sondage lineaire, puissance de 2,
+** charge <= 1/2). Les noms sont internes une seule fois dans une arena de
+** blocs: pas de strdup par cle, les pointeurs restent valides jusqu'a
+** stats_table_free(). Les entrees sont denses, dans l'ordre d'insertion.
+**
+** Le top-N passe par un tas borne de N entrees (O(n log N)) au lieu d'un
+** qsort de toute la table: assez leger pour etre refait a chaque tick.
+*/
+
+# include <stddef.h>
+# include <stdint.h>
+
+# include "tm_money.h"
+
+typedef struct s_stats_entry
+{
+	const char	*key;       /* interne (arena) */
+	uint32_t	hash;
+	uint32_t	seq;        /* rang d'insertion */
+	long		count;      /* kills ou evenements loot */
+	tm_money_t	tt_sum;
+	tm_money_t	final_sum;  /* TT + MU */
+	double		sum;        /* globals (PED, double comme globals.csv) */
+}	t_stats_entry;
+
+typedef struct s_stats_arena
+{
+	struct s_stats_arena	*next;
+	size_t					used;
+	size_t					cap;
+	char					data[];
+}	t_stats_arena;
+
+typedef struct s_stats_table
+{
+	t_stats_entry	*v;
+	size_t			len;
+	size_t			cap;
+	uint32_t		*slots;     /* index + 1, 0 = libre */
+	size_t			nslots;
+	t_stats_arena	*arena;
+}	t_stats_table;
+
+/*
+** Ordre du top: > 0 si a passe avant b.
+** count: count decroissant puis nom croissant (top mobs).
+** final: final_sum decroissant puis ordre d'insertion (top loot).
+** sum: sum decroissant, count decroissant puis nom croissant (globals).
+*/
+typedef int	(*t_stats_rank)(const t_stats_entry *a, const t_stats_entry *b);
+
+int		stats_rank_count(const t_stats_entry *a, const t_stats_entry *b);
+int		stats_rank_final(const t_stats_entry *a, const t_stats_entry *b);
+int		stats_rank_sum(const t_stats_entry *a, const t_stats_entry *b);
+
+/* Table mise a zero = table vide valide. */
+void	stats_table_free(t_stats_table *t);
+
+/* Entree de 'key' ("(unknown)" si vide), creee a zero. NULL si malloc echoue. */
+t_stats_entry	*stats_table_get(t_stats_table *t, const char *key);
+
+/*
+** Remplit out[0..ret) avec les 'max' meilleures entrees selon 'rank',
+** triees (meilleure d'abord). Pointeurs valides jusqu'au prochain get/free.
+*/
+size_t	stats_table_top(const t_stats_table *t, t_stats_rank rank,
+			const t_stats_entry **out, size_t max);
+
+#endif
@@ -0,0 +1,46 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   tm_fmt.h                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                   +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/22                                #+#    #+#             */
+/*   Updated: 2026/02/22                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TM_FMT_H
+# define TM_FMT_H
+
+/*
+** Integer / fixed-point formatting without the printf machinery.
+**
+** Hot paths (hunt CSV rows, sessions export, money labels) format millions
+** of int64 per replay. Output is byte-identical to "%lld" / "%llu" and to
+** tm_money_format_ped4/ped2 ("-12.3456", "0.05").
+**
+** The *_raw variants write no NUL and return the length; dst must hold
+** TM_FMT_I64_MAX bytes (TM_FMT_MONEY_MAX for money).
+*/
+
+# include <stddef.h>
+# include <stdint.h>
+
+# define TM_FMT_I64_MAX		21      /* "-9223372036854775808" */
+# define TM_FMT_MONEY_MAX	22      /* sign + 15 digits + '.' + 4 */
+
+size_t	tm_fmt_u64_raw(char *dst, uint64_t v);
+size_t	tm_fmt_i64_raw(char *dst, int64_t v);
+
+/*
+** Fixed point: v in 1/10^scale_digits units, printed with 'decimals'
+** digits (decimals <= scale_digits, rounded half away from zero).
+*/
+size_t	tm_fmt_fixed_raw(char *dst, int64_t v, int scale_digits,
+			int decimals);
+
+/* NUL-terminated (truncated to cap - 1), returns the full length. */
+size_t	tm_fmt_i64(char *dst, size_t cap, int64_t v);
+
+#endif
@@ -0,0 +1,35 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   tm_time.h                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                   +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/22                                #+#    #+#             */
+/*   Updated: 2026/02/22                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TM_TIME_H
+# define TM_TIME_H
+
+/*
+** Local "YYYY-MM-DD HH:MM:SS" (chat.log) -> unix time, without mktime per
+** line.
+**
+** The fixed layout is decoded with digit arithmetic; the UTC offset of the
+** calendar day comes from a small cache (one mktime pair per new day).
+** Days where the offset changes (DST switch) and any other layout go
+** through sscanf + mktime as before, so results always equal mktime with
+** tm_isdst = -1.
+**
+** Thread-safe (REPLAY decode threads): cache slots are single atomic words.
+** The local timezone is assumed fixed for the life of the process.
+*/
+
+# include <stdint.h>
+
+/* 1 on success (*out = unix time), 0 if ts is not a valid timestamp. */
+int	tm_time_local_to_unix(const char *ts, int64_t *out);
+
+#endif
@@ -0,0 +1,32 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   tm_wake.h                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                   +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17                                #+#    #+#             */
+/*   Updated: 2026/10/17                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TM_WAKE_H
+# define TM_WAKE_H
+
+/*
+** "Nouvelles donnees" vers le thread UI, sans dependre du backend fenetre.
+**
+** Les modules de donnees (hunt_bus, monitor_health, globals_engine)
+** appellent tm_wake() apres une ecriture; main.c branche window_wake()
+** une fois la fenetre creee. Sans notifieur, tm_wake() ne fait rien (outils,
+** benchs): l'UI verra les donnees au prochain tick idle.
+**
+** tm_wake_set_notify() avant le demarrage des threads parser/globals.
+*/
+
+typedef void	(*t_tm_wake_fn)(void);
+
+void	tm_wake_set_notify(t_tm_wake_fn fn);
+void	tm_wake(void);
+
+#endif
@@ -87,4 +87,11 @@ int	tracker_stats_compute(const char *csv_path, long start_line, t_hunt_stats *o
 int	tracker_stats_compute_range(const char *csv_path, long start_line,
 								  long end_line, t_hunt_stats *out);
 
+/*
+** Same, start_byte = byte offset of start_line in the CSV when known
+** (session anchor), -1 otherwise. An invalid offset falls back to a scan.
+*/
+int	tracker_stats_compute_range_at(const char *csv_path, long start_line,
+		long long start_byte, long end_line, t_hunt_stats *out);
+
 #endif
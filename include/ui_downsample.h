@@ -45,4 +45,115 @@ int	ui_downsample_minmax_pixels(
 		int rep_cap,
 		int *out_rep_n);
 
+/*
+** Min/max pyramid (segment tree) over one series, kept between frames.
+**
+** Zooming or resizing a graph re-downsamples the same data: with the
+** pyramid each pixel column costs O(log n) (column bounds by bisection on
+** x, extrema by tree query) instead of a walk over all its points.
+**
+** ui_ds_pyramid_sync() copies the series and recomputes only the leaves
+** from the first changed index, and their ancestors. Returns that first
+** changed index (n: unchanged), -1 when out of memory (the pyramid is
+** left empty). Finding it compares the whole copy: O(n).
+** ui_ds_pyramid_sync_from() trusts the caller instead: [0, from) did not
+** change (e.g. an append generation that did not move), so appending k
+** points costs O(k + log n). Same return value.
+** A t_ui_ds_pyramid must start zeroed; UI thread only.
+*/
+typedef struct s_ui_ds_pyramid
+{
+	double	*v;         /* series copy (leaves) */
+	int		*x;         /* x_seconds copy (or index) */
+	int		*imin;      /* per node: leftmost smallest value, -1 = empty */
+	int		*imax;      /* per node: leftmost largest value */
+	int		n;
+	int		size;       /* leaves, power of 2 */
+	int		bad;        /* first NaN / x going back (n: none) */
+}	t_ui_ds_pyramid;
+
+int	ui_ds_pyramid_sync(t_ui_ds_pyramid *p, const double *values,
+		const int *x_seconds, int n);
+int	ui_ds_pyramid_sync_from(t_ui_ds_pyramid *p, const double *values,
+		const int *x_seconds, int n, int from);
+void	ui_ds_pyramid_free(t_ui_ds_pyramid *p);
+
+/*
+** Same polyline points and markers as ui_downsample_minmax_pixels() in
+** O(pixels * log n), from a pyramid synced with (values, x_seconds, n).
+** poly_idx can differ when several points of a column fall on its top or
+** bottom row: here the (leftmost) extreme value, there the first point to
+** reach that row. Both name a point drawn on that same pixel.
+** Falls back to the linear walk when the pyramid does not match n or the
+** series has NaN gaps / unsorted x.
+*/
+int	ui_downsample_minmax_pyramid(
+		const t_ui_ds_pyramid *p,
+		const double *values,
+		const int *x_seconds,
+		int n,
+		int xmin,
+		int xmax,
+		double vmin,
+		double vmax,
+		t_rect plot,
+		t_point_i *poly_pts,
+		int *poly_idx,
+		int poly_cap,
+		t_point_i *rep_pts,
+		int *rep_idx,
+		int rep_cap,
+		int *out_rep_n);
+
+/*
+** Pixel columns of one x view, in value space: per column the first,
+** last, smallest and largest point (indices into the pyramid). They do
+** not depend on the y scale, so a new vmax only re-projects them, O(px).
+**
+** - ui_ds_columns_build(): all columns, O(px * log n). 0 if the pyramid
+**   cannot serve (NaN / unsorted x), out of memory or plot too small.
+** - ui_ds_columns_update(): the pyramid was synced once since, 'from'
+**   being the first changed index. Refills only the columns from the first
+**   changed point on and returns the first one (px_w: none changed),
+**   -1 if the columns must be built again.
+** - ui_ds_columns_emit(): keeps the poly_n / *rep_n points emitted left of
+**   col_from and projects the columns >= col_from with [vmin..vmax] into
+**   plot (same output as ui_downsample_minmax_pyramid()). Returns the new
+**   polyline count, -1 if the columns do not match the pyramid / plot.
+** A t_ui_ds_columns must start zeroed; UI thread only.
+*/
+typedef struct s_ui_ds_col
+{
+	int	first;      /* -1 = no point in this column */
+	int	last;
+	int	imin;       /* leftmost smallest value */
+	int	imax;       /* leftmost largest value */
+}	t_ui_ds_col;
+
+typedef struct s_ui_ds_columns
+{
+	t_ui_ds_col	*col;
+	int			cap;
+	int			px_w;       /* plot.w + 1, 0 = not built */
+	int			xmin;
+	int			xmax;
+	int			n;          /* pyramid points the columns cover */
+}	t_ui_ds_columns;
+
+int	ui_ds_columns_build(t_ui_ds_columns *c, const t_ui_ds_pyramid *p,
+		int xmin, int xmax, int plot_w);
+int	ui_ds_columns_update(t_ui_ds_columns *c, const t_ui_ds_pyramid *p,
+		int from);
+int	ui_ds_columns_emit(const t_ui_ds_columns *c, const t_ui_ds_pyramid *p,
+		int col_from, double vmin, double vmax, t_rect plot,
+		t_point_i *poly_pts, int *poly_idx, int poly_n, int poly_cap,
+		t_point_i *rep_pts, int *rep_idx, int *rep_n, int rep_cap);
+void	ui_ds_columns_free(t_ui_ds_columns *c);
+
+/*
+** Largest value with x in [x0..x1] (0 if none) in O(log n).
+** Returns 0 if the pyramid cannot answer (NaN / unsorted x).
+*/
+int	ui_ds_pyramid_max(const t_ui_ds_pyramid *p, int x0, int x1, double *out);
+
 #endif
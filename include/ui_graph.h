@@ -118,6 +118,13 @@ void	ui_graph_timeseries_badges_annotations(t_window *w, t_ui_state *ui, t_rect
 /*  Zoomable variants (Overview + main zoom window)                           */
 /* -------------------------------------------------------------------------- */
 
+/*
+ * series_version: bumped by the caller when the data changes.
+ * append_gen: generation of the plotted series (0 = unknown). While it holds,
+ * only the last point may change and points are appended: the graph extends
+ * its columns instead of re-downsampling the whole series.
+ */
+
 void	ui_graph_timeseries_zoom(t_window *w, t_ui_state *ui, t_rect r,
 				const char *title,
 				const double *values,
@@ -128,7 +135,8 @@ void	ui_graph_timeseries_zoom(t_window *w, t_ui_state *ui, t_rect r,
 				const char *unit,
 				unsigned int line_color,
 				t_ui_graph_zoom *zoom,
-				uint32_t series_version);
+				uint32_t series_version,
+				uint32_t append_gen);
 
 void	ui_graph_timeseries_zoom_badges(t_window *w, t_ui_state *ui, t_rect r,
 				const char *title,
@@ -141,7 +149,8 @@ void	ui_graph_timeseries_zoom_badges(t_window *w, t_ui_state *ui, t_rect r,
 				const char *unit,
 				unsigned int line_color,
 				t_ui_graph_zoom *zoom,
-				uint32_t series_version);
+				uint32_t series_version,
+				uint32_t append_gen);
 
 void	ui_graph_timeseries_zoom_annotations(t_window *w, t_ui_state *ui, t_rect r,
 				const char *title,
@@ -155,7 +164,8 @@ void	ui_graph_timeseries_zoom_annotations(t_window *w, t_ui_state *ui, t_rect r,
 				const t_ui_graph_annot *annots,
 				int annots_n,
 				t_ui_graph_zoom *zoom,
-				uint32_t series_version);
+				uint32_t series_version,
+				uint32_t append_gen);
 
 void	ui_graph_timeseries_zoom_badges_annotations(t_window *w, t_ui_state *ui, t_rect r,
 				const char *title,
@@ -170,6 +180,7 @@ void	ui_graph_timeseries_zoom_badges_annotations(t_window *w, t_ui_state *ui, t_
 				const t_ui_graph_annot *annots,
 				int annots_n,
 				t_ui_graph_zoom *zoom,
-				uint32_t series_version);
+				uint32_t series_version,
+				uint32_t append_gen);
 
 #endif
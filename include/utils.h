@@ -29,6 +29,8 @@ void		tm_free_str_key_array(void *arr, size_t len,
 
 void		ft_sleep_ms(int ms);
 uint64_t	ft_time_ms(void);
+/* Monotonic clock in microseconds (cost measurements). */
+uint64_t	ft_time_us(void);
 
 #endif
 
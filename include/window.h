@@ -23,6 +23,18 @@ typedef struct s_point_i
 	int	y;
 }	t_point_i;
 
+/* Window-space rectangle (damage regions). */
+typedef struct s_rect_i
+{
+	int	x;
+	int	y;
+	int	w;
+	int	h;
+}	t_rect_i;
+
+# define WINDOW_DAMAGE_MAX	16
+# define WINDOW_DAMAGE_TILE	32
+
 typedef struct s_window
 {
     int				running;
@@ -64,6 +76,17 @@ typedef struct s_window
 	int			key_h;
 
     int				use_buffer;
+
+	/* Input events handled by the last window_poll_events() (redraw hint) */
+	int			input_events;
+
+	/*
+	** Damage since the last window_present(): only these rectangles are
+	** sent to the screen, nothing at all when there are none.
+	*/
+	int			damage_full;
+	int			damage_n;
+	t_rect_i	damage[WINDOW_DAMAGE_MAX];
     
     void			*backend_1;
     void			*backend_2;
@@ -92,7 +115,36 @@ void	window_draw_line(t_window *w, int x0, int y0, int x1, int y1, int color);
 */
 void	window_draw_polyline(t_window *w, const t_point_i *pts, int n, int color);
 
+/*
+** Damage: window_present() sends only the damaged rectangles and returns
+** without touching the screen when there are none.
+** - The software renderer (X11) finds the changed WINDOW_DAMAGE_TILE tiles
+**   itself by comparing the frame with the last one sent.
+** - Server-side drawing (Win32, X11 fallback) damages the whole window on
+**   any draw call.
+** - Backends add expose / resize damage; callers may add their own.
+** A frame that draws nothing and has no damage costs nothing to present.
+*/
+void	window_damage_add(t_window *w, int x, int y, int width, int height);
+void	window_damage_all(t_window *w);
+int		window_has_damage(const t_window *w);
+void	window_damage_clear(t_window *w);
+
+/*
+** Adds the tiles of w->pixels that differ from prev (same pitch, last frame
+** sent) as damage and copies them into prev.
+*/
+void	window_damage_diff(t_window *w, unsigned int *prev);
+
 void	window_present(t_window *w);
+
+/*
+** Idle wait: returns 1 as soon as input is pending on any open window or
+** window_wake() was called, 0 after timeout_ms.
+*/
+int		window_wait_events(int timeout_ms);
+/* Any thread (parser, globals): cuts the current / next idle wait short. */
+void	window_wake(void);
 void	window_destroy(t_window *w);
 
 #endif
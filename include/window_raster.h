@@ -0,0 +1,66 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   window_raster.h                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                   +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/22                                #+#    #+#             */
+/*   Updated: 2026/02/22                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef WINDOW_RASTER_H
+# define WINDOW_RASTER_H
+
+/*
+** CPU raster into a 32-bit pixel buffer (t_window.pixels).
+**
+** Same pixel rules as the X11 core requests it replaces:
+** - fill_rect covers [x, x + w) x [y, y + h),
+** - lines are thin (1 px) and include both endpoints,
+** - text draws only the glyph foreground (no background box).
+** Everything is clipped to the buffer; colors are already pixel values.
+*/
+
+# include "window.h"
+
+# include <stdint.h>
+
+# define RASTER_GLYPH_W_MAX	32
+
+typedef struct s_raster
+{
+	uint32_t	*px;
+	int			pitch;      /* pixels per row */
+	int			w;
+	int			h;
+}	t_raster;
+
+/*
+** Bitmap font: one cell of cell_w x cell_h per byte value. Row masks have
+** the leftmost pixel in bit 31. The pen sits at (origin_x, ascent) in the
+** cell and moves by advance[c].
+*/
+typedef struct s_raster_font
+{
+	int				cell_w;
+	int				cell_h;
+	int				ascent;
+	int				origin_x;
+	unsigned char	advance[256];
+	uint32_t		*rows;      /* 256 * cell_h */
+}	t_raster_font;
+
+void	raster_fill_rect(const t_raster *r, int x, int y, int w, int h,
+			uint32_t c);
+void	raster_line(const t_raster *r, int x0, int y0, int x1, int y1,
+			uint32_t c);
+void	raster_polyline(const t_raster *r, const t_point_i *pts, int n,
+			uint32_t c);
+
+/* Pen starts at (x, baseline). */
+void	raster_text(const t_raster *r, const t_raster_font *f, int x,
+			int baseline, const char *s, uint32_t c);
+
+#endif
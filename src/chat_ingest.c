@@ -0,0 +1,601 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   chat_ingest.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: login <login@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/20 00:00:00 by login             #+#    #+#             */
+/*   Updated: 2026/02/20 00:00:00 by login            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* clock_gettime() / pthread_cond_timedwait() under strict C99 builds */
+#ifndef _WIN32
+# ifndef _POSIX_C_SOURCE
+#  define _POSIX_C_SOURCE 200809L
+# endif
+#endif
+
+#include "chat_ingest.h"
+#include "fs_utils.h"
+#include "fs_watch.h"
+#include "monitor_health.h"
+#include "tm_string.h"
+#include "utils.h"
+
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Same tailing policy as the former per-parser loops: bounded waits so the
+ * stop request is seen quickly, size re-check on notification or every
+ * INGEST_SAFETY_CHECK_MS.
+ */
+#define INGEST_WAIT_SLICE_MS 250
+#define INGEST_SAFETY_CHECK_MS 2000
+#define INGEST_READ_CHUNK 65536
+
+/* -------------------------------------------------------------------------- */
+/* Portable lock / condition / thread                                         */
+/* -------------------------------------------------------------------------- */
+
+#ifdef _WIN32
+# include <windows.h>
+
+typedef SRWLOCK				t_ing_lock;
+typedef CONDITION_VARIABLE	t_ing_cond;
+# define ING_LOCK_INIT SRWLOCK_INIT
+# define ING_COND_INIT CONDITION_VARIABLE_INIT
+
+static void	ing_lock(t_ing_lock *l)
+{
+	AcquireSRWLockExclusive(l);
+}
+
+static void	ing_unlock(t_ing_lock *l)
+{
+	ReleaseSRWLockExclusive(l);
+}
+
+static void	ing_cond_wait_ms(t_ing_cond *c, t_ing_lock *l, int ms)
+{
+	(void)SleepConditionVariableSRW(c, l, (DWORD)ms, 0);
+}
+
+static void	ing_cond_broadcast(t_ing_cond *c)
+{
+	WakeAllConditionVariable(c);
+}
+#else
+# include <pthread.h>
+# include <time.h>
+
+typedef pthread_mutex_t		t_ing_lock;
+typedef pthread_cond_t		t_ing_cond;
+# define ING_LOCK_INIT PTHREAD_MUTEX_INITIALIZER
+# define ING_COND_INIT PTHREAD_COND_INITIALIZER
+
+static void	ing_lock(t_ing_lock *l)
+{
+	pthread_mutex_lock(l);
+}
+
+static void	ing_unlock(t_ing_lock *l)
+{
+	pthread_mutex_unlock(l);
+}
+
+static void	ing_cond_wait_ms(t_ing_cond *c, t_ing_lock *l, int ms)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	ts.tv_sec += ms / 1000;
+	ts.tv_nsec += (long)(ms % 1000) * 1000000L;
+	if (ts.tv_nsec >= 1000000000L)
+	{
+		ts.tv_sec++;
+		ts.tv_nsec -= 1000000000L;
+	}
+	(void)pthread_cond_timedwait(c, l, &ts);
+}
+
+static void	ing_cond_broadcast(t_ing_cond *c)
+{
+	pthread_cond_broadcast(c);
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+/* State                                                                      */
+/* -------------------------------------------------------------------------- */
+
+struct s_chat_ingest_sub
+{
+	int						active;
+	uint64_t				read_seq;
+	int						holding; /* last returned slot not released yet */
+	t_chat_ingest_sub_stats	st;
+};
+
+typedef struct s_chat_ingest
+{
+	char				path[1024];
+	FILE				*in;
+	atomic_int			stop;
+	int					running;
+	int					refs;
+
+	uint64_t			write_seq;
+	char				slots[CHAT_INGEST_RING][CHAT_INGEST_LINE_MAX];
+	t_chat_ingest_sub	subs[CHAT_INGEST_MAX_SUBS];
+
+	/* partial line carried until its '\n' arrives */
+	char				carry[CHAT_INGEST_LINE_MAX];
+	size_t				carry_len;
+	int					carry_truncated;
+
+	unsigned long long	lines;
+	unsigned long long	bytes;
+	unsigned long long	truncated;
+	unsigned long long	stalls;
+	unsigned long long	stall_ms;
+}	t_chat_ingest;
+
+static t_chat_ingest	g_ing;
+static t_ing_lock		g_lock = ING_LOCK_INIT;    /* ring + cursors */
+static t_ing_cond		g_data = ING_COND_INIT;    /* new lines */
+static t_ing_cond		g_space = ING_COND_INIT;   /* cursor advanced */
+static t_ing_lock		g_life = ING_LOCK_INIT;    /* subscribe/unsubscribe */
+
+/* -------------------------------------------------------------------------- */
+/* Ring (g_lock held)                                                         */
+/* -------------------------------------------------------------------------- */
+
+static t_chat_ingest_sub	*slowest_sub(void)
+{
+	t_chat_ingest_sub	*best;
+	int					i;
+
+	best = NULL;
+	i = 0;
+	while (i < CHAT_INGEST_MAX_SUBS)
+	{
+		if (g_ing.subs[i].active
+			&& (!best || g_ing.subs[i].read_seq < best->read_seq))
+			best = &g_ing.subs[i];
+		i++;
+	}
+	return (best);
+}
+
+static int	ring_full(void)
+{
+	t_chat_ingest_sub	*s;
+
+	s = slowest_sub();
+	if (!s)
+		return (0);
+	return (g_ing.write_seq - s->read_seq >= CHAT_INGEST_RING);
+}
+
+/* Returns 0 if a stop was requested while waiting for space. */
+static int	ring_publish(const char *line, size_t len)
+{
+	t_chat_ingest_sub	*s;
+	uint64_t			t0;
+	char				*slot;
+
+	ing_lock(&g_lock);
+	if (ring_full())
+	{
+		g_ing.stalls++;
+		s = slowest_sub();
+		if (s)
+			s->st.stalls++;
+		t0 = ft_time_ms();
+		while (ring_full() && atomic_load(&g_ing.stop) == 0)
+			ing_cond_wait_ms(&g_space, &g_lock, INGEST_WAIT_SLICE_MS);
+		g_ing.stall_ms += ft_time_ms() - t0;
+	}
+	if (atomic_load(&g_ing.stop) != 0)
+	{
+		ing_unlock(&g_lock);
+		return (0);
+	}
+	slot = g_ing.slots[g_ing.write_seq % CHAT_INGEST_RING];
+	memcpy(slot, line, len);
+	slot[len] = '\0';
+	g_ing.write_seq++;
+	g_ing.lines++;
+	g_ing.bytes += len;
+	ing_cond_broadcast(&g_data);
+	ing_unlock(&g_lock);
+	return (1);
+}
+
+/* -------------------------------------------------------------------------- */
+/* Line splitting (ingest thread only)                                        */
+/* -------------------------------------------------------------------------- */
+
+static void	carry_append(const char *p, size_t n)
+{
+	size_t	room;
+
+	/* keep 2 bytes for '\n' + NUL */
+	room = sizeof(g_ing.carry) - 2 - g_ing.carry_len;
+	if (n > room)
+	{
+		n = room;
+		g_ing.carry_truncated = 1;
+	}
+	memcpy(g_ing.carry + g_ing.carry_len, p, n);
+	g_ing.carry_len += n;
+}
+
+static int	split_and_publish(const char *buf, size_t n)
+{
+	const char	*p;
+	const char	*end;
+	const char	*nl;
+
+	p = buf;
+	end = buf + n;
+	while (p < end)
+	{
+		nl = memchr(p, '\n', (size_t)(end - p));
+		if (!nl)
+		{
+			carry_append(p, (size_t)(end - p));
+			break ;
+		}
+		carry_append(p, (size_t)(nl - p));
+		g_ing.carry[g_ing.carry_len++] = '\n';
+		if (g_ing.carry_truncated)
+			g_ing.truncated++;
+		if (!ring_publish(g_ing.carry, g_ing.carry_len))
+			return (0);
+		g_ing.carry_len = 0;
+		g_ing.carry_truncated = 0;
+		p = nl + 1;
+	}
+	return (1);
+}
+
+/* -------------------------------------------------------------------------- */
+/* Tailing (ingest thread only)                                               */
+/* -------------------------------------------------------------------------- */
+
+/* Returns 1 if chat.log grew or rotated, 0 if idle, -1 on reopen error. */
+static int	reopen_if_rotated(long *last_pos)
+{
+	long	sz;
+	int		rotated;
+
+	if (!g_ing.in)
+	{
+		/* A previous reopen failed: retry on each check. */
+		g_ing.in = fs_fopen_shared_read(g_ing.path);
+		if (!g_ing.in)
+			return (-1);
+		fseek(g_ing.in, 0, SEEK_END);
+		*last_pos = ftell(g_ing.in);
+		return (0);
+	}
+	clearerr(g_ing.in);
+	sz = fs_file_size(g_ing.path);
+	monitor_health_on_watch_check();
+	rotated = (sz >= 0 && sz < *last_pos);
+	if (rotated)
+	{
+		/* chat.log rotated or truncated: the partial line is stale */
+		g_ing.carry_len = 0;
+		g_ing.carry_truncated = 0;
+		fclose(g_ing.in);
+		g_ing.in = fs_fopen_shared_read(g_ing.path);
+		if (!g_ing.in)
+		{
+			monitor_health_on_io_error("reopen chatlog", errno, 0);
+			return (-1);
+		}
+		fseek(g_ing.in, 0, SEEK_END);
+		*last_pos = ftell(g_ing.in);
+	}
+	else
+		fseek(g_ing.in, *last_pos, SEEK_SET);
+	monitor_health_update_chat(ft_time_ms(), sz, *last_pos, rotated);
+	return (rotated || (sz >= 0 && sz > *last_pos));
+}
+
+/* Returns 1 when chat.log must be re-checked (size / rotation). */
+static int	ingest_wait(t_fs_watch *fw, uint64_t *last_check_ms)
+{
+	int			r;
+	uint64_t	now_ms;
+
+	r = fs_watch_wait(fw, INGEST_WAIT_SLICE_MS);
+	monitor_health_on_watch_wait(r == FS_WATCH_CHANGED);
+	now_ms = ft_time_ms();
+	if (r == FS_WATCH_CHANGED
+		|| now_ms - *last_check_ms >= INGEST_SAFETY_CHECK_MS)
+	{
+		*last_check_ms = now_ms;
+		return (1);
+	}
+	return (0);
+}
+
+static void	ingest_loop(void)
+{
+	static char	buf[INGEST_READ_CHUNK];
+	size_t		n;
+	long		last_pos;
+	uint64_t	last_io_ms;
+	uint64_t	last_check_ms;
+	uint64_t	wake_ms;
+	t_fs_watch	fw;
+
+	fs_watch_open(&fw, g_ing.path);
+	monitor_health_set_watch_backend(fs_watch_backend_name(&fw));
+	last_pos = ftell(g_ing.in);
+	last_io_ms = ft_time_ms();
+	last_check_ms = last_io_ms;
+	monitor_health_update_chat(last_io_ms, fs_file_size(g_ing.path), last_pos, 0);
+	wake_ms = 0;
+	while (atomic_load(&g_ing.stop) == 0)
+	{
+		n = 0;
+		if (g_ing.in)
+			n = fread(buf, 1, sizeof(buf), g_ing.in);
+		if (n > 0)
+		{
+			last_pos += (long)n;
+			if (!split_and_publish(buf, n))
+				break ;
+			if (ft_time_ms() - last_io_ms >= 1000)
+			{
+				last_io_ms = ft_time_ms();
+				monitor_health_update_chat(last_io_ms,
+					fs_file_size(g_ing.path), last_pos, 0);
+			}
+			continue ;
+		}
+		/* EOF: the batch that woke us up is fully published. */
+		if (wake_ms)
+			monitor_health_on_watch_drain(ft_time_ms() - wake_ms);
+		wake_ms = 0;
+		if (ingest_wait(&fw, &last_check_ms))
+		{
+			if (reopen_if_rotated(&last_pos) > 0)
+				wake_ms = ft_time_ms();
+		}
+		else if (g_ing.in)
+		{
+			clearerr(g_ing.in);
+			fseek(g_ing.in, last_pos, SEEK_SET);
+		}
+	}
+	fs_watch_close(&fw);
+}
+
+/* -------------------------------------------------------------------------- */
+/* Thread                                                                     */
+/* -------------------------------------------------------------------------- */
+
+#ifdef _WIN32
+static HANDLE	g_th = NULL;
+
+static DWORD WINAPI	thread_fn(LPVOID p)
+{
+	(void)p;
+	ingest_loop();
+	return (0);
+}
+
+static int	start_thread(void)
+{
+	DWORD	id;
+
+	g_th = CreateThread(NULL, 0, thread_fn, NULL, 0, &id);
+	return (g_th ? 0 : -1);
+}
+
+static void	join_thread(void)
+{
+	if (!g_th)
+		return ;
+	WaitForSingleObject(g_th, INFINITE);
+	CloseHandle(g_th);
+	g_th = NULL;
+}
+#else
+static pthread_t	g_th;
+
+static void	*thread_fn(void *p)
+{
+	(void)p;
+	ingest_loop();
+	return (NULL);
+}
+
+static int	start_thread(void)
+{
+	return (pthread_create(&g_th, NULL, thread_fn, NULL) == 0 ? 0 : -1);
+}
+
+static void	join_thread(void)
+{
+	pthread_join(g_th, NULL);
+}
+#endif
+
+static int	ingest_start(const char *chatlog_path)
+{
+	g_ing.in = fs_fopen_shared_read(chatlog_path);
+	if (!g_ing.in)
+	{
+		monitor_health_on_io_error("open chatlog", errno, 0);
+		return (-1);
+	}
+	safe_copy(g_ing.path, sizeof(g_ing.path), chatlog_path);
+	fseek(g_ing.in, 0, SEEK_END);
+	g_ing.write_seq = 0;
+	g_ing.carry_len = 0;
+	g_ing.carry_truncated = 0;
+	g_ing.lines = 0;
+	g_ing.bytes = 0;
+	g_ing.truncated = 0;
+	g_ing.stalls = 0;
+	g_ing.stall_ms = 0;
+	atomic_store(&g_ing.stop, 0);
+	if (start_thread() != 0)
+	{
+		fclose(g_ing.in);
+		g_ing.in = NULL;
+		return (-1);
+	}
+	ing_lock(&g_lock);
+	g_ing.running = 1;
+	ing_unlock(&g_lock);
+	return (0);
+}
+
+static void	ingest_stop(void)
+{
+	atomic_store(&g_ing.stop, 1);
+	ing_lock(&g_lock);
+	ing_cond_broadcast(&g_space);
+	ing_unlock(&g_lock);
+	join_thread();
+	if (g_ing.in)
+		fclose(g_ing.in);
+	g_ing.in = NULL;
+	ing_lock(&g_lock);
+	g_ing.running = 0;
+	ing_unlock(&g_lock);
+}
+
+/* -------------------------------------------------------------------------- */
+/* Public API                                                                 */
+/* -------------------------------------------------------------------------- */
+
+t_chat_ingest_sub	*chat_ingest_subscribe(const char *chatlog_path,
+						const char *name)
+{
+	t_chat_ingest_sub	*sub;
+	int					i;
+
+	if (!chatlog_path || !*chatlog_path)
+		return (NULL);
+	ing_lock(&g_life);
+	if (!g_ing.running && ingest_start(chatlog_path) != 0)
+	{
+		ing_unlock(&g_life);
+		return (NULL);
+	}
+	sub = NULL;
+	ing_lock(&g_lock);
+	i = 0;
+	while (i < CHAT_INGEST_MAX_SUBS && !sub)
+	{
+		if (!g_ing.subs[i].active)
+		{
+			sub = &g_ing.subs[i];
+			memset(sub, 0, sizeof(*sub));
+			safe_copy(sub->st.name, sizeof(sub->st.name), name ? name : "?");
+			sub->read_seq = g_ing.write_seq;
+			sub->active = 1;
+		}
+		i++;
+	}
+	ing_unlock(&g_lock);
+	if (sub)
+		g_ing.refs++;
+	else if (g_ing.refs == 0)
+		ingest_stop();
+	ing_unlock(&g_life);
+	return (sub);
+}
+
+void	chat_ingest_unsubscribe(t_chat_ingest_sub *sub)
+{
+	if (!sub)
+		return ;
+	ing_lock(&g_life);
+	ing_lock(&g_lock);
+	sub->active = 0;
+	sub->holding = 0;
+	ing_cond_broadcast(&g_space);
+	ing_unlock(&g_lock);
+	g_ing.refs--;
+	if (g_ing.refs <= 0)
+	{
+		g_ing.refs = 0;
+		ingest_stop();
+	}
+	ing_unlock(&g_life);
+}
+
+const char	*chat_ingest_next(t_chat_ingest_sub *sub, int timeout_ms)
+{
+	const char	*line;
+	uint64_t	lag;
+
+	if (!sub)
+		return (NULL);
+	line = NULL;
+	ing_lock(&g_lock);
+	if (sub->holding)
+	{
+		sub->read_seq++;
+		sub->holding = 0;
+		sub->st.consumed++;
+		ing_cond_broadcast(&g_space);
+	}
+	if (sub->read_seq == g_ing.write_seq && timeout_ms > 0)
+		ing_cond_wait_ms(&g_data, &g_lock, timeout_ms);
+	if (sub->read_seq < g_ing.write_seq)
+	{
+		lag = g_ing.write_seq - sub->read_seq;
+		if (lag > sub->st.lag_max)
+			sub->st.lag_max = lag;
+		line = g_ing.slots[sub->read_seq % CHAT_INGEST_RING];
+		sub->holding = 1;
+	}
+	ing_unlock(&g_lock);
+	return (line);
+}
+
+void	chat_ingest_get_stats(t_chat_ingest_stats *out)
+{
+	int	i;
+
+	if (!out)
+		return ;
+	memset(out, 0, sizeof(*out));
+	ing_lock(&g_lock);
+	out->running = g_ing.running;
+	out->ring_capacity = CHAT_INGEST_RING;
+	out->lines = g_ing.lines;
+	out->bytes = g_ing.bytes;
+	out->truncated = g_ing.truncated;
+	out->stalls = g_ing.stalls;
+	out->stall_ms = g_ing.stall_ms;
+	i = 0;
+	while (i < CHAT_INGEST_MAX_SUBS)
+	{
+		if (g_ing.subs[i].active)
+		{
+			out->subs[out->subs_count] = g_ing.subs[i].st;
+			out->subs[out->subs_count].lag
+				= g_ing.write_seq - g_ing.subs[i].read_seq;
+			out->subs_count++;
+		}
+		i++;
+	}
+	ing_unlock(&g_lock);
+}
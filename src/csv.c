@@ -216,35 +216,68 @@ static int	csv_needs_quotes_sep(const char *s, char sep)
 	return (0);
 }
 
-void	csv_write_field_sep(FILE *f, const char *s, char sep)
+size_t	csv_write_field_sep(FILE *f, const char *s, char sep)
 {
 	const char	*p;
+	size_t		n;
 
 	if (!f)
-		return ;
+		return (0);
 	if (!s)
 		s = "";
 	if (!csv_needs_quotes_sep(s, sep))
 	{
 		fputs(s, f);
-		return ;
+		return (strlen(s));
 	}
 	fputc('"', f);
+	n = 2;
 	p = s;
 	while (*p)
 	{
 		if (*p == '"')
+		{
 			fputs("\"\"", f);
+			n++;
+		}
 		else
 			fputc(*p, f);
+		n++;
 		p++;
 	}
 	fputc('"', f);
+	return (n);
 }
 
-void	csv_write_field(FILE *f, const char *s)
+size_t	csv_write_field(FILE *f, const char *s)
 {
-	csv_write_field_sep(f, s, CSV_SEP);
+	return (csv_write_field_sep(f, s, CSV_SEP));
+}
+
+size_t	csv_format_field_sep(char *dst, const char *s, char sep)
+{
+	size_t	n;
+
+	if (!dst)
+		return (0);
+	if (!s)
+		s = "";
+	if (!csv_needs_quotes_sep(s, sep))
+	{
+		n = strlen(s);
+		memcpy(dst, s, n);
+		return (n);
+	}
+	n = 0;
+	dst[n++] = '"';
+	while (*s)
+	{
+		if (*s == '"')
+			dst[n++] = '"';
+		dst[n++] = *s++;
+	}
+	dst[n++] = '"';
+	return (n);
 }
 
 void	csv_write_row_sep(FILE *f, const char **fields, int n, char sep)
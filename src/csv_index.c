@@ -29,11 +29,16 @@ extern off_t	ftello(FILE *stream);
 # define TM_FTELL64 ftello
 #endif
 
+/*
+ * v2: row_index counts every text line after the header (continuation lines
+ * of multi-line quoted rows included). v1 files used another numbering:
+ * their magic no longer matches, so they are rebuilt instead of trusted.
+ */
 #define INDEX_SUFFIX ".idx"
-#define INDEX_MAGIC  "#csv_index_v1"
+#define INDEX_MAGIC  "#csv_index_v2"
 
 #define INDEX_STATE_SUFFIX ".idxstate"
-#define INDEX_STATE_MAGIC  "#csv_index_state_v1"
+#define INDEX_STATE_MAGIC  "#csv_index_state_v2"
 
 /* Forward declarations (needed because we add incremental helpers above). */
 static int	make_index_path(char *out, size_t outsz, const char *csv_path);
@@ -360,10 +365,6 @@ int	csv_index_state_rebuild_ex(const char *csv_path,
 	{
 		while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r'))
 			line[--len] = '\0';
-		if (line[0] == '\0')
-			continue;
-		if (line[0] == '#')
-			continue;
 		if (!saw_first_data)
 		{
 			const char *p = line;
@@ -374,12 +375,13 @@ int	csv_index_state_rebuild_ex(const char *csv_path,
 			if (strncmp(p, "timestamp", 9) == 0)
 				continue;
 		}
+		/* Every line after the header counts (data-line indices). */
 		{
 			long long ts;
-			if (!extract_ts_fast(line, &ts))
-				continue;
+
 			saw_first_data = 1;
-			last_ts = ts;
+			if (extract_ts_fast(line, &ts))
+				last_ts = ts;
 			data_row++;
 		}
 	}
@@ -754,10 +756,6 @@ int	csv_index_build_ex(const char *csv_path,
 		/* Normalize EOL for checks. */
 		while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r'))
 			line[--len] = '\0';
-		if (line[0] == '\0')
-			continue ;
-		if (line[0] == '#')
-			continue ;
 		/* Header line contains "timestamp" in first column. */
 		if (!saw_first_data)
 		{
@@ -770,14 +768,15 @@ int	csv_index_build_ex(const char *csv_path,
 			if (strncmp(p, "timestamp", 9) == 0)
 				continue ;
 		}
-		/* Data line. */
+		/*
+		 * Data line. Every line after the header is a data row (same numbering
+		 * as the stats/series readers); only rows with a timestamp are indexed.
+		 */
 		{
 			long long ts;
 
-			if (!extract_ts_fast(line, &ts))
-				continue ;
 			saw_first_data = 1;
-			if ((data_row % opt.stride_rows) == 0)
+			if ((data_row % opt.stride_rows) == 0 && extract_ts_fast(line, &ts))
 			{
 				fprintf(out, "%zu,%lld,%llu\n", data_row, ts, pos);
 				entries++;
@@ -837,6 +836,76 @@ int	csv_index_build_ex(const char *csv_path,
 	return (1);
 }
 
+/*
+ * Opens <csv_path>.idx positioned on its first checkpoint (magic + column
+ * header consumed). out_stride = stride from the magic line (0 if absent).
+ */
+static FILE	*index_open_checkpoints(const char *csv_path, char *ipath,
+				size_t ipsz, size_t *out_stride, CsvIndexReport *out_report)
+{
+	FILE	*f;
+	char	hdr[256];
+
+	*out_stride = 0;
+	if (!csv_path)
+	{
+		rep_set(out_report, CSV_INDEX_OPEN_FAILED, NULL, "invalid csv path");
+		errno = EINVAL;
+		return (NULL);
+	}
+	if (!make_index_path(ipath, ipsz, csv_path))
+	{
+		rep_set(out_report, CSV_INDEX_OOM, NULL, "index path too long");
+		return (NULL);
+	}
+	f = fopen(ipath, "rb");
+	if (!f)
+	{
+		rep_set(out_report, CSV_INDEX_OPEN_FAILED, ipath, "index not found");
+		return (NULL);
+	}
+	/* Line1 magic (+ stride), line2 header. */
+	if (!read_index_stride(f, out_stride) || !fgets(hdr, (int)sizeof(hdr), f))
+	{
+		rep_set(out_report, CSV_INDEX_BAD_FORMAT, ipath, "bad index header");
+		fclose(f);
+		return (NULL);
+	}
+	return (f);
+}
+
+/* Next "row_index,timestamp,byte_offset" line. 1 = got one, 0 = EOF/error. */
+static int	index_next_checkpoint(FILE *f, char **line, size_t *cap,
+				int *io_err, unsigned long long *row, long long *ts,
+				unsigned long long *off)
+{
+	size_t	len;
+	char	*c1;
+	char	*c2;
+
+	while (read_line_dyn(f, line, cap, io_err, &len, 0))
+	{
+		/* Normalize EOL. */
+		while (len > 0 && ((*line)[len - 1] == '\n' || (*line)[len - 1] == '\r'))
+			(*line)[--len] = '\0';
+		if ((*line)[0] == '\0' || (*line)[0] == '#')
+			continue ;
+		/* Simple split 3 columns by comma. */
+		c1 = strchr(*line, ',');
+		if (!c1)
+			continue ;
+		*c1 = '\0';
+		c2 = strchr(c1 + 1, ',');
+		if (!c2)
+			continue ;
+		*c2 = '\0';
+		if (parse_u64_strict(*line, row) && parse_ll_strict_local(c1 + 1, ts)
+			&& parse_u64_strict(c2 + 1, off))
+			return (1);
+	}
+	return (0);
+}
+
 int	csv_index_lookup_offset_ex(const char *csv_path,
 					long long timestamp,
 					unsigned long long *out_offset,
@@ -848,11 +917,14 @@ int	csv_index_lookup_offset_ex(const char *csv_path,
 	FILE	*f;
 	char	*line;
 	size_t	cap;
-	size_t	len;
+	size_t	stride;
 	int		io_err;
 	unsigned long long	best_off;
 	unsigned long long	best_row;
 	long long	best_ts;
+	unsigned long long	row;
+	unsigned long long	off;
+	long long	ts;
 	int		got;
 
 	if (out_offset)
@@ -861,74 +933,19 @@ int	csv_index_lookup_offset_ex(const char *csv_path,
 		*out_checkpoint_ts = 0;
 	if (out_checkpoint_row)
 		*out_checkpoint_row = 0;
-	if (!csv_path)
-	{
-		rep_set(out_report, CSV_INDEX_OPEN_FAILED, NULL, "invalid csv path");
-		errno = EINVAL;
-		return (0);
-	}
-	if (!make_index_path(ipath, sizeof(ipath), csv_path))
-	{
-		rep_set(out_report, CSV_INDEX_OOM, NULL, "index path too long");
-		return (0);
-	}
-	f = fopen(ipath, "rb");
+	f = index_open_checkpoints(csv_path, ipath, sizeof(ipath), &stride,
+			out_report);
 	if (!f)
-	{
-		rep_set(out_report, CSV_INDEX_OPEN_FAILED, ipath, "index not found");
 		return (0);
-	}
 	line = NULL;
 	cap = 0;
-	len = 0;
-	io_err = 0;
+	io_err = RL_OK;
 	best_off = 0;
 	best_row = 0;
 	best_ts = LLONG_MIN;
 	got = 0;
-
-	/* Line1 magic, line2 header. */
-	if (!read_line_dyn(f, &line, &cap, &io_err, &len, 0))
-		goto done;
-	if (strncmp(line, INDEX_MAGIC, strlen(INDEX_MAGIC)) != 0)
-		goto done;
-	if (!read_line_dyn(f, &line, &cap, &io_err, &len, 0))
-		goto done;
-
-	while (read_line_dyn(f, &line, &cap, &io_err, &len, 0))
+	while (index_next_checkpoint(f, &line, &cap, &io_err, &row, &ts, &off))
 	{
-		char	*cols[3];
-		char	*tmp;
-		unsigned long long row;
-		unsigned long long off;
-		long long ts;
-
-		/* Normalize EOL. */
-		while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r'))
-			line[--len] = '\0';
-		if (line[0] == '\0' || line[0] == '#')
-			continue ;
-		/* Simple split 3 columns by comma. */
-		tmp = line;
-		cols[0] = tmp;
-		cols[1] = NULL;
-		cols[2] = NULL;
-		{
-			char *c1 = strchr(tmp, ',');
-			if (!c1) continue;
-			*c1 = '\0';
-			cols[1] = c1 + 1;
-			char *c2 = strchr(cols[1], ',');
-			if (!c2) continue;
-			*c2 = '\0';
-			cols[2] = c2 + 1;
-		}
-		if (!parse_u64_strict(cols[0], &row))
-			continue ;
-		if (!parse_ll_strict_local(cols[1], &ts))
-			continue ;
-		if (!parse_u64_strict(cols[2], &off))
-			continue ;
 		if (ts <= timestamp && ts >= best_ts)
 		{
 			best_ts = ts;
@@ -941,8 +958,78 @@ int	csv_index_lookup_offset_ex(const char *csv_path,
 		 * preserves correctness even if timestamps are out-of-order.
 		 */
 	}
+	if (io_err != RL_OK || ferror(f))
+		rep_set(out_report, CSV_INDEX_IO_ERROR, ipath, "I/O error while reading index");
+	else if (!got)
+		rep_set(out_report, CSV_INDEX_BAD_FORMAT, ipath, "no checkpoint found");
+	else
+		rep_set(out_report, CSV_INDEX_OK, ipath, NULL);
+	if (got)
+	{
+		if (out_offset)
+			*out_offset = best_off;
+		if (out_checkpoint_ts)
+			*out_checkpoint_ts = best_ts;
+		if (out_checkpoint_row)
+			*out_checkpoint_row = best_row;
+	}
+	free(line);
+	fclose(f);
+	return (got);
+}
 
-done:
+int	csv_index_lookup_row_ex(const char *csv_path,
+					unsigned long long row_index,
+					unsigned long long *out_offset,
+					long long *out_checkpoint_ts,
+					unsigned long long *out_checkpoint_row,
+					size_t *out_stride,
+					CsvIndexReport *out_report)
+{
+	char	ipath[512];
+	FILE	*f;
+	char	*line;
+	size_t	cap;
+	size_t	stride;
+	int		io_err;
+	unsigned long long	best_off;
+	unsigned long long	best_row;
+	long long	best_ts;
+	unsigned long long	row;
+	unsigned long long	off;
+	long long	ts;
+	int		got;
+
+	if (out_offset)
+		*out_offset = 0;
+	if (out_checkpoint_ts)
+		*out_checkpoint_ts = 0;
+	if (out_checkpoint_row)
+		*out_checkpoint_row = 0;
+	if (out_stride)
+		*out_stride = 0;
+	f = index_open_checkpoints(csv_path, ipath, sizeof(ipath), &stride,
+			out_report);
+	if (!f)
+		return (0);
+	line = NULL;
+	cap = 0;
+	io_err = RL_OK;
+	best_off = 0;
+	best_row = 0;
+	best_ts = 0;
+	got = 0;
+	/* Same full scan as the timestamp lookup: rows may repeat after a rebuild. */
+	while (index_next_checkpoint(f, &line, &cap, &io_err, &row, &ts, &off))
+	{
+		if (row <= row_index && (!got || row >= best_row))
+		{
+			best_row = row;
+			best_off = off;
+			best_ts = ts;
+			got = 1;
+		}
+	}
 	if (io_err != RL_OK || ferror(f))
 		rep_set(out_report, CSV_INDEX_IO_ERROR, ipath, "I/O error while reading index");
 	else if (!got)
@@ -957,6 +1044,8 @@ done:
 			*out_checkpoint_ts = best_ts;
 		if (out_checkpoint_row)
 			*out_checkpoint_row = best_row;
+		if (out_stride)
+			*out_stride = stride;
 	}
 	free(line);
 	fclose(f);
@@ -6,23 +6,114 @@
 
 #include "frame_limiter.h"
 #include "utils.h" /* ft_time_ms / ft_sleep_ms */
+#include "window.h" /* window_wait_events */
+
+#include <string.h>
+
+static t_fl_stats	g_stats;
+
+static const uint64_t	g_cost_lim_us[FL_HIST_BUCKETS - 1] = {
+	1000, 4000, 8000, 16000, 33000};
+static const uint64_t	g_period_lim_ms[FL_HIST_BUCKETS - 1] = {
+	17, 34, 100, 250, 500};
+
+static int	hist_bucket(const uint64_t *lim, uint64_t v)
+{
+	int	b;
+
+	b = 0;
+	while (b < FL_HIST_BUCKETS - 1 && v > lim[b])
+		b++;
+	return (b);
+}
+
+void	fl_init(t_frame_limiter *fl, int target_ms)
+{
+	if (!fl)
+		return ;
+	memset(fl, 0, sizeof(*fl));
+	fl->target_ms = target_ms;
+}
 
 void	fl_begin(t_frame_limiter *fl)
 {
+	uint64_t	now;
+
 	if (!fl)
 		return ;
-	fl->frame_start_ms = ft_time_ms();
+	now = ft_time_ms();
+	if (fl->frame_start_ms != 0)
+		g_stats.period_hist[hist_bucket(g_period_lim_ms,
+				now - fl->frame_start_ms)]++;
+	fl->frame_start_ms = now;
+	fl->frame_start_us = ft_time_us();
+	fl->drawn = 1;
+}
+
+void	fl_mark(t_frame_limiter *fl, int changed)
+{
+	if (!fl || !changed)
+		return ;
+	fl->last_change_ms = fl->frame_start_ms;
+	if (fl->last_change_ms == 0)
+		fl->last_change_ms = 1;
+}
+
+int	fl_should_draw(t_frame_limiter *fl, int changed)
+{
+	if (!fl)
+		return (1);
+	fl_mark(fl, changed);
+	if (!changed && !fl->settle && fl->last_draw_ms != 0
+		&& fl->frame_start_ms - fl->last_draw_ms < FL_IDLE_REDRAW_MS)
+	{
+		fl->drawn = 0;
+		return (0);
+	}
+	fl->settle = (changed != 0);
+	fl->last_draw_ms = fl->frame_start_ms;
+	if (fl->last_draw_ms == 0)
+		fl->last_draw_ms = 1;
+	return (1);
 }
 
 void	fl_end_sleep(t_frame_limiter *fl)
 {
-	uint64_t	elapsed;
-	int		sleep_ms;
+	uint64_t	cost_us;
+	int			elapsed;
+	int			wait_ms;
 
 	if (!fl)
 		return ;
-	elapsed = ft_time_ms() - fl->frame_start_ms;
-	sleep_ms = fl->target_ms - (int)elapsed;
-	if (sleep_ms > 0)
-		ft_sleep_ms(sleep_ms);
+	cost_us = ft_time_us() - fl->frame_start_us;
+	g_stats.frames++;
+	if (fl->drawn)
+	{
+		g_stats.drawn++;
+		g_stats.cost_hist[hist_bucket(g_cost_lim_us, cost_us)]++;
+		if (cost_us > g_stats.cost_max_us)
+			g_stats.cost_max_us = cost_us;
+	}
+	elapsed = (int)(cost_us / 1000ULL);
+	g_stats.active = (fl->last_change_ms != 0
+			&& fl->frame_start_ms - fl->last_change_ms < FL_ACTIVE_HOLD_MS);
+	if (g_stats.active)
+	{
+		wait_ms = fl->target_ms - elapsed;
+		if (wait_ms > 0)
+			ft_sleep_ms(wait_ms);
+		return ;
+	}
+	wait_ms = FL_IDLE_REDRAW_MS - elapsed;
+	if (wait_ms <= 0)
+		return ;
+	g_stats.idle_waits++;
+	if (window_wait_events(wait_ms))
+		g_stats.woken++;
+}
+
+void	fl_get_stats(t_fl_stats *out)
+{
+	if (out)
+		*out = g_stats;
 }
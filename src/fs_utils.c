@@ -21,6 +21,7 @@
 
 #include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #ifdef _WIN32
@@ -180,6 +181,35 @@ long	fs_file_size(const char *path)
 	return (sz);
 }
 
+#ifdef _WIN32
+int	fs_file_stat(const char *path, long long *size, long long *mtime)
+{
+	struct __stat64	st;
+
+	if (!path || _stat64(path, &st) != 0)
+		return (-1);
+	if (size)
+		*size = (long long)st.st_size;
+	if (mtime)
+		*mtime = (long long)st.st_mtime;
+	return (0);
+}
+#else
+int	fs_file_stat(const char *path, long long *size, long long *mtime)
+{
+	struct stat	st;
+
+	if (!path || stat(path, &st) != 0)
+		return (-1);
+	if (size)
+		*size = (long long)st.st_size;
+	if (mtime)
+		*mtime = (long long)st.st_mtim.tv_sec * 1000000000LL
+			+ (long long)st.st_mtim.tv_nsec;
+	return (0);
+}
+#endif
+
 int	fs_truncate_fp(FILE *f, long new_size)
 {
 	if (!f)
@@ -208,6 +238,163 @@ int	fs_truncate_fp(FILE *f, long new_size)
 #endif
 }
 
+/* -------------------------------------------------------------------------- */
+/* Tail (reverse block reader)                                                */
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Reads [pos, size) backwards into buf (data kept at the end of the buffer)
+ * until it holds max_lines '\n' before its last byte, or the file start.
+ * Returns the byte count, *at_start = 1 if it begins at offset 0.
+ */
+static long	tail_scan(FILE *f, long size, int max_lines, char **buf,
+				int *at_start)
+{
+	char	*nb;
+	long	cap;
+	long	len;
+	long	pos;
+	long	chunk;
+	long	nl;
+	long	i;
+
+	cap = 0;
+	len = 0;
+	nl = 0;
+	pos = size;
+	while (pos > 0 && nl < max_lines && len < FS_TAIL_SCAN_MAX)
+	{
+		chunk = (pos < FS_TAIL_BLOCK) ? pos : FS_TAIL_BLOCK;
+		if (len + chunk > cap)
+		{
+			cap = (cap ? cap * 2 : FS_TAIL_BLOCK * 2);
+			nb = (char *)malloc((size_t)cap);
+			if (!nb)
+				return (-1);
+			if (len)
+				memcpy(nb + cap - len, *buf + (cap / 2) - len, (size_t)len);
+			free(*buf);
+			*buf = nb;
+		}
+		pos -= chunk;
+		if (fseek(f, pos, SEEK_SET) != 0 || fread(*buf + cap - len - chunk,
+				1, (size_t)chunk, f) != (size_t)chunk)
+			return (-1);
+		i = 0;
+		while (i < chunk)
+		{
+			/* the last byte of the file never starts a line */
+			if ((*buf)[cap - len - chunk + i] == '\n' && pos + i != size - 1)
+				nl++;
+			i++;
+		}
+		len += chunk;
+	}
+	*at_start = (pos == 0);
+	if (len && cap != len)
+		memmove(*buf, *buf + cap - len, (size_t)len);
+	return (len);
+}
+
+static void	tail_copy_line(char *dst, const char *src, long n)
+{
+	while (n > 0 && (src[n - 1] == '\n' || src[n - 1] == '\r'))
+		n--;
+	if (n > FS_TAIL_LINE_MAX - 1)
+		n = FS_TAIL_LINE_MAX - 1;
+	memcpy(dst, src, (size_t)n);
+	dst[n] = '\0';
+}
+
+/* Keeps the last max_lines lines of buf[0..len). */
+static void	tail_split(t_fs_tail *t, const char *buf, long len, int max_lines)
+{
+	const char	*p;
+	const char	*end;
+	const char	*nl;
+	long		count;
+	long		skip;
+
+	p = buf;
+	end = buf + len;
+	if (!t->at_start)
+	{
+		nl = (const char *)memchr(p, '\n', (size_t)len);
+		p = nl ? nl + 1 : end;
+	}
+	count = 0;
+	nl = p;
+	while (nl < end)
+	{
+		count++;
+		nl = (const char *)memchr(nl, '\n', (size_t)(end - nl));
+		nl = nl ? nl + 1 : end;
+	}
+	skip = (count > max_lines) ? count - max_lines : 0;
+	if (skip)
+		t->at_start = 0;
+	t->n = 0;
+	while (p < end)
+	{
+		nl = (const char *)memchr(p, '\n', (size_t)(end - p));
+		nl = nl ? nl + 1 : end;
+		if (skip > 0)
+			skip--;
+		else
+			tail_copy_line(t->lines[t->n++], p, (long)(nl - p));
+		p = nl;
+	}
+}
+
+int	fs_tail_read(t_fs_tail *t, const char *path, int max_lines)
+{
+	FILE		*f;
+	char		*buf;
+	long long	size;
+	long long	mtime;
+	long		len;
+
+	if (!t || !path || max_lines <= 0)
+		return (-1);
+	if (max_lines > FS_TAIL_MAX_LINES)
+		max_lines = FS_TAIL_MAX_LINES;
+	if (fs_file_stat(path, &size, &mtime) != 0)
+	{
+		t->n = 0;
+		t->size = -1;
+		return (-1);
+	}
+	if (t->lines && t->size == size && t->mtime == mtime
+		&& t->max_lines == max_lines)
+		return (0);
+	if (!t->lines)
+		t->lines = malloc(FS_TAIL_MAX_LINES * sizeof(*t->lines));
+	f = t->lines ? fs_fopen_shared_read(path) : NULL;
+	t->n = 0;
+	t->size = -1;
+	if (!f)
+		return (-1);
+	buf = NULL;
+	len = tail_scan(f, (long)size, max_lines, &buf, &t->at_start);
+	fclose(f);
+	if (len >= 0)
+	{
+		tail_split(t, buf, len, max_lines);
+		t->size = size;
+		t->mtime = mtime;
+		t->max_lines = max_lines;
+	}
+	free(buf);
+	return ((len >= 0) ? 1 : -1);
+}
+
+void	fs_tail_free(t_fs_tail *t)
+{
+	if (!t)
+		return ;
+	free(t->lines);
+	memset(t, 0, sizeof(*t));
+}
 
 /* -------------------------------------------------------------------------- */
 /* Paths helpers (exe dir, join, chdir)                                       */
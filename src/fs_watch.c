@@ -0,0 +1,199 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fs_watch.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: login <login@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/20 00:00:00 by login             #+#    #+#             */
+/*   Updated: 2026/02/20 00:00:00 by login            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* poll() / read() under strict C99 builds */
+#ifndef _WIN32
+# ifndef _POSIX_C_SOURCE
+#  define _POSIX_C_SOURCE 200809L
+# endif
+#endif
+
+#include "fs_watch.h"
+#include "fs_utils.h"
+#include "tm_string.h"
+#include "utils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+# define FS_WATCH_HAS_INOTIFY 1
+# include <poll.h>
+# include <unistd.h>
+# include <sys/inotify.h>
+#endif
+
+static const char	*path_basename(const char *path)
+{
+	const char	*b;
+	const char	*p;
+
+	b = path;
+	p = path;
+	while (*p)
+	{
+		if (*p == '/' || *p == '\\')
+			b = p + 1;
+		p++;
+	}
+	return (b);
+}
+
+static int	env_forces_polling(void)
+{
+	const char	*v;
+
+	v = getenv("TM_FS_WATCH");
+	return (v && strcmp(v, "poll") == 0);
+}
+
+#ifdef FS_WATCH_HAS_INOTIFY
+
+/*
+ * We watch the parent directory (not the file itself): the game may delete /
+ * recreate chat.log, and a watch on the old inode would then stay silent.
+ * Events for other files of the directory are filtered by name.
+ */
+# define FS_WATCH_DIR_MASK (IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE \
+	| IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_ATTRIB)
+
+static int	inotify_open(t_fs_watch *w, const char *path)
+{
+	char	dir[1024];
+
+	if (fs_path_parent(dir, sizeof(dir), path) != 0 || dir[0] == '\0')
+		safe_copy(dir, sizeof(dir), ".");
+	w->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (w->fd < 0)
+		return (0);
+	w->wd = inotify_add_watch(w->fd, dir, FS_WATCH_DIR_MASK);
+	if (w->wd < 0)
+	{
+		close(w->fd);
+		w->fd = -1;
+		return (0);
+	}
+	return (1);
+}
+
+/* Drains every queued event. Returns 1 if one of them targets our file. */
+static int	inotify_drain(t_fs_watch *w)
+{
+	char						buf[4096];
+	ssize_t						n;
+	size_t						off;
+	const struct inotify_event	*ev;
+	int							hit;
+
+	hit = 0;
+	while (1)
+	{
+		n = read(w->fd, buf, sizeof(buf));
+		if (n <= 0)
+			break ;
+		off = 0;
+		while (off + sizeof(struct inotify_event) <= (size_t)n)
+		{
+			ev = (const struct inotify_event *)(const void *)(buf + off);
+			if (ev->mask & IN_Q_OVERFLOW)
+				hit = 1;
+			else if (ev->len > 0 && strcmp(ev->name, w->name) == 0)
+				hit = 1;
+			off += sizeof(struct inotify_event) + ev->len;
+		}
+	}
+	return (hit);
+}
+
+static int	inotify_wait(t_fs_watch *w, int max_wait_ms)
+{
+	struct pollfd	pfd;
+	uint64_t		deadline;
+	uint64_t		now;
+	int				rc;
+
+	deadline = ft_time_ms() + (uint64_t)max_wait_ms;
+	while (1)
+	{
+		now = ft_time_ms();
+		if (now >= deadline)
+			return (FS_WATCH_TIMEOUT);
+		pfd.fd = w->fd;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+		rc = poll(&pfd, 1, (int)(deadline - now));
+		if (rc <= 0)
+			return (FS_WATCH_TIMEOUT);
+		/* Only unrelated files changed: keep waiting for ours. */
+		if (inotify_drain(w))
+			return (FS_WATCH_CHANGED);
+	}
+}
+#endif
+
+void	fs_watch_open(t_fs_watch *w, const char *path)
+{
+	if (!w)
+		return ;
+	memset(w, 0, sizeof(*w));
+	w->fd = -1;
+	w->wd = -1;
+	w->backend = FS_WATCH_BACKEND_POLL;
+	if (!path || !*path)
+		return ;
+	safe_copy(w->name, sizeof(w->name), path_basename(path));
+	if (env_forces_polling())
+		return ;
+#ifdef FS_WATCH_HAS_INOTIFY
+	if (inotify_open(w, path))
+		w->backend = FS_WATCH_BACKEND_INOTIFY;
+#endif
+}
+
+void	fs_watch_close(t_fs_watch *w)
+{
+	if (!w)
+		return ;
+#ifdef FS_WATCH_HAS_INOTIFY
+	if (w->fd >= 0)
+		close(w->fd);
+#endif
+	w->fd = -1;
+	w->wd = -1;
+	w->backend = FS_WATCH_BACKEND_POLL;
+}
+
+int	fs_watch_wait(t_fs_watch *w, int max_wait_ms)
+{
+	if (max_wait_ms < 0)
+		max_wait_ms = 0;
+#ifdef FS_WATCH_HAS_INOTIFY
+	if (w && w->backend == FS_WATCH_BACKEND_INOTIFY)
+		return (inotify_wait(w, max_wait_ms));
+#endif
+	if (max_wait_ms > FS_WATCH_POLL_MS)
+		max_wait_ms = FS_WATCH_POLL_MS;
+	ft_sleep_ms(max_wait_ms);
+	return (FS_WATCH_CHANGED);
+}
+
+int	fs_watch_is_event_driven(const t_fs_watch *w)
+{
+	return (w && w->backend != FS_WATCH_BACKEND_POLL);
+}
+
+const char	*fs_watch_backend_name(const t_fs_watch *w)
+{
+	if (w && w->backend == FS_WATCH_BACKEND_INOTIFY)
+		return ("inotify");
+	return ("polling");
+}
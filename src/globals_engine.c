@@ -13,8 +13,10 @@
 #include "globals_engine.h"
 #include "globals_parser.h"
 #include "csv.h"
+#include "chat_ingest.h"
 #include "fs_utils.h"
-#include "ui_utils.h"
+#include "line_reader.h"
+#include "tm_wake.h"
 
 #include <stdio.h>
 
@@ -24,6 +26,7 @@ static int	append_event(FILE *out, const t_globals_event *ev)
         return (-1);
     csv_write_row6(out, ev->ts, ev->type, ev->name, "", ev->value, ev->raw);
     fflush(out);
+    tm_wake();
     return (0);
 }
 
@@ -38,9 +41,10 @@ static void	process_line(FILE *out, const char *line)
 int	globals_run_replay(const char *chatlog_path, const char *csv_path,
 				atomic_int *stop_flag)
 {
-    FILE	*in;
-    FILE	*out;
-    char	buf[2048];
+    FILE			*in;
+    FILE			*out;
+    t_line_reader	lr;
+    t_line_view		v;
     
     in = fs_fopen_shared_read(chatlog_path);
     if (!in)
@@ -52,72 +56,51 @@ int	globals_run_replay(const char *chatlog_path, const char *csv_path,
         return (-1);
     }
     csv_ensure_header6(out);
-	while (!stop_flag || atomic_load(stop_flag) == 0)
+    if (line_reader_init(&lr, in, 0) == 0)
     {
-        if (!fgets(buf, sizeof(buf), in))
-            break ;
-        process_line(out, buf);
+        while (!stop_flag || atomic_load(stop_flag) == 0)
+        {
+            if (line_reader_next(&lr, &v) <= 0)
+                break ;
+            process_line(out, v.ptr);
+        }
+        line_reader_free(&lr);
     }
     fclose(out);
     fclose(in);
     return (0);
 }
 
+/*
+ * LIVE: chat.log is tailed once by chat_ingest (shared with the hunt parser);
+ * GLOBALS_WAIT_SLICE_MS bounds each wait so stop_flag stays responsive.
+ */
+#define GLOBALS_WAIT_SLICE_MS 250
+
 int	globals_run_live(const char *chatlog_path, const char *csv_path,
 				atomic_int *stop_flag)
 {
-    FILE	*in;
-    FILE	*out;
-    char	buf[2048];
-    long	last_pos;
+    t_chat_ingest_sub	*sub;
+    FILE				*out;
+    const char			*line;
     
-    in = fs_fopen_shared_read(chatlog_path);
-    if (!in)
-        return (-1);
     out = fopen(csv_path, "ab");
     if (!out)
+        return (-1);
+    sub = chat_ingest_subscribe(chatlog_path, "globals");
+    if (!sub)
     {
-        fclose(in);
+        fclose(out);
         return (-1);
     }
     csv_ensure_header6(out);
-    fseek(in, 0, SEEK_END);
-    last_pos = ftell(in);
 	while (!stop_flag || atomic_load(stop_flag) == 0)
     {
-        if (fgets(buf, sizeof(buf), in))
-        {
-            process_line(out, buf);
-            last_pos = ftell(in);
-        }
-        else
-        {
-            long	sz;
-            
-            clearerr(in);
-            sz = fs_file_size(chatlog_path);
-            if (sz >= 0 && sz < last_pos)
-            {
-                fclose(in);
-                in = fs_fopen_shared_read(chatlog_path);
-                if (!in)
-                {
-                    ui_sleep_ms(250);
-                    continue ;
-                }
-                fseek(in, 0, SEEK_END);
-                last_pos = ftell(in);
-            }
-            else if (sz >= 0 && sz > last_pos)
-                fseek(in, last_pos, SEEK_SET);
-            else
-            {
-                ui_sleep_ms(200);
-                fseek(in, last_pos, SEEK_SET);
-            }
-        }
+        line = chat_ingest_next(sub, GLOBALS_WAIT_SLICE_MS);
+        if (line)
+            process_line(out, line);
     }
+    chat_ingest_unsubscribe(sub);
     fclose(out);
-    fclose(in);
     return (0);
 }
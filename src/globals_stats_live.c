@@ -0,0 +1,136 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   globals_stats_live.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/21                                #+#    #+#             */
+/*   Updated: 2026/02/21                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "globals_stats_live.h"
+
+#include "core_paths.h"
+#include "fs_utils.h"
+#include "utils.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define GSL_LINE_SZ 8192
+#define GSL_HEAD_SZ 64
+
+typedef struct s_globals_live
+{
+	long			file_pos;            /* bytes already folded in */
+	char			head[GSL_HEAD_SZ];   /* first bytes read, rotation check */
+	size_t			head_len;
+	t_globals_acc	acc;
+	t_globals_stats	stats;
+	int				dirty;
+}	t_globals_live;
+
+static t_globals_live	g_live;
+static int				g_ready = 0;
+
+static void	live_clear(t_globals_live *g)
+{
+	globals_stats_acc_free(&g->acc);
+	memset(g, 0, sizeof(*g));
+}
+
+/* Same size or larger but another file (rotated / rewritten). */
+static int	head_changed(FILE *f, const t_globals_live *g)
+{
+	char	buf[GSL_HEAD_SZ];
+
+	if (!g->head_len)
+		return (0);
+	if (fseek(f, 0, SEEK_SET) != 0)
+		return (1);
+	return (fread(buf, 1, g->head_len, f) != g->head_len
+		|| memcmp(buf, g->head, g->head_len) != 0);
+}
+
+static void	head_capture(FILE *f, t_globals_live *g)
+{
+	size_t	want;
+
+	if (g->head_len == GSL_HEAD_SZ || g->file_pos <= (long)g->head_len)
+		return ;
+	want = (g->file_pos < GSL_HEAD_SZ) ? (size_t)g->file_pos : GSL_HEAD_SZ;
+	if (fseek(f, 0, SEEK_SET) != 0)
+		return ;
+	g->head_len = fread(g->head, 1, want, f);
+}
+
+/* Folds in the complete lines after file_pos (same splitting as compute). */
+static void	live_read(FILE *f, t_globals_live *g)
+{
+	char	line[GSL_LINE_SZ];
+	long	pos_before;
+	long	pos_after;
+	size_t	len;
+
+	if (fseek(f, g->file_pos, SEEK_SET) != 0)
+		return ;
+	while (fgets(line, (int)sizeof(line), f))
+	{
+		len = strlen(line);
+		pos_after = ftell(f);
+		if (pos_after < 0 || (len && line[len - 1] != '\n' && feof(f)))
+			break ;
+		pos_before = g->file_pos;
+		g->file_pos = pos_after;
+		tm_trim_eol(line);
+		if (pos_before == 0 && globals_stats_is_header(line))
+		{
+			g->stats.csv_has_header = 1;
+			continue ;
+		}
+		globals_stats_add_line(&g->stats, &g->acc, line);
+		g->dirty = 1;
+	}
+}
+
+void	globals_stats_live_force_reset(void)
+{
+	live_clear(&g_live);
+	g_ready = 0;
+}
+
+void	globals_stats_live_tick(void)
+{
+	const char	*path;
+	FILE		*f;
+	long		sz;
+
+	path = tm_path_globals_csv();
+	sz = fs_file_size(path);
+	f = (sz >= 0) ? fs_fopen_shared_read(path) : NULL;
+	if (!f)
+	{
+		globals_stats_live_force_reset();
+		return ;
+	}
+	if (sz < g_live.file_pos || head_changed(f, &g_live))
+		live_clear(&g_live);
+	live_read(f, &g_live);
+	head_capture(f, &g_live);
+	fclose(f);
+	if (g_live.dirty)
+	{
+		globals_stats_fill_tops(&g_live.stats, &g_live.acc);
+		g_live.dirty = 0;
+	}
+	g_ready = 1;
+}
+
+const t_globals_stats	*globals_stats_live_get(void)
+{
+	if (!g_ready)
+		return (NULL);
+	return (&g_live.stats);
+}
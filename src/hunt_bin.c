@@ -0,0 +1,690 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   hunt_bin.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                   +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/20                                #+#    #+#             */
+/*   Updated: 2026/02/20                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "hunt_bin.h"
+
+#include "fs_utils.h"
+#include "line_reader.h"
+#include "utils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define HUNT_BIN_READ_BLOCK 4096
+#define HUNT_BIN_NAME_MAX 1023
+
+/* ------------------------------ types / paths ----------------------------- */
+
+static const char	*g_type_names[] = {
+	"", "SHOT", "KILL", "LOOT_ITEM", "SWEAT", "RECEIVED_OTHER",
+	"GLOBAL", "HOF", "ATH", ""
+};
+
+const char	*hunt_bin_type_name(t_hunt_bin_type type)
+{
+	if ((unsigned)type > (unsigned)HUNT_BIN_OTHER)
+		return ("");
+	return (g_type_names[type]);
+}
+
+t_hunt_bin_type	hunt_bin_type_from_str(const char *type)
+{
+	int	i;
+
+	if (!type || !type[0])
+		return (HUNT_BIN_OTHER);
+	i = HUNT_BIN_SHOT;
+	while (i < HUNT_BIN_OTHER)
+	{
+		if (strcmp(type, g_type_names[i]) == 0)
+			return ((t_hunt_bin_type)i);
+		i++;
+	}
+	return (HUNT_BIN_OTHER);
+}
+
+static int	make_path(char *out, size_t outsz, const char *csv_path,
+				const char *suffix)
+{
+	int	n;
+
+	if (!out || !csv_path)
+		return (0);
+	n = snprintf(out, outsz, "%s%s", csv_path, suffix);
+	return (n > 0 && (size_t)n < outsz);
+}
+
+static int	env_disabled(void)
+{
+	const char	*v;
+
+	v = getenv("TM_HUNT_BIN");
+	return (v && strcmp(v, "0") == 0);
+}
+
+/* ------------------------------ names table ------------------------------- */
+
+static int	names_push(t_hunt_bin_names *t, const char *s, size_t len)
+{
+	char		**nv;
+	uint32_t	ncap;
+
+	if (t->n == t->cap)
+	{
+		ncap = t->cap ? t->cap * 2 : 256;
+		nv = (char **)realloc(t->v, ncap * sizeof(*nv));
+		if (!nv)
+			return (-1);
+		t->v = nv;
+		t->cap = ncap;
+	}
+	t->v[t->n] = (char *)malloc(len + 1);
+	if (!t->v[t->n])
+		return (-1);
+	memcpy(t->v[t->n], s, len);
+	t->v[t->n][len] = '\0';
+	t->n++;
+	return (0);
+}
+
+static void	names_free(t_hunt_bin_names *t)
+{
+	uint32_t	i;
+
+	i = 0;
+	while (i < t->n)
+		free(t->v[i++]);
+	free(t->v);
+	memset(t, 0, sizeof(*t));
+}
+
+/* Loads complete lines appended since t->file_pos (a trailing partial line waits). */
+static int	names_load_more(t_hunt_bin_names *t, FILE *f)
+{
+	char	line[HUNT_BIN_NAME_MAX + 1];
+	size_t	len;
+
+	if (!f || fseek(f, t->file_pos, SEEK_SET) != 0)
+		return (-1);
+	while (fgets(line, (int)sizeof(line), f))
+	{
+		len = strlen(line);
+		if (len == 0 || line[len - 1] != '\n')
+			break ;
+		if (names_push(t, line, len - 1) != 0)
+			return (-1);
+		t->file_pos += (long)len;
+	}
+	clearerr(f);
+	return (0);
+}
+
+/* -------------------------------- records --------------------------------- */
+
+static int	header_write(FILE *f)
+{
+	unsigned char	h[HUNT_BIN_HEADER_SIZE];
+	uint32_t		v;
+
+	memset(h, 0, sizeof(h));
+	memcpy(h, HUNT_BIN_MAGIC, 4);
+	v = HUNT_BIN_VERSION;
+	memcpy(h + 4, &v, 4);
+	v = (uint32_t)sizeof(t_hunt_bin_rec);
+	memcpy(h + 8, &v, 4);
+	/* New generation per rebuild: never 0 (pre-generation files). */
+	v = (uint32_t)ft_time_us();
+	if (v == 0)
+		v = 1;
+	memcpy(h + 12, &v, 4);
+	return (fwrite(h, 1, sizeof(h), f) == sizeof(h) ? 0 : -1);
+}
+
+/* Returns the number of complete records, -1 if the header doesn't match. */
+static long	bin_record_count(FILE *f)
+{
+	unsigned char	h[HUNT_BIN_HEADER_SIZE];
+	uint32_t		ver;
+	uint32_t		rsz;
+	long			sz;
+
+	if (!f || fseek(f, 0, SEEK_SET) != 0
+		|| fread(h, 1, sizeof(h), f) != sizeof(h))
+		return (-1);
+	memcpy(&ver, h + 4, 4);
+	memcpy(&rsz, h + 8, 4);
+	if (memcmp(h, HUNT_BIN_MAGIC, 4) != 0 || ver != HUNT_BIN_VERSION
+		|| rsz != (uint32_t)sizeof(t_hunt_bin_rec))
+		return (-1);
+	if (fseek(f, 0, SEEK_END) != 0)
+		return (-1);
+	sz = ftell(f);
+	if (sz < HUNT_BIN_HEADER_SIZE)
+		return (-1);
+	return ((sz - HUNT_BIN_HEADER_SIZE) / (long)sizeof(t_hunt_bin_rec));
+}
+
+/* Generation of the header, 0 if unreadable (or written before it existed). */
+static uint32_t	bin_generation(FILE *f)
+{
+	unsigned char	h[HUNT_BIN_HEADER_SIZE];
+	uint32_t		gen;
+
+	if (!f || fseek(f, 0, SEEK_SET) != 0
+		|| fread(h, 1, sizeof(h), f) != sizeof(h)
+		|| memcmp(h, HUNT_BIN_MAGIC, 4) != 0)
+		return (0);
+	memcpy(&gen, h + 12, 4);
+	return (gen);
+}
+
+static int	bin_read_rec(FILE *f, long idx, t_hunt_bin_rec *rec)
+{
+	long	off;
+
+	off = HUNT_BIN_HEADER_SIZE + idx * (long)sizeof(t_hunt_bin_rec);
+	if (fseek(f, off, SEEK_SET) != 0)
+		return (-1);
+	return (fread(rec, sizeof(*rec), 1, f) == 1 ? 0 : -1);
+}
+
+static int64_t	rec_end(const t_hunt_bin_rec *rec)
+{
+	return (rec->csv_off + (int64_t)rec->csv_len);
+}
+
+static void	rec_fill(t_hunt_bin_rec *rec, const t_hunt_csv_row_view *row,
+				int64_t csv_off, int row_len)
+{
+	memset(rec, 0, sizeof(*rec));
+	rec->ts_unix = row->ts_unix;
+	rec->value_uPED = (int64_t)row->value_uPED;
+	rec->kill_id = row->kill_id;
+	rec->csv_off = csv_off;
+	if (row->qty > INT32_MAX)
+		rec->qty = INT32_MAX;
+	else if (row->qty < INT32_MIN)
+		rec->qty = INT32_MIN;
+	else
+		rec->qty = (int32_t)row->qty;
+	rec->name_id = HUNT_BIN_NO_NAME;
+	rec->type_name_id = HUNT_BIN_NO_NAME;
+	rec->flags = row->flags;
+	rec->csv_len = (uint32_t)row_len;
+	rec->type = (uint8_t)hunt_bin_type_from_str(row->type);
+	rec->has_value = (uint8_t)(row->has_value != 0);
+	/* The raw text is not mirrored: keep what the series needs from it. */
+	if (rec->type == HUNT_BIN_SHOT && hunt_csv_raw_is_hit(row->raw))
+		rec->bits |= HUNT_BIN_HIT;
+}
+
+/* --------------------------------- writer --------------------------------- */
+
+static uint32_t	name_hash(const char *s)
+{
+	uint32_t	h;
+
+	h = 2166136261u;
+	while (*s)
+	{
+		h ^= (unsigned char)*s++;
+		h *= 16777619u;
+	}
+	return (h);
+}
+
+static int	slots_grow(t_hunt_bin_writer *w)
+{
+	uint32_t	*ns;
+	uint32_t	n;
+	uint32_t	i;
+	uint32_t	h;
+
+	n = w->nslots ? w->nslots * 2 : 1024;
+	ns = (uint32_t *)calloc(n, sizeof(*ns));
+	if (!ns)
+		return (-1);
+	i = 0;
+	while (i < w->tab.n)
+	{
+		h = name_hash(w->tab.v[i]) & (n - 1);
+		while (ns[h])
+			h = (h + 1) & (n - 1);
+		ns[h] = i + 1;
+		i++;
+	}
+	free(w->slots);
+	w->slots = ns;
+	w->nslots = n;
+	return (0);
+}
+
+static uint32_t	writer_intern(t_hunt_bin_writer *w, const char *s)
+{
+	uint32_t	h;
+	uint32_t	id;
+	size_t		len;
+
+	if (!s || !s[0])
+		return (HUNT_BIN_NO_NAME);
+	if ((w->tab.n + 1) * 2 > w->nslots && slots_grow(w) != 0)
+		return (HUNT_BIN_NO_NAME);
+	h = name_hash(s) & (w->nslots - 1);
+	while (w->slots[h])
+	{
+		if (strcmp(w->tab.v[w->slots[h] - 1], s) == 0)
+			return (w->slots[h] - 1);
+		h = (h + 1) & (w->nslots - 1);
+	}
+	len = strlen(s);
+	if (len >= HUNT_BIN_NAME_MAX || memchr(s, '\n', len)
+		|| names_push(&w->tab, s, len) != 0)
+		return (HUNT_BIN_NO_NAME);
+	id = w->tab.n - 1;
+	w->slots[h] = id + 1;
+	/* Names must be readable before the records that point at them. */
+	fwrite(s, 1, len, w->names);
+	fputc('\n', w->names);
+	fflush(w->names);
+	return (id);
+}
+
+static void	writer_disable(t_hunt_bin_writer *w)
+{
+	if (w->bin)
+		fclose(w->bin);
+	if (w->names)
+		fclose(w->names);
+	w->bin = NULL;
+	w->names = NULL;
+}
+
+static int	writer_put(t_hunt_bin_writer *w, const t_hunt_csv_row_view *row,
+				int row_len)
+{
+	t_hunt_bin_rec	rec;
+
+	rec_fill(&rec, row, w->csv_pos, row_len);
+	if (row->type)
+	{
+		rec.name_id = writer_intern(w, row->name);
+		if (rec.type == HUNT_BIN_OTHER)
+			rec.type_name_id = writer_intern(w, row->type);
+	}
+	else
+		rec.type = HUNT_BIN_INVALID;
+	if (fwrite(&rec, sizeof(rec), 1, w->bin) != 1)
+		return (-1);
+	w->csv_pos += row_len;
+	return (0);
+}
+
+static int	looks_like_header(const char *line)
+{
+	return (strstr(line, "timestamp") && (strstr(line, "event_type")
+			|| strstr(line, ",type,")));
+}
+
+/*
+ * Mirrors the CSV from w->csv_pos to its end, 1 record per text line
+ * (unparsable => INVALID), exactly as the line-based CSV readers count rows.
+ * Used to build the sidecar at open, and to catch up after a row holding an
+ * embedded '\n' (quoted GLOBAL raw): such a row spans several text lines.
+ */
+static int	writer_catch_up(t_hunt_bin_writer *w)
+{
+	FILE				*f;
+	t_line_reader		lr;
+	t_line_view			lv;
+	t_hunt_csv_row_view	row;
+	char				*tmp;
+	size_t				tcap;
+	int					first;
+
+	f = fs_fopen_shared_read(w->csv_path);
+	if (!f || fseek(f, (long)w->csv_pos, SEEK_SET) != 0
+		|| line_reader_init(&lr, f, 0) != 0)
+	{
+		if (f)
+			fclose(f);
+		return (-1);
+	}
+	tmp = NULL;
+	tcap = 0;
+	first = (w->csv_pos == 0);
+	while (line_reader_next(&lr, &lv) > 0 && lv.ptr[lv.len - 1] == '\n')
+	{
+		if (first && looks_like_header(lv.ptr))
+		{
+			first = 0;
+			w->csv_pos += (int64_t)lv.len;
+			continue ;
+		}
+		first = 0;
+		if (lv.len + 1 > tcap)
+		{
+			free(tmp);
+			tcap = lv.len + 1;
+			tmp = (char *)malloc(tcap);
+			if (!tmp)
+				break ;
+		}
+		memcpy(tmp, lv.ptr, lv.len + 1);
+		if (!hunt_csv_parse_row_inplace(tmp, &row))
+			memset(&row, 0, sizeof(row));
+		if (writer_put(w, &row, (int)lv.len) != 0)
+			break ;
+	}
+	free(tmp);
+	line_reader_free(&lr);
+	fclose(f);
+	return (0);
+}
+
+static int	writer_is_in_sync(const char *bin_path, long csv_size)
+{
+	FILE			*f;
+	long			n;
+	t_hunt_bin_rec	last;
+	int				ok;
+
+	f = fs_fopen_shared_read(bin_path);
+	if (!f)
+		return (0);
+	ok = 0;
+	n = bin_record_count(f);
+	if (n > 0 && fseek(f, 0, SEEK_END) == 0
+		&& ftell(f) == HUNT_BIN_HEADER_SIZE + n * (long)sizeof(last)
+		&& bin_read_rec(f, n - 1, &last) == 0)
+		ok = (rec_end(&last) == (int64_t)csv_size);
+	fclose(f);
+	return (ok);
+}
+
+static int	writer_open_existing(t_hunt_bin_writer *w, const char *bin_path,
+				const char *names_path)
+{
+	FILE	*f;
+
+	f = fs_fopen_shared_read(names_path);
+	if (!f)
+		return (-1);
+	/* A torn last line (crash) would shift every id after it: rebuild. */
+	if (names_load_more(&w->tab, f) != 0
+		|| fs_file_size(names_path) != w->tab.file_pos || slots_grow(w) != 0)
+	{
+		fclose(f);
+		return (-1);
+	}
+	fclose(f);
+	while (w->tab.n * 2 > w->nslots)
+		if (slots_grow(w) != 0)
+			return (-1);
+	w->names = fopen(names_path, "ab");
+	w->bin = fopen(bin_path, "ab");
+	if (!w->names || !w->bin)
+		return (-1);
+	(void)setvbuf(w->bin, NULL, _IOFBF, 1 << 20);
+	return (0);
+}
+
+int	hunt_bin_writer_open(t_hunt_bin_writer *w, const char *csv_path,
+		FILE *csv_out)
+{
+	char	bin_path[512];
+	char	names_path[512];
+	long	csv_size;
+
+	if (!w)
+		return (-1);
+	memset(w, 0, sizeof(*w));
+	if (env_disabled() || !csv_out
+		|| !make_path(w->csv_path, sizeof(w->csv_path), csv_path, "")
+		|| !make_path(bin_path, sizeof(bin_path), csv_path, HUNT_BIN_SUFFIX)
+		|| !make_path(names_path, sizeof(names_path), csv_path,
+			HUNT_BIN_NAMES_SUFFIX))
+		return (-1);
+	csv_size = ftell(csv_out);
+	if (csv_size < 0)
+		return (-1);
+	if (writer_is_in_sync(bin_path, csv_size))
+	{
+		w->csv_pos = csv_size;
+		if (writer_open_existing(w, bin_path, names_path) == 0)
+			return (0);
+		hunt_bin_writer_close(w);
+	}
+	w->names = fopen(names_path, "wb");
+	w->bin = fopen(bin_path, "wb");
+	if (w->bin)
+		(void)setvbuf(w->bin, NULL, _IOFBF, 1 << 20);
+	if (!w->names || !w->bin || header_write(w->bin) != 0
+		|| writer_catch_up(w) != 0 || w->csv_pos != csv_size)
+	{
+		hunt_bin_writer_close(w);
+		(void)remove(bin_path);
+		return (-1);
+	}
+	fflush(w->bin);
+	return (0);
+}
+
+int	hunt_bin_writer_append(t_hunt_bin_writer *w,
+		const t_hunt_csv_row_view *row, int row_len)
+{
+	t_hunt_csv_row_view	r;
+
+	if (!w || !w->bin || !row || row_len <= 0 || w->lagging)
+		return (0);
+	if ((row->name && strchr(row->name, '\n'))
+		|| (row->raw && strchr(row->raw, '\n')))
+	{
+		/* Several CSV text lines: re-read them after the next CSV flush. */
+		w->lagging = 1;
+		return (0);
+	}
+	/* Same fixups as a reader parsing the CSV row back. */
+	r = *row;
+	hunt_csv_row_normalize(&r);
+	if (writer_put(w, &r, row_len) != 0)
+	{
+		writer_disable(w);
+		return (-1);
+	}
+	return (0);
+}
+
+/* Call right after the CSV itself was flushed. */
+void	hunt_bin_writer_flush(t_hunt_bin_writer *w)
+{
+	if (!w || !w->bin)
+		return ;
+	if (w->lagging)
+	{
+		w->lagging = 0;
+		if (writer_catch_up(w) != 0)
+		{
+			writer_disable(w);
+			return ;
+		}
+	}
+	if (fflush(w->bin) != 0)
+		writer_disable(w);
+}
+
+/* Call after the CSV stream was closed (or flushed). */
+void	hunt_bin_writer_close(t_hunt_bin_writer *w)
+{
+	if (!w)
+		return ;
+	hunt_bin_writer_flush(w);
+	writer_disable(w);
+	names_free(&w->tab);
+	free(w->slots);
+	w->slots = NULL;
+	w->nslots = 0;
+}
+
+/* --------------------------------- reader --------------------------------- */
+
+int	hunt_bin_reader_open(t_hunt_bin_reader *r, const char *csv_path)
+{
+	char		bin_path[512];
+	char		names_path[512];
+	uint32_t	gen;
+
+	if (!r)
+		return (-1);
+	hunt_bin_reader_close(r);
+	if (!make_path(bin_path, sizeof(bin_path), csv_path, HUNT_BIN_SUFFIX)
+		|| !make_path(names_path, sizeof(names_path), csv_path,
+			HUNT_BIN_NAMES_SUFFIX))
+		return (-1);
+	if (strcmp(names_path, r->names_path) != 0)
+	{
+		names_free(&r->tab);
+		memcpy(r->names_path, names_path, sizeof(names_path));
+	}
+	r->bin = fs_fopen_shared_read(bin_path);
+	r->csv = fs_fopen_shared_read(csv_path);
+	if (!r->bin || !r->csv)
+	{
+		hunt_bin_reader_close(r);
+		return (-1);
+	}
+	gen = bin_generation(r->bin);
+	/* Rebuilt sidecar: same ids may now name something else. */
+	if (gen != r->gen)
+	{
+		names_free(&r->tab);
+		r->gen = gen;
+	}
+	return (0);
+}
+
+uint32_t	hunt_bin_reader_generation(const t_hunt_bin_reader *r)
+{
+	if (!r)
+		return (0);
+	return (r->gen);
+}
+
+void	hunt_bin_reader_close(t_hunt_bin_reader *r)
+{
+	if (!r)
+		return ;
+	if (r->bin)
+		fclose(r->bin);
+	if (r->csv)
+		fclose(r->csv);
+	r->bin = NULL;
+	r->csv = NULL;
+}
+
+void	hunt_bin_reader_free(t_hunt_bin_reader *r)
+{
+	if (!r)
+		return ;
+	hunt_bin_reader_close(r);
+	names_free(&r->tab);
+	free(r->buf);
+	memset(r, 0, sizeof(*r));
+}
+
+/*
+ * The writer flushes the CSV before the sidecar, but stdio may push a full
+ * buffer earlier: keep the longest prefix whose rows are already in the CSV.
+ */
+long long	hunt_bin_reader_count(t_hunt_bin_reader *r)
+{
+	t_hunt_bin_rec	rec;
+	long			n;
+	long			lo;
+	long			hi;
+	long			csv_size;
+
+	if (!r || !r->bin || !r->csv || fseek(r->csv, 0, SEEK_END) != 0)
+		return (-1);
+	csv_size = ftell(r->csv);
+	n = bin_record_count(r->bin);
+	if (n <= 0 || csv_size <= 0)
+		return (n == 0 ? 0 : -1);
+	lo = 0;
+	hi = n;
+	while (lo < hi)
+	{
+		n = lo + (hi - lo + 1) / 2;
+		if (bin_read_rec(r->bin, n - 1, &rec) != 0)
+			return (-1);
+		if (rec_end(&rec) <= (int64_t)csv_size)
+			lo = n;
+		else
+			hi = n - 1;
+	}
+	if (lo == 0)
+		return (0);
+	/* Cheap identity check: the last kept row must end a CSV line. */
+	if (bin_read_rec(r->bin, lo - 1, &rec) != 0 || rec.csv_len == 0
+		|| fseek(r->csv, (long)(rec_end(&rec) - 1), SEEK_SET) != 0
+		|| fgetc(r->csv) != '\n')
+		return (-1);
+	return ((long long)lo);
+}
+
+size_t	hunt_bin_reader_read(t_hunt_bin_reader *r, unsigned long long first,
+			size_t max, const t_hunt_bin_rec **out)
+{
+	t_hunt_bin_rec	*nb;
+	size_t			got;
+
+	if (!r || !r->bin || !out || max == 0)
+		return (0);
+	if (max > HUNT_BIN_READ_BLOCK)
+		max = HUNT_BIN_READ_BLOCK;
+	if (!r->buf)
+	{
+		nb = (t_hunt_bin_rec *)malloc(HUNT_BIN_READ_BLOCK * sizeof(*nb));
+		if (!nb)
+			return (0);
+		r->buf = nb;
+		r->buf_cap = HUNT_BIN_READ_BLOCK;
+	}
+	if (bin_read_rec(r->bin, (long)first, r->buf) != 0)
+		return (0);
+	got = 1;
+	if (max > 1)
+		got += fread(r->buf + 1, sizeof(*r->buf), max - 1, r->bin);
+	*out = r->buf;
+	return (got);
+}
+
+const char	*hunt_bin_reader_name(t_hunt_bin_reader *r, uint32_t id)
+{
+	FILE	*f;
+
+	if (!r || id == HUNT_BIN_NO_NAME)
+		return ("");
+	if (id >= r->tab.n)
+	{
+		f = fs_fopen_shared_read(r->names_path);
+		if (f && fs_file_size(r->names_path) < r->tab.file_pos)
+			names_free(&r->tab);
+		if (f)
+		{
+			(void)names_load_more(&r->tab, f);
+			fclose(f);
+		}
+	}
+	if (id >= r->tab.n)
+		return ("");
+	return (r->tab.v[id]);
+}
@@ -0,0 +1,205 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   hunt_bus.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                   +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/21                                #+#    #+#             */
+/*   Updated: 2026/02/21                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "hunt_bus.h"
+#include "tm_wake.h"
+
+#include <stdatomic.h>
+#include <string.h>
+
+#define RING_MASK ((unsigned long long)HUNT_BUS_RING - 1ULL)
+
+/*
+ * SPSC: head n'est ecrit que par le parser, tail que par le thread UI.
+ * Un slot entre tail et head appartient au consommateur, le producteur
+ * ne le reecrit qu'apres que tail l'a depasse.
+ */
+typedef struct s_hunt_bus_ring
+{
+	_Atomic unsigned long long	head;
+	_Atomic unsigned long long	tail;
+	_Atomic unsigned long long	dropped;
+	_Atomic unsigned long long	applied;
+	t_hunt_bus_event			slot[HUNT_BUS_RING];
+}	t_hunt_bus_ring;
+
+typedef struct s_hunt_bus
+{
+	_Atomic int					active;
+	_Atomic unsigned			gen;
+	_Atomic long long			end;        /* fin logique du CSV publie */
+	_Atomic unsigned long long	published;
+	t_hunt_bus_ring				ring[HUNT_BUS_SUBS];
+}	t_hunt_bus;
+
+static t_hunt_bus	g_bus;
+
+/* ------------------------------- producteur ------------------------------- */
+
+void	hunt_bus_begin(long long csv_end)
+{
+	atomic_store(&g_bus.end, csv_end);
+	atomic_fetch_add(&g_bus.gen, 1u);
+	atomic_store(&g_bus.active, 1);
+}
+
+void	hunt_bus_end(void)
+{
+	atomic_store(&g_bus.active, 0);
+}
+
+static int	field_copy(char *dst, size_t cap, const char *src)
+{
+	size_t	n;
+
+	if (!src)
+		src = "";
+	n = strlen(src);
+	if (n >= cap || memchr(src, '\n', n))
+		return (-1);
+	memcpy(dst, src, n + 1);
+	return (0);
+}
+
+static int	event_fill(t_hunt_bus_event *e, const t_hunt_csv_row_view *row,
+				long long csv_off, int len)
+{
+	t_hunt_csv_row_view	r;
+
+	/* Memes corrections qu'un lecteur qui relit la ligne du CSV. */
+	r = *row;
+	hunt_csv_row_normalize(&r);
+	if (field_copy(e->type, sizeof(e->type), r.type) != 0
+		|| field_copy(e->name, sizeof(e->name), r.name) != 0
+		|| field_copy(e->raw, sizeof(e->raw), r.raw) != 0)
+		return (-1);
+	e->csv_off = csv_off;
+	e->csv_len = (uint32_t)len;
+	e->gen = atomic_load_explicit(&g_bus.gen, memory_order_relaxed);
+	e->ts_unix = r.ts_unix;
+	e->value_uPED = r.value_uPED;
+	e->kill_id = r.kill_id;
+	e->qty = r.qty;
+	e->flags = r.flags;
+	e->has_value = r.has_value;
+	return (0);
+}
+
+void	hunt_bus_publish(const t_hunt_csv_row_view *row, long long csv_off,
+			int len)
+{
+	static t_hunt_bus_event	ev;    /* 1 seul producteur, hors pile */
+	t_hunt_bus_ring			*r;
+	unsigned long long		head;
+	int						i;
+
+	if (!row || len <= 0
+		|| !atomic_load_explicit(&g_bus.active, memory_order_relaxed))
+		return ;
+	/* Avant la publication: une ligne appliquee est toujours couverte. */
+	atomic_store_explicit(&g_bus.end, csv_off + len, memory_order_release);
+	/* Trop long ou multi-lignes: les lecteurs la prendront dans le CSV. */
+	if (event_fill(&ev, row, csv_off, len) != 0)
+		return ;
+	i = 0;
+	while (i < HUNT_BUS_SUBS)
+	{
+		r = &g_bus.ring[i++];
+		head = atomic_load_explicit(&r->head, memory_order_relaxed);
+		if (head - atomic_load_explicit(&r->tail, memory_order_acquire)
+			>= (unsigned long long)HUNT_BUS_RING)
+		{
+			atomic_fetch_add_explicit(&r->dropped, 1ULL, memory_order_relaxed);
+			continue ;
+		}
+		r->slot[head & RING_MASK] = ev;
+		atomic_store_explicit(&r->head, head + 1ULL, memory_order_release);
+	}
+	atomic_fetch_add_explicit(&g_bus.published, 1ULL, memory_order_release);
+	tm_wake();
+}
+
+/* ------------------------------ consommateurs ----------------------------- */
+
+int	hunt_bus_drain(t_hunt_bus_sub sub, long *pos, t_hunt_bus_apply fn,
+		void *ctx)
+{
+	t_hunt_bus_ring			*r;
+	const t_hunt_bus_event	*e;
+	t_hunt_csv_row_view		row;
+	unsigned long long		tail;
+	unsigned				gen;
+	int						n;
+
+	if ((int)sub < 0 || sub >= HUNT_BUS_SUBS || !pos || !fn)
+		return (0);
+	r = &g_bus.ring[sub];
+	gen = atomic_load_explicit(&g_bus.gen, memory_order_acquire);
+	tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+	n = 0;
+	while (tail != atomic_load_explicit(&r->head, memory_order_acquire))
+	{
+		e = &r->slot[tail & RING_MASK];
+		if (e->gen == gen && e->csv_off > (long long)*pos)
+			break ;
+		if (e->gen == gen && e->csv_off == (long long)*pos)
+		{
+			row.ts_unix = e->ts_unix;
+			row.type = e->type;
+			row.name = e->name;
+			row.qty = e->qty;
+			row.value_uPED = e->value_uPED;
+			row.has_value = e->has_value;
+			row.kill_id = e->kill_id;
+			row.flags = e->flags;
+			row.raw = e->raw;
+			fn(ctx, &row, e->csv_off);
+			*pos = (long)(e->csv_off + (long long)e->csv_len);
+			n++;
+		}
+		tail++;
+		atomic_store_explicit(&r->tail, tail, memory_order_release);
+	}
+	if (n)
+		atomic_fetch_add_explicit(&r->applied, (unsigned long long)n,
+			memory_order_relaxed);
+	return (n);
+}
+
+int	hunt_bus_covers(long long pos)
+{
+	return (atomic_load_explicit(&g_bus.active, memory_order_acquire)
+		&& pos <= atomic_load_explicit(&g_bus.end, memory_order_acquire));
+}
+
+unsigned long long	hunt_bus_version(void)
+{
+	return (atomic_load_explicit(&g_bus.published, memory_order_acquire));
+}
+
+void	hunt_bus_get_stats(t_hunt_bus_stats *out)
+{
+	int	i;
+
+	if (!out)
+		return ;
+	memset(out, 0, sizeof(*out));
+	out->active = atomic_load(&g_bus.active);
+	out->published = atomic_load(&g_bus.published);
+	i = 0;
+	while (i < HUNT_BUS_SUBS)
+	{
+		out->applied[i] = atomic_load(&g_bus.ring[i].applied);
+		out->dropped[i] = atomic_load(&g_bus.ring[i].dropped);
+		i++;
+	}
+}
@@ -20,16 +20,29 @@
 #include "hunt_csv.h"
 
 #include "csv.h"
+#include "csv_index.h"
 #include "eu_economy.h"
 #include "fs_utils.h"
+#include "tm_fmt.h"
 #include "tm_string.h"
+#include "tm_time.h"
+
+#include "utils.h"
 
 #include <ctype.h>
 #include <errno.h>
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
+#ifndef _WIN32
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
 /* ----------------------------- small parsers ----------------------------- */
 
 static int	parse_int64(const char *s, int64_t *out)
@@ -173,30 +186,8 @@ int	hunt_csv_repair_trailing_partial_line(FILE *f)
 
 int	hunt_csv_ts_text_to_unix(const char *ts_text, int64_t *out_unix)
 {
-	struct tm	tm;
-	int			yr, mo, da, ho, mi, se;
-	time_t		t;
-
-	if (!out_unix)
-		return (0);
-	*out_unix = 0;
-	if (!ts_text || strlen(ts_text) < 19)
-		return (0);
-	memset(&tm, 0, sizeof(tm));
-	if (sscanf(ts_text, "%d-%d-%d %d:%d:%d", &yr, &mo, &da, &ho, &mi, &se) != 6)
-		return (0);
-	tm.tm_year = yr - 1900;
-	tm.tm_mon = mo - 1;
-	tm.tm_mday = da;
-	tm.tm_hour = ho;
-	tm.tm_min = mi;
-	tm.tm_sec = se;
-	tm.tm_isdst = -1;
-	t = mktime(&tm);
-	if (t == (time_t)-1)
-		return (0);
-	*out_unix = (int64_t)t;
-	return (1);
+	/* Shared with hunt_rules: per-day offset cache, no mktime per row. */
+	return (tm_time_local_to_unix(ts_text, out_unix));
 }
 
 void	hunt_csv_format_ts_local(char *dst, size_t cap, int64_t ts_unix)
@@ -250,17 +241,35 @@ static int	parse_v2_inplace(char *line, t_hunt_csv_row_view *out)
 	parse_uint32(cols[6], &flags);
 	out->flags = flags;
 	out->raw = cols[7] ? cols[7] : "";
+	hunt_csv_row_normalize(out);
+	return (1);
+}
+
+void	hunt_csv_row_normalize(t_hunt_csv_row_view *row)
+{
+	if (!row || !row->type)
+		return ;
 	/* SWEAT safety: if value missing but qty present, compute it. */
-	if (strcmp(out->type, "SWEAT") == 0 && (!out->has_value || out->value_uPED == 0))
+	if (strcmp(row->type, "SWEAT") == 0 && (!row->has_value || row->value_uPED == 0))
 	{
-		if (out->qty > 0)
+		if (row->qty > 0)
 		{
-			out->value_uPED = (tm_money_t)out->qty
+			row->value_uPED = (tm_money_t)row->qty
 				* (tm_money_t)EU_SWEAT_uPED_PER_BOTTLE;
-			out->has_value = 1;
+			row->has_value = 1;
 		}
 	}
-	return (1);
+}
+
+int	hunt_csv_raw_is_hit(const char *raw)
+{
+	if (!raw)
+		return (0);
+	if (strstr(raw, "You inflicted ") != NULL)
+		return (1);
+	if (strstr(raw, "Vous avez inflig") != NULL)
+		return (1);
+	return (0);
 }
 
 int	hunt_csv_parse_row_inplace(char *line, t_hunt_csv_row_view *out)
@@ -321,41 +330,319 @@ int64_t	hunt_csv_tail_max_kill_id(const char *path)
 
 /* ----------------------------- row writing -------------------------------- */
 
-int	hunt_csv_write_v2(FILE *f, int64_t ts_unix,
+/* 5 numeric columns (TM_FMT_I64_MAX) + 7 separators + '\n'. */
+size_t	hunt_csv_v2_row_max(const char *type, const char *name, const char *raw)
+{
+	size_t	n;
+
+	n = 5 * TM_FMT_I64_MAX + 8;
+	n += 2 * (type ? strlen(type) : 0) + 2;
+	n += 2 * (name ? strlen(name) : 0) + 2;
+	n += 2 * (raw ? strlen(raw) : 0) + 2;
+	return (n);
+}
+
+int	hunt_csv_format_v2(char *dst, size_t cap, int64_t ts_unix,
 			const char *type, const char *name,
 			long qty, tm_money_t value_uPED,
 			int64_t kill_id, uint32_t flags,
 			const char *raw)
 {
-	char	s_ts[32];
-	char	s_qty[32];
-	char	s_val[32];
-	char	s_kid[32];
-	char	s_flags[32];
+	size_t	n;
 
-	if (!f)
+	if (!dst || cap < hunt_csv_v2_row_max(type, name, raw))
+		return (-1);
+	/* Numeric columns never need quoting: written as is. */
+	n = tm_fmt_i64_raw(dst, ts_unix);
+	dst[n++] = ',';
+	n += csv_format_field_sep(dst + n, type ? type : "", CSV_SEP);
+	dst[n++] = ',';
+	n += csv_format_field_sep(dst + n, name ? name : "", CSV_SEP);
+	dst[n++] = ',';
+	n += tm_fmt_i64_raw(dst + n, (int64_t)qty);
+	dst[n++] = ',';
+	n += tm_fmt_i64_raw(dst + n, (int64_t)value_uPED);
+	dst[n++] = ',';
+	n += tm_fmt_i64_raw(dst + n, kill_id);
+	dst[n++] = ',';
+	n += tm_fmt_u64_raw(dst + n, (uint64_t)flags);
+	dst[n++] = ',';
+	n += csv_format_field_sep(dst + n, raw ? raw : "", CSV_SEP);
+	dst[n++] = '\n';
+	return ((int)n);
+}
+
+/* ----------------------------- row cursor --------------------------------- */
+
+static int	cursor_looks_like_header(const char *line)
+{
+	return (strstr(line, "timestamp")
+		&& (strstr(line, "event_type") || strstr(line, ",type,")));
+}
+
+static int	cursor_work_fit(t_hunt_csv_cursor *c, size_t len)
+{
+	char	*nw;
+
+	if (len + 1 <= c->work_cap)
+		return (1);
+	nw = (char *)realloc(c->work, len + 1);
+	if (!nw)
+		return (0);
+	c->work = nw;
+	c->work_cap = len + 1;
+	return (1);
+}
+
+#ifndef _WIN32
+
+/* Maps the file, usable size cut after its last '\n'. 0 = ok, -1 = use stdio. */
+static int	cursor_map(t_hunt_csv_cursor *c, const char *path)
+{
+	struct stat	st;
+	int			fd;
+	void		*m;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return (-1);
+	if (fstat(fd, &st) != 0 || st.st_size <= 0)
+	{
+		close(fd);
+		return (-1);
+	}
+	m = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (m == MAP_FAILED)
 		return (-1);
-	snprintf(s_ts, sizeof(s_ts), "%lld", (long long)ts_unix);
-	snprintf(s_qty, sizeof(s_qty), "%ld", qty);
-	snprintf(s_val, sizeof(s_val), "%lld", (long long)value_uPED);
-	snprintf(s_kid, sizeof(s_kid), "%lld", (long long)kill_id);
-	snprintf(s_flags, sizeof(s_flags), "%u", (unsigned)flags);
-
-	csv_write_field(f, s_ts);
-	fputc(',', f);
-	csv_write_field(f, type ? type : "");
-	fputc(',', f);
-	csv_write_field(f, name ? name : "");
-	fputc(',', f);
-	csv_write_field(f, s_qty);
-	fputc(',', f);
-	csv_write_field(f, s_val);
-	fputc(',', f);
-	csv_write_field(f, s_kid);
-	fputc(',', f);
-	csv_write_field(f, s_flags);
-	fputc(',', f);
-	csv_write_field(f, raw ? raw : "");
-	fputc('\n', f);
+	(void)posix_madvise(m, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+	c->map = (const char *)m;
+	c->map_len = (size_t)st.st_size;
+	c->size = c->map_len;
+	while (c->size > 0 && c->map[c->size - 1] != '\n')
+		c->size--;
 	return (0);
 }
+
+#endif
+
+static int	cursor_open_stdio(t_hunt_csv_cursor *c, const char *path)
+{
+	if (c->f)
+	{
+		line_reader_free(&c->lr);
+		if (fseek(c->f, 0, SEEK_SET) != 0)
+			return (-1);
+	}
+	else
+		c->f = fs_fopen_shared_read(path);
+	c->pos = 0;
+	if (!c->f || line_reader_init(&c->lr, c->f, 0) != 0)
+		return (-1);
+	return (0);
+}
+
+int	hunt_csv_cursor_open(t_hunt_csv_cursor *c, const char *path)
+{
+	const char	*line;
+	size_t		len;
+
+	if (!c || !path)
+		return (-1);
+	memset(c, 0, sizeof(*c));
+	if (strlen(path) < sizeof(c->path))
+		memcpy(c->path, path, strlen(path) + 1);
+#ifndef _WIN32
+	if (cursor_map(c, path) != 0)
+#endif
+	if (cursor_open_stdio(c, path) != 0)
+	{
+		hunt_csv_cursor_close(c);
+		return (-1);
+	}
+	if (!hunt_csv_cursor_next(c, &line, &len) || !cursor_work_fit(c, len))
+	{
+		c->pos = 0;
+		c->row = 0;
+		return (0);
+	}
+	memcpy(c->work, line, len);
+	c->work[len] = '\0';
+	c->has_header = cursor_looks_like_header(c->work);
+	if (!c->has_header && c->map)
+		c->pos = 0;
+	else if (!c->has_header && cursor_open_stdio(c, path) != 0)
+	{
+		hunt_csv_cursor_close(c);
+		return (-1);
+	}
+	c->row = 0;
+	c->data_off = c->pos;
+	return (0);
+}
+
+void	hunt_csv_cursor_close(t_hunt_csv_cursor *c)
+{
+	if (!c)
+		return ;
+#ifndef _WIN32
+	if (c->map)
+		munmap((void *)c->map, c->map_len);
+#endif
+	if (c->f)
+	{
+		line_reader_free(&c->lr);
+		fclose(c->f);
+	}
+	free(c->work);
+	memset(c, 0, sizeof(*c));
+}
+
+int	hunt_csv_cursor_next(t_hunt_csv_cursor *c, const char **line, size_t *len)
+{
+	const char	*p;
+	const char	*nl;
+	t_line_view	lv;
+
+	if (c->map)
+	{
+		if (c->pos >= c->size)
+			return (0);
+		p = c->map + c->pos;
+		nl = (const char *)memchr(p, '\n', c->size - c->pos);
+		*line = p;
+		*len = (size_t)(nl - p) + 1;
+		c->line_off = c->pos;
+		c->pos += *len;
+		c->row++;
+		return (1);
+	}
+	if (!c->f)
+		return (0);
+	/* Same contract as the mapping: a last line without '\n' is not a row yet */
+	if (line_reader_next(&c->lr, &lv) <= 0
+		|| lv.len == 0 || lv.ptr[lv.len - 1] != '\n')
+		return (0);
+	*line = lv.ptr;
+	*len = lv.len;
+	c->line_off = c->pos;
+	c->pos += lv.len;
+	c->row++;
+	return (1);
+}
+
+int	hunt_csv_cursor_next_row(t_hunt_csv_cursor *c, t_hunt_csv_row_view *row)
+{
+	const char	*line;
+	size_t		len;
+
+	if (!hunt_csv_cursor_next(c, &line, &len))
+		return (-1);
+	if (!cursor_work_fit(c, len))
+		return (0);
+	memcpy(c->work, line, len);
+	c->work[len] = '\0';
+	tm_trim_eol(c->work);
+	return (hunt_csv_parse_row_inplace(c->work, row));
+}
+
+unsigned long long	hunt_csv_cursor_skip(t_hunt_csv_cursor *c,
+						unsigned long long n)
+{
+	unsigned long long	done;
+	const char			*line;
+	size_t				len;
+
+	done = 0;
+	while (done < n && hunt_csv_cursor_next(c, &line, &len))
+		done++;
+	return (done);
+}
+
+int	hunt_csv_cursor_seek(t_hunt_csv_cursor *c, unsigned long long byte_off,
+		unsigned long long row)
+{
+	long	saved;
+
+	if (!c || byte_off < c->data_off)
+		return (-1);
+	if (c->map)
+	{
+		if (byte_off > c->size
+			|| (byte_off > 0 && c->map[byte_off - 1] != '\n'))
+			return (-1);
+		c->pos = (size_t)byte_off;
+		c->row = row;
+		return (0);
+	}
+	if (!c->f || byte_off > (unsigned long long)LONG_MAX)
+		return (-1);
+	saved = ftell(c->f);
+	if (byte_off > 0 && (fseek(c->f, (long)byte_off - 1, SEEK_SET) != 0
+			|| fgetc(c->f) != '\n'))
+	{
+		/* keep the block reader consistent with its buffered bytes */
+		(void)fseek(c->f, saved, SEEK_SET);
+		return (-1);
+	}
+	if (byte_off == 0 && fseek(c->f, 0, SEEK_SET) != 0)
+		return (-1);
+	line_reader_free(&c->lr);
+	if (line_reader_init(&c->lr, c->f, 0) != 0)
+		return (-1);
+	c->pos = (size_t)byte_off;
+	c->row = row;
+	return (0);
+}
+
+/*
+ * Jumps to the best csv_index checkpoint <= row (ahead of the cursor).
+ * The checkpoint must still point at a row with the indexed timestamp
+ * (0 = unparsable row), otherwise the index is stale and is ignored.
+ */
+static int	cursor_seek_checkpoint(t_hunt_csv_cursor *c, unsigned long long row)
+{
+	unsigned long long	off;
+	unsigned long long	cp_row;
+	long long			cp_ts;
+	size_t				saved_pos;
+	unsigned long long	saved_row;
+	t_hunt_csv_row_view	view;
+	int					rc;
+
+	if (!c->path[0] || row <= c->row
+		|| !csv_index_lookup_row_ex(c->path, row, &off, &cp_ts, &cp_row,
+			NULL, NULL)
+		|| cp_row <= c->row)
+		return (-1);
+	saved_pos = c->pos;
+	saved_row = c->row;
+	if (hunt_csv_cursor_seek(c, off, cp_row) != 0)
+		return (-1);
+	rc = hunt_csv_cursor_next_row(c, &view);
+	if ((rc == 1 && view.ts_unix == cp_ts) || (rc == 0 && cp_ts == 0))
+		return (hunt_csv_cursor_seek(c, off, cp_row));
+	(void)hunt_csv_cursor_seek(c, saved_pos, saved_row);
+	return (-1);
+}
+
+unsigned long long	hunt_csv_cursor_goto(t_hunt_csv_cursor *c,
+						unsigned long long row, long long byte_hint)
+{
+	if (!c)
+		return (0);
+	if (byte_hint >= 0
+		&& hunt_csv_cursor_seek(c, (unsigned long long)byte_hint, row) == 0)
+		return (row);
+	(void)cursor_seek_checkpoint(c, row);
+	if (c->row > row)
+		return (c->row);
+	return (c->row + hunt_csv_cursor_skip(c, row - c->row));
+}
+
+unsigned long long	hunt_csv_cursor_tell(const t_hunt_csv_cursor *c)
+{
+	if (!c)
+		return (0);
+	return ((unsigned long long)c->pos);
+}
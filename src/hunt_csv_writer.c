@@ -0,0 +1,229 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   hunt_csv_writer.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                   +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/22                                #+#    #+#             */
+/*   Updated: 2026/02/22                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* fileno(), fsync() */
+#ifndef _WIN32
+# ifndef _POSIX_C_SOURCE
+#  define _POSIX_C_SOURCE 200809L
+# endif
+#endif
+
+#include "hunt_csv_writer.h"
+
+#include "hunt_csv.h"
+#include "monitor_health.h"
+#include "utils.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+# include <io.h>
+# define TM_FILENO _fileno
+# define TM_FSYNC  _commit
+# define TM_WRITE(fd, p, n) _write((fd), (p), (unsigned int)(n))
+#else
+# include <unistd.h>
+# define TM_FILENO fileno
+# define TM_FSYNC  fsync
+# define TM_WRITE(fd, p, n) write((fd), (p), (n))
+#endif
+
+#define LATENCY_ROWS       64
+#define LATENCY_BATCH      (64u * 1024u)
+#define BIG_BATCH          (1024u * 1024u)
+#define MAX_AGE_MS         1000u
+#define FSYNC_DEFAULT_MS   200u
+#define WRITE_CHUNK        (1u << 30)
+
+const char	*hunt_csv_flush_policy_name(t_csv_flush_policy p)
+{
+	if (p == CSV_FLUSH_THROUGHPUT)
+		return ("throughput");
+	if (p == CSV_FLUSH_FSYNC)
+		return ("fsync");
+	return ("latency");
+}
+
+/* TM_CSV_FLUSH=latency|throughput|fsync[:ms]; inconnu => def. */
+static void	policy_from_env(t_hunt_csv_writer *w, t_csv_flush_policy def)
+{
+	const char	*v;
+	long		ms;
+
+	w->policy = def;
+	w->max_age_ms = MAX_AGE_MS;
+	v = getenv("TM_CSV_FLUSH");
+	if (!v || !*v)
+		;
+	else if (strcmp(v, "latency") == 0)
+		w->policy = CSV_FLUSH_LATENCY;
+	else if (strcmp(v, "throughput") == 0)
+		w->policy = CSV_FLUSH_THROUGHPUT;
+	else if (strncmp(v, "fsync", 5) == 0 && (v[5] == '\0' || v[5] == ':'))
+		w->policy = CSV_FLUSH_FSYNC;
+	w->batch_max = (w->policy == CSV_FLUSH_LATENCY) ? LATENCY_BATCH : BIG_BATCH;
+	if (w->policy != CSV_FLUSH_FSYNC)
+		return ;
+	w->max_age_ms = FSYNC_DEFAULT_MS;
+	if (v && v[5] == ':')
+	{
+		ms = strtol(v + 6, NULL, 10);
+		if (ms > 0)
+			w->max_age_ms = (uint64_t)ms;
+	}
+}
+
+int	hunt_csv_writer_open(t_hunt_csv_writer *w, FILE *out,
+		t_csv_flush_policy def)
+{
+	if (!w)
+		return (-1);
+	memset(w, 0, sizeof(*w));
+	w->fd = -1;
+	if (!out || fflush(out) != 0)
+		return (-1);
+	w->out = out;
+	w->fd = TM_FILENO(out);
+	policy_from_env(w, def);
+	monitor_health_set_csv_policy(hunt_csv_flush_policy_name(w->policy));
+	return (w->fd < 0 ? -1 : 0);
+}
+
+static int	buf_reserve(t_hunt_csv_writer *w, size_t need)
+{
+	size_t	cap;
+	char	*p;
+
+	if (w->len + need <= w->cap)
+		return (0);
+	cap = w->cap ? w->cap : 4096;
+	while (cap < w->len + need)
+		cap *= 2;
+	p = (char *)realloc(w->buf, cap);
+	if (!p)
+		return (-1);
+	w->buf = p;
+	w->cap = cap;
+	return (0);
+}
+
+int	hunt_csv_writer_append(t_hunt_csv_writer *w, int64_t ts_unix,
+		const char *type, const char *name, long qty,
+		tm_money_t value_uPED, int64_t kill_id, uint32_t flags,
+		const char *raw)
+{
+	size_t	need;
+	int		n;
+
+	if (!w || w->fd < 0 || w->err)
+		return (-1);
+	need = hunt_csv_v2_row_max(type, name, raw);
+	if (buf_reserve(w, need) != 0)
+	{
+		/* Plus de memoire: on vide le lot et on reessaie une fois. */
+		if (hunt_csv_writer_commit(w) != 0 || buf_reserve(w, need) != 0)
+			return (-1);
+	}
+	n = hunt_csv_format_v2(w->buf + w->len, w->cap - w->len, ts_unix, type,
+			name, qty, value_uPED, kill_id, flags, raw);
+	if (n <= 0)
+		return (-1);
+	if (w->rows == 0)
+		w->first_ms = ft_time_ms();
+	w->len += (size_t)n;
+	w->rows++;
+	return (n);
+}
+
+int	hunt_csv_writer_due(const t_hunt_csv_writer *w, uint64_t now_ms,
+		int critical)
+{
+	if (!w || w->rows == 0)
+		return (0);
+	if (w->len >= w->batch_max)
+		return (1);
+	if (now_ms >= w->first_ms && now_ms - w->first_ms >= w->max_age_ms)
+		return (1);
+	if (w->policy != CSV_FLUSH_LATENCY)
+		return (0);
+	return (critical || w->rows >= LATENCY_ROWS);
+}
+
+static int	write_all(int fd, const char *p, size_t n)
+{
+	long	k;
+	size_t	chunk;
+
+	while (n > 0)
+	{
+		chunk = (n > WRITE_CHUNK) ? WRITE_CHUNK : n;
+		k = (long)TM_WRITE(fd, p, chunk);
+		if (k < 0 && errno == EINTR)
+			continue ;
+		if (k <= 0)
+			return (-1);
+		p += k;
+		n -= (size_t)k;
+	}
+	return (0);
+}
+
+int	hunt_csv_writer_commit(t_hunt_csv_writer *w)
+{
+	uint64_t	t0;
+	uint64_t	dt;
+	int			synced;
+	int			ok;
+	int			err;
+
+	if (!w || w->fd < 0)
+		return (-1);
+	if (w->rows == 0 || w->err)
+		return (w->err ? -1 : 0);
+	t0 = ft_time_us();
+	ok = (write_all(w->fd, w->buf, w->len) == 0);
+	synced = (ok && w->policy == CSV_FLUSH_FSYNC);
+	if (synced && TM_FSYNC(w->fd) != 0)
+		ok = 0;
+	err = ok ? 0 : errno;
+	dt = ft_time_us() - t0;
+	monitor_health_on_flush(ft_time_ms(), ok, err, 0);
+	if (ok)
+		monitor_health_on_csv_commit(ft_time_ms(), w->rows,
+			(long long)w->len, dt, synced);
+	else
+	{
+		/* Fin de fichier inconnue: on arrete d'ecrire (comme ferror()). */
+		w->err = 1;
+		monitor_health_on_io_error("CSV write", err, 0);
+	}
+	w->len = 0;
+	w->rows = 0;
+	return (ok ? 0 : -1);
+}
+
+void	hunt_csv_writer_close(t_hunt_csv_writer *w)
+{
+	if (!w)
+		return ;
+	if (w->fd >= 0)
+		(void)hunt_csv_writer_commit(w);
+	free(w->buf);
+	w->buf = NULL;
+	w->cap = 0;
+	w->len = 0;
+	w->rows = 0;
+	w->fd = -1;
+	w->out = NULL;
+}
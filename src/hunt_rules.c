@@ -10,12 +10,22 @@
 /*                                                                            */
 /* ************************************************************************** */
 
+/* localtime_r(): hunt_decode_line() runs on REPLAY worker threads */
+#ifndef _WIN32
+# ifndef _POSIX_C_SOURCE
+#  define _POSIX_C_SOURCE 200809L
+# endif
+#endif
+
 #include "hunt_rules.h"
 #include "eu_economy.h"
 #include "tm_string.h"
 #include "tm_money.h"
+#include "tm_time.h"
+#include "pattern_set.h"
 
 #include <ctype.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -33,13 +43,9 @@
  */
 #define LOOT_GROUP_WINDOW_SEC 0
 #define COMBAT_TO_LOOT_WINDOW_SEC 60
-static int			g_has_pending = 0;
-static t_hunt_event	g_pending;
-static char			g_player_name[128];
-static char			g_last_kill_ts[32];
-static time_t		g_last_loot_t = 0;
-static time_t		g_last_combat_t = 0;
-static time_t		g_last_explicit_kill_t = 0;
+
+/* State behind the context-free API (hunt_parse_line() & co). */
+static t_hunt_rules_ctx	g_default_ctx;
 
 /* If a proper "You killed ..." line happened very recently, do NOT infer a kill
  * from a loot packet (prevents KILL duplicates / UNKNOWN kills).
@@ -49,18 +55,21 @@ static time_t		g_last_explicit_kill_t = 0;
 static void	now_timestamp(char *buf, size_t bufsz)
 {
 	time_t		t;
-	struct tm	*lt;
+	struct tm	lt;
 	
 	if (!buf || bufsz == 0)
 		return;
 	t = time(NULL);
-	lt = localtime(&t);
-	if (!lt)
+#ifdef _WIN32
+	if (localtime_s(&lt, &t) != 0)
+#else
+	if (localtime_r(&t, &lt) == NULL)
+#endif
 	{
 		buf[0] = '\0';
 		return;
 	}
-	strftime(buf, bufsz, "%Y-%m-%d %H:%M:%S", lt);
+	strftime(buf, bufsz, "%Y-%m-%d %H:%M:%S", &lt);
 }
 
 static int	is_2digits(const char *p)
@@ -96,27 +105,11 @@ static int	extract_chatlog_timestamp(const char *line, char *out, size_t outsz)
 
 static time_t	parse_ts_to_time(const char *ts)
 {
-	struct tm	tm;
-	int			yr;
-	int			mo;
-	int			da;
-	int			ho;
-	int			mi;
-	int			se;
-	
-	if (!ts || strlen(ts) < 19)
-		return ((time_t)0);
-	memset(&tm, 0, sizeof(tm));
-	if (sscanf(ts, "%d-%d-%d %d:%d:%d", &yr, &mo, &da, &ho, &mi, &se) != 6)
+	int64_t	t;
+
+	if (!tm_time_local_to_unix(ts, &t))
 		return ((time_t)0);
-	tm.tm_year = yr - 1900;
-	tm.tm_mon = mo - 1;
-	tm.tm_mday = da;
-	tm.tm_hour = ho;
-	tm.tm_min = mi;
-	tm.tm_sec = se;
-	tm.tm_isdst = -1;
-	return (mktime(&tm));
+	return ((time_t)t);
 }
 
 static void	trim_final_dot(char *s)
@@ -132,39 +125,129 @@ static void	trim_final_dot(char *s)
 		s[n - 1] = '\0';
 }
 
-static int	contains_any(const char *line, const char *const *pats, size_t n)
+/* -------------------------------------------------------------------------- */
+/* Rule table                                                                 */
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Every line pattern of the rules, in one table: each line is scanned ONCE by
+ * a pattern_set automaton instead of one strstr() per pattern.
+ * Groups are contiguous id ranges; inside a group the order is the lookup
+ * priority (first matching token wins, as the former strstr cascades).
+ * The loot field tokens (" x (", " Value:") start with a space, which would
+ * defeat the first-byte dispatch: they stay plain strstr() calls, only run on
+ * "You received" lines.
+ */
+enum e_hunt_pat
+{
+	P_SHOT = 0,        /* 9: strict SHOT patterns */
+	P_INFLICT_EN = 0,
+	P_INFLICT_FR = 1,
+	P_CRIT = 9,        /* 2 */
+	P_RECEIVED = 11,   /* 2 */
+	P_KILL = 13,       /* 3 */
+	P_IGNORE = 16,     /* 5 */
+	P_COUNT = 21
+};
+
+static const char *const	g_pats[P_COUNT] = {
+	"You inflicted ",
+	"Vous avez infligé ",
+	"The target Dodged your attack",
+	"The target Evaded your attack",
+	"La cible a esquivé votre attaque",
+	"La cible a évité votre attaque",
+	"You missed",
+	"Vous avez raté",
+	"Vous manquez votre cible",
+	"Critical hit",
+	"Coup critique",
+	"You received ",
+	"Vous avez reçu ",
+	"You killed ",
+	"Vous avez tué ",
+	"Vous tuez ",
+	"[Rookie]",
+	"[Débutant]",
+	"[#",
+	"[ROCKtropia",
+	"[HyperStim"
+};
+
+static t_pattern_set	g_ps;
+/* 0 = not built, 1 = building, 2 = ready, -1 = build failed (strstr) */
+static atomic_int		g_ps_state;
+
+int	hunt_rules_init(void)
+{
+	int	expected;
+
+	expected = 0;
+	if (atomic_compare_exchange_strong(&g_ps_state, &expected, 1))
+	{
+		if (pattern_set_build(&g_ps, g_pats, P_COUNT) == 0)
+			atomic_store(&g_ps_state, 2);
+		else
+			atomic_store(&g_ps_state, -1);
+	}
+	return ((atomic_load(&g_ps_state) == -1) ? -1 : 0);
+}
+
+/*
+ * Same matches as pattern_set_scan(), one strstr() per pattern: used while
+ * the automaton is not ready (build failed, or built by another thread).
+ */
+static void	rules_scan_strstr(const char *line, t_pattern_match *m)
 {
-	size_t	i;
-	
-	if (!line)
-		return (0);
+	const char	*p;
+	size_t		i;
+
+	m->found = 0;
 	i = 0;
-	while (i < n)
+	while (i < P_COUNT)
 	{
-		if (pats[i] && strstr(line, pats[i]))
-			return (1);
+		p = strstr(line, g_pats[i]);
+		if (p)
+		{
+			m->found |= (uint64_t)1 << i;
+			m->at[i] = p;
+		}
 		i++;
 	}
-	return (0);
 }
 
-static const char	*find_after_token(const char *line, const char *const *tok,
+/* The engine builds the matcher before its threads; lazy for other callers. */
+static void	rules_scan(const char *line, t_pattern_match *m)
+{
+	if (atomic_load(&g_ps_state) == 0)
+		(void)hunt_rules_init();
+	if (atomic_load(&g_ps_state) == 2)
+		pattern_set_scan(&g_ps, line, m);
+	else
+		rules_scan_strstr(line, m);
+}
+
+static int	any_of(const t_pattern_match *m, size_t first, size_t n)
+{
+	uint64_t	mask;
+
+	mask = (((uint64_t)1 << n) - 1) << first;
+	return ((m->found & mask) != 0);
+}
+
+/* First token of the group present in the line => pointer just after it. */
+static const char	*find_after_token(const t_pattern_match *m, size_t first,
 									  size_t n)
 {
 	size_t		i;
 	const char	*p;
-	
-	if (!line)
-		return (NULL);
+
 	i = 0;
 	while (i < n)
 	{
-		if (tok[i])
-		{
-			p = strstr(line, tok[i]);
-			if (p)
-				return (p + strlen(tok[i]));
-		}
+		p = pattern_match_at(m, first + i);
+		if (p)
+			return (p + strlen(g_pats[first + i]));
 		i++;
 	}
 	return (NULL);
@@ -183,31 +266,14 @@ static void	zero_event(t_hunt_event *ev)
 	memset(ev, 0, sizeof(*ev));
 }
 
-int	hunt_pending_pop(t_hunt_event *ev)
-{
-	if (!ev || !g_has_pending)
-		return (0);
-	*ev = g_pending;
-	g_has_pending = 0;
-	memset(&g_pending, 0, sizeof(g_pending));
-	return (1);
-}
-
-void	hunt_rules_set_player_name(const char *name)
-{
-	safe_copy(g_player_name, sizeof(g_player_name), name);
-}
-
 /* -------------------------------------------------------------------------- */
 /* Parsing helpers                                                            */
 /* -------------------------------------------------------------------------- */
 
-static void	init_event(const char *line_in, t_hunt_event *ev, char *line,
-					   char *ts)
+/* 'line': chomped copy of the chat line (rules_scan() ran on it). */
+static void	init_event(const char *line, t_hunt_event *ev, char *ts)
 {
 	zero_event(ev);
-	safe_copy(line, MAX_LINE, line_in);
-	tm_chomp_crlf(line);
 	safe_copy(ev->raw, sizeof(ev->raw), line);
 	ts[0] = '\0';
 	if (!extract_chatlog_timestamp(line, ts, 32))
@@ -215,138 +281,113 @@ static void	init_event(const char *line_in, t_hunt_event *ev, char *line,
 	safe_copy(ev->ts, sizeof(ev->ts), ts);
 }
 
-static void	push_pending_kill(const char *line, const char *ts)
+/* -------------------------------------------------------------------------- */
+/* Order-dependent rules (t_hunt_rules_ctx)                                   */
+/* -------------------------------------------------------------------------- */
+
+static void	push_pending_kill(t_hunt_rules_ctx *c, const char *line,
+					const char *ts)
 {
-	zero_event(&g_pending);
-	safe_copy(g_pending.ts, sizeof(g_pending.ts), ts);
-	safe_copy(g_pending.type, sizeof(g_pending.type), "KILL");
-	safe_copy(g_pending.name, sizeof(g_pending.name), "UNKNOWN");
-	safe_copy(g_pending.raw, sizeof(g_pending.raw), line);
-	g_has_pending = 1;
-	snprintf(g_last_kill_ts, sizeof(g_last_kill_ts), "%s", ts);
+	zero_event(&c->pending);
+	safe_copy(c->pending.ts, sizeof(c->pending.ts), ts);
+	safe_copy(c->pending.type, sizeof(c->pending.type), "KILL");
+	safe_copy(c->pending.name, sizeof(c->pending.name), "UNKNOWN");
+	safe_copy(c->pending.raw, sizeof(c->pending.raw), line);
+	c->has_pending = 1;
+	snprintf(c->last_kill_ts, sizeof(c->last_kill_ts), "%s", ts);
 }
 
-static int	should_make_kill(time_t t)
+static int	should_make_kill(const t_hunt_rules_ctx *c, time_t t)
 {
-	if (!g_last_combat_t)
+	if (!c->last_combat_t)
 		return (0);
-	return ((t - g_last_combat_t) <= COMBAT_TO_LOOT_WINDOW_SEC);
+	return ((t - (time_t)c->last_combat_t) <= COMBAT_TO_LOOT_WINDOW_SEC);
 }
 
-static int	is_same_loot_group(time_t t)
+static int	is_same_loot_group(const t_hunt_rules_ctx *c, time_t t)
 {
-	if (!g_last_loot_t)
+	if (!c->last_loot_t)
 		return (0);
-	return ((t - g_last_loot_t) <= LOOT_GROUP_WINDOW_SEC);
+	return ((t - (time_t)c->last_loot_t) <= LOOT_GROUP_WINDOW_SEC);
 }
 
-static int	legacy_pending_kill(const char *line, const char *ts)
+static int	legacy_pending_kill(t_hunt_rules_ctx *c, const char *line,
+					const char *ts)
 {
-	if (ts[0] && strcmp(g_last_kill_ts, ts) != 0)
+	if (ts[0] && strcmp(c->last_kill_ts, ts) != 0)
 	{
-		push_pending_kill(line, ts);
+		push_pending_kill(c, line, ts);
 		return (1);
 	}
 	return (0);
 }
 
-static int	handle_loot_time(time_t t, const char *line, const char *ts)
+static int	handle_loot_time(t_hunt_rules_ctx *c, time_t t, const char *line,
+					const char *ts)
 {
-	if (g_last_explicit_kill_t)
+	if (c->last_explicit_kill_t)
 	{
 		time_t	dt;
 
-		dt = t - g_last_explicit_kill_t;
+		dt = t - (time_t)c->last_explicit_kill_t;
 		if (dt < 0)
 			dt = -dt;
 		if (dt <= KILL_TO_LOOT_GRACE_SEC)
 		{
-			g_last_loot_t = t;
+			c->last_loot_t = (long long)t;
 			return (0);
 		}
 	}
-	if (is_same_loot_group(t))
+	if (is_same_loot_group(c, t))
 	{
-		g_last_loot_t = t;
+		c->last_loot_t = (long long)t;
 		return (0);
 	}
-	g_last_loot_t = t;
-	if (should_make_kill(t))
+	c->last_loot_t = (long long)t;
+	if (should_make_kill(c, t))
 	{
-		push_pending_kill(line, ts);
+		push_pending_kill(c, line, ts);
 		return (1);
 	}
 	return (0);
 }
 
-static int	maybe_grouped_kill(const char *line, const char *ts)
+static int	maybe_grouped_kill(t_hunt_rules_ctx *c, time_t t, const char *line,
+					const char *ts)
 {
-	time_t	t;
-	
-	t = parse_ts_to_time(ts);
 	if (t)
-		return (handle_loot_time(t, line, ts));
-	return (legacy_pending_kill(line, ts));
+		return (handle_loot_time(c, t, line, ts));
+	return (legacy_pending_kill(c, line, ts));
 }
 
-static void	update_combat_time(const char *ts)
+static void	update_combat_time(t_hunt_rules_ctx *c, time_t t)
 {
-	time_t	t;
-	
-	t = parse_ts_to_time(ts);
 	if (t)
-		g_last_combat_t = t;
-}
-
-static int	is_shot_strict(const char *line)
-{
-	static const char *const	pats[] = {
-		"You inflicted ",
-		"Vous avez infligé ",
-		"The target Dodged your attack",
-		"The target Evaded your attack",
-		"La cible a esquivé votre attaque",
-		"La cible a évité votre attaque",
-		"You missed",
-		"Vous avez raté",
-		"Vous manquez votre cible"
-	};
-	
-	return (contains_any(line, pats, sizeof(pats) / sizeof(pats[0])));
+		c->last_combat_t = (long long)t;
 }
 
-static int	is_shot_critical(const char *line)
+static int	is_shot_critical(const t_pattern_match *m)
 {
-	if (!(strstr(line, "Critical hit") || strstr(line, "Coup critique")))
+	if (!any_of(m, P_CRIT, 2))
 		return (0);
-	if (strstr(line, "You inflicted "))
-		return (1);
-	if (strstr(line, "Vous avez infligé "))
-		return (1);
-	return (0);
+	return (any_of(m, P_INFLICT_EN, 1) || any_of(m, P_INFLICT_FR, 1));
 }
 
-static int	parse_shot_line(const char *line, const char *ts, t_hunt_event *ev)
+static int	parse_shot_line(const t_pattern_match *m, t_hunt_event *ev)
 {
-	if (!is_shot_strict(line) && !is_shot_critical(line))
+	if (!any_of(m, P_SHOT, 9) && !is_shot_critical(m))
 		return (0);
-	update_combat_time(ts);
 	safe_copy(ev->type, sizeof(ev->type), "SHOT");
 	safe_copy(ev->qty, sizeof(ev->qty), "1");
 	return (1);
 }
 
-static const char	*received_start(const char *line)
+static const char	*received_start(const t_pattern_match *m)
 {
-	static const char *const	tok[] = {
-		"You received ",
-		"Vous avez reçu "
-	};
-	
-	return (find_after_token(line, tok, sizeof(tok) / sizeof(tok[0])));
+	return (find_after_token(m, P_RECEIVED, 2));
 }
 
-static const char	*find_value_token(const char *start)
+static const char	*find_value_token(const char *start, size_t *toklen)
 {
 	static const char *const	val[] = {
 		" Value:",
@@ -362,7 +403,10 @@ static const char	*find_value_token(const char *start)
 	{
 		p = strstr(start, val[i]);
 		if (p)
+		{
+			*toklen = strlen(val[i]);
 			return (p);
+		}
 		i++;
 	}
 	return (NULL);
@@ -383,28 +427,6 @@ static int	extract_item_name(const char *start, const char *xpos,
 	return (len > 0);
 }
 
-static const char	*skip_value_token(const char *start, const char *valp)
-{
-	static const char *const	val[] = {
-		" Value:",
-		" Value :",
-		" Valeur:",
-		" Valeur :"
-	};
-	size_t					i;
-	const char				*p;
-	
-	i = 0;
-	while (i < sizeof(val) / sizeof(val[0]))
-	{
-		p = strstr(start, val[i]);
-		if (p == valp)
-			return (p + strlen(val[i]));
-		i++;
-	}
-	return (valp);
-}
-
 static int	set_loot_event(t_hunt_event *ev, const char *item,
 						   int qty, tm_money_t value_uPED)
 {
@@ -442,16 +464,17 @@ static int	get_loot_fields(const char *start, char *item, size_t itemsz,
 	const char	*xpos;
 	const char	*valp;
 	const char	*vstart;
+	size_t		vlen;
 	tm_money_t	v;
 	
 	xpos = strstr(start, " x (");
-	valp = find_value_token(start);
+	valp = find_value_token(start, &vlen);
 	if (!xpos || !valp || xpos >= valp)
 		return (0);
 	if (!extract_item_name(start, xpos, item, itemsz))
 		return (0);
 	*qty = atoi(xpos + (int)strlen(" x ("));
-	vstart = skip_value_token(start, valp);
+	vstart = valp + vlen;
 	while (*vstart && isspace((unsigned char)*vstart))
 		vstart++;
 	v = 0;
@@ -461,23 +484,17 @@ static int	get_loot_fields(const char *start, char *item, size_t itemsz,
 	return (1);
 }
 
-static int	parse_received_loot(const char *line, const char *ts,
-								t_hunt_event *ev)
+static int	parse_received_loot(const char *start, t_hunt_event *ev)
 {
-	const char	*start;
 	char		item[256];
 	int			qty;
 	tm_money_t	value_uPED;
 	
-	start = received_start(line);
-	if (!start)
-		return (0);
 	if (!get_loot_fields(start, item, sizeof(item), &qty, &value_uPED))
 		return (-1);
 	if (strcmp(item, "Vibrant Sweat") == 0)
 		return (set_sweat_event(ev, qty) + 2);
 	set_loot_event(ev, item, qty, value_uPED);
-	(void)ts;
 	return (1);
 }
 
@@ -492,16 +509,15 @@ static int	set_received_other(t_hunt_event *ev, const char *start)
 	return (0);
 }
 
-static int	parse_received_line(const char *line, const char *ts,
-								t_hunt_event *ev)
+static int	parse_received_line(const t_pattern_match *m, t_hunt_event *ev)
 {
 	const char	*start;
 	int			ok;
 	
-	start = received_start(line);
+	start = received_start(m);
 	if (!start)
 		return (0);
-	ok = parse_received_loot(line, ts, ev);
+	ok = parse_received_loot(start, ev);
 	if (ok == 1)
 		return (1);
 	if (ok == 2)
@@ -510,32 +526,30 @@ static int	parse_received_line(const char *line, const char *ts,
 	return (1);
 }
 
-static int	parse_kill_line(const char *line, const char *ts, t_hunt_event *ev)
+static int	parse_kill_line(const t_pattern_match *m, t_hunt_event *ev)
 {
-	static const char *const	tok[] = {
-		"You killed ",
-		"Vous avez tué ",
-		"Vous tuez "
-	};
-	const char					*start;
-	char						mob[256];
+	const char	*start;
+	char		mob[256];
 	
-	start = find_after_token(line, tok, sizeof(tok) / sizeof(tok[0]));
+	start = find_after_token(m, P_KILL, 3);
 	if (!start)
 		return (0);
 	safe_copy(mob, sizeof(mob), start);
 	trim_final_dot(mob);
-	if (ts[0] && strcmp(g_last_kill_ts, ts) != 0)
+	safe_copy(ev->type, sizeof(ev->type), "KILL");
+	safe_copy(ev->name, sizeof(ev->name), mob);
+	return (1);
+}
+
+/* Explicit KILL: dropped if a kill (explicit or inferred) has the same ts. */
+static int	apply_kill(t_hunt_rules_ctx *c, const t_hunt_decoded *d)
+{
+	if (d->ev.ts[0] && strcmp(c->last_kill_ts, d->ev.ts) != 0)
 	{
-		time_t	kt;
-
-		kt = parse_ts_to_time(ts);
-		if (kt)
-			g_last_explicit_kill_t = kt;
-		safe_copy(ev->type, sizeof(ev->type), "KILL");
-		safe_copy(ev->name, sizeof(ev->name), mob);
-		snprintf(g_last_kill_ts, sizeof(g_last_kill_ts), "%s", ts);
-		return (1);
+		if (d->t)
+			c->last_explicit_kill_t = d->t;
+		snprintf(c->last_kill_ts, sizeof(c->last_kill_ts), "%s", d->ev.ts);
+		return (0);
 	}
 	return (-1);
 }
@@ -546,43 +560,147 @@ static int	parse_kill_line(const char *line, const char *ts, t_hunt_event *ev)
 
 int	hunt_should_ignore_line(const char *line)
 {
+	t_pattern_match	m;
+
 	if (!line || !*line)
 		return (1);
-	if (strstr(line, "[Rookie]") != NULL)
-		return (1);
-	if (strstr(line, "[Débutant]") != NULL)
-		return (1);
-	if (strstr(line, "[#"))
-		return (1);
-	if (strstr(line, "[ROCKtropia") != NULL)
-		return (1);
-	if (strstr(line, "[HyperStim") != NULL)
-		return (1);
-	return (0);
+	rules_scan(line, &m);
+	return (any_of(&m, P_IGNORE, 5));
 }
 
-int	hunt_parse_line(const char *line_in, t_hunt_event *ev)
+t_hunt_line_kind	hunt_classify_line(const char *line)
 {
-	char	line[MAX_LINE];
-	char	ts[32];
-	int		ret;
-	int		sweat_ret;
-	
-	if (!line_in || !ev)
+	t_pattern_match	m;
+
+	if (!line || !*line)
+		return (HUNT_LINE_NONE);
+	rules_scan(line, &m);
+	if (any_of(&m, P_IGNORE, 5))
+		return (HUNT_LINE_NONE);
+	if (any_of(&m, P_SHOT, 9) || is_shot_critical(&m))
+		return (HUNT_LINE_SHOT);
+	if (received_start(&m))
+		return (HUNT_LINE_RECEIVED);
+	if (find_after_token(&m, P_KILL, 3))
+		return (HUNT_LINE_KILL);
+	return (HUNT_LINE_NONE);
+}
+
+void	hunt_decode_line(const char *line_in, t_hunt_decoded *d)
+{
+	char			line[MAX_LINE];
+	char			ts[32];
+	t_pattern_match	m;
+	int				ret;
+
+	if (!d)
+		return ;
+	d->kind = HUNT_LINE_NONE;
+	d->t = 0;
+	d->ignored = 0;
+	if (!line_in)
+	{
+		zero_event(&d->ev);
+		return ;
+	}
+	safe_copy(line, MAX_LINE, line_in);
+	tm_chomp_crlf(line);
+	/* One automaton pass per line: the channel filter reuses the match. */
+	rules_scan(line, &m);
+	if (!*line_in || any_of(&m, P_IGNORE, 5))
+	{
+		d->ignored = 1;
+		zero_event(&d->ev);
+		return ;
+	}
+	init_event(line, &d->ev, ts);
+	ret = 0;
+	if (parse_shot_line(&m, &d->ev))
+		d->kind = HUNT_LINE_SHOT;
+	else
+		ret = parse_received_line(&m, &d->ev);
+	if (ret)
+		d->kind = (ret == 2) ? HUNT_LINE_SWEAT : HUNT_LINE_RECEIVED;
+	else if (d->kind == HUNT_LINE_NONE && parse_kill_line(&m, &d->ev))
+		d->kind = HUNT_LINE_KILL;
+	if (d->kind != HUNT_LINE_NONE && d->kind != HUNT_LINE_SWEAT)
+		d->t = (long long)parse_ts_to_time(ts);
+}
+
+void	hunt_rules_ctx_init(t_hunt_rules_ctx *c)
+{
+	if (c)
+		memset(c, 0, sizeof(*c));
+}
+
+void	hunt_rules_ctx_set_player_name(t_hunt_rules_ctx *c, const char *name)
+{
+	if (c)
+		safe_copy(c->player_name, sizeof(c->player_name), name);
+}
+
+int	hunt_rules_ctx_apply(t_hunt_rules_ctx *c, t_hunt_decoded *d)
+{
+	if (!c || !d)
 		return (-1);
-	init_event(line_in, ev, line, ts);
-	if (parse_shot_line(line, ts, ev))
-		return (0);
-	sweat_ret = parse_received_line(line, ts, ev);
-	if (sweat_ret)
+	if (d->ignored)
+		return (2);
+	if (d->kind == HUNT_LINE_SHOT)
 	{
-		if (sweat_ret == 2)
-			return (0);
-		ret = maybe_grouped_kill(line, ts);
-		return (ret);
+		update_combat_time(c, (time_t)d->t);
+		return (0);
 	}
-	ret = parse_kill_line(line, ts, ev);
-	if (ret > 0)
+	if (d->kind == HUNT_LINE_SWEAT)
 		return (0);
+	if (d->kind == HUNT_LINE_RECEIVED)
+		return (maybe_grouped_kill(c, (time_t)d->t, d->ev.raw, d->ev.ts));
+	if (d->kind == HUNT_LINE_KILL)
+		return (apply_kill(c, d));
 	return (-1);
-}
\ No newline at end of file
+}
+
+int	hunt_rules_ctx_parse_line(t_hunt_rules_ctx *c, const char *line_in,
+			t_hunt_event *ev)
+{
+	t_hunt_decoded	d;
+	int				ret;
+
+	if (!c || !line_in || !ev)
+		return (-1);
+	hunt_decode_line(line_in, &d);
+	ret = hunt_rules_ctx_apply(c, &d);
+	*ev = d.ev;
+	return (ret);
+}
+
+int	hunt_rules_ctx_pending_pop(t_hunt_rules_ctx *c, t_hunt_event *ev)
+{
+	if (!c || !ev || !c->has_pending)
+		return (0);
+	*ev = c->pending;
+	c->has_pending = 0;
+	memset(&c->pending, 0, sizeof(c->pending));
+	return (1);
+}
+
+/* Context-free API: thin wrappers over g_default_ctx (single parser). */
+
+void	hunt_rules_set_player_name(const char *name)
+{
+	hunt_rules_ctx_set_player_name(&g_default_ctx, name);
+}
+
+int	hunt_apply_decoded(t_hunt_decoded *d)
+{
+	return (hunt_rules_ctx_apply(&g_default_ctx, d));
+}
+
+int	hunt_parse_line(const char *line_in, t_hunt_event *ev)
+{
+	return (hunt_rules_ctx_parse_line(&g_default_ctx, line_in, ev));
+}
+
+int	hunt_pending_pop(t_hunt_event *ev)
+{
+	return (hunt_rules_ctx_pending_pop(&g_default_ctx, ev));
+}
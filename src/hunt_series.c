@@ -13,10 +13,13 @@
 #include "hunt_series.h"
 
 #include "hunt_csv.h"
+#include "hunt_bus.h"
+#include "hunt_bin.h"
 #include "fs_utils.h"
 #include "utils.h"
 
 #include <ctype.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -233,17 +236,6 @@ static int	row_has_value(const t_hunt_csv_row_view *row)
 	return (row->has_value || ((row->flags & 1u) != 0u));
 }
 
-static int	raw_is_hit(const char *raw)
-{
-	if (!raw)
-		return (0);
-	if (strstr(raw, "You inflicted ") != NULL)
-		return (1);
-	if (strstr(raw, "Vous avez inflig") != NULL)
-		return (1);
-	return (0);
-}
-
 static int	looks_like_hunt_csv_header(const char *line)
 {
 	if (!line)
@@ -256,13 +248,99 @@ static int	looks_like_hunt_csv_header(const char *line)
 
 /* -------------------------------------------------------------------------- */
 
-static void	series_clear_all(t_hunt_series *s)
+/* ------------------------------- storage ---------------------------------- */
+
+static int	*ev_int(const t_hs_col *c, int i)
 {
-	int	i;
+	return ((int *)c->chunk[i >> HS_EV_CHUNK_SHIFT] + (i & (HS_EV_CHUNK - 1)));
+}
+
+static tm_money_t	*ev_money(const t_hs_col *c, int i)
+{
+	return ((tm_money_t *)c->chunk[i >> HS_EV_CHUNK_SHIFT]
+		+ (i & (HS_EV_CHUNK - 1)));
+}
+
+static unsigned char	*ev_u8(const t_hs_col *c, int i)
+{
+	return ((unsigned char *)c->chunk[i >> HS_EV_CHUNK_SHIFT]
+		+ (i & (HS_EV_CHUNK - 1)));
+}
+
+/* Room for element 'count' (one more chunk when the last one is full). */
+static int	col_room(t_hs_col *c, int count, size_t elem)
+{
+	void	**p;
+	int		slots;
+
+	if (count < 0 || count == INT_MAX)
+		return (-1);
+	if (count < c->nchunk * HS_EV_CHUNK)
+		return (0);
+	if (c->nchunk == c->slots)
+	{
+		slots = c->slots ? c->slots * 2 : 16;
+		p = (void **)realloc(c->chunk, (size_t)slots * sizeof(*p));
+		if (!p)
+			return (-1);
+		c->chunk = p;
+		c->slots = slots;
+	}
+	c->chunk[c->nchunk] = malloc(elem * (size_t)HS_EV_CHUNK);
+	if (!c->chunk[c->nchunk])
+		return (-1);
+	c->nchunk++;
+	return (0);
+}
+
+static void	col_free(t_hs_col *c)
+{
+	while (c->nchunk > 0)
+		free(c->chunk[--c->nchunk]);
+	free(c->chunk);
+	c->chunk = NULL;
+	c->slots = 0;
+}
+
+static void	series_release(t_hunt_series *s)
+{
+	free(s->buckets);
+	s->buckets = NULL;
+	s->bucket_cap = 0;
+	col_free(&s->kill_ev_sec);
+	col_free(&s->hits_ev_sec);
+	col_free(&s->hits_ev_hits);
+	col_free(&s->shots_ev_sec);
+	col_free(&s->shots_ev_shots);
+	col_free(&s->shots_ev_hits);
+	col_free(&s->loot_ev_sec);
+	col_free(&s->loot_ev_uPED);
+	col_free(&s->loot_ev_group_count);
+	col_free(&s->loot_ev_has_kill);
+}
+
+/* Shared by every series so a reset never reuses a generation a UI cache saw. */
+static void	series_bump_append_gen(t_hunt_series *s)
+{
+	static uint32_t	g_append_gen;
+
+	g_append_gen++;
+	if (g_append_gen == 0)
+		g_append_gen = 1;
+	s->append_gen = g_append_gen;
+}
 
+/*
+ * Nothing is memset: buckets are zeroed when the window grows over them
+ * (ensure_bucket), events are written before their count moves.
+ */
+static void	series_clear_all(t_hunt_series *s)
+{
 	if (!s)
 		return ;
+	series_release(s);
 	s->file_pos = 0;
+	s->data_idx = 0;
 	s->t0 = 0;
 	s->last_t = 0;
 	s->shots_total = 0;
@@ -281,53 +359,48 @@ static void	series_clear_all(t_hunt_series *s)
 	s->last_loot_ev_t = 0;
 	s->last_loot_ev_kill_id = 0;
 	s->version = 0;
-	i = 0;
-	while (i < HS_MAX_POINTS)
-	{
-		s->buckets[i].shots = 0;
-		s->buckets[i].hits = 0;
-		s->buckets[i].kills = 0;
-		s->buckets[i].loot_uPED = 0;
-		s->buckets[i].expense_uPED = 0;
-		i++;
-	}
+	series_bump_append_gen(s);
 }
 
 static void	series_clear_buckets(t_hunt_series *s)
 {
-	int	i;
-
 	if (!s)
 		return ;
 	s->first_bucket = 0;
 	s->count = 0;
-	i = 0;
-	while (i < HS_MAX_POINTS)
-	{
-		s->buckets[i].shots = 0;
-		s->buckets[i].hits = 0;
-		s->buckets[i].kills = 0;
-		s->buckets[i].loot_uPED = 0;
-	s->buckets[i].expense_uPED = 0;
-		i++;
-	}
+	series_bump_append_gen(s);
 }
 
 void	hunt_series_reset(t_hunt_series *s, long start_offset, int bucket_sec)
 {
+	t_hunt_bin_reader	bin;
+
 	if (!s)
 		return ;
+	series_release(s);
+	/* The sidecar reader keeps its names table (checked per generation). */
+	bin = s->bin;
 	memset(s, 0, sizeof(*s));
+	s->bin = bin;
 	s->initialized = 0;
 	s->start_offset = (start_offset < 0) ? 0 : start_offset;
+	s->start_byte = -1;
 	s->bucket_sec = (bucket_sec <= 0) ? 60 : bucket_sec;
 	series_clear_all(s);
 }
 
+void	hunt_series_free(t_hunt_series *s)
+{
+	if (!s)
+		return ;
+	series_clear_all(s);
+	hunt_bin_reader_free(&s->bin);
+	s->initialized = 0;
+}
+
 static void	shift_window_forward(t_hunt_series *s, long new_first)
 {
 	long	shift;
-	int		i;
 
 	shift = new_first - s->first_bucket;
 	if (shift <= 0)
@@ -339,18 +412,30 @@ static void	shift_window_forward(t_hunt_series *s, long new_first)
 	}
 	memmove(&s->buckets[0], &s->buckets[(int)shift],
 		(size_t)(s->count - shift) * sizeof(s->buckets[0]));
-	i = s->count - (int)shift;
-	while (i < HS_MAX_POINTS)
-	{
-		s->buckets[i].shots = 0;
-		s->buckets[i].hits = 0;
-		s->buckets[i].kills = 0;
-		s->buckets[i].loot_uPED = 0;
-		s->buckets[i].expense_uPED = 0;
-		i++;
-	}
 	s->count -= (int)shift;
 	s->first_bucket = new_first;
+	series_bump_append_gen(s);
+}
+
+/* Grows the bucket array to hold n buckets (doubling, <= HS_MAX_POINTS). */
+static int	buckets_reserve(t_hunt_series *s, int n)
+{
+	t_hs_bucket	*p;
+	int			cap;
+
+	if (n <= s->bucket_cap)
+		return (0);
+	cap = s->bucket_cap ? s->bucket_cap : 256;
+	while (cap < n)
+		cap *= 2;
+	if (cap > HS_MAX_POINTS)
+		cap = HS_MAX_POINTS;
+	p = (t_hs_bucket *)realloc(s->buckets, (size_t)cap * sizeof(*p));
+	if (!p)
+		return (-1);
+	s->buckets = p;
+	s->bucket_cap = cap;
+	return (0);
 }
 
 static int	ensure_bucket(t_hunt_series *s, long abs_bucket)
@@ -360,6 +445,9 @@ static int	ensure_bucket(t_hunt_series *s, long abs_bucket)
 
 	if (s->count == 0)
 	{
+		if (buckets_reserve(s, 1) != 0)
+			return (-1);
+		memset(&s->buckets[0], 0, sizeof(s->buckets[0]));
 		s->first_bucket = abs_bucket;
 		s->count = 1;
 		return (0);
@@ -371,103 +459,84 @@ static int	ensure_bucket(t_hunt_series *s, long abs_bucket)
 	local = abs_bucket - s->first_bucket;
 	if (local >= HS_MAX_POINTS)
 		return (-1);
+	/* Out-of-order row: an already plotted bucket changes. */
+	if ((int)local < s->count - 1)
+		series_bump_append_gen(s);
 	if ((int)local >= s->count)
 	{
+		if (buckets_reserve(s, (int)local + 1) != 0)
+			return (-1);
 		i = s->count;
-		while (i <= (int)local && i < HS_MAX_POINTS)
-		{
-			s->buckets[i].shots = 0;
-			s->buckets[i].hits = 0;
-			s->buckets[i].kills = 0;
-			s->buckets[i].loot_uPED = 0;
-			s->buckets[i].expense_uPED = 0;
-			i++;
-		}
+		while (i <= (int)local)
+			memset(&s->buckets[i++], 0, sizeof(s->buckets[0]));
 		s->count = (int)local + 1;
 	}
 	return ((int)local);
 }
 
-static void	push_kill_event(t_hunt_series *s, time_t t)
+/* ------------------------------- events ----------------------------------- */
+
+static int	event_rel_sec(const t_hunt_series *s, time_t t)
 {
 	int	rel;
 
-	if (!s || !s->t0 || !t)
-		return ;
 	rel = 0;
 	if (t > s->t0)
 		rel = (int)(t - s->t0);
 	if (rel < 0)
 		rel = 0;
-	if (s->kill_ev_count < HS_MAX_EVENTS)
-	{
-		s->kill_ev_sec[s->kill_ev_count] = rel;
-		s->kill_ev_count++;
+	return (rel);
+}
+
+static void	push_kill_event(t_hunt_series *s, time_t t)
+{
+	int	i;
+
+	if (!s || !s->t0 || !t)
 		return ;
-	}
-	memmove(&s->kill_ev_sec[0], &s->kill_ev_sec[1],
-		(size_t)(HS_MAX_EVENTS - 1) * sizeof(s->kill_ev_sec[0]));
-	s->kill_ev_sec[HS_MAX_EVENTS - 1] = rel;
+	i = s->kill_ev_count;
+	if (col_room(&s->kill_ev_sec, i, sizeof(int)) != 0)
+		return ;
+	*ev_int(&s->kill_ev_sec, i) = event_rel_sec(s, t);
+	/* First kill: the loot graphs start filtering on has_kill. */
+	if (s->kill_ev_count++ == 0)
+		series_bump_append_gen(s);
 }
 
 static void	push_hits_event(t_hunt_series *s, time_t t, long hits)
 {
-	int	rel;
+	int	i;
 
 	if (!s || !s->t0 || !t)
 		return ;
 	if (hits <= 0)
 		return ;
-	rel = 0;
-	if (t > s->t0)
-		rel = (int)(t - s->t0);
-	if (rel < 0)
-		rel = 0;
-	if (s->hits_ev_count < HS_MAX_EVENTS)
-	{
-		s->hits_ev_sec[s->hits_ev_count] = rel;
-		s->hits_ev_hits[s->hits_ev_count] = (int)hits;
-		s->hits_ev_count++;
+	i = s->hits_ev_count;
+	if (col_room(&s->hits_ev_sec, i, sizeof(int)) != 0
+		|| col_room(&s->hits_ev_hits, i, sizeof(int)) != 0)
 		return ;
-	}
-	memmove(&s->hits_ev_sec[0], &s->hits_ev_sec[1],
-		(size_t)(HS_MAX_EVENTS - 1) * sizeof(s->hits_ev_sec[0]));
-	memmove(&s->hits_ev_hits[0], &s->hits_ev_hits[1],
-		(size_t)(HS_MAX_EVENTS - 1) * sizeof(s->hits_ev_hits[0]));
-	s->hits_ev_sec[HS_MAX_EVENTS - 1] = rel;
-	s->hits_ev_hits[HS_MAX_EVENTS - 1] = (int)hits;
+	*ev_int(&s->hits_ev_sec, i) = event_rel_sec(s, t);
+	*ev_int(&s->hits_ev_hits, i) = (int)hits;
+	s->hits_ev_count++;
 }
 
 static void	push_shots_event(t_hunt_series *s, time_t t, long shots, long hits)
 {
-	int	rel;
+	int	i;
 
 	if (!s || !s->t0 || !t)
 		return ;
 	if (shots <= 0)
 		return ;
-	rel = 0;
-	if (t > s->t0)
-		rel = (int)(t - s->t0);
-	if (rel < 0)
-		rel = 0;
-	if (s->shots_ev_count < HS_MAX_EVENTS)
-	{
-		s->shots_ev_sec[s->shots_ev_count] = rel;
-		s->shots_ev_shots[s->shots_ev_count] = (int)shots;
-		s->shots_ev_hits[s->shots_ev_count] = (int)((hits < 0) ? 0 : hits);
-		s->shots_ev_count++;
+	i = s->shots_ev_count;
+	if (col_room(&s->shots_ev_sec, i, sizeof(int)) != 0
+		|| col_room(&s->shots_ev_shots, i, sizeof(int)) != 0
+		|| col_room(&s->shots_ev_hits, i, sizeof(int)) != 0)
 		return ;
-	}
-	memmove(&s->shots_ev_sec[0], &s->shots_ev_sec[1],
-		(size_t)(HS_MAX_EVENTS - 1) * sizeof(s->shots_ev_sec[0]));
-	memmove(&s->shots_ev_shots[0], &s->shots_ev_shots[1],
-		(size_t)(HS_MAX_EVENTS - 1) * sizeof(s->shots_ev_shots[0]));
-	memmove(&s->shots_ev_hits[0], &s->shots_ev_hits[1],
-		(size_t)(HS_MAX_EVENTS - 1) * sizeof(s->shots_ev_hits[0]));
-	s->shots_ev_sec[HS_MAX_EVENTS - 1] = rel;
-	s->shots_ev_shots[HS_MAX_EVENTS - 1] = (int)shots;
-	s->shots_ev_hits[HS_MAX_EVENTS - 1] = (int)((hits < 0) ? 0 : hits);
+	*ev_int(&s->shots_ev_sec, i) = event_rel_sec(s, t);
+	*ev_int(&s->shots_ev_shots, i) = (int)shots;
+	*ev_int(&s->shots_ev_hits, i) = (int)((hits < 0) ? 0 : hits);
+	s->shots_ev_count++;
 }
 
 static void	mark_loot_has_kill(t_hunt_series *s, time_t t)
@@ -475,81 +544,59 @@ static void	mark_loot_has_kill(t_hunt_series *s, time_t t)
 	if (!s || !t || s->loot_ev_count <= 0)
 		return ;
 	if (s->last_loot_ev_t == t)
-		s->loot_ev_has_kill[s->loot_ev_count - 1] = 1;
+		*ev_u8(&s->loot_ev_has_kill, s->loot_ev_count - 1) = 1;
 }
 
 static void	push_loot_value(t_hunt_series *s, time_t t, int64_t kill_id,
 						tm_money_t v_uPED)
 {
 	int	rel;
+	int	i;
 
 	if (!s || !s->t0 || !t)
 		return ;
-	rel = 0;
-	if (t > s->t0)
-		rel = (int)(t - s->t0);
-	if (rel < 0)
-		rel = 0;
+	rel = event_rel_sec(s, t);
 
 	/* Loot packet grouping:
 	 * - Preferred: group by kill_id (robust with multi-kills/same second)
 	 * - Fallback: if kill_id is missing (0), group by same timestamp second.
 	 */
-	if (s->loot_ev_count > 0)
-	{
-		if (kill_id > 0 && s->last_loot_ev_kill_id == kill_id)
-		{
-				s->loot_ev_uPED[s->loot_ev_count - 1] += v_uPED;
-			s->loot_ev_group_count[s->loot_ev_count - 1]++;
-			return ;
-		}
-		if (kill_id <= 0 && s->last_loot_ev_kill_id <= 0 && s->last_loot_ev_t == t)
-		{
-				s->loot_ev_uPED[s->loot_ev_count - 1] += v_uPED;
-			s->loot_ev_group_count[s->loot_ev_count - 1]++;
-			return ;
-		}
-	}
-
-	if (s->loot_ev_count < HS_MAX_EVENTS)
+	i = s->loot_ev_count - 1;
+	if (i >= 0 && ((kill_id > 0 && s->last_loot_ev_kill_id == kill_id)
+			|| (kill_id <= 0 && s->last_loot_ev_kill_id <= 0
+				&& s->last_loot_ev_t == t)))
 	{
-		s->loot_ev_sec[s->loot_ev_count] = rel;
-		s->loot_ev_uPED[s->loot_ev_count] = v_uPED;
-		s->loot_ev_group_count[s->loot_ev_count] = 1;
-		s->loot_ev_has_kill[s->loot_ev_count] =
-			(kill_id > 0
-				|| (s->kill_ev_count > 0
-					&& s->kill_ev_sec[s->kill_ev_count - 1] == rel)) ? 1 : 0;
-		s->loot_ev_count++;
-		s->last_loot_ev_t = t;
-		s->last_loot_ev_kill_id = kill_id;
+		*ev_money(&s->loot_ev_uPED, i) += v_uPED;
+		(*ev_int(&s->loot_ev_group_count, i))++;
 		return ;
 	}
-	memmove(&s->loot_ev_sec[0], &s->loot_ev_sec[1],
-		(size_t)(HS_MAX_EVENTS - 1) * sizeof(s->loot_ev_sec[0]));
-	memmove(&s->loot_ev_uPED[0], &s->loot_ev_uPED[1],
-		(size_t)(HS_MAX_EVENTS - 1) * sizeof(s->loot_ev_uPED[0]));
-	memmove(&s->loot_ev_group_count[0], &s->loot_ev_group_count[1],
-		(size_t)(HS_MAX_EVENTS - 1) * sizeof(s->loot_ev_group_count[0]));
-	memmove(&s->loot_ev_has_kill[0], &s->loot_ev_has_kill[1],
-		(size_t)(HS_MAX_EVENTS - 1) * sizeof(s->loot_ev_has_kill[0]));
-	s->loot_ev_sec[HS_MAX_EVENTS - 1] = rel;
-	s->loot_ev_uPED[HS_MAX_EVENTS - 1] = v_uPED;
-	s->loot_ev_group_count[HS_MAX_EVENTS - 1] = 1;
-	s->loot_ev_has_kill[HS_MAX_EVENTS - 1] =
-		(kill_id > 0
+	i = s->loot_ev_count;
+	if (col_room(&s->loot_ev_sec, i, sizeof(int)) != 0
+		|| col_room(&s->loot_ev_uPED, i, sizeof(tm_money_t)) != 0
+		|| col_room(&s->loot_ev_group_count, i, sizeof(int)) != 0
+		|| col_room(&s->loot_ev_has_kill, i, sizeof(unsigned char)) != 0)
+		return ;
+	*ev_int(&s->loot_ev_sec, i) = rel;
+	*ev_money(&s->loot_ev_uPED, i) = v_uPED;
+	*ev_int(&s->loot_ev_group_count, i) = 1;
+	*ev_u8(&s->loot_ev_has_kill, i) = (kill_id > 0
 			|| (s->kill_ev_count > 0
-				&& s->kill_ev_sec[s->kill_ev_count - 1] == rel)) ? 1 : 0;
+				&& *ev_int(&s->kill_ev_sec, s->kill_ev_count - 1) == rel))
+		? 1 : 0;
+	s->loot_ev_count++;
 	s->last_loot_ev_t = t;
 	s->last_loot_ev_kill_id = kill_id;
 }
 
 
-static void	process_row_view(t_hunt_series *s, const t_hunt_csv_row_view *row)
+/* hit: SHOT outcome, -1 = read it from row->raw. */
+static void	process_row(t_hunt_series *s, const t_hunt_csv_row_view *row,
+				int hit)
 {
 	time_t	t;
 	long	abs_bucket;
 	int		idx;
+	int		had_logged;
 	tm_money_t	v_uPED;
 
 	if (!s || !row)
@@ -575,7 +622,9 @@ static void	process_row_view(t_hunt_series *s, const t_hunt_csv_row_view *row)
 		s->buckets[idx].shots++;
 		s->shots_total++;
 		s->shots_since_kill++;
-		if (raw_is_hit(row->raw))
+		if (hit < 0)
+			hit = hunt_csv_raw_is_hit(row->raw);
+		if (hit)
 		{
 			s->buckets[idx].hits++;
 			s->hits_total++;
@@ -599,8 +648,12 @@ static void	process_row_view(t_hunt_series *s, const t_hunt_csv_row_view *row)
 	{
 		if (row_has_value(row) && row->value_uPED != 0)
 		{
+			had_logged = (s->expense_total_uPED != 0);
 			s->buckets[idx].expense_uPED = tm_money_add(s->buckets[idx].expense_uPED, row->value_uPED);
 			s->expense_total_uPED = tm_money_add(s->expense_total_uPED, row->value_uPED);
+			/* Cost/ROI switch source for every bucket when this flips. */
+			if (had_logged != (s->expense_total_uPED != 0))
+				series_bump_append_gen(s);
 		}
 		return ;
 	}
@@ -623,32 +676,123 @@ static void	process_row_view(t_hunt_series *s, const t_hunt_csv_row_view *row)
 	}
 }
 
-static long	skip_header_and_offset(FILE *f, long start_offset)
+/* Byte offset of data row start_offset (header skipped), EOF if shorter. */
+static long	skip_header_and_offset(const char *csv_path, long start_offset,
+				long long start_byte)
 {
-	char	buf[4096];
-	long	data_lines;
-	int		first;
-	long	pos_before;
+	t_hunt_csv_cursor	cur;
+	long				pos;
 
-	data_lines = 0;
-	first = 1;
-	while (f && fgets(buf, (int)sizeof(buf), f))
+	if (hunt_csv_cursor_open(&cur, csv_path) != 0)
+		return (0);
+	if (start_offset > 0)
+		(void)hunt_csv_cursor_goto(&cur, (unsigned long long)start_offset,
+			start_byte);
+	pos = (long)hunt_csv_cursor_tell(&cur);
+	hunt_csv_cursor_close(&cur);
+	return (pos);
+}
+
+/* Row published by the LIVE parser (hunt_bus), starting at s->file_pos. */
+static void	bus_apply_row(void *ctx, const t_hunt_csv_row_view *row,
+				long long csv_off)
+{
+	t_hunt_series	*s;
+
+	(void)csv_off;
+	s = (t_hunt_series *)ctx;
+	s->data_idx++;
+	process_row(s, row, -1);
+}
+
+/* Same rules as a CSV row, dispatched on the sidecar record. */
+static void	process_bin_rec(t_hunt_series *s, const t_hunt_bin_rec *rec)
+{
+	t_hunt_csv_row_view	row;
+
+	if (rec->type == HUNT_BIN_INVALID)
+		return ;
+	memset(&row, 0, sizeof(row));
+	row.ts_unix = rec->ts_unix;
+	if (rec->type == HUNT_BIN_OTHER)
+		row.type = hunt_bin_reader_name(&s->bin, rec->type_name_id);
+	else
+		row.type = hunt_bin_type_name((t_hunt_bin_type)rec->type);
+	row.name = hunt_bin_reader_name(&s->bin, rec->name_id);
+	row.qty = rec->qty;
+	row.value_uPED = rec->value_uPED;
+	row.has_value = rec->has_value;
+	row.kill_id = rec->kill_id;
+	row.flags = rec->flags;
+	process_row(s, &row, (rec->bits & HUNT_BIN_HIT) != 0);
+}
+
+/*
+ * Sidecar records [s->data_idx, end) (end = -1: up to the last one), with
+ * file_pos/data_idx moved past each of them. Returns the rows processed,
+ * -1 if the sidecar is unusable (the caller reads the CSV instead).
+ */
+static long	series_read_bin(t_hunt_series *s, long end)
+{
+	const t_hunt_bin_rec	*recs;
+	long long				count;
+	size_t					n;
+	size_t					i;
+	long					done;
+
+	count = hunt_bin_reader_count(&s->bin);
+	if (count < 0)
+		return (-1);
+	if (end >= 0 && count > end)
+		count = end;
+	done = 0;
+	while (count > s->data_idx)
 	{
-		pos_before = ftell(f) - (long)strlen(buf);
-		if (first)
-		{
-			first = 0;
-			if (looks_like_hunt_csv_header(buf))
-				continue ;
-		}
-		if (data_lines == start_offset)
-		{
-			fseek(f, pos_before, SEEK_SET);
+		n = hunt_bin_reader_read(&s->bin, (unsigned long long)s->data_idx,
+				(size_t)(count - s->data_idx), &recs);
+		if (n == 0)
 			break ;
+		i = 0;
+		while (i < n)
+		{
+			if (recs[i].type != HUNT_BIN_INVALID)
+			{
+				process_bin_rec(s, &recs[i]);
+				done++;
+			}
+			s->file_pos = (long)(recs[i].csv_off + recs[i].csv_len);
+			s->data_idx++;
+			i++;
 		}
-		data_lines++;
 	}
-	return (ftell(f));
+	return (done);
+}
+
+/*
+ * Fast path: consume the rows already mirrored in the binary sidecar
+ * (record i = data row i), then let the CSV loop pick up whatever is left.
+ */
+static int	series_update_bin(t_hunt_series *s, const char *csv_path)
+{
+	const t_hunt_bin_rec	*recs;
+	long					done;
+
+	if (hunt_bin_reader_open(&s->bin, csv_path) != 0)
+		return (0);
+	if (!s->initialized && hunt_bin_reader_count(&s->bin) > s->start_offset
+		&& hunt_bin_reader_read(&s->bin, (unsigned long long)s->start_offset,
+			1, &recs) == 1)
+	{
+		series_clear_all(s);
+		s->file_pos = (long)recs[0].csv_off;
+		s->data_idx = s->start_offset;
+		s->initialized = 1;
+	}
+	done = 0;
+	if (s->initialized)
+		done = series_read_bin(s, -1);
+	hunt_bin_reader_close(&s->bin);
+	return (done > 0 ? (int)done : 0);
 }
 
 int	hunt_series_update(t_hunt_series *s, const char *csv_path)
@@ -664,25 +808,34 @@ int	hunt_series_update(t_hunt_series *s, const char *csv_path)
 	if (!s || !csv_path)
 		return (0);
 	sz = fs_file_size(csv_path);
-	if (sz >= 0 && s->file_pos > sz)
+	/* Past EOF but still in the parser's buffer (bus): not a truncation. */
+	if (sz >= 0 && s->file_pos > sz && !hunt_bus_covers(s->file_pos))
+	{
 		s->initialized = 0;
+		s->start_byte = -1;
+	}
+	rows_ok = 0;
+	if (s->initialized)
+		rows_ok += hunt_bus_drain(HUNT_BUS_SERIES, &s->file_pos,
+				bus_apply_row, s);
+	rows_ok += series_update_bin(s, csv_path);
 	f = fs_fopen_shared_read(csv_path);
 	if (!f)
 		return (0);
 	if (!s->initialized)
 	{
 		series_clear_all(s);
-		pos = skip_header_and_offset(f, s->start_offset);
+		pos = skip_header_and_offset(csv_path, s->start_offset,
+				s->start_byte);
 		if (pos < 0)
 			pos = 0;
 		s->file_pos = pos;
+		s->data_idx = s->start_offset;
 		s->initialized = 1;
 	}
-	else
-		fseek(f, s->file_pos, SEEK_SET);
+	fseek(f, s->file_pos, SEEK_SET);
 
 	first = 1;
-	rows_ok = 0;
 	while (fgets(line, (int)sizeof(line), f))
 	{
 		/* Protect against gigantic lines */
@@ -694,14 +847,18 @@ int	hunt_series_update(t_hunt_series *s, const char *csv_path)
 			continue ;
 		}
 		first = 0;
+		/* Data row index (header excluded): where the sidecar resumes. */
+		s->data_idx++;
 		/* V2 parsing in-place (plus rapide: pas de copie) */
 		if (!hunt_csv_parse_row_inplace(line, &row))
 			continue ;	/* ignore malformed */
-		process_row_view(s, &row);
+		process_row(s, &row, -1);
 		rows_ok++;
 	}
 	s->file_pos = ftell(f);
 	fclose(f);
+	rows_ok += hunt_bus_drain(HUNT_BUS_SERIES, &s->file_pos,
+			bus_apply_row, s);
 	if (rows_ok > 0)
 		s->version++;
 	return (1);
@@ -713,10 +870,19 @@ int	hunt_series_rebuild_range(t_hunt_series *s,
 					long end_line,
 					int bucket_sec)
 {
-	FILE					*f;
-	char					line[4096];
-	long					data_idx;
-	int					first;
+	return (hunt_series_rebuild_range_at(s, csv_path, start_line, -1,
+			end_line, bucket_sec));
+}
+
+int	hunt_series_rebuild_range_at(t_hunt_series *s,
+					const char *csv_path,
+					long start_line,
+					long long start_byte,
+					long end_line,
+					int bucket_sec)
+{
+	t_hunt_csv_cursor	cur;
+	int					rc;
 	t_hunt_csv_row_view	row;
 
 	if (!s || !csv_path)
@@ -730,39 +896,42 @@ int	hunt_series_rebuild_range(t_hunt_series *s,
 	/* We rebuild from scratch, so ignore incremental cursor. */
 	s->initialized = 1;
 	s->file_pos = 0;
+	s->data_idx = start_line;
 
-	f = fs_fopen_shared_read(csv_path);
-	if (!f)
+	/* Sidecar first, the CSV only for the rows it does not hold (yet). */
+	if (hunt_bin_reader_open(&s->bin, csv_path) == 0)
+	{
+		if (series_read_bin(s, end_line) > 0)
+			s->version++;
+		hunt_bin_reader_close(&s->bin);
+	}
+	if (end_line >= 0 && s->data_idx >= end_line)
+	{
+		s->version++;
+		return (1);
+	}
+	if (s->data_idx > start_line)
+		start_byte = s->file_pos;
+	if (hunt_csv_cursor_open(&cur, csv_path) != 0)
 		return (0);
-	data_idx = 0;
-	first = 1;
-	while (fgets(line, (int)sizeof(line), f))
+	/* Range bounds on DATA rows (header ignored); skipped rows are not parsed */
+	s->data_idx = (long)hunt_csv_cursor_goto(&cur,
+			(unsigned long long)s->data_idx, start_byte);
+	while (end_line < 0 || s->data_idx < end_line)
 	{
-		line[sizeof(line) - 1] = '\0';
-		/* Skip CSV header once */
-		if (first && looks_like_hunt_csv_header(line))
-		{
-			first = 0;
-			continue ;
-		}
-		first = 0;
-		/* Apply range bounds on DATA lines (header ignored) */
-		if (data_idx < start_line)
-		{
-			data_idx++;
-			continue ;
-		}
-		if (end_line >= 0 && data_idx >= end_line)
+		rc = hunt_csv_cursor_next_row(&cur, &row);
+		if (rc < 0)
 			break ;
-		/* Parse + process if valid; malformed lines still count in data_idx */
-		if (hunt_csv_parse_row_inplace(line, &row))
+		/* malformed rows still count in data_idx */
+		if (rc == 1)
 		{
-			process_row_view(s, &row);
+			process_row(s, &row, -1);
 			s->version++;
 		}
-		data_idx++;
+		s->data_idx++;
 	}
-	fclose(f);
+	s->file_pos = (long)hunt_csv_cursor_tell(&cur);
+	hunt_csv_cursor_close(&cur);
 	s->version++;
 	return (1);
 }
@@ -782,21 +951,25 @@ int	hunt_series_sanity_check(const t_hunt_series *s)
 		return (0);
 	if (s->bucket_sec <= 0)
 		return (0);
-	if (s->count < 0 || s->count > HS_MAX_POINTS)
+	if (s->count < 0 || s->count > HS_MAX_POINTS || s->count > s->bucket_cap)
 		return (0);
-	if (s->kill_ev_count < 0 || s->kill_ev_count > HS_MAX_EVENTS)
+	if (s->kill_ev_count < 0
+		|| s->kill_ev_count > s->kill_ev_sec.nchunk * HS_EV_CHUNK)
 		return (0);
-	if (s->hits_ev_count < 0 || s->hits_ev_count > HS_MAX_EVENTS)
+	if (s->hits_ev_count < 0
+		|| s->hits_ev_count > s->hits_ev_sec.nchunk * HS_EV_CHUNK)
 		return (0);
-	if (s->shots_ev_count < 0 || s->shots_ev_count > HS_MAX_EVENTS)
+	if (s->shots_ev_count < 0
+		|| s->shots_ev_count > s->shots_ev_sec.nchunk * HS_EV_CHUNK)
 		return (0);
-	if (s->loot_ev_count < 0 || s->loot_ev_count > HS_MAX_EVENTS)
+	if (s->loot_ev_count < 0
+		|| s->loot_ev_count > s->loot_ev_sec.nchunk * HS_EV_CHUNK)
 		return (0);
 	/* Ensure loot group counts are always positive for stored events. */
 	i = 0;
 	while (i < s->loot_ev_count)
 	{
-		if (s->loot_ev_group_count[i] <= 0)
+		if (*ev_int(&s->loot_ev_group_count, i) <= 0)
 			return (0);
 		i++;
 	}
@@ -1144,11 +1317,11 @@ int	hunt_series_build_kill_events(const t_hunt_series *s, int last_minutes,
 	start = 0;
 	if (last_minutes > 0)
 	{
-		end_sec = s->kill_ev_sec[s->kill_ev_count - 1];
+		end_sec = *ev_int(&s->kill_ev_sec, s->kill_ev_count - 1);
 		min_sec = end_sec - (last_minutes * 60);
 		if (min_sec < 0)
 			min_sec = 0;
-		while (start < s->kill_ev_count && s->kill_ev_sec[start] < min_sec)
+		while (start < s->kill_ev_count && *ev_int(&s->kill_ev_sec, start) < min_sec)
 			start++;
 	}
 	n = 0;
@@ -1156,7 +1329,7 @@ int	hunt_series_build_kill_events(const t_hunt_series *s, int last_minutes,
 	i = start;
 	while (i < s->kill_ev_count && n < HS_MAX_POINTS)
 	{
-		out_x_seconds[n] = s->kill_ev_sec[i];
+		out_x_seconds[n] = *ev_int(&s->kill_ev_sec, i);
 		out_values[n] = (double)(i + 1);
 		if (out_values[n] > vmax)
 			vmax = out_values[n];
@@ -1188,11 +1361,11 @@ int	hunt_series_build_hits_events(const t_hunt_series *s, int last_minutes,
 	start = 0;
 	if (last_minutes > 0)
 	{
-		end_sec = s->hits_ev_sec[s->hits_ev_count - 1];
+		end_sec = *ev_int(&s->hits_ev_sec, s->hits_ev_count - 1);
 		min_sec = end_sec - (last_minutes * 60);
 		if (min_sec < 0)
 			min_sec = 0;
-		while (start < s->hits_ev_count && s->hits_ev_sec[start] < min_sec)
+		while (start < s->hits_ev_count && *ev_int(&s->hits_ev_sec, start) < min_sec)
 			start++;
 	}
 	n = 0;
@@ -1200,13 +1373,13 @@ int	hunt_series_build_hits_events(const t_hunt_series *s, int last_minutes,
 	i = start;
 	while (i < s->hits_ev_count && n < HS_MAX_POINTS)
 	{
-		if (s->hits_ev_hits[i] <= 0)
+		if (*ev_int(&s->hits_ev_hits, i) <= 0)
 		{
 			i++;
 			continue ;
 		}
-		out_x_seconds[n] = s->hits_ev_sec[i];
-		out_values[n] = (double)s->hits_ev_hits[i];
+		out_x_seconds[n] = *ev_int(&s->hits_ev_sec, i);
+		out_values[n] = (double)*ev_int(&s->hits_ev_hits, i);
 		if (out_values[n] > vmax)
 			vmax = out_values[n];
 		n++;
@@ -1237,11 +1410,11 @@ int	hunt_series_build_shots_events(const t_hunt_series *s, int last_minutes,
 	start = 0;
 	if (last_minutes > 0)
 	{
-		end_sec = s->shots_ev_sec[s->shots_ev_count - 1];
+		end_sec = *ev_int(&s->shots_ev_sec, s->shots_ev_count - 1);
 		min_sec = end_sec - (last_minutes * 60);
 		if (min_sec < 0)
 			min_sec = 0;
-		while (start < s->shots_ev_count && s->shots_ev_sec[start] < min_sec)
+		while (start < s->shots_ev_count && *ev_int(&s->shots_ev_sec, start) < min_sec)
 			start++;
 	}
 	n = 0;
@@ -1249,13 +1422,13 @@ int	hunt_series_build_shots_events(const t_hunt_series *s, int last_minutes,
 	i = start;
 	while (i < s->shots_ev_count && n < HS_MAX_POINTS)
 	{
-		if (s->shots_ev_shots[i] <= 0)
+		if (*ev_int(&s->shots_ev_shots, i) <= 0)
 		{
 			i++;
 			continue ;
 		}
-		out_x_seconds[n] = s->shots_ev_sec[i];
-		out_values[n] = (double)s->shots_ev_shots[i];
+		out_x_seconds[n] = *ev_int(&s->shots_ev_sec, i);
+		out_values[n] = (double)*ev_int(&s->shots_ev_shots, i);
 		if (out_values[n] > vmax)
 			vmax = out_values[n];
 		n++;
@@ -1289,11 +1462,11 @@ int	hunt_series_build_hit_rate_events(const t_hunt_series *s, int last_minutes,
 	start = 0;
 	if (last_minutes > 0)
 	{
-		end_sec = s->shots_ev_sec[s->shots_ev_count - 1];
+		end_sec = *ev_int(&s->shots_ev_sec, s->shots_ev_count - 1);
 		min_sec = end_sec - (last_minutes * 60);
 		if (min_sec < 0)
 			min_sec = 0;
-		while (start < s->shots_ev_count && s->shots_ev_sec[start] < min_sec)
+		while (start < s->shots_ev_count && *ev_int(&s->shots_ev_sec, start) < min_sec)
 			start++;
 	}
 	n = 0;
@@ -1301,8 +1474,8 @@ int	hunt_series_build_hit_rate_events(const t_hunt_series *s, int last_minutes,
 	i = start;
 	while (i < s->shots_ev_count && n < HS_MAX_POINTS)
 	{
-		shots = (double)s->shots_ev_shots[i];
-		hits = (double)s->shots_ev_hits[i];
+		shots = (double)*ev_int(&s->shots_ev_shots, i);
+		hits = (double)*ev_int(&s->shots_ev_hits, i);
 		if (shots <= 0.0)
 		{
 			i++;
@@ -1313,7 +1486,7 @@ int	hunt_series_build_hit_rate_events(const t_hunt_series *s, int last_minutes,
 			rate = 0.0;
 		if (rate > 100.0)
 			rate = 100.0;
-		out_x_seconds[n] = s->shots_ev_sec[i];
+		out_x_seconds[n] = *ev_int(&s->shots_ev_sec, i);
 		out_values[n] = rate;
 		if (out_values[n] > vmax)
 			vmax = out_values[n];
@@ -1349,11 +1522,11 @@ int	hunt_series_build_loot_events_ex(const t_hunt_series *s, int last_minutes,
 	start = 0;
 	if (last_minutes > 0)
 	{
-		end_sec = s->loot_ev_sec[s->loot_ev_count - 1];
+		end_sec = *ev_int(&s->loot_ev_sec, s->loot_ev_count - 1);
 		min_sec = end_sec - (last_minutes * 60);
 		if (min_sec < 0)
 			min_sec = 0;
-		while (start < s->loot_ev_count && s->loot_ev_sec[start] < min_sec)
+		while (start < s->loot_ev_count && *ev_int(&s->loot_ev_sec, start) < min_sec)
 			start++;
 	}
 	has_kills = (s->kill_ev_count > 0);
@@ -1363,8 +1536,8 @@ int	hunt_series_build_loot_events_ex(const t_hunt_series *s, int last_minutes,
 		i = 0;
 		while (i < start)
 		{
-			if (s->loot_ev_uPED[i] > 0 && (!has_kills || s->loot_ev_has_kill[i]))
-				acc_uPED += s->loot_ev_uPED[i];
+			if (*ev_money(&s->loot_ev_uPED, i) > 0 && (!has_kills || *ev_u8(&s->loot_ev_has_kill, i)))
+				acc_uPED += *ev_money(&s->loot_ev_uPED, i);
 			i++;
 		}
 	}
@@ -1373,21 +1546,21 @@ int	hunt_series_build_loot_events_ex(const t_hunt_series *s, int last_minutes,
 	i = start;
 	while (i < s->loot_ev_count && n < HS_MAX_POINTS)
 	{
-		if (!(s->loot_ev_uPED[i] > 0 && (!has_kills || s->loot_ev_has_kill[i])))
+		if (!(*ev_money(&s->loot_ev_uPED, i) > 0 && (!has_kills || *ev_u8(&s->loot_ev_has_kill, i))))
 		{
 			i++;
 			continue ;
 		}
-		out_x_seconds[n] = s->loot_ev_sec[i];
+		out_x_seconds[n] = *ev_int(&s->loot_ev_sec, i);
 		if (out_group_counts)
-			out_group_counts[n] = s->loot_ev_group_count[i] > 0 ? s->loot_ev_group_count[i] : 1;
+			out_group_counts[n] = *ev_int(&s->loot_ev_group_count, i) > 0 ? *ev_int(&s->loot_ev_group_count, i) : 1;
 		if (cumulative)
 		{
-			acc_uPED += s->loot_ev_uPED[i];
+			acc_uPED += *ev_money(&s->loot_ev_uPED, i);
 			out_values[n] = tm_money_to_ped_double(acc_uPED);
 		}
 		else
-			out_values[n] = tm_money_to_ped_double(s->loot_ev_uPED[i]);
+			out_values[n] = tm_money_to_ped_double(*ev_money(&s->loot_ev_uPED, i));
 		if (out_values[n] > vmax)
 			vmax = out_values[n];
 		n++;
@@ -65,6 +65,7 @@ static void	range_normalize(long *start, long *end_raw)
 
 void	hunt_series_live_tick(void)
 {
+	t_session_anchor	anchor;
 	long	offset;
 	long	r_start;
 	long	r_end_raw;
@@ -75,9 +76,9 @@ void	hunt_series_live_tick(void)
 	int		ok;
 
 	/* If the user loaded a session range, Graph LIVE must follow that range. */
-	r_start = 0;
-	r_end_raw = -1;
-	range_on = session_load_range(tm_path_session_range(), &r_start, &r_end_raw);
+	range_on = session_load_range_anchor(tm_path_session_range(), &anchor,
+			&r_end_raw);
+	r_start = anchor.line;
 	if (range_on)
 	{
 		range_normalize(&r_start, &r_end_raw);
@@ -102,8 +103,9 @@ void	hunt_series_live_tick(void)
 			}
 			if (r_end_resolved < r_start)
 				r_end_resolved = r_start;
-			ok = hunt_series_rebuild_range(&g_hs, tm_path_hunt_csv(),
-				r_start, r_end_resolved, 60);
+			ok = hunt_series_rebuild_range_at(&g_hs, tm_path_hunt_csv(),
+				r_start, session_anchor_resolve(tm_path_hunt_csv(), &anchor),
+				r_end_resolved, 60);
 			g_ready = ok ? 1 : 0;
 			g_last_mode = 1;
 			g_last_range_start = r_start;
@@ -123,10 +125,12 @@ void	hunt_series_live_tick(void)
 		return ;
 	}
 
-	offset = session_load_offset(tm_path_session_offset());
+	(void)session_load_offset_anchor(tm_path_session_offset(), &anchor);
+	offset = anchor.line;
 	if (!g_ready || g_last_mode != 0 || offset != g_last_offset)
 	{
 		hunt_series_reset(&g_hs, offset, 60);
+		g_hs.start_byte = session_anchor_resolve(tm_path_hunt_csv(), &anchor);
 		g_last_offset = offset;
 		g_ready = 1;
 		g_last_mode = 0;
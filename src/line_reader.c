@@ -0,0 +1,145 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   line_reader.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: login <login@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/20 00:00:00 by login             #+#    #+#             */
+/*   Updated: 2026/02/20 00:00:00 by login            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "line_reader.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+int	line_reader_init(t_line_reader *r, FILE *f, size_t block)
+{
+	if (!r)
+		return (-1);
+	memset(r, 0, sizeof(*r));
+	if (!f)
+		return (-1);
+	if (block == 0)
+		block = LINE_READER_BLOCK;
+	r->buf = (char *)malloc(block + 1);
+	if (!r->buf)
+		return (-1);
+	r->f = f;
+	r->cap = block;
+	return (0);
+}
+
+void	line_reader_free(t_line_reader *r)
+{
+	if (!r)
+		return ;
+	free(r->buf);
+	memset(r, 0, sizeof(*r));
+}
+
+static void	restore_nul(t_line_reader *r)
+{
+	if (!r->nul_active)
+		return ;
+	r->buf[r->nul_pos] = r->nul_saved;
+	r->nul_active = 0;
+}
+
+/*
+ * Makes room after 'end': first slides the unread tail to the front, then
+ * doubles the buffer if the pending line alone fills it.
+ */
+static int	make_room(t_line_reader *r)
+{
+	size_t	pending;
+	char	*nb;
+
+	pending = r->end - r->start;
+	if (r->start > 0)
+	{
+		memmove(r->buf, r->buf + r->start, pending);
+		r->start = 0;
+		r->end = pending;
+	}
+	if (r->end < r->cap)
+		return (0);
+	nb = (char *)realloc(r->buf, r->cap * 2 + 1);
+	if (!nb)
+		return (-1);
+	r->buf = nb;
+	r->cap *= 2;
+	return (0);
+}
+
+/* Returns bytes read (0 at EOF), -1 on error. */
+static long	fill(t_line_reader *r)
+{
+	size_t	n;
+
+	if (r->eof)
+		return (0);
+	if (make_room(r) != 0)
+		return (-1);
+	n = fread(r->buf + r->end, 1, r->cap - r->end, r->f);
+	if (n == 0)
+	{
+		r->eof = 1;
+		return (ferror(r->f) ? -1 : 0);
+	}
+	r->end += n;
+	return ((long)n);
+}
+
+static void	emit(t_line_reader *r, size_t len, t_line_view *out)
+{
+	size_t	pos;
+
+	pos = r->start + len;
+	/* buf has cap + 1 bytes, so 'pos' is always addressable */
+	r->nul_pos = pos;
+	r->nul_saved = r->buf[pos];
+	r->nul_active = 1;
+	r->buf[pos] = '\0';
+	out->ptr = r->buf + r->start;
+	out->len = len;
+	r->start = pos;
+	r->bytes += len;
+}
+
+int	line_reader_next(t_line_reader *r, t_line_view *out)
+{
+	const char	*nl;
+	size_t		scanned;
+	long		got;
+
+	if (!r || !r->buf || !out)
+		return (-1);
+	restore_nul(r);
+	scanned = 0;
+	while (1)
+	{
+		nl = memchr(r->buf + r->start + scanned, '\n',
+				r->end - r->start - scanned);
+		if (nl)
+		{
+			emit(r, (size_t)(nl - (r->buf + r->start)) + 1, out);
+			return (1);
+		}
+		scanned = r->end - r->start;
+		got = fill(r);
+		if (got < 0)
+			return (-1);
+		if (got == 0)
+			break ;
+	}
+	/* EOF: last line without '\n' */
+	if (r->end > r->start)
+	{
+		emit(r, r->end - r->start, out);
+		return (1);
+	}
+	return (0);
+}
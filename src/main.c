@@ -27,6 +27,8 @@
 
 /* Health (operational trust) */
 #include "monitor_health.h"
+#include "tm_wake.h"
+#include "chat_ingest.h"
 
 #include "screen_graph_live.h"
 #include "hunt_series_live.h"
@@ -36,7 +38,7 @@
 #include "parser_thread.h"
 #include "globals_thread.h"
 #include "tracker_stats.h"
-#include "globals_stats.h"
+#include "globals_stats_live.h"
 #include "session.h"
 #include "session_export.h"
 #include "sessions_catalog.h"
@@ -50,6 +52,8 @@
 #include "chatlog_path.h"
 #include "core_paths.h"
 #include "fs_utils.h"
+#include "refresh_sched.h"
+#include "hunt_bus.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -82,8 +86,11 @@ typedef struct s_app
 	int			globals_mode_live;
 	uint64_t	session_start_ms;
 
-	/* caches */
-	uint64_t	last_refresh_ms;
+	/* caches (refreshed by app_refresh_cached when their source changed) */
+	t_refresh_sched	refresh;
+	int			refresh_series;
+	int			refresh_stats;
+	unsigned long long	bus_seen;   /* hunt_bus_version() already handled */
 	long		last_offset;
 	t_hunt_stats	hunt_stats;
 	int			hunt_stats_ok;
@@ -94,18 +101,21 @@ typedef struct s_app
 	int			sweat_enabled;
 
 	/* feed */
+	t_fs_tail	hunt_tail;
 	char		hunt_feed_buf[32][256];
 	const char	*hunt_feed_lines[32];
 	int			hunt_feed_n;
 	int			hunt_feed_scroll;
 	int			hunt_info_scroll;
 
+	t_fs_tail	globals_tail;
 	char		globals_feed_buf[24][256];
 	const char	*globals_feed_lines[24];
 	int			globals_feed_n;
 	int			globals_feed_scroll;
 	int			globals_info_scroll;
 
+	t_fs_tail	sessions_tail;
 	char		sessions_feed_buf[20][256];
 	const char	*sessions_feed_lines[20];
 	int			sessions_feed_n;
@@ -387,136 +397,233 @@ static int	csv_format_line(char *dst, size_t dstsz, const char *line)
 	}
 }
 
-static int	file_tail_csv_formatted(const char *path, int max_lines,
-							  char out[][256], int out_cap, int *out_n)
+/*
+ * Last max_lines lines of a CSV, formatted (header skipped). The tail is
+ * read backwards from EOF and cached by (size, mtime): an unchanged file
+ * costs one stat() and keeps the previous out[] as is.
+ */
+static int	file_tail_csv_formatted(t_fs_tail *tail, const char *path,
+							  int max_lines, char out[][256], int out_cap, int *out_n)
 {
-	FILE	*f;
-	char	line[1024];
-	char	ring[64][1024];
-	int		count;
-	int		idx;
-	int		i;
-	int		start;
+	int		rc;
+	int		first;
 	int		n;
-	int		seen_header;
+	int		i;
 
-	if (out_n)
-		*out_n = 0;
-	if (!path || max_lines <= 0 || !out || out_cap <= 0 || !out_n)
+	if (!tail || !path || max_lines <= 0 || !out || out_cap <= 0 || !out_n)
 		return (0);
-	f = fs_fopen_shared_read(path);
-	if (!f)
+	if (max_lines > FS_TAIL_MAX_LINES - 1)
+		max_lines = FS_TAIL_MAX_LINES - 1;
+	/* one extra line: the header is dropped if the tail reaches it */
+	rc = fs_tail_read(tail, path, max_lines + 1);
+	if (rc == 0)
+		return (*out_n > 0);
+	*out_n = 0;
+	if (rc < 0)
 		return (0);
-	if (max_lines > 64)
-		max_lines = 64;
-	count = 0;
-	idx = 0;
-	seen_header = 0;
-	while (fgets(line, (int)sizeof(line), f))
-	{
-		if (!seen_header)
-		{
-			seen_header = 1;
-			if (looks_like_any_csv_header(line))
-				continue ;
-		}
-		snprintf(ring[idx], sizeof(ring[idx]), "%s", line);
-		idx = (idx + 1) % max_lines;
-		if (count < max_lines)
-			count++;
-	}
-	fclose(f);
-	start = (count == max_lines) ? idx : 0;
-	n = (count < out_cap) ? count : out_cap;
+	first = 0;
+	if (tail->at_start && tail->n > 0
+		&& looks_like_any_csv_header(tail->lines[0]))
+		first = 1;
+	if (tail->n - first > max_lines)
+		first = tail->n - max_lines;
+	n = tail->n - first;
+	if (n > out_cap)
+		n = out_cap;
 	i = 0;
 	while (i < n)
 	{
-		int src = (start + i) % max_lines;
-		csv_format_line(out[i], 256, ring[src]);
+		csv_format_line(out[i], 256, tail->lines[first + i]);
 		i++;
 	}
 	*out_n = n;
 	return (n > 0);
 }
 
-static void	app_refresh_cached(t_app *app)
+/* -------------------------------------------------------------------------- */
+/* Cache refresh: one source per input, probed every 250 ms                    */
+/* -------------------------------------------------------------------------- */
+
+static uint64_t	probe_config(void *ctx)
 {
-	uint64_t	now;
-	long		offset;
-	int		need;
+	uint64_t	h;
 
-	if (!app)
-		return ;
-	now = ft_time_ms();
-	need = (app->last_refresh_ms == 0 || (now - app->last_refresh_ms) > 250);
-	if (!need)
-		return ;
-	app->last_refresh_ms = now;
+	(void)ctx;
+	h = refresh_sig_file(refresh_sig_begin(), tm_path_weapon_selected());
+	return (refresh_sig_file(h, tm_path_options_cfg()));
+}
 
-	/*
-	 * Graphe LIVE: maintient un cache serie "chaud" en arriere-plan.
-	 * (Le screen Graph LIVE l'utilise ensuite sans re-initialisation.)
-	 */
-	if (parser_thread_is_running())
-		hunt_series_live_tick();
+static void	refresh_config(void *ctx)
+{
+	t_app	*app;
 
-	/* weapon */
+	app = (t_app *)ctx;
 	app->weapon_name[0] = '\0';
 	weapon_selected_load(tm_path_weapon_selected(), app->weapon_name, sizeof(app->weapon_name));
-
-	/* sweat */
 	app->sweat_enabled = 0;
 	sweat_option_load(tm_path_options_cfg(), &app->sweat_enabled);
+}
 
-	/* offset + stats (range view if a session is loaded) */
-	offset = session_load_offset(tm_path_session_offset());
-	app->last_offset = offset;
+/* Everything the stats / series live ticks read, plus the parser flush counter. */
+static uint64_t	probe_hunt(void *ctx)
+{
+	uint64_t	h;
 
-	/* Live stats cache (no rescans): follows offset or an optional loaded range. */
+	(void)ctx;
+	h = refresh_sig_u64(refresh_sig_begin(), monitor_health_csv_version());
+	h = refresh_sig_file(h, tm_path_hunt_csv());
+	h = refresh_sig_file(h, tm_path_session_offset());
+	h = refresh_sig_file(h, tm_path_session_range());
+	h = refresh_sig_file(h, tm_path_options_cfg());
+	return (refresh_sig_file(h, tm_path_weapon_selected()));
+}
+
+static uint64_t	probe_series(void *ctx)
+{
+	return (refresh_sig_u64(probe_hunt(ctx),
+			(uint64_t)parser_thread_is_running()));
+}
+
+/*
+ * Graphe LIVE: maintient un cache serie "chaud" en arriere-plan.
+ * (Le screen Graph LIVE l'utilise ensuite sans re-initialisation.)
+ */
+static void	refresh_series(void *ctx)
+{
+	(void)ctx;
+	if (parser_thread_is_running())
+		hunt_series_live_tick();
+}
+
+/* Live stats cache (no rescans): follows offset or an optional loaded range. */
+static void	refresh_stats(void *ctx)
+{
+	t_app				*app;
+	const t_hunt_stats	*ps;
+	long				start_off;
+	long				end_raw;
+	long				end_res;
+
+	app = (t_app *)ctx;
+	app->last_offset = session_load_offset(tm_path_session_offset());
 	tracker_stats_live_tick();
+	ps = tracker_stats_live_get();
+	memset(&app->hunt_stats, 0, sizeof(app->hunt_stats));
+	if (ps)
 	{
-		const t_hunt_stats	*ps;
-		long				start_off;
-		long				end_raw;
-		long				end_res;
-
-		ps = tracker_stats_live_get();
-		memset(&app->hunt_stats, 0, sizeof(app->hunt_stats));
-		if (ps)
-		{
-			app->hunt_stats = *ps;
-			app->hunt_stats_ok = 1;
-		}
-		else
-			app->hunt_stats_ok = 0;
-		app->session_range_active = tracker_stats_live_is_range();
-		app->session_range_start = 0;
-		app->session_range_end = -1;
-		if (app->session_range_active)
-		{
-			start_off = 0;
-			end_raw = -1;
-			end_res = -1;
-			tracker_stats_live_get_range(&start_off, &end_raw, &end_res);
-			app->session_range_start = start_off;
-			app->session_range_end = end_res;
-		}
+		app->hunt_stats = *ps;
+		app->hunt_stats_ok = 1;
 	}
-	memset(&app->globals_stats, 0, sizeof(app->globals_stats));
-	app->globals_stats_ok = (globals_stats_compute(tm_path_globals_csv(), 0, &app->globals_stats) == 0);
+	else
+		app->hunt_stats_ok = 0;
+	app->session_range_active = tracker_stats_live_is_range();
+	app->session_range_start = 0;
+	app->session_range_end = -1;
+	if (app->session_range_active)
+	{
+		start_off = 0;
+		end_raw = -1;
+		end_res = -1;
+		tracker_stats_live_get_range(&start_off, &end_raw, &end_res);
+		app->session_range_start = start_off;
+		app->session_range_end = end_res;
+	}
+}
 
-	/* feeds */
-	file_tail_csv_formatted(tm_path_hunt_csv(), 28, app->hunt_feed_buf, 32, &app->hunt_feed_n);
+static uint64_t	probe_hunt_feed(void *ctx)
+{
+	(void)ctx;
+	return (refresh_sig_file(refresh_sig_begin(), tm_path_hunt_csv()));
+}
+
+static void	refresh_hunt_feed(void *ctx)
+{
+	t_app	*app;
+
+	app = (t_app *)ctx;
+	file_tail_csv_formatted(&app->hunt_tail, tm_path_hunt_csv(), 28, app->hunt_feed_buf, 32, &app->hunt_feed_n);
 	for (int i = 0; i < app->hunt_feed_n; i++)
 		app->hunt_feed_lines[i] = app->hunt_feed_buf[i];
-	file_tail_csv_formatted(tm_path_globals_csv(), 18, app->globals_feed_buf, 24, &app->globals_feed_n);
+}
+
+static uint64_t	probe_globals(void *ctx)
+{
+	(void)ctx;
+	return (refresh_sig_file(refresh_sig_begin(), tm_path_globals_csv()));
+}
+
+static void	refresh_globals(void *ctx)
+{
+	t_app					*app;
+	const t_globals_stats	*gstats;
+
+	app = (t_app *)ctx;
+	globals_stats_live_tick();
+	gstats = globals_stats_live_get();
+	app->globals_stats_ok = (gstats != NULL);
+	if (gstats)
+		app->globals_stats = *gstats;
+	else
+		memset(&app->globals_stats, 0, sizeof(app->globals_stats));
+	file_tail_csv_formatted(&app->globals_tail, tm_path_globals_csv(), 18, app->globals_feed_buf, 24, &app->globals_feed_n);
 	for (int i = 0; i < app->globals_feed_n; i++)
 		app->globals_feed_lines[i] = app->globals_feed_buf[i];
-	file_tail_csv_formatted(tm_path_sessions_stats_csv(), 16, app->sessions_feed_buf, 20, &app->sessions_feed_n);
+}
+
+static uint64_t	probe_sessions(void *ctx)
+{
+	(void)ctx;
+	return (refresh_sig_file(refresh_sig_begin(), tm_path_sessions_stats_csv()));
+}
+
+static void	refresh_sessions(void *ctx)
+{
+	t_app	*app;
+
+	app = (t_app *)ctx;
+	file_tail_csv_formatted(&app->sessions_tail, tm_path_sessions_stats_csv(), 16, app->sessions_feed_buf, 20, &app->sessions_feed_n);
 	for (int i = 0; i < app->sessions_feed_n; i++)
 		app->sessions_feed_lines[i] = app->sessions_feed_buf[i];
 }
 
+static void	app_refresh_init(t_app *app)
+{
+	t_refresh_sched	*s;
+
+	s = &app->refresh;
+	refresh_sched_init(s, 250);
+	app->refresh_series = refresh_sched_add(s, "series", probe_series, refresh_series, app);
+	refresh_sched_add(s, "config", probe_config, refresh_config, app);
+	app->refresh_stats = refresh_sched_add(s, "stats", probe_hunt, refresh_stats, app);
+	refresh_sched_add(s, "globals", probe_globals, refresh_globals, app);
+	refresh_sched_add(s, "hunt feed", probe_hunt_feed, refresh_hunt_feed, app);
+	refresh_sched_add(s, "sessions", probe_sessions, refresh_sessions, app);
+}
+
+/* Forces every cache to reload on the next frame (state files rewritten). */
+static void	app_refresh_invalidate(t_app *app)
+{
+	refresh_sched_invalidate(&app->refresh);
+}
+
+/* 1 if a cache was refreshed (new data to show). */
+static int	app_refresh_cached(t_app *app)
+{
+	unsigned long long	bus;
+
+	if (!app)
+		return (0);
+	/* Rows published by the LIVE parser: same frame, no flush/reopen wait. */
+	bus = hunt_bus_version();
+	if (bus != app->bus_seen)
+	{
+		app->bus_seen = bus;
+		refresh_sched_mark(&app->refresh, app->refresh_series);
+		refresh_sched_mark(&app->refresh, app->refresh_stats);
+	}
+	return (refresh_sched_tick(&app->refresh, ft_time_ms()) > 0);
+}
+
 static int	app_chatlog_ok(char *out_path, size_t outsz)
 {
 	if (out_path && outsz)
@@ -583,7 +690,8 @@ static void	app_action_set_offset_end(t_window *w)
 	end = session_count_data_lines(tm_path_hunt_csv());
 	/* Leaving any loaded session view */
 	(session_clear_range(tm_path_session_range()));
-	session_save_offset(tm_path_session_offset(), end);
+	session_save_offset_ex(tm_path_session_offset(), tm_path_hunt_csv(),
+		end);
 	/* Force la serie LIVE a se recaler immediatement sur ce nouvel offset. */
 	hunt_series_live_force_reset();
 	snprintf(line, sizeof(line), "OK : Offset session = %ld ligne(s) (fin CSV)", end);
@@ -607,7 +715,7 @@ static void	app_action_stop_export_offset(t_window *w, t_app *app)
 	parser_thread_stop();
 	/* Stop+Export always targets the current session (offset->EOF), not a loaded range. */
 	(session_clear_range(tm_path_session_range()));
-	app->last_refresh_ms = 0;
+	app_refresh_invalidate(app);
 	start_off = session_load_offset(tm_path_session_offset());
 	end_off = session_count_data_lines(tm_path_hunt_csv());
 	memset(&s, 0, sizeof(s));
@@ -632,7 +740,8 @@ static void	app_action_stop_export_offset(t_window *w, t_app *app)
 		ui_screen_message(w, "STOP + EXPORT", msg, 3);
 		return ;
 	}
-	session_save_offset(tm_path_session_offset(), end_off);
+	session_save_offset_ex(tm_path_session_offset(), tm_path_hunt_csv(),
+		end_off);
 	/* Force la serie LIVE a re-demarrer sur le nouvel offset. */
 	hunt_series_live_force_reset();
 	/* Fin de session => obliger la saisie du mob au prochain Start */
@@ -812,7 +921,8 @@ static void	app_apply_session_range(t_window *w, t_app *app, const t_session_ent
 		ui_screen_message(w, "CHARGER SESSION", msg, 3);
 		return ;
 	}
-	if (session_save_range(tm_path_session_range(), e->start_offset, e->end_offset) != 0)
+	if (session_save_range_ex(tm_path_session_range(), tm_path_hunt_csv(),
+			e->start_offset, e->end_offset) != 0)
 	{
 		msg[0] = "[ERREUR] Impossible d'ecrire hunt_session.range";
 		msg[1] = tm_path_session_range();
@@ -828,7 +938,7 @@ static void	app_apply_session_range(t_window *w, t_app *app, const t_session_ent
 	ui_screen_message(w, "CHARGER SESSION", msg, 3);
 
 	/* Force refresh cache immediately */
-	app->last_refresh_ms = 0;
+	app_refresh_invalidate(app);
 }
 
 static void	app_draw_session_picker(t_window *w, t_ui_state *ui, t_app *app, t_rect content)
@@ -1824,7 +1934,7 @@ static void	app_page_sessions(t_window *w, t_ui_state *ui, t_app *app, t_rect co
 			"Retour courant", UI_BTN_GHOST, app->session_range_active))
 		{
 			(session_clear_range(tm_path_session_range()));
-			app->last_refresh_ms = 0;
+			app_refresh_invalidate(app);
 		}
 	}
 	if (app->sessions_feed_n > 0)
@@ -1941,11 +2051,15 @@ static void	health_pill(t_window *w, int x, int y, HealthLevel l)
 static void	app_page_health(t_window *w, t_ui_state *ui, t_app *app, t_rect content)
 {
 	MonitorHealth	h;
+	t_chat_ingest_stats	ing;
+	t_hunt_bus_stats	bus;
+	t_fl_stats		fls;
 	uint64_t		now_ms;
 	t_rect			body;
 	t_rect			grid;
 	t_rect			io;
 	t_rect			lat;
+	t_rect			rf;
 	t_rect			err;
 	char			buf[256];
 	char			sz_chat[64];
@@ -1954,8 +2068,7 @@ static void	app_page_health(t_window *w, t_ui_state *ui, t_app *app, t_rect cont
 	unsigned int	c_border;
 	unsigned int	c_muted;
 
-	(void)app;
-	if (!w || !ui)
+	if (!w || !ui || !app)
 		return ;
 	c_ok = 0x55FF7A;
 	c_border = ui->theme->border;
@@ -1966,14 +2079,16 @@ static void	app_page_health(t_window *w, t_ui_state *ui, t_app *app, t_rect cont
 
 	app_page_header(w, ui, content, "Health", "I/O + Latence + erreurs (RCE-safe)", &body);
 
-	/* Layout: 2 columns top (I/O, Parser) + full width bottom (Errors) */
+	/* Layout: 2 columns top (I/O, Parser) + full width Refresh, Errors */
 	grid = (t_rect){body.x + UI_PAD, body.y + UI_PAD, body.w - UI_PAD * 2, body.h - UI_PAD * 2};
-	io = (t_rect){grid.x, grid.y, grid.w / 2 - 6, 170};
-	lat = (t_rect){grid.x + grid.w / 2 + 6, grid.y, grid.w / 2 - 6, 170};
-	err = (t_rect){grid.x, grid.y + 170 + 12, grid.w, grid.h - (170 + 12)};
+	io = (t_rect){grid.x, grid.y, grid.w / 2 - 6, 242};
+	lat = (t_rect){grid.x + grid.w / 2 + 6, grid.y, grid.w / 2 - 6, 242};
+	rf = (t_rect){grid.x, grid.y + 242 + 12, grid.w, 36 + 18 * (app->refresh.n + 3)};
+	err = (t_rect){grid.x, rf.y + rf.h + 12, grid.w, grid.h - (rf.y + rf.h + 12 - grid.y)};
 
 	ui_draw_panel(w, io, ui->theme->surface, c_border);
 	ui_draw_panel(w, lat, ui->theme->surface, c_border);
+	ui_draw_panel(w, rf, ui->theme->surface, c_border);
 	ui_draw_panel(w, err, ui->theme->surface, c_border);
 
 	/* --- I/O block --- */
@@ -2020,6 +2135,46 @@ static void	app_page_health(t_window *w, t_ui_state *ui, t_app *app, t_rect cont
 		ui_draw_text(w, io.x + 12, io.y + 152, buf, 0xFF3B3B);
 	}
 
+	/* Shared chat.log ingest (LIVE): ring usage + per-consumer cursors */
+	chat_ingest_get_stats(&ing);
+	if (!ing.running)
+		ui_draw_text(w, io.x + 12, io.y + 170, "ingest: stopped", c_muted);
+	else
+	{
+		snprintf(buf, sizeof(buf), "ingest: %llu lines  stalls:%llu (%llu ms)",
+			ing.lines, ing.stalls, ing.stall_ms);
+		ui_draw_text(w, io.x + 12, io.y + 170, buf, ing.stalls ? 0xFFB020 : ui->theme->text2);
+		buf[0] = '\0';
+		for (int i = 0; i < ing.subs_count; i++)
+		{
+			char	part[64];
+
+			snprintf(part, sizeof(part), "%s%s lag %llu/%d (max %llu)",
+				i ? "  |  " : "", ing.subs[i].name, ing.subs[i].lag,
+				ing.ring_capacity, ing.subs[i].lag_max);
+			strncat(buf, part, sizeof(buf) - strlen(buf) - 1);
+		}
+		ui_draw_text(w, io.x + 12, io.y + 188, buf, ui->theme->text2);
+	}
+
+	/* CSV writer (group commit): throughput + commit latency histogram */
+	if (!h.csv_writer.policy[0])
+		ui_draw_text(w, io.x + 12, io.y + 206, "csv writer: n/a", c_muted);
+	else
+	{
+		const t_health_csv_writer	*cw = &h.csv_writer;
+
+		fmt_bytes(sz_csv, sizeof(sz_csv), (long)cw->bytes_per_sec);
+		snprintf(buf, sizeof(buf), "csv writer: %s  %d rows/s  %s/s  commits:%lld  fsync:%lld",
+			cw->policy, cw->rows_per_sec, sz_csv, cw->commits, cw->syncs);
+		ui_draw_text(w, io.x + 12, io.y + 206, buf, ui->theme->text2);
+		snprintf(buf, sizeof(buf), "commit <=100us:%d <=1ms:%d <=10ms:%d <=100ms:%d <=1s:%d >1s:%d  max %d us",
+			cw->lat_hist[0], cw->lat_hist[1], cw->lat_hist[2], cw->lat_hist[3],
+			cw->lat_hist[4], cw->lat_hist[5], cw->lat_max_us);
+		ui_draw_text(w, io.x + 12, io.y + 224, buf,
+			(cw->lat_hist[4] + cw->lat_hist[5]) ? 0xFFB020 : ui->theme->text2);
+	}
+
 	/* --- Parser / Latence block --- */
 	ui_draw_text(w, lat.x + 12, lat.y + 10, "Parser / Latence", ui->theme->text);
 	health_pill(w, lat.x + 12, lat.y + 34, h.lag_level);
@@ -2042,6 +2197,71 @@ static void	app_page_health(t_window *w, t_ui_state *ui, t_app *app, t_rect cont
 	}
 	snprintf(buf, sizeof(buf), "parse errors: %d", h.parse_errors);
 	ui_draw_text(w, lat.x + 12, lat.y + 98, buf, h.parse_errors ? 0xFFB020 : c_muted);
+	if (h.watch_backend[0])
+	{
+		snprintf(buf, sizeof(buf), "watch: %s  wakeups:%lld  idle:%lld  stat:%lld",
+			h.watch_backend, h.watch_wakeups, h.watch_timeouts, h.watch_size_checks);
+		ui_draw_text(w, lat.x + 12, lat.y + 118, buf, ui->theme->text2);
+		snprintf(buf, sizeof(buf), "wake->ingest: %d ms (max %d ms)",
+			h.watch_latency_ms, h.watch_latency_max_ms);
+		ui_draw_text(w, lat.x + 12, lat.y + 136, buf, ui->theme->text2);
+	}
+	else
+		ui_draw_text(w, lat.x + 12, lat.y + 118, "watch: n/a (LIVE inactif)", c_muted);
+	if (h.replay_bytes > 0)
+	{
+		fmt_bytes(sz_chat, sizeof(sz_chat), (long)h.replay_bytes);
+		snprintf(buf, sizeof(buf), "replay%s: %s in %.1f s (%.2f MiB/s, %d thr)",
+			h.replay_done ? "" : " (en cours)", sz_chat,
+			(double)h.replay_ms / 1000.0, (double)h.replay_mbps_x100 / 100.0,
+			h.replay_threads > 0 ? h.replay_threads : 1);
+		ui_draw_text(w, lat.x + 12, lat.y + 156, buf, ui->theme->text2);
+	}
+	hunt_bus_get_stats(&bus);
+	if (bus.published > 0)
+	{
+		snprintf(buf, sizeof(buf), "bus%s: %llu rows  stats %llu (drop %llu)  series %llu (drop %llu)",
+			bus.active ? "" : " (stop)", bus.published,
+			bus.applied[HUNT_BUS_STATS], bus.dropped[HUNT_BUS_STATS],
+			bus.applied[HUNT_BUS_SERIES], bus.dropped[HUNT_BUS_SERIES]);
+		ui_draw_text(w, lat.x + 12, lat.y + 176, buf, ui->theme->text2);
+	}
+
+	/* --- UI cache refresh (change-driven) --- */
+	snprintf(buf, sizeof(buf), "Refresh (probe: %llu us / %llu ms)",
+		(unsigned long long)app->refresh.probe_us,
+		(unsigned long long)app->refresh.period_ms);
+	ui_draw_text(w, rf.x + 12, rf.y + 10, buf, ui->theme->text);
+	for (int i = 0; i < app->refresh.n; i++)
+	{
+		const t_refresh_source	*src = &app->refresh.src[i];
+		unsigned long long		avg;
+
+		avg = src->misses ? src->total_us / src->misses : 0;
+		snprintf(buf, sizeof(buf),
+			"%-10s  hits:%-8llu misses:%-6llu  last:%llu us  avg:%llu us  max:%llu us",
+			src->name, src->hits, src->misses,
+			(unsigned long long)src->last_us, avg,
+			(unsigned long long)src->max_us);
+		ui_draw_text(w, rf.x + 12, rf.y + 32 + 18 * i, buf, ui->theme->text2);
+	}
+	fl_get_stats(&fls);
+	snprintf(buf, sizeof(buf),
+		"Frames: %s  drawn:%llu/%llu  idle waits:%llu (woken:%llu)  max:%llu us",
+		fls.active ? "60 fps" : "idle 4 fps", fls.drawn, fls.frames,
+		fls.idle_waits, fls.woken, (unsigned long long)fls.cost_max_us);
+	ui_draw_text(w, rf.x + 12, rf.y + 32 + 18 * app->refresh.n, buf, ui->theme->text);
+	snprintf(buf, sizeof(buf),
+		"cost   <=1ms:%llu <=4ms:%llu <=8ms:%llu <=16ms:%llu <=33ms:%llu >33ms:%llu",
+		fls.cost_hist[0], fls.cost_hist[1], fls.cost_hist[2],
+		fls.cost_hist[3], fls.cost_hist[4], fls.cost_hist[5]);
+	ui_draw_text(w, rf.x + 12, rf.y + 50 + 18 * app->refresh.n, buf,
+		(fls.cost_hist[4] + fls.cost_hist[5]) ? 0xFFB020 : ui->theme->text2);
+	snprintf(buf, sizeof(buf),
+		"period <=17ms:%llu <=34ms:%llu <=100ms:%llu <=250ms:%llu <=500ms:%llu >500ms:%llu",
+		fls.period_hist[0], fls.period_hist[1], fls.period_hist[2],
+		fls.period_hist[3], fls.period_hist[4], fls.period_hist[5]);
+	ui_draw_text(w, rf.x + 12, rf.y + 68 + 18 * app->refresh.n, buf, ui->theme->text2);
 
 	/* --- Errors ring buffer --- */
 	ui_draw_text(w, err.x + 12, err.y + 10, "Errors (last 10)", ui->theme->text);
@@ -2198,6 +2418,7 @@ int	main(int argc, char **argv)
 	const char		*footer;
 	t_ui_layout	ly;
 	t_rect			content;
+	int				changed;
 
 	memset(&app, 0, sizeof(app));
 	(void)argc;
@@ -2209,10 +2430,13 @@ int	main(int argc, char **argv)
 	app.hunt_mode_live = 1;
 	app.globals_mode_live = 1;
 	ui.theme = &g_theme_dark;
-	fl.target_ms = 16;
+	fl_init(&fl, 16);
+	app_refresh_init(&app);
 
 	if (window_init(&w, "tracker_loot", 1024, 768) != 0)
 		return (1);
+	/* Parser / globals threads: new rows cut the idle wait short. */
+	tm_wake_set_notify(window_wake);
 	ui_ensure_globals_csv();
 	ui_ensure_hunt_csv();
 	/*
@@ -2228,6 +2452,7 @@ int	main(int argc, char **argv)
 	{
 		fl_begin(&fl);
 		window_poll_events(&w);
+		changed = (w.input_events > 0);
 
 		/* Hotkey: H toggles the HEALTH page (operational trust). */
 		if (w.key_h)
@@ -2244,49 +2469,53 @@ int	main(int argc, char **argv)
 				app.nav_cursor = page_to_nav_cursor(app.page);
 			}
 		}
-		app_refresh_cached(&app);
-
-		/* Chrome */
-		footer = "Up/Down navigation  |  Enter ouvrir  |  Molette: defiler  |  Esc: fermer";
-		content = ui_draw_chrome_ex(&w, &ui, NULL, NULL, footer, 280);
-		ui_calc_layout_ex(&w, &ly, 280);
-
-		/* Sidebar nav + Topbar */
-		app_sidebar_nav(&w, &ui, &ly, &app);
-		app_topbar(&w, &ui, &ly, &app);
-
-		/* Pages */
-		if (app.page == PAGE_CHASSE)
-			app_page_chasse(&w, &ui, &app, content);
-		else if (app.page == PAGE_GLOBALS)
-			app_page_globals(&w, &ui, &app, content);
-		else if (app.page == PAGE_SESSIONS)
-			app_page_sessions(&w, &ui, &app, content);
-		else if (app.page == PAGE_CONFIG)
-			app_page_config(&w, &ui, &app, content);
-		else if (app.page == PAGE_MAINTENANCE)
-			app_page_maintenance(&w, &ui, &app, content);
-		else if (app.page == PAGE_AIDE)
-			app_page_aide(&w, &ui, &app, content);
-		else if (app.page == PAGE_HEALTH)
-			app_page_health(&w, &ui, &app, content);
-		else
+		changed |= app_refresh_cached(&app);
+
+		/* Nothing new (input, data, idle period): keep the last frame. */
+		if (fl_should_draw(&fl, changed))
 		{
-			/* Dashboard removed: fall back to Chasse for any unknown page value. */
-			app.page = PAGE_CHASSE;
-			app.nav_cursor = 0;
-			app_page_chasse(&w, &ui, &app, content);
-		}
+			/* Chrome */
+			footer = "Up/Down navigation  |  Enter ouvrir  |  Molette: defiler  |  Esc: fermer";
+			content = ui_draw_chrome_ex(&w, &ui, NULL, NULL, footer, 280);
+			ui_calc_layout_ex(&w, &ly, 280);
+
+			/* Sidebar nav + Topbar */
+			app_sidebar_nav(&w, &ui, &ly, &app);
+			app_topbar(&w, &ui, &ly, &app);
+
+			/* Pages */
+			if (app.page == PAGE_CHASSE)
+				app_page_chasse(&w, &ui, &app, content);
+			else if (app.page == PAGE_GLOBALS)
+				app_page_globals(&w, &ui, &app, content);
+			else if (app.page == PAGE_SESSIONS)
+				app_page_sessions(&w, &ui, &app, content);
+			else if (app.page == PAGE_CONFIG)
+				app_page_config(&w, &ui, &app, content);
+			else if (app.page == PAGE_MAINTENANCE)
+				app_page_maintenance(&w, &ui, &app, content);
+			else if (app.page == PAGE_AIDE)
+				app_page_aide(&w, &ui, &app, content);
+			else if (app.page == PAGE_HEALTH)
+				app_page_health(&w, &ui, &app, content);
+			else
+			{
+				/* Dashboard removed: fall back to Chasse for any unknown page value. */
+				app.page = PAGE_CHASSE;
+				app.nav_cursor = 0;
+				app_page_chasse(&w, &ui, &app, content);
+			}
 
-		/* Overlay weapon picker */
-		if (w.key_escape && app.weapon_picker_open)
-			app_weapon_picker_close(&app);
-		app_draw_weapon_picker(&w, &ui, &app, content);
+			/* Overlay weapon picker */
+			if (w.key_escape && app.weapon_picker_open)
+				app_weapon_picker_close(&app);
+			app_draw_weapon_picker(&w, &ui, &app, content);
 
-		/* Overlay session picker */
-		if (w.key_escape && app.session_picker_open)
-			app_session_picker_close(&app);
-		app_draw_session_picker(&w, &ui, &app, content);
+			/* Overlay session picker */
+			if (w.key_escape && app.session_picker_open)
+				app_session_picker_close(&app);
+			app_draw_session_picker(&w, &ui, &app, content);
+		}
 
 		/* Hotkey: O toggles overlay (comme test.tar.gz) */
 		if (w.key_o)
@@ -2316,6 +2545,9 @@ int	main(int argc, char **argv)
 	}
 
 	app_weapon_picker_close(&app);
+	fs_tail_free(&app.hunt_tail);
+	fs_tail_free(&app.globals_tail);
+	fs_tail_free(&app.sessions_tail);
 	window_destroy(&w);
 	return (0);
 }
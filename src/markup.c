@@ -13,6 +13,7 @@
 #include "markup.h"
 #include "markup_ini.h"
 
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -29,6 +30,8 @@ void	markup_db_init(t_markup_db *db)
     db->items = NULL;
     db->count = 0;
     db->cap = 0;
+    db->slots = NULL;
+    db->nslots = 0;
 }
 
 void	markup_db_free(t_markup_db *db)
@@ -36,9 +39,91 @@ void	markup_db_free(t_markup_db *db)
     if (!db)
         return ;
     free(db->items);
-    db->items = NULL;
-    db->count = 0;
-    db->cap = 0;
+    free(db->slots);
+    markup_db_init(db);
+}
+
+static uint32_t	name_hash(const char *s)
+{
+    uint32_t	h;
+
+    h = 2166136261u;
+    while (*s)
+    {
+        h ^= (unsigned char)*s++;
+        h *= 16777619u;
+    }
+    return (h);
+}
+
+/* Slot of 'name': its entry, or the free slot where it would go. */
+static size_t	index_probe(const t_markup_db *db, const char *name)
+{
+    size_t	h;
+
+    h = name_hash(name) & (db->nslots - 1);
+    while (db->slots[h]
+        && strcmp(db->items[db->slots[h] - 1].name, name) != 0)
+        h = (h + 1) & (db->nslots - 1);
+    return (h);
+}
+
+/* Sized for count + 1 rules at load <= 1/2; first duplicate name wins. */
+static int	index_rebuild(t_markup_db *db)
+{
+    uint32_t	*ns;
+    size_t		n;
+    size_t		i;
+    size_t		h;
+
+    n = 64;
+    while (n < (db->count + 1) * 2)
+        n *= 2;
+    ns = (uint32_t *)calloc(n, sizeof(*ns));
+    if (!ns)
+        return (-1);
+    free(db->slots);
+    db->slots = ns;
+    db->nslots = n;
+    i = 0;
+    while (i < db->count)
+    {
+        h = index_probe(db, db->items[i].name);
+        if (!db->slots[h])
+            db->slots[h] = (uint32_t)(i + 1);
+        i++;
+    }
+    return (0);
+}
+
+long	markup_db_find(const t_markup_db *db, const char *item_name)
+{
+    size_t	h;
+    size_t	i;
+
+    if (!db || !item_name)
+        return (-1);
+    if (!db->nslots)
+    {
+        i = 0;
+        while (i < db->count && strcmp(db->items[i].name, item_name) != 0)
+            i++;
+        return ((i < db->count) ? (long)i : -1);
+    }
+    h = index_probe(db, item_name);
+    return (db->slots[h] ? (long)db->slots[h] - 1 : -1);
+}
+
+int	markup_db_reindex(t_markup_db *db)
+{
+    size_t	i;
+
+    if (!db)
+        return (-1);
+    i = 0;
+    while (i < db->count)
+        markup_rule_prepare(&db->items[i++]);
+    return (index_rebuild(db));
 }
 
 static int	db_reserve(t_markup_db *db, size_t need)
@@ -68,26 +153,23 @@ static int	db_push(t_markup_db *db, const t_markup_rule *r)
         return (-1);
     if (db_reserve(db, db->count + 1) != 0)
         return (-1);
+    if ((db->count + 1) * 2 > db->nslots && index_rebuild(db) != 0)
+        return (-1);
     db->items[db->count] = *r;
     db->count++;
+    db->slots[index_probe(db, r->name)] = (uint32_t)db->count;
     return (0);
 }
 
 static int	db_update_if_exists(t_markup_db *db, const t_markup_rule *r)
 {
-    size_t	i;
+    long	i;
     
-    i = 0;
-    while (i < db->count)
-    {
-        if (strcmp(db->items[i].name, r->name) == 0)
-        {
-            db->items[i] = *r;
-            return (1);
-        }
-        i++;
-    }
-    return (0);
+    i = markup_db_find(db, r->name);
+    if (i < 0)
+        return (0);
+    db->items[i] = *r;
+    return (1);
 }
 
 int	markup_db_load(t_markup_db *db, const char *path)
@@ -107,21 +189,15 @@ int	markup_db_load(t_markup_db *db, const char *path)
 int	markup_db_get(const t_markup_db *db, const char *item_name,
                   t_markup_rule *out)
 {
-    size_t	i;
+    long	i;
     
     if (!db || !item_name || !out)
         return (0);
-    i = 0;
-    while (i < db->count)
-    {
-        if (strcmp(db->items[i].name, item_name) == 0)
-        {
-            *out = db->items[i];
-            return (1);
-        }
-        i++;
-    }
-    return (0);
+    i = markup_db_find(db, item_name);
+    if (i < 0)
+        return (0);
+    *out = db->items[i];
+    return (1);
 }
 
 double	markup_apply(const t_markup_rule *r, double tt_value)
@@ -133,6 +209,31 @@ double	markup_apply(const t_markup_rule *r, double tt_value)
     return (tt_value * r->value);
 }
 
+void	markup_rule_prepare(t_markup_rule *r)
+{
+    if (!r)
+        return ;
+    r->mul_1e4 = 10000;
+    r->add_uPED = 0;
+    if (r->type == MARKUP_TT_PLUS)
+        r->add_uPED = tm_money_from_ped_double(r->value);
+    else
+    {
+        r->mul_1e4 = (int64_t)llround(r->value * 10000.0);
+        if (r->mul_1e4 <= 0)
+            r->mul_1e4 = 10000;
+    }
+}
+
+tm_money_t	markup_rule_apply_money(const t_markup_rule *r, tm_money_t tt)
+{
+    if (!r)
+        return (tt);
+    if (r->type == MARKUP_TT_PLUS)
+        return (tt + r->add_uPED);
+    return (tm_money_mul_mu(tt, r->mul_1e4));
+}
+
 t_markup_rule	markup_default_rule(void)
 {
     t_markup_rule	r;
@@ -141,6 +242,7 @@ t_markup_rule	markup_default_rule(void)
     strncpy(r.name, "(default)", sizeof(r.name) - 1);
     r.type = MARKUP_PERCENT;
     r.value = 1.0;
+    markup_rule_prepare(&r);
     return (r);
 }
 
@@ -151,12 +253,13 @@ t_markup_rule	markup_default_rule(void)
  */
 int	markup__db_insert_or_update(t_markup_db *db, const t_markup_rule *r)
 {
-    int	updated;
+    t_markup_rule	p;
     
     if (!db || !r)
         return (-1);
-    updated = db_update_if_exists(db, r);
-    if (updated == 1)
+    p = *r;
+    markup_rule_prepare(&p);
+    if (db_update_if_exists(db, &p) == 1)
         return (0);
-    return (db_push(db, r));
+    return (db_push(db, &p));
 }
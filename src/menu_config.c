@@ -164,6 +164,7 @@ static int	markup_db_upsert(t_markup_db *db, int idx, const t_markup_rule *r)
 	if (idx >= 0 && (size_t)idx < db->count)
 	{
 		db->items[idx] = *r;
+		markup_db_reindex(db);
 		return (1);
 	}
 	if (db->count + 1 > db->cap)
@@ -176,6 +177,7 @@ static int	markup_db_upsert(t_markup_db *db, int idx, const t_markup_rule *r)
 		db->cap = ncap;
 	}
 	db->items[db->count++] = *r;
+	markup_db_reindex(db);
 	return (1);
 }
 
@@ -186,10 +188,12 @@ static void	markup_db_delete(t_markup_db *db, int idx)
 	if (idx == (int)db->count - 1)
 	{
 		db->count--;
+		markup_db_reindex(db);
 		return;
 	}
 	memmove(&db->items[idx], &db->items[idx + 1], (db->count - (size_t)idx - 1) * sizeof(*db->items));
 	db->count--;
+	markup_db_reindex(db);
 }
 
 void	menu_config_armes(t_window *w)
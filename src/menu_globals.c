@@ -26,7 +26,7 @@
 #include "overlay.h"
 
 #include "core_paths.h"
-#include "globals_stats.h"
+#include "globals_stats_live.h"
 #include "globals_thread.h"
 #include "csv.h"
 
@@ -124,7 +124,7 @@ static void	screen_dashboard_globals_live(t_window *w)
 		return;
 	ui.theme = &g_theme_dark;
 	selected = 0;
-	fl.target_ms = 16;
+	fl_init(&fl, 16);
 	last_ms = ft_time_ms();
 	refresh_acc = 1.0;
 	cache_n = 0;
@@ -138,6 +138,7 @@ static void	screen_dashboard_globals_live(t_window *w)
 		if (dt < 0.0)
 			dt = 0.0;
 		window_poll_events(w);
+		fl_mark(&fl, w->input_events > 0);
 		overlay_tick_auto_hunt();
 		if (w->key_escape || w->key_enter)
 			break;
@@ -146,8 +147,11 @@ static void	screen_dashboard_globals_live(t_window *w)
 		if (refresh_acc >= 0.250)
 		{
 			refresh_acc = 0.0;
-			memset(&s, 0, sizeof(s));
-			(void)globals_stats_compute(tm_path_globals_csv(), 0, &s);
+			globals_stats_live_tick();
+			if (globals_stats_live_get())
+				s = *globals_stats_live_get();
+			else
+				memset(&s, 0, sizeof(s));
 
 			n = 0;
 			snprintf(buf[n++], sizeof(buf[0]), "DASHBOARD GLOBALS LIVE");
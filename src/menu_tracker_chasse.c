@@ -30,6 +30,7 @@
 #include "screen_graph_live.h"
 #include "hunt_series_live.h"
 #include "tracker_stats_live.h"
+#include "hunt_bus.h"
 
 #include "core_paths.h"
 #include "config_arme.h"
@@ -701,7 +702,7 @@ static void	screen_dashboard_live(t_window *w)
 	ui.theme = &g_theme_dark;
 	page = DASH_RESUME;
 	selected = (int)page;
-	fl.target_ms = 16;
+	fl_init(&fl, 16);
 	last_ms = ft_time_ms();
 	refresh_acc = 1.0;
 	cache_ok = 0;
@@ -716,6 +717,7 @@ static void	screen_dashboard_live(t_window *w)
 		if (dt < 0.0)
 			dt = 0.0;
 		window_poll_events(w);
+		fl_mark(&fl, w->input_events > 0);
 		
 		/* Navigation clavier */
 		if (w->key_escape)
@@ -856,6 +858,34 @@ static void	fmt_elapsed(char *dst, size_t cap, double sec)
 	snprintf(dst, cap, "%02d:%02d:%02d", h, m, s);
 }
 
+/*
+** Append generation of the plotted series (ui_graph zoom variants): changes
+** with the tab, the cost per shot (Cost/ROI) or when the hunt series
+** rewrites plotted rows (append_gen). 0 = no series.
+*/
+static uint32_t	graph_append_gen(const t_hunt_series *hs, int tab,
+					tm_money_t cost_shot_uPED)
+{
+	static uint32_t		gen;
+	static uint32_t		key_gen;
+	static int			key_tab = -1;
+	static tm_money_t	key_cs;
+
+	if (!hs)
+		return (0);
+	if (gen == 0 || hs->append_gen != key_gen || tab != key_tab
+		|| cost_shot_uPED != key_cs)
+	{
+		gen++;
+		if (gen == 0)
+			gen = 1;
+		key_gen = hs->append_gen;
+		key_tab = tab;
+		key_cs = cost_shot_uPED;
+	}
+	return (gen);
+}
+
 void	screen_graph_live(t_window *w)
 {
 	t_ui_state	ui;
@@ -904,6 +934,8 @@ void	screen_graph_live(t_window *w)
 	uint64_t	now_ms;
 	double		dt;
 	double		refresh_acc;
+	unsigned long long	data_sig;
+	unsigned long long	drawn_sig;
 
 	char		buf_hits[64];
 	char		buf_kills[64];
@@ -932,9 +964,10 @@ void	screen_graph_live(t_window *w)
 	hs = hunt_series_live_get();
 	st = tracker_stats_live_get();
 
-	fl.target_ms = 16;
+	fl_init(&fl, 16);
 	last_ms = ft_time_ms();
 	refresh_acc = 1.0;
+	drawn_sig = 0;
 	while (w->running)
 	{
 		fl_begin(&fl);
@@ -966,6 +999,17 @@ void	screen_graph_live(t_window *w)
 			st = tracker_stats_live_get();
 		}
 
+		/* Nothing new (input, series, LIVE rows, idle period): skip drawing. */
+		data_sig = hunt_bus_version() * 31ULL + (hs ? hs->version : 0);
+		if (!fl_should_draw(&fl, w->input_events > 0 || data_sig != drawn_sig))
+		{
+			overlay_tick_auto_hunt();
+			window_present(w);
+			fl_end_sleep(&fl);
+			continue ;
+		}
+		drawn_sig = data_sig;
+
 		/* Format KPIs (safe defaults when no data) */
 		if (hs && hs->initialized)
 		{
@@ -1647,7 +1691,9 @@ void	screen_graph_live(t_window *w)
 								(vmax <= 0.0 ? 1.0 : vmax * 1.10),
 								y_label, unit, line_col,
 								(ann_n > 0 ? ann : NULL), ann_n,
-								&zoom_states[selected], hs ? hs->version : 0);
+								&zoom_states[selected], hs ? hs->version : 0,
+								graph_append_gen(hs, selected,
+									st ? st->cost_shot_uPED : 0));
 						else if (selected == 0 || selected == 1 || selected == 2
 							|| selected == 3 || selected == 5
 							|| selected == 6 || selected == 7)
@@ -1656,13 +1702,17 @@ void	screen_graph_live(t_window *w)
 								(vmax <= 0.0 ? 1.0 : vmax * 1.10),
 								y_label, unit, line_col,
 								(ann_n > 0 ? ann : NULL), ann_n,
-								&zoom_states[selected], hs ? hs->version : 0);
+								&zoom_states[selected], hs ? hs->version : 0,
+								graph_append_gen(hs, selected,
+									st ? st->cost_shot_uPED : 0));
 						else
 							ui_graph_timeseries_zoom(w, &ui, gr, title,
 								values, xsec, nplot,
 								(vmax <= 0.0 ? 1.0 : vmax * 1.10),
 								y_label, unit, line_col,
-								&zoom_states[selected], hs ? hs->version : 0);
+								&zoom_states[selected], hs ? hs->version : 0,
+								graph_append_gen(hs, selected,
+									st ? st->cost_shot_uPED : 0));
 					}
 				}
 			}
@@ -1711,7 +1761,8 @@ static void	action_stop_and_export(t_window *w)
 			snprintf(l1, sizeof(l1), "OK : session exportee dans %s", tm_path_sessions_stats_csv());
 		else
 			snprintf(l1, sizeof(l1), "[WARN] export session CSV impossible.");
-		session_save_offset(tm_path_session_offset(), end_off);
+		session_save_offset_ex(tm_path_session_offset(), tm_path_hunt_csv(),
+			end_off);
 		/* Force la serie LIVE a re-demarrer sur le nouvel offset. */
 		hunt_series_live_force_reset();
 			/* Nouveau: on termine une session => le mob doit etre re-saisi au prochain Start. */
@@ -1786,7 +1837,8 @@ static void	action_set_offset_to_end(t_window *w)
 	const char	*msg[2];
 	
 	offset = session_count_data_lines(tm_path_hunt_csv());
-	session_save_offset(tm_path_session_offset(), offset);
+	session_save_offset_ex(tm_path_session_offset(), tm_path_hunt_csv(),
+		offset);
 	/* Force la serie LIVE a se recaler immediatement sur ce nouvel offset. */
 	hunt_series_live_force_reset();
 	snprintf(line, sizeof(line), "OK : Offset session = %ld ligne(s) (fin CSV)", offset);
@@ -1,6 +1,7 @@
 #include "monitor_health.h"
 #include "tm_string.h" /* safe_copy */
 #include "utils.h"     /* ft_time_ms */
+#include "tm_wake.h"   /* tm_wake */
 
 #include <stdatomic.h>
 #include <string.h>
@@ -14,6 +15,13 @@ typedef struct s_health_slot
 	int		count;
 } 	t_health_slot;
 
+typedef struct s_health_rate_slot
+{
+	uint64_t	sec;
+	long long	rows;
+	long long	bytes;
+} 	t_health_rate_slot;
+
 typedef struct s_health_state
 {
 	_Atomic unsigned	seq;
@@ -36,6 +44,21 @@ typedef struct s_health_state
 
 	t_health_slot	slots[HEALTH_SLOTS];
 
+	char		watch_backend[16];
+	long long	watch_wakeups;
+	long long	watch_timeouts;
+	long long	watch_size_checks;
+	int		watch_latency_ms;
+	int		watch_latency_max_ms;
+
+	long long	replay_bytes;
+	long long	replay_ms;
+	int		replay_done;
+	int		replay_threads;
+
+	t_health_csv_writer	csv;
+	t_health_rate_slot	csv_slots[HEALTH_SLOTS];
+
 	t_health_error	err_ring[HEALTH_ERR_RING];
 	int		err_head;  /* next write */
 	int		err_count; /* <= RING */
@@ -43,6 +66,9 @@ typedef struct s_health_state
 
 static t_health_state	g_h;
 
+/* Bumped on every CSV flush; outside the seqlock, read on its own. */
+static _Atomic unsigned long long	g_csv_version;
+
 static void	write_begin(void)
 {
 	atomic_fetch_add(&g_h.seq, 1u);
@@ -107,6 +133,10 @@ void	monitor_health_reset(const char *chat_path, const char *csv_path)
 	g_h.last_errno = 0;
 	g_h.last_ferror = 0;
 	memset(g_h.slots, 0, sizeof(g_h.slots));
+	g_h.replay_bytes = 0;
+	g_h.replay_ms = 0;
+	g_h.replay_done = 0;
+	g_h.replay_threads = 0;
 	memset(g_h.err_ring, 0, sizeof(g_h.err_ring));
 	g_h.err_head = 0;
 	g_h.err_count = 0;
@@ -138,6 +168,66 @@ void	monitor_health_on_flush(uint64_t now_ms, int ok, int err_no, int ferror_cod
 		push_error(HEALTH_FAIL, now_ms, "CSV flush failed", err_no, ferror_code);
 	}
 	write_end();
+	atomic_fetch_add(&g_csv_version, 1ULL);
+	tm_wake();
+}
+
+unsigned long long	monitor_health_csv_version(void)
+{
+	return (atomic_load(&g_csv_version));
+}
+
+void	monitor_health_set_csv_policy(const char *name)
+{
+	write_begin();
+	memset(&g_h.csv, 0, sizeof(g_h.csv));
+	memset(g_h.csv_slots, 0, sizeof(g_h.csv_slots));
+	safe_copy(g_h.csv.policy, sizeof(g_h.csv.policy), name ? name : "");
+	write_end();
+}
+
+static int	lat_bucket(uint64_t us)
+{
+	uint64_t	lim;
+	int			b;
+
+	lim = 100;
+	b = 0;
+	while (b < HEALTH_LAT_BUCKETS - 1 && us > lim)
+	{
+		lim *= 10;
+		b++;
+	}
+	return (b);
+}
+
+void	monitor_health_on_csv_commit(uint64_t now_ms, int rows, long long bytes,
+							uint64_t latency_us, int synced)
+{
+	t_health_rate_slot	*sl;
+	uint64_t			sec;
+
+	sec = now_ms / 1000ULL;
+	write_begin();
+	g_h.csv.rows += rows;
+	g_h.csv.bytes += bytes;
+	g_h.csv.commits++;
+	if (synced)
+		g_h.csv.syncs++;
+	g_h.csv.lat_hist[lat_bucket(latency_us)]++;
+	if (latency_us > (uint64_t)g_h.csv.lat_max_us)
+		g_h.csv.lat_max_us = (latency_us > 0x7fffffffULL)
+			? 0x7fffffff : (int)latency_us;
+	sl = &g_h.csv_slots[sec % (uint64_t)HEALTH_SLOTS];
+	if (sl->sec != sec)
+	{
+		sl->sec = sec;
+		sl->rows = 0;
+		sl->bytes = 0;
+	}
+	sl->rows += rows;
+	sl->bytes += bytes;
+	write_end();
 }
 
 void	monitor_health_on_io_error(const char *ctx, int err_no, int ferror_code)
@@ -176,6 +266,24 @@ void	monitor_health_on_parse_error(const char *ctx)
 	write_end();
 }
 
+void	monitor_health_on_parse_errors(const char *ctx, long long n)
+{
+	uint64_t	now_ms;
+	char		msg[HEALTH_ERR_MSG];
+
+	if (n <= 0)
+		return ;
+	now_ms = ft_time_ms();
+	if (!ctx)
+		ctx = "parse";
+	snprintf(msg, sizeof(msg), "Parse: %s (x%lld)", ctx, n);
+
+	write_begin();
+	g_h.parse_errors += (int)n;
+	push_error(HEALTH_WARN, now_ms, msg, 0, 0);
+	write_end();
+}
+
 void	monitor_health_update_io(uint64_t now_ms, long chat_size, long chat_pos,
 							long csv_size, int rotated)
 {
@@ -191,6 +299,85 @@ void	monitor_health_update_io(uint64_t now_ms, long chat_size, long chat_pos,
 	write_end();
 }
 
+void	monitor_health_update_chat(uint64_t now_ms, long chat_size, long chat_pos,
+							int rotated)
+{
+	write_begin();
+	g_h.chat_size = chat_size;
+	g_h.chat_pos = chat_pos;
+	if (rotated)
+	{
+		g_h.rotation_detected = 1;
+		push_error(HEALTH_WARN, now_ms, "chat.log rotation detected", 0, 0);
+	}
+	write_end();
+}
+
+void	monitor_health_update_csv(long csv_size)
+{
+	write_begin();
+	g_h.csv_size = csv_size;
+	write_end();
+}
+
+void	monitor_health_set_watch_backend(const char *name)
+{
+	write_begin();
+	safe_copy(g_h.watch_backend, sizeof(g_h.watch_backend), name ? name : "");
+	g_h.watch_wakeups = 0;
+	g_h.watch_timeouts = 0;
+	g_h.watch_size_checks = 0;
+	g_h.watch_latency_ms = 0;
+	g_h.watch_latency_max_ms = 0;
+	write_end();
+}
+
+void	monitor_health_on_watch_wait(int changed)
+{
+	write_begin();
+	if (changed)
+		g_h.watch_wakeups++;
+	else
+		g_h.watch_timeouts++;
+	write_end();
+}
+
+void	monitor_health_on_watch_check(void)
+{
+	write_begin();
+	g_h.watch_size_checks++;
+	write_end();
+}
+
+void	monitor_health_on_watch_drain(uint64_t latency_ms)
+{
+	int	ms;
+
+	ms = (latency_ms > 0x7fffffffULL) ? 0x7fffffff : (int)latency_ms;
+	write_begin();
+	g_h.watch_latency_ms = ms;
+	if (ms > g_h.watch_latency_max_ms)
+		g_h.watch_latency_max_ms = ms;
+	write_end();
+}
+
+void	monitor_health_on_replay_progress(long long bytes, uint64_t elapsed_ms,
+							int done)
+{
+	write_begin();
+	g_h.replay_bytes = bytes;
+	g_h.replay_ms = (long long)elapsed_ms;
+	g_h.replay_done = done;
+	write_end();
+}
+
+void	monitor_health_set_replay_threads(int threads)
+{
+	write_begin();
+	g_h.replay_threads = threads;
+	write_end();
+}
+
 static HealthLevel	level_from_lag_ms(long long lag_ms)
 {
 	if (lag_ms < 1500)
@@ -215,6 +402,18 @@ void	monitor_health_snapshot(MonitorHealth *out, uint64_t now_ms)
 	int		last_errno;
 	int		last_ferror;
 	t_health_slot	slots[HEALTH_SLOTS];
+	char		watch_backend[16];
+	long long	watch_wakeups;
+	long long	watch_timeouts;
+	long long	watch_size_checks;
+	int		watch_latency_ms;
+	int		watch_latency_max_ms;
+	long long	replay_bytes;
+	long long	replay_ms;
+	int		replay_done;
+	int		replay_threads;
+	t_health_csv_writer	csv;
+	t_health_rate_slot	csv_slots[HEALTH_SLOTS];
 	t_health_error	err_ring[HEALTH_ERR_RING];
 	int		err_head;
 	int		err_count;
@@ -238,6 +437,18 @@ void	monitor_health_snapshot(MonitorHealth *out, uint64_t now_ms)
 		last_errno = g_h.last_errno;
 		last_ferror = g_h.last_ferror;
 		memcpy(slots, g_h.slots, sizeof(slots));
+		memcpy(watch_backend, g_h.watch_backend, sizeof(watch_backend));
+		watch_wakeups = g_h.watch_wakeups;
+		watch_timeouts = g_h.watch_timeouts;
+		watch_size_checks = g_h.watch_size_checks;
+		watch_latency_ms = g_h.watch_latency_ms;
+		watch_latency_max_ms = g_h.watch_latency_max_ms;
+		replay_bytes = g_h.replay_bytes;
+		replay_ms = g_h.replay_ms;
+		replay_done = g_h.replay_done;
+		replay_threads = g_h.replay_threads;
+		csv = g_h.csv;
+		memcpy(csv_slots, g_h.csv_slots, sizeof(csv_slots));
 		memcpy(err_ring, g_h.err_ring, sizeof(err_ring));
 		err_head = g_h.err_head;
 		err_count = g_h.err_count;
@@ -258,6 +469,20 @@ void	monitor_health_snapshot(MonitorHealth *out, uint64_t now_ms)
 	out->parse_errors = parse_errors;
 	out->last_errno = last_errno;
 	out->last_ferror = last_ferror;
+	memcpy(out->watch_backend, watch_backend, sizeof(out->watch_backend));
+	out->watch_backend[sizeof(out->watch_backend) - 1] = '\0';
+	out->watch_wakeups = watch_wakeups;
+	out->watch_timeouts = watch_timeouts;
+	out->watch_size_checks = watch_size_checks;
+	out->watch_latency_ms = watch_latency_ms;
+	out->watch_latency_max_ms = watch_latency_max_ms;
+	out->replay_bytes = replay_bytes;
+	out->replay_ms = replay_ms;
+	out->replay_done = replay_done;
+	out->replay_threads = replay_threads;
+	if (replay_ms > 0)
+		out->replay_mbps_x100 = (int)(((double)replay_bytes / (1024.0 * 1024.0))
+			* 100000.0 / (double)replay_ms);
 
 	/* Derived: lag */
 	if (last_event_ms == 0)
@@ -288,6 +513,25 @@ void	monitor_health_snapshot(MonitorHealth *out, uint64_t now_ms)
 		out->events_per_sec_x100 = (sum * 100) / HEALTH_SLOTS;
 	}
 
+	/* Derived: CSV writer rows/bytes per second over the last 10 seconds */
+	out->csv_writer = csv;
+	out->csv_writer.policy[sizeof(out->csv_writer.policy) - 1] = '\0';
+	{
+		uint64_t	sec_now = now_ms / 1000ULL;
+		long long	rows = 0;
+		long long	bytes = 0;
+		for (int i = 0; i < HEALTH_SLOTS; i++)
+		{
+			if (csv_slots[i].sec <= sec_now && (sec_now - csv_slots[i].sec) < (uint64_t)HEALTH_SLOTS)
+			{
+				rows += csv_slots[i].rows;
+				bytes += csv_slots[i].bytes;
+			}
+		}
+		out->csv_writer.rows_per_sec = (int)(rows / HEALTH_SLOTS);
+		out->csv_writer.bytes_per_sec = bytes / HEALTH_SLOTS;
+	}
+
 	/* Errors: newest first */
 	out->errors_count = err_count;
 	for (int i = 0; i < err_count && i < HEALTH_ERR_RING; i++)
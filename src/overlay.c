@@ -213,7 +213,8 @@ static void	overlay_action_stop_export(void)
 		overlay_toastf("OK : STOP+EXPORT (offset=%ld)", end_off);
 	else
 		overlay_toastf("[WARN] export CSV impossible");
-	session_save_offset(tm_path_session_offset(), end_off);
+	session_save_offset_ex(tm_path_session_offset(), tm_path_hunt_csv(),
+		end_off);
 	/* Force la serie LIVE a re-demarrer sur le nouvel offset. */
 	hunt_series_live_force_reset();
 	/* Fin de session => obliger la saisie du mob au prochain Start */
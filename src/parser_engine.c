@@ -14,8 +14,13 @@
 #include "globals_parser.h"
 #include "hunt_rules.h"
 #include "hunt_csv.h"
+#include "hunt_csv_writer.h"
+#include "hunt_bin.h"
+#include "hunt_bus.h"
 #include "fs_utils.h"
-#include "ui_utils.h"
+#include "chat_ingest.h"
+#include "line_reader.h"
+#include "replay_shards.h"
 #include "monitor_health.h"
 #include "utils.h"
 #include "sweat_option.h"
@@ -64,10 +69,27 @@ typedef struct s_kill_ctx
 {
 	t_kill_slot	slots[KILL_CTX_MAX];
 	int			head;
-	time_t		last_flush_t;
-	int			flush_pending;
 }	t_kill_ctx;
 
+/*
+ * Per-run parser state (one per parser_run_*): CSV output (batched writer
+ * + binary sidecar), kill_id linkage and the hunt_rules context. Nothing
+ * here is shared between runs, so a REPLAY and a LIVE parser can work side
+ * by side.
+ * Only the LIVE run publishes on the hunt bus (bus = 1, csv_pos = CSV end).
+ */
+typedef struct s_engine_run
+{
+	FILE				*out;
+	t_hunt_csv_writer	csv;
+	int64_t				kill_id;
+	t_kill_ctx			kctx;
+	t_hunt_rules_ctx	rules;
+	t_hunt_bin_writer	bin;
+	int					bus;
+	int64_t				csv_pos;
+}	t_engine_run;
+
 static void	kill_ctx_reset(t_kill_ctx *k)
 {
 	if (!k)
@@ -83,7 +105,7 @@ static int	csv_is_critical_event(const char *type)
 	/*
 	 * UX LIVE graphs:
 	 * - Loot/kill & Kills points must appear as soon as the mob is killed / looted.
-	 * - We therefore force a flush on low-frequency "critical" events.
+	 * - The latency-first policy therefore commits on these low-frequency rows.
 	 */
 	if (strncmp(type, "KILL", 4) == 0)
 		return (1);
@@ -93,52 +115,20 @@ static int	csv_is_critical_event(const char *type)
 }
 
 /*
- * Performance/Durability trade-off:
- * - fflush() on each row is very expensive during intensive hunts (SHOT spam).
- * - We still want a responsive LIVE UI (kills/loot must appear immediately).
- *
- * Policy:
- * - Always flush on critical events (KILL / LOOT_ITEM) -> immediate graph point.
- * - Otherwise: flush at most once per second, or every 64 rows.
+ * Performance/Durability trade-off: rows are batched by hunt_csv_writer
+ * (one write() per batch), the policy decides when a batch is due.
+ * The binary sidecar is flushed right after the CSV (never ahead of it).
  */
-static void	csv_maybe_flush(FILE *out, t_kill_ctx *kctx, const char *type)
+static void	csv_commit(t_engine_run *r)
 {
-	time_t	now;
-	int	rc;
-	int	fe;
-	int	err;
+	(void)hunt_csv_writer_commit(&r->csv);
+	hunt_bin_writer_flush(&r->bin);
+}
 
-	if (!out)
-		return ;
-	if (!kctx)
-	{
-		rc = fflush(out);
-		fe = ferror(out);
-		err = errno;
-		monitor_health_on_flush(ft_time_ms(), (rc == 0 && fe == 0), err, fe);
-		return ;
-	}
-	now = time(NULL);
-	if (csv_is_critical_event(type))
-	{
-		rc = fflush(out);
-		fe = ferror(out);
-		err = errno;
-		monitor_health_on_flush(ft_time_ms(), (rc == 0 && fe == 0), err, fe);
-		kctx->flush_pending = 0;
-		kctx->last_flush_t = now;
-		return ;
-	}
-	kctx->flush_pending++;
-	if (kctx->flush_pending >= 64 || kctx->last_flush_t != now)
-	{
-		rc = fflush(out);
-		fe = ferror(out);
-		err = errno;
-		monitor_health_on_flush(ft_time_ms(), (rc == 0 && fe == 0), err, fe);
-		kctx->flush_pending = 0;
-		kctx->last_flush_t = now;
-	}
+static void	csv_maybe_commit(t_engine_run *r, int critical)
+{
+	if (hunt_csv_writer_due(&r->csv, ft_time_ms(), critical))
+		csv_commit(r);
 }
 
 static void	kill_ctx_on_kill(t_kill_ctx *k, int64_t ts_unix, int64_t kill_id)
@@ -231,7 +221,6 @@ static void	log_engine_error(const char *ctx, const char *path)
 void	parser_engine_set_player_name(const char *name)
 {
 	safe_copy(g_my_name, sizeof(g_my_name), name);
-	hunt_rules_set_player_name(name);
 }
 
 static void	map_globals_to_hunt(t_hunt_event *dst,
@@ -284,70 +273,120 @@ static int	extract_value_from_raw_uPED(const char *raw, tm_money_t *out)
 	return (tm_money_parse_ped(vp, out));
 }
 
-static int	append_event(FILE *out, int64_t *kill_id_state, t_kill_ctx *kctx,
-					const t_hunt_event *ev)
+/*
+ * Order-independent part of a CSV row (timestamp, qty, fixed-point value).
+ * Computed on the REPLAY worker threads, or inline by append_event().
+ */
+typedef struct s_event_prep
 {
 	int64_t		ts_unix;
 	long		qty;
 	tm_money_t	v;
 	int			has_v;
-	int64_t		kid;
-	uint32_t	flags;
+}	t_event_prep;
 
-	if (!out || !ev)
-		return (-1);
+static void	prepare_event(const t_hunt_event *ev, t_event_prep *p)
+{
 	/* V2 strict */
-	ts_unix = 0;
-	if (!hunt_csv_ts_text_to_unix(ev->ts, &ts_unix))
-		ts_unix = (int64_t)time(NULL);
-	qty = parse_long_default0(ev->qty);
+	p->ts_unix = 0;
+	if (!hunt_csv_ts_text_to_unix(ev->ts, &p->ts_unix))
+		p->ts_unix = (int64_t)time(NULL);
+	p->qty = parse_long_default0(ev->qty);
 	/* fixed-point value */
-	v = 0;
-	has_v = 0;
+	p->v = 0;
+	p->has_v = 0;
 	if (strcmp(ev->type, "SWEAT") == 0)
 	{
-		if (qty > 0)
+		if (p->qty > 0)
 		{
-			v = (tm_money_t)qty * (tm_money_t)EU_SWEAT_uPED_PER_BOTTLE;
-			has_v = 1;
+			p->v = (tm_money_t)p->qty * (tm_money_t)EU_SWEAT_uPED_PER_BOTTLE;
+			p->has_v = 1;
 		}
 	}
 	else
 	{
-		has_v = tm_money_parse_ped(ev->value, &v);
-		if (!has_v && ev->raw[0])
-			has_v = extract_value_from_raw_uPED(ev->raw, &v);
+		p->has_v = tm_money_parse_ped(ev->value, &p->v);
+		if (!p->has_v && ev->raw[0])
+			p->has_v = extract_value_from_raw_uPED(ev->raw, &p->v);
 	}
+}
+
+/* Fields as formatted by hunt_csv_format_v2() (sidecar, bus). */
+static void	event_row(const t_hunt_event *ev, const t_event_prep *p,
+					int64_t kid, uint32_t flags, t_hunt_csv_row_view *row)
+{
+	row->ts_unix = p->ts_unix;
+	row->type = ev->type;
+	row->name = ev->name;
+	row->qty = p->qty;
+	row->value_uPED = p->v;
+	row->has_value = 1;
+	row->kill_id = kid;
+	row->flags = flags;
+	row->raw = ev->raw;
+}
+
+/* LIVE: decoded row to the UI caches, before the CSV flush. */
+static void	publish_bus(t_engine_run *r, const t_hunt_csv_row_view *row,
+					int len)
+{
+	if (!r->bus)
+		return ;
+	if (len <= 0 || r->csv.err)
+	{
+		/* Offsets no longer known: readers go back to the CSV only. */
+		r->bus = 0;
+		hunt_bus_end();
+		return ;
+	}
+	hunt_bus_publish(row, r->csv_pos, len);
+	r->csv_pos += len;
+}
+
+static int	write_event(t_engine_run *r, const t_hunt_event *ev,
+					const t_event_prep *p)
+{
+	t_hunt_csv_row_view	row;
+	int64_t				kid;
+	uint32_t			flags;
+	int					len;
+
 	/* kill_id: assign on KILL; attach LOOT_ITEM to best recent kill (ring-buffer) */
 	kid = 0;
-	if (strncmp(ev->type, "KILL", 4) == 0 && kill_id_state)
+	if (strncmp(ev->type, "KILL", 4) == 0)
 	{
-		kid = ++(*kill_id_state);
-		if (kctx)
-			kill_ctx_on_kill(kctx, ts_unix, kid);
+		kid = ++r->kill_id;
+		kill_ctx_on_kill(&r->kctx, p->ts_unix, kid);
 	}
-	else if (strcmp(ev->type, "LOOT_ITEM") == 0 && kctx)
+	else if (strcmp(ev->type, "LOOT_ITEM") == 0)
 	{
-		kid = kill_ctx_attach_loot(kctx, ts_unix);
+		kid = kill_ctx_attach_loot(&r->kctx, p->ts_unix);
 	}
-	flags = (has_v ? 1u : 0u);
+	flags = (p->has_v ? 1u : 0u);
 	if (kid > 0)
 		flags |= (1u << 1);
-	hunt_csv_write_v2(out, ts_unix, ev->type, ev->name, qty,
-					v, kid, flags, ev->raw);
+	len = hunt_csv_writer_append(&r->csv, p->ts_unix, ev->type, ev->name,
+					p->qty, p->v, kid, flags, ev->raw);
+	event_row(ev, p, kid, flags, &row);
+	if (len > 0 && r->bin.bin)
+		hunt_bin_writer_append(&r->bin, &row, len);
+	publish_bus(r, &row, len);
 	/* Health: parser is alive as soon as an event is validated. */
 	monitor_health_on_event(ft_time_ms());
-	if (ferror(out))
-		monitor_health_on_io_error("CSV write", errno, ferror(out));
-	/*
-	 * IMPORTANT (LIVE graph UX):
-	 * Force flush on KILL/LOOT_ITEM so points appear immediately after a kill,
-	 * not only after the next SHOT (buffered IO).
-	 */
-	csv_maybe_flush(out, kctx, ev->type);
+	csv_maybe_commit(r, csv_is_critical_event(ev->type));
 	return (0);
 }
 
+static int	append_event(t_engine_run *r, const t_hunt_event *ev)
+{
+	t_event_prep	p;
+
+	if (!r->out || !ev || r->csv.fd < 0)
+		return (-1);
+	prepare_event(ev, &p);
+	return (write_event(r, ev, &p));
+}
+
 static int	backup_legacy_hunt_csv(const char *csv_path, const char *suffix)
 {
 	char	bak[1024];
@@ -362,38 +401,35 @@ static int	backup_legacy_hunt_csv(const char *csv_path, const char *suffix)
 	return (1);
 }
 
-static int	try_process_globals(FILE *out, int64_t *kill_id_state,
-						t_kill_ctx *kctx, const char *line)
+static int	try_process_globals(t_engine_run *r, const char *line)
 {
 	t_globals_event	gev;
 	t_hunt_event		ev;
 	
 	if (globals_parse_line(line, &gev) != 1)
 		return (0);
-	if (g_my_name[0] && !strstr(gev.raw, g_my_name))
+	if (r->rules.player_name[0] && !strstr(gev.raw, r->rules.player_name))
 		return (1);
 	map_globals_to_hunt(&ev, &gev);
-	append_event(out, kill_id_state, kctx, &ev);
+	append_event(r, &ev);
 	return (1);
 }
 
-static void	flush_pending_hunt(FILE *out, int64_t *kill_id_state,
-						t_kill_ctx *kctx, t_hunt_event *ev)
+static void	flush_pending_hunt(t_engine_run *r, t_hunt_event *ev)
 {
-	while (hunt_pending_pop(ev))
-		append_event(out, kill_id_state, kctx, ev);
+	while (hunt_rules_ctx_pending_pop(&r->rules, ev))
+		append_event(r, ev);
 }
 
-static void	process_hunt(FILE *out, int64_t *kill_id_state,
-					t_kill_ctx *kctx, const char *line)
+static void	process_hunt(t_engine_run *r, const char *line)
 {
 	t_hunt_event	ev;
 	int			ret;
 	int			sweat_enabled;
 
-	if (hunt_should_ignore_line(line))
+	ret = hunt_rules_ctx_parse_line(&r->rules, line, &ev);
+	if (ret == 2)
 		return ;
-	ret = hunt_parse_line(line, &ev);
 	if (ret < 0)
 	{
 		monitor_health_on_parse_error("hunt_parse_line");
@@ -410,44 +446,60 @@ static void	process_hunt(FILE *out, int64_t *kill_id_state,
 	{
 		t_hunt_event	pend;
 
-		if (hunt_pending_pop(&pend))
-			append_event(out, kill_id_state, kctx, &pend);
+		if (hunt_rules_ctx_pending_pop(&r->rules, &pend))
+			append_event(r, &pend);
 	}
-	append_event(out, kill_id_state, kctx, &ev);
-	flush_pending_hunt(out, kill_id_state, kctx, &ev);
+	append_event(r, &ev);
+	flush_pending_hunt(r, &ev);
 }
 
-static void	process_line(FILE *out, int64_t *kill_id_state,
-					t_kill_ctx *kctx, const char *line)
+static void	process_line(t_engine_run *r, const char *line)
 {
-	if (try_process_globals(out, kill_id_state, kctx, line))
+	if (try_process_globals(r, line))
 		return ;
-	process_hunt(out, kill_id_state, kctx, line);
+	process_hunt(r, line);
 }
 
+static void	close_in(FILE **in)
+{
+	if (in && *in)
+	{
+		fclose(*in);
+		*in = NULL;
+	}
+}
+
+/*
+ * 'in' may be NULL: LIVE reads chat.log through chat_ingest, only the CSV
+ * side is opened here.
+ */
 static int	open_io_files(FILE **in, FILE **out,
 					  const char *chatlog_path, const char *csv_path)
 {
 	char	line[256];
+	int		rc;
+	int		err;
 
-	*in = fs_fopen_shared_read(chatlog_path);
-	if (!*in)
+	if (in)
 	{
-		log_engine_error("open chatlog", chatlog_path);
-		monitor_health_on_io_error("open chatlog", errno, 0);
-		return (-1);
+		*in = fs_fopen_shared_read(chatlog_path);
+		if (!*in)
+		{
+			log_engine_error("open chatlog", chatlog_path);
+			monitor_health_on_io_error("open chatlog", errno, 0);
+			return (-1);
+		}
 	}
 	*out = fopen(csv_path, "ab+");
 	if (!*out)
 	{
 		log_engine_error("open csv", csv_path);
 		monitor_health_on_io_error("open csv", errno, 0);
-		fclose(*in);
-		*in = NULL;
+		close_in(in);
 		return (-1);
 	}
 	monitor_health_reset(chatlog_path, csv_path);
-	/* Big buffered IO for intensive sessions (flushed by csv_maybe_flush). */
+	/* Header/repair only: rows then go through hunt_csv_writer. */
 	(void)setvbuf(*out, NULL, _IOFBF, 1 << 20);
 	/*
 	 * V2 strict only.
@@ -472,8 +524,7 @@ static int	open_io_files(FILE **in, FILE **out,
 		{
 			log_engine_error("backup legacy hunt csv", csv_path);
 			monitor_health_on_io_error("backup legacy hunt csv", errno, 0);
-			fclose(*in);
-			*in = NULL;
+			close_in(in);
 			return (-1);
 		}
 		*out = fopen(csv_path, "ab+");
@@ -481,8 +532,7 @@ static int	open_io_files(FILE **in, FILE **out,
 		{
 			log_engine_error("open csv after backup", csv_path);
 			monitor_health_on_io_error("open csv after backup", errno, 0);
-			fclose(*in);
-			*in = NULL;
+			close_in(in);
 			return (-1);
 		}
 		(void)setvbuf(*out, NULL, _IOFBF, 1 << 20);
@@ -493,116 +543,258 @@ static int	open_io_files(FILE **in, FILE **out,
 	/* If repair truncated the file to 0, recreate a clean V2 header. */
 	hunt_csv_ensure_header_v2(*out);
 	(void)fseek(*out, 0, SEEK_END);
-	csv_maybe_flush(*out, NULL, NULL);
-	monitor_health_update_io(ft_time_ms(), fs_file_size(chatlog_path), ftell(*in), fs_file_size(csv_path), 0);
+	rc = fflush(*out);
+	err = errno;
+	monitor_health_on_flush(ft_time_ms(), (rc == 0 && !ferror(*out)), err,
+		ferror(*out));
+	if (in)
+		monitor_health_update_io(ft_time_ms(), fs_file_size(chatlog_path), ftell(*in), fs_file_size(csv_path), 0);
+	else
+		monitor_health_update_csv(fs_file_size(csv_path));
 	return (0);
 }
 
 
-static int	replay_loop(FILE *in, FILE *out, int64_t *kill_id_state,
-					t_kill_ctx *kctx, atomic_int *stop_flag)
+/* Health progress refresh period during REPLAY (in lines). */
+#define REPLAY_PROGRESS_LINES 4096
+
+static void	log_replay_throughput(unsigned long long bytes, uint64_t ms)
 {
-	char	buf[2048];
+	FILE	*f;
+	double	mb;
+
+	f = fopen(tm_path_parser_debug_log(), "ab");
+	if (!f)
+		return ;
+	mb = (double)bytes / (1024.0 * 1024.0);
+	fprintf(f, "[ENGINE] replay: %.2f MiB in %llu ms (%.2f MiB/s)\n",
+		mb, (unsigned long long)ms,
+		ms ? mb * 1000.0 / (double)ms : 0.0);
+	fclose(f);
+}
 
+static int	replay_loop(FILE *in, t_engine_run *r, atomic_int *stop_flag)
+{
+	t_line_reader	lr;
+	t_line_view		v;
+	uint64_t		t0;
+	unsigned int	n;
+
+	if (line_reader_init(&lr, in, 0) != 0)
+		return (-1);
+	t0 = ft_time_ms();
+	n = 0;
 	while (!stop_flag || (atomic_load(stop_flag) == 0))
 	{
-		if (!fgets(buf, sizeof(buf), in))
+		if (line_reader_next(&lr, &v) <= 0)
 			break ;
-		process_line(out, kill_id_state, kctx, buf);
+		process_line(r, v.ptr);
+		if (++n % REPLAY_PROGRESS_LINES == 0)
+			monitor_health_on_replay_progress((long long)lr.bytes,
+				ft_time_ms() - t0, 0);
 	}
+	monitor_health_on_replay_progress((long long)lr.bytes, ft_time_ms() - t0, 1);
+	log_replay_throughput(lr.bytes, ft_time_ms() - t0);
+	line_reader_free(&lr);
 	return (0);
 }
 
-int	parser_run_replay(const char *chatlog_path, const char *csv_path,
-					  atomic_int *stop_flag)
+/*
+ * Parallel REPLAY (replay_shards): pattern matching and the order-independent
+ * row fields run on worker threads; hunt_rules_ctx_apply() and write_event()
+ * (kill_id, kill ctx, inferred kills) run here in file order, so the CSV is
+ * byte-identical to replay_loop().
+ */
+typedef struct s_replay_rec
 {
-	FILE	*in;
-	FILE	*out;
-	int64_t	kill_id_state;
-	t_kill_ctx	kctx;
-	
-	kill_id_state = 0;
-	kill_ctx_reset(&kctx);
-	if (open_io_files(&in, &out, chatlog_path, csv_path) < 0)
-		return (-1);
-	kill_id_state = hunt_csv_tail_max_kill_id(csv_path);
-	replay_loop(in, out, &kill_id_state, &kctx, stop_flag);
-	fclose(out);
-	fclose(in);
-	return (0);
-}
+	int				is_globals;
+	t_hunt_decoded	d;
+	t_event_prep	prep;
+}	t_replay_rec;
 
-static int	reopen_if_rotated(FILE **in, const char *path,
-					long *last_pos, const char *csv_path)
+typedef struct s_replay_par
 {
-	long	sz;
-	int	rotated;
-	uint64_t	now_ms;
+	t_engine_run	*run;
+	int				sweat_enabled;
+	uint64_t		t0;
+}	t_replay_par;
 
-	rotated = 0;
-	now_ms = ft_time_ms();
-	if (!in || !*in || !path || !last_pos)
+/*
+ * Worker thread: same filters as process_line(), without the ordered state
+ * (run->rules.player_name is only read).
+ */
+static int	replay_decode(void *ctx, const char *line, size_t len, void *rec)
+{
+	t_replay_par	*rp;
+	t_replay_rec	*r;
+	t_globals_event	gev;
+
+	(void)len;
+	rp = (t_replay_par *)ctx;
+	r = (t_replay_rec *)rec;
+	r->is_globals = 0;
+	if (globals_parse_line(line, &gev) == 1)
+	{
+		if (rp->run->rules.player_name[0]
+			&& !strstr(gev.raw, rp->run->rules.player_name))
+			return (0);
+		r->is_globals = 1;
+		map_globals_to_hunt(&r->d.ev, &gev);
+		prepare_event(&r->d.ev, &r->prep);
+		return (1);
+	}
+	hunt_decode_line(line, &r->d);
+	if (r->d.ignored)
 		return (0);
-	clearerr(*in);
-	sz = fs_file_size(path);
-	if (sz >= 0 && sz < *last_pos)
+	if (r->d.kind == HUNT_LINE_NONE)
+		return (-1);
+	if (r->d.kind == HUNT_LINE_SWEAT && !rp->sweat_enabled)
+		return (0);
+	prepare_event(&r->d.ev, &r->prep);
+	return (1);
+}
+
+/* Caller thread, file order: mirrors process_hunt() / try_process_globals(). */
+static void	replay_apply(void *ctx, void *rec)
+{
+	t_replay_par	*rp;
+	t_replay_rec	*r;
+	t_hunt_event	pend;
+	int				ret;
+
+	rp = (t_replay_par *)ctx;
+	r = (t_replay_rec *)rec;
+	if (r->is_globals)
 	{
-		/* chat.log rotated or truncated */
-		rotated = 1;
-		fclose(*in);
-		*in = fs_fopen_shared_read(path);
-		if (!*in)
-		{
-			monitor_health_on_io_error("reopen chatlog", errno, 0);
-			ui_sleep_ms(250);
-			return (-1);
-		}
-		fseek(*in, 0, SEEK_END);
-		*last_pos = ftell(*in);
+		write_event(rp->run, &r->d.ev, &r->prep);
+		return ;
 	}
-	else if (sz >= 0 && sz > *last_pos)
-		fseek(*in, *last_pos, SEEK_SET);
-	else
+	ret = hunt_rules_ctx_apply(&rp->run->rules, &r->d);
+	if (ret < 0)
 	{
-		ui_sleep_ms(200);
-		fseek(*in, *last_pos, SEEK_SET);
+		monitor_health_on_parse_error("hunt_parse_line");
+		return ;
 	}
-	if (csv_path)
-		monitor_health_update_io(now_ms, sz, *last_pos, fs_file_size(csv_path), rotated);
+	if (ret == 1 && hunt_rules_ctx_pending_pop(&rp->run->rules, &pend))
+		append_event(rp->run, &pend);
+	write_event(rp->run, &r->d.ev, &r->prep);
+	flush_pending_hunt(rp->run, &pend);
+}
+
+static void	replay_progress(void *ctx, unsigned long long bytes,
+					long long rejected)
+{
+	t_replay_par	*rp;
+
+	rp = (t_replay_par *)ctx;
+	if (rejected > 0)
+		monitor_health_on_parse_errors("hunt_parse_line", rejected);
+	monitor_health_on_replay_progress((long long)bytes, ft_time_ms() - rp->t0, 0);
+}
+
+static int	replay_parallel(FILE *in, t_engine_run *run, int threads,
+					atomic_int *stop_flag)
+{
+	t_replay_par		rp;
+	t_replay_shards_cfg	cfg;
+	uint64_t			ms;
+	int					rc;
+
+	memset(&rp, 0, sizeof(rp));
+	rp.run = run;
+	sweat_option_load(tm_path_options_cfg(), &rp.sweat_enabled);
+	rp.t0 = ft_time_ms();
+	memset(&cfg, 0, sizeof(cfg));
+	cfg.threads = threads;
+	cfg.rec_size = sizeof(t_replay_rec);
+	cfg.decode = replay_decode;
+	cfg.decode_ctx = &rp;
+	cfg.apply = replay_apply;
+	cfg.apply_ctx = &rp;
+	cfg.progress = replay_progress;
+	cfg.progress_ctx = &rp;
+	rc = replay_shards_run(in, &cfg, stop_flag);
+	if (rc != 0)
+		log_engine_error("parallel replay", tm_path_hunt_csv());
+	ms = ft_time_ms() - rp.t0;
+	monitor_health_on_replay_progress((long long)ftell(in), ms, 1);
+	log_replay_throughput((unsigned long long)ftell(in), ms);
+	return (rc);
+}
+
+static void	engine_run_init(t_engine_run *r)
+{
+	memset(r, 0, sizeof(*r));
+	/* Before any REPLAY worker: no thread races on the first build. */
+	if (hunt_rules_init() != 0)
+		log_engine_error("pattern_set_build (strstr fallback)", NULL);
+	kill_ctx_reset(&r->kctx);
+	hunt_rules_ctx_init(&r->rules);
+	hunt_rules_ctx_set_player_name(&r->rules, g_my_name);
+}
+
+int	parser_run_replay(const char *chatlog_path, const char *csv_path,
+					  atomic_int *stop_flag)
+{
+	FILE			*in;
+	t_engine_run	run;
+	int				threads;
+	
+	engine_run_init(&run);
+	if (open_io_files(&in, &run.out, chatlog_path, csv_path) < 0)
+		return (-1);
+	run.kill_id = hunt_csv_tail_max_kill_id(csv_path);
+	(void)hunt_csv_writer_open(&run.csv, run.out, CSV_FLUSH_THROUGHPUT);
+	(void)hunt_bin_writer_open(&run.bin, csv_path, run.out);
+	threads = replay_shards_default_threads();
+	monitor_health_set_replay_threads(threads);
+	if (threads > 1)
+		replay_parallel(in, &run, threads, stop_flag);
 	else
-		monitor_health_update_io(now_ms, sz, *last_pos, 0, rotated);
-	return (rotated);
+		replay_loop(in, &run, stop_flag);
+	csv_commit(&run);
+	hunt_csv_writer_close(&run.csv);
+	fclose(run.out);
+	hunt_bin_writer_close(&run.bin);
+	fclose(in);
+	return (0);
 }
 
-static void	live_loop(FILE *in, FILE *out, int64_t *kill_id_state,
-					t_kill_ctx *kctx, const char *path, const char *csv_path, atomic_int *stop_flag)
+/*
+ * LIVE: chat.log is tailed once by chat_ingest (shared with the globals
+ * parser); this loop only consumes complete lines from the shared ring.
+ * LIVE_WAIT_SLICE_MS bounds each wait so stop_flag stays responsive.
+ */
+#define LIVE_WAIT_SLICE_MS 250
+
+static void	live_loop(t_chat_ingest_sub *sub, t_engine_run *r,
+					const char *csv_path, atomic_int *stop_flag)
 {
-	char		buf[2048];
-	long		last_pos;
+	const char	*line;
 	uint64_t	last_io_ms;
 	uint64_t	now_ms;
+	int			dirty;
 
-	last_io_ms = 0;
-	fseek(in, 0, SEEK_END);
-	last_pos = ftell(in);
-	now_ms = ft_time_ms();
-	monitor_health_update_io(now_ms, fs_file_size(path), last_pos, csv_path ? fs_file_size(csv_path) : 0, 0);
-	last_io_ms = now_ms;
+	last_io_ms = ft_time_ms();
+	dirty = 0;
 	while (!stop_flag || (atomic_load(stop_flag) == 0))
 	{
-		if (fgets(buf, sizeof(buf), in))
+		line = chat_ingest_next(sub, LIVE_WAIT_SLICE_MS);
+		if (line)
 		{
-			process_line(out, kill_id_state, kctx, buf);
-			last_pos = ftell(in);
+			process_line(r, line);
+			dirty = 1;
 		}
-		else
-			(void)reopen_if_rotated(&in, path, &last_pos, csv_path);
-
+		/* Periodic CSV size snapshot only while lines flow (no stat() when AFK). */
 		now_ms = ft_time_ms();
-		if (now_ms - last_io_ms >= 1000)
+		/* Idle: an aged batch must not wait for the next chat line. */
+		if (hunt_csv_writer_due(&r->csv, now_ms, 0))
+			csv_commit(r);
+		if (dirty && now_ms - last_io_ms >= 1000)
 		{
-			monitor_health_update_io(now_ms, fs_file_size(path), last_pos, csv_path ? fs_file_size(csv_path) : 0, 0);
+			monitor_health_update_csv(csv_path ? fs_file_size(csv_path) : 0);
 			last_io_ms = now_ms;
+			dirty = 0;
 		}
 	}
 }
@@ -610,18 +802,33 @@ static void	live_loop(FILE *in, FILE *out, int64_t *kill_id_state,
 int	parser_run_live(const char *chatlog_path, const char *csv_path,
 					atomic_int *stop_flag)
 {
-	FILE	*in;
-	FILE	*out;
-	int64_t	kill_id_state;
-	t_kill_ctx	kctx;
+	t_chat_ingest_sub	*sub;
+	t_engine_run		run;
 	
-	kill_id_state = 0;
-	kill_ctx_reset(&kctx);
-	if (open_io_files(&in, &out, chatlog_path, csv_path) < 0)
+	engine_run_init(&run);
+	if (open_io_files(NULL, &run.out, chatlog_path, csv_path) < 0)
 		return (-1);
-	kill_id_state = hunt_csv_tail_max_kill_id(csv_path);
-	live_loop(in, out, &kill_id_state, &kctx, chatlog_path, csv_path, stop_flag);
-	fclose(out);
-	fclose(in);
+	sub = chat_ingest_subscribe(chatlog_path, "hunt");
+	if (!sub)
+	{
+		log_engine_error("open chatlog", chatlog_path);
+		fclose(run.out);
+		return (-1);
+	}
+	run.kill_id = hunt_csv_tail_max_kill_id(csv_path);
+	(void)hunt_csv_writer_open(&run.csv, run.out, CSV_FLUSH_LATENCY);
+	(void)hunt_bin_writer_open(&run.bin, csv_path, run.out);
+	run.csv_pos = (int64_t)ftell(run.out);
+	run.bus = (run.csv_pos >= 0);
+	if (run.bus)
+		hunt_bus_begin((long long)run.csv_pos);
+	live_loop(sub, &run, csv_path, stop_flag);
+	chat_ingest_unsubscribe(sub);
+	csv_commit(&run);
+	hunt_csv_writer_close(&run.csv);
+	fclose(run.out);
+	hunt_bin_writer_close(&run.bin);
+	if (run.bus)
+		hunt_bus_end();
 	return (0);
 }
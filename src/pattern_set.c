@@ -0,0 +1,239 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pattern_set.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: login <login@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/20 00:00:00 by login             #+#    #+#             */
+/*   Updated: 2026/02/20 00:00:00 by login            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pattern_set.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Build:
+ *  1) byte classes (bytes of the patterns get their own class, the rest 0),
+ *  2) trie of all patterns (state 0 = root),
+ *  3) BFS: failure links folded into the transition table (full DFA) and
+ *     output masks merged along the suffix links,
+ *  4) transitions rewritten as "row offset of the next state | PS_ACCEPT",
+ *     and the table of bytes that leave the root (first-byte dispatch).
+ */
+#define PS_ACCEPT 0x8000u
+
+static int	build_classes(t_pattern_set *ps, const char *const *pats,
+				size_t npats, size_t *states)
+{
+	const unsigned char	*p;
+	size_t				i;
+
+	ps->nclass = 1;
+	*states = 1;
+	for (i = 0; i < npats; i++)
+	{
+		if (!pats[i] || !pats[i][0])
+			return (-1);
+		p = (const unsigned char *)pats[i];
+		while (*p)
+		{
+			if (!ps->cls[*p])
+				ps->cls[*p] = (uint8_t)ps->nclass++;
+			(*states)++;
+			p++;
+		}
+	}
+	if (*states * ps->nclass > PATTERN_SET_MAX_CELLS)
+		return (-1);
+	return (0);
+}
+
+static size_t	trie_insert(t_pattern_set *ps, const char *pat, size_t next)
+{
+	const unsigned char	*p;
+	size_t				s;
+	size_t				c;
+
+	s = 0;
+	p = (const unsigned char *)pat;
+	while (*p)
+	{
+		c = s * ps->nclass + ps->cls[*p];
+		if (!ps->delta[c])
+			ps->delta[c] = (uint16_t)next++;
+		s = ps->delta[c];
+		p++;
+	}
+	ps->out[s] |= (uint64_t)1 << (size_t)(ps->npats);
+	return (next);
+}
+
+static int	link_failures(t_pattern_set *ps)
+{
+	size_t		*queue;
+	uint16_t	*fail;
+	size_t		head;
+	size_t		tail;
+	size_t		s;
+	size_t		c;
+	uint16_t	t;
+
+	queue = (size_t *)malloc(ps->nstates * sizeof(*queue));
+	fail = (uint16_t *)calloc(ps->nstates, sizeof(*fail));
+	if (!queue || !fail)
+	{
+		free(queue);
+		free(fail);
+		return (-1);
+	}
+	head = 0;
+	tail = 0;
+	for (c = 1; c < ps->nclass; c++)
+		if (ps->delta[c])
+			queue[tail++] = ps->delta[c];
+	while (head < tail)
+	{
+		s = queue[head++];
+		ps->out[s] |= ps->out[fail[s]];
+		for (c = 0; c < ps->nclass; c++)
+		{
+			t = ps->delta[s * ps->nclass + c];
+			if (t)
+			{
+				fail[t] = ps->delta[(size_t)fail[s] * ps->nclass + c];
+				queue[tail++] = t;
+			}
+			else
+				ps->delta[s * ps->nclass + c]
+					= ps->delta[(size_t)fail[s] * ps->nclass + c];
+		}
+	}
+	free(queue);
+	free(fail);
+	return (0);
+}
+
+static void	encode_rows(t_pattern_set *ps)
+{
+	size_t	i;
+	size_t	t;
+
+	for (i = 0; i < 256; i++)
+		ps->first[i] = (ps->cls[i] && ps->delta[ps->cls[i]] != 0);
+
+	for (i = 0; i < ps->nstates * ps->nclass; i++)
+	{
+		t = ps->delta[i];
+		ps->delta[i] = (uint16_t)(t * ps->nclass);
+		if (ps->out[t])
+			ps->delta[i] |= PS_ACCEPT;
+	}
+}
+
+int	pattern_set_build(t_pattern_set *ps, const char *const *pats, size_t npats)
+{
+	size_t	cap;
+	size_t	next;
+	size_t	i;
+
+	if (!ps)
+		return (-1);
+	memset(ps, 0, sizeof(*ps));
+	if (!pats || npats == 0 || npats > PATTERN_SET_MAX
+		|| build_classes(ps, pats, npats, &cap) != 0)
+		return (-1);
+	ps->delta = (uint16_t *)calloc(cap * ps->nclass, sizeof(*ps->delta));
+	ps->out = (uint64_t *)calloc(cap, sizeof(*ps->out));
+	ps->len = (size_t *)calloc(npats, sizeof(*ps->len));
+	if (!ps->delta || !ps->out || !ps->len)
+	{
+		pattern_set_free(ps);
+		return (-1);
+	}
+	next = 1;
+	for (i = 0; i < npats; i++)
+	{
+		ps->len[i] = strlen(pats[i]);
+		next = trie_insert(ps, pats[i], next);
+		ps->npats++;
+	}
+	ps->nstates = next;
+	if (link_failures(ps) != 0)
+	{
+		pattern_set_free(ps);
+		return (-1);
+	}
+	encode_rows(ps);
+	return (0);
+}
+
+void	pattern_set_free(t_pattern_set *ps)
+{
+	if (!ps)
+		return ;
+	free(ps->delta);
+	free(ps->out);
+	free(ps->len);
+	memset(ps, 0, sizeof(*ps));
+}
+
+static void	record_hits(const t_pattern_set *ps, size_t row,
+				const unsigned char *p, t_pattern_match *m)
+{
+	uint64_t	hit;
+	size_t		id;
+
+	hit = ps->out[row / ps->nclass] & ~m->found;
+	while (hit)
+	{
+		id = 0;
+		while (!(hit & ((uint64_t)1 << id)))
+			id++;
+		m->at[id] = (const char *)p + 1 - ps->len[id];
+		m->found |= (uint64_t)1 << id;
+		hit &= ~((uint64_t)1 << id);
+	}
+}
+
+void	pattern_set_scan(const t_pattern_set *ps, const char *s,
+			t_pattern_match *m)
+{
+	const unsigned char	*p;
+	const uint16_t		*delta;
+	const uint8_t		*cls;
+	unsigned			v;
+
+	m->found = 0;
+	if (!ps || !ps->delta || !s)
+		return ;
+	delta = ps->delta;
+	cls = ps->cls;
+	p = (const unsigned char *)s;
+	v = 0;
+	while (*p)
+	{
+		/* first-byte dispatch: at the root, skip bytes no pattern starts with */
+		if (v == 0)
+		{
+			while (*p && !ps->first[*p])
+				p++;
+			if (!*p)
+				break ;
+		}
+		v = delta[(v & ~PS_ACCEPT) + cls[*p]];
+		if (v & PS_ACCEPT)
+			record_hits(ps, v & ~PS_ACCEPT, p, m);
+		p++;
+	}
+}
+
+const char	*pattern_match_at(const t_pattern_match *m, size_t id)
+{
+	if (!m || id >= PATTERN_SET_MAX || !(m->found & ((uint64_t)1 << id)))
+		return (NULL);
+	return (m->at[id]);
+}
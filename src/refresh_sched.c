@@ -0,0 +1,160 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   refresh_sched.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/21                                #+#    #+#             */
+/*   Updated: 2026/02/21                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "refresh_sched.h"
+
+#include "fs_utils.h"
+#include "utils.h"
+
+#include <string.h>
+
+void	refresh_sched_init(t_refresh_sched *s, uint64_t period_ms)
+{
+	if (!s)
+		return ;
+	memset(s, 0, sizeof(*s));
+	s->period_ms = period_ms;
+}
+
+int	refresh_sched_add(t_refresh_sched *s, const char *name,
+		t_refresh_probe probe, t_refresh_fn refresh, void *ctx)
+{
+	t_refresh_source	*src;
+
+	if (!s || !probe || !refresh || s->n >= REFRESH_SCHED_MAX)
+		return (-1);
+	src = &s->src[s->n];
+	memset(src, 0, sizeof(*src));
+	src->name = name ? name : "?";
+	src->probe = probe;
+	src->refresh = refresh;
+	src->ctx = ctx;
+	src->dirty = 1;
+	return (s->n++);
+}
+
+void	refresh_sched_invalidate(t_refresh_sched *s)
+{
+	int	i;
+
+	if (!s)
+		return ;
+	i = 0;
+	while (i < s->n)
+		s->src[i++].dirty = 1;
+	s->last_ms = 0;
+}
+
+static void	source_refresh(t_refresh_source *src)
+{
+	uint64_t	t0;
+	uint64_t	dt;
+
+	t0 = ft_time_us();
+	src->refresh(src->ctx);
+	dt = ft_time_us() - t0;
+	src->last_us = dt;
+	src->total_us += dt;
+	if (dt > src->max_us)
+		src->max_us = dt;
+	src->misses++;
+	src->dirty = 0;
+}
+
+void	refresh_sched_mark(t_refresh_sched *s, int idx)
+{
+	if (!s || idx < 0 || idx >= s->n)
+		return ;
+	s->src[idx].dirty = 1;
+	s->pending = 1;
+}
+
+int	refresh_sched_tick(t_refresh_sched *s, uint64_t now_ms)
+{
+	t_refresh_source	*src;
+	uint64_t			t0;
+	uint64_t			spent;
+	uint64_t			sig;
+	int					probe;
+	int					done;
+	int					i;
+
+	if (!s)
+		return (0);
+	probe = (s->last_ms == 0 || now_ms - s->last_ms > s->period_ms);
+	if (!probe && !s->pending)
+		return (0);
+	if (probe)
+		s->last_ms = now_ms;
+	s->pending = 0;
+	done = 0;
+	spent = 0;
+	t0 = ft_time_us();
+	i = 0;
+	while (i < s->n)
+	{
+		src = &s->src[i++];
+		if (probe)
+		{
+			sig = src->probe(src->ctx);
+			if (sig != src->sig)
+				src->dirty = 1;
+			src->sig = sig;
+			if (!src->dirty)
+				src->hits++;
+		}
+		if (!src->dirty)
+			continue ;
+		source_refresh(src);
+		spent += src->last_us;
+		done++;
+	}
+	/* refresh costs are accounted per source, not in the probe pass */
+	if (probe)
+		s->probe_us = ft_time_us() - t0 - spent;
+	return (done);
+}
+
+/* ------------------------------- signatures ------------------------------- */
+
+uint64_t	refresh_sig_begin(void)
+{
+	return (14695981039346656037ULL);
+}
+
+uint64_t	refresh_sig_u64(uint64_t h, uint64_t v)
+{
+	int	i;
+
+	i = 0;
+	while (i < 8)
+	{
+		h ^= (v >> (i * 8)) & 0xFFu;
+		h *= 1099511628211ULL;
+		i++;
+	}
+	return (h);
+}
+
+uint64_t	refresh_sig_file(uint64_t h, const char *path)
+{
+	long long	size;
+	long long	mtime;
+
+	if (fs_file_stat(path, &size, &mtime) != 0)
+	{
+		size = -1;
+		mtime = -1;
+	}
+	h = refresh_sig_u64(h, (uint64_t)size);
+	return (refresh_sig_u64(h, (uint64_t)mtime));
+}
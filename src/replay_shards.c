@@ -0,0 +1,336 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   replay_shards.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: login <login@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/20 00:00:00 by login             #+#    #+#             */
+/*   Updated: 2026/02/20 00:00:00 by login            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* sysconf(_SC_NPROCESSORS_ONLN) under strict C99 builds */
+#ifndef _WIN32
+# ifndef _POSIX_C_SOURCE
+#  define _POSIX_C_SOURCE 200809L
+# endif
+#endif
+
+#include "replay_shards.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * One batch = threads * shard_bytes of chat.log. Records of a batch are kept
+ * until it has been applied, so the shard size bounds memory: a shard of
+ * SHOT spam (~100 bytes/line) yields a few thousand records.
+ */
+
+typedef struct s_shard
+{
+	const t_replay_shards_cfg	*cfg;
+	const char					*beg;
+	size_t						len;
+	char						*line;     /* NUL-terminated copy of a line */
+	size_t						line_cap;
+	unsigned char				*recs;
+	size_t						nrec;
+	size_t						rec_cap;
+	long long					rejected;
+	int							err;
+}	t_shard;
+
+/* -------------------------------------------------------------------------- */
+/* Portable thread                                                            */
+/* -------------------------------------------------------------------------- */
+
+static void	shard_decode(t_shard *s);
+
+#ifdef _WIN32
+# include <windows.h>
+
+typedef HANDLE	t_shard_thread;
+
+static DWORD WINAPI	thread_fn(LPVOID p)
+{
+	shard_decode((t_shard *)p);
+	return (0);
+}
+
+static int	thread_start(t_shard_thread *th, t_shard *s)
+{
+	DWORD	id;
+
+	*th = CreateThread(NULL, 0, thread_fn, s, 0, &id);
+	return (*th ? 0 : -1);
+}
+
+static void	thread_join(t_shard_thread *th)
+{
+	WaitForSingleObject(*th, INFINITE);
+	CloseHandle(*th);
+}
+
+static int	cpu_count(void)
+{
+	SYSTEM_INFO	si;
+
+	GetSystemInfo(&si);
+	return ((int)si.dwNumberOfProcessors);
+}
+#else
+# include <pthread.h>
+# include <unistd.h>
+
+typedef pthread_t	t_shard_thread;
+
+static void	*thread_fn(void *p)
+{
+	shard_decode((t_shard *)p);
+	return (NULL);
+}
+
+static int	thread_start(t_shard_thread *th, t_shard *s)
+{
+	return (pthread_create(th, NULL, thread_fn, s) == 0 ? 0 : -1);
+}
+
+static void	thread_join(t_shard_thread *th)
+{
+	pthread_join(*th, NULL);
+}
+
+static int	cpu_count(void)
+{
+	long	n;
+
+	n = sysconf(_SC_NPROCESSORS_ONLN);
+	return (n > 0 ? (int)n : 1);
+}
+#endif
+
+int	replay_shards_default_threads(void)
+{
+	const char	*v;
+	int			n;
+
+	v = getenv("TM_REPLAY_THREADS");
+	if (v && *v)
+		n = atoi(v);
+	else
+		n = cpu_count();
+	if (n < 1)
+		n = 1;
+	if (n > REPLAY_SHARDS_MAX_THREADS)
+		n = REPLAY_SHARDS_MAX_THREADS;
+	return (n);
+}
+
+/* -------------------------------------------------------------------------- */
+/* Worker                                                                     */
+/* -------------------------------------------------------------------------- */
+
+static int	grow(void **p, size_t *cap, size_t need, size_t elem)
+{
+	size_t	n;
+	void	*q;
+
+	if (need <= *cap)
+		return (0);
+	n = *cap ? *cap : 64;
+	while (n < need)
+		n *= 2;
+	q = realloc(*p, n * elem);
+	if (!q)
+		return (-1);
+	*p = q;
+	*cap = n;
+	return (0);
+}
+
+static void	shard_decode(t_shard *s)
+{
+	const char	*p;
+	const char	*end;
+	const char	*nl;
+	size_t		len;
+	int			rc;
+
+	p = s->beg;
+	end = s->beg + s->len;
+	while (p < end && !s->err)
+	{
+		nl = (const char *)memchr(p, '\n', (size_t)(end - p));
+		len = nl ? (size_t)(nl - p) + 1 : (size_t)(end - p);
+		if (grow((void **)&s->line, &s->line_cap, len + 1, 1) != 0
+			|| grow((void **)&s->recs, &s->rec_cap, s->nrec + 1,
+				s->cfg->rec_size) != 0)
+		{
+			s->err = 1;
+			break ;
+		}
+		memcpy(s->line, p, len);
+		s->line[len] = '\0';
+		rc = s->cfg->decode(s->cfg->decode_ctx, s->line, len,
+				s->recs + s->nrec * s->cfg->rec_size);
+		if (rc > 0)
+			s->nrec++;
+		else if (rc < 0)
+			s->rejected++;
+		p += len;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+/* Batch                                                                      */
+/* -------------------------------------------------------------------------- */
+
+/* Cut [buf, buf+len) into n shards, each ending right after a '\n'. */
+static int	split_shards(t_shard *sh, int n, const char *buf, size_t len)
+{
+	size_t		pos;
+	size_t		cut;
+	const char	*nl;
+	int			i;
+	int			used;
+
+	pos = 0;
+	used = 0;
+	for (i = 0; i < n && pos < len; i++)
+	{
+		cut = (i == n - 1) ? len : (len / (size_t)n) * (size_t)(i + 1);
+		if (cut < pos)
+			cut = pos;
+		if (cut < len)
+		{
+			nl = (const char *)memchr(buf + cut, '\n', len - cut);
+			cut = nl ? (size_t)(nl - buf) + 1 : len;
+		}
+		sh[used].beg = buf + pos;
+		sh[used].len = cut - pos;
+		sh[used].nrec = 0;
+		sh[used].rejected = 0;
+		sh[used].err = 0;
+		used++;
+		pos = cut;
+	}
+	return (used);
+}
+
+static int	run_batch(t_shard *sh, int n, const t_replay_shards_cfg *cfg,
+				long long *rejected)
+{
+	t_shard_thread	th[REPLAY_SHARDS_MAX_THREADS];
+	int				started[REPLAY_SHARDS_MAX_THREADS];
+	int				i;
+	size_t			k;
+	int				err;
+
+	err = 0;
+	for (i = 1; i < n; i++)
+		started[i] = (thread_start(&th[i], &sh[i]) == 0);
+	shard_decode(&sh[0]);
+	for (i = 1; i < n; i++)
+	{
+		if (started[i])
+			thread_join(&th[i]);
+		else
+			shard_decode(&sh[i]);
+	}
+	for (i = 0; i < n && !err; i++)
+	{
+		err = sh[i].err;
+		*rejected += sh[i].rejected;
+		for (k = 0; k < sh[i].nrec && !err; k++)
+			cfg->apply(cfg->apply_ctx, sh[i].recs + k * cfg->rec_size);
+	}
+	return (err ? -1 : 0);
+}
+
+/* Last '\n' of buf[0..len) (C99 has no memrchr). */
+static size_t	last_line_end(const char *buf, size_t len)
+{
+	while (len > 0 && buf[len - 1] != '\n')
+		len--;
+	return (len);
+}
+
+static void	free_shards(t_shard *sh, int n, char *buf)
+{
+	int	i;
+
+	for (i = 0; i < n; i++)
+	{
+		free(sh[i].line);
+		free(sh[i].recs);
+	}
+	free(buf);
+}
+
+int	replay_shards_run(FILE *in, const t_replay_shards_cfg *cfg,
+				atomic_int *stop_flag)
+{
+	t_shard				sh[REPLAY_SHARDS_MAX_THREADS];
+	char				*buf;
+	size_t				cap;
+	size_t				have;
+	size_t				got;
+	size_t				cut;
+	int					n;
+	int					used;
+	int					eof;
+	int					rc;
+	unsigned long long	bytes;
+	long long			rejected;
+
+	if (!in || !cfg || !cfg->decode || !cfg->apply || cfg->rec_size == 0)
+		return (-1);
+	n = cfg->threads > 0 ? cfg->threads : replay_shards_default_threads();
+	if (n > REPLAY_SHARDS_MAX_THREADS)
+		n = REPLAY_SHARDS_MAX_THREADS;
+	memset(sh, 0, sizeof(sh));
+	for (used = 0; used < n; used++)
+		sh[used].cfg = cfg;
+	cap = (size_t)n * (cfg->shard_bytes ? cfg->shard_bytes : REPLAY_SHARD_BYTES);
+	buf = (char *)malloc(cap);
+	if (!buf)
+		return (-1);
+	have = 0;
+	bytes = 0;
+	eof = 0;
+	rc = 0;
+	while (!eof && rc == 0 && (!stop_flag || atomic_load(stop_flag) == 0))
+	{
+		got = fread(buf + have, 1, cap - have, in);
+		eof = (have + got < cap);
+		have += got;
+		cut = eof ? have : last_line_end(buf, have);
+		if (cut == 0 && !eof)
+		{
+			/* a single line larger than the whole batch: grow and read on */
+			char	*nb;
+
+			nb = (char *)realloc(buf, cap * 2);
+			if (!nb)
+				rc = -1;
+			else
+			{
+				buf = nb;
+				cap *= 2;
+			}
+			continue ;
+		}
+		rejected = 0;
+		used = split_shards(sh, n, buf, cut);
+		rc = run_batch(sh, used, cfg, &rejected);
+		bytes += cut;
+		if (cfg->progress)
+			cfg->progress(cfg->progress_ctx, bytes, rejected);
+		memmove(buf, buf + cut, have - cut);
+		have -= cut;
+	}
+	free_shards(sh, n, buf);
+	return (rc);
+}
@@ -14,10 +14,12 @@
 
 #include "csv_index.h"
 #include "fs_utils.h"
+#include "hunt_csv.h"
 
+#include <limits.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
-#include <limits.h>
 
 int	session_load_range(const char *path, long *out_start, long *out_end)
 {
@@ -79,6 +81,218 @@ int	session_clear_range(const char *path)
 	return (0);
 }
 
+/* --------------------------- byte anchors ---------------------------------- */
+
+/* FNV-1a of the bytes right before 'off' (at most SESSION_ANCHOR_FP_LEN). */
+static long long	anchor_fingerprint(const char *csv_path, long long off)
+{
+	unsigned char	buf[SESSION_ANCHOR_FP_LEN];
+	FILE			*f;
+	uint32_t		h;
+	size_t			len;
+	size_t			i;
+
+	if (!csv_path || off <= 0 || off > LONG_MAX)
+		return (-1);
+	len = (off < SESSION_ANCHOR_FP_LEN) ? (size_t)off : sizeof(buf);
+	f = fs_fopen_shared_read(csv_path);
+	if (!f)
+		return (-1);
+	if (fseek(f, (long)(off - (long long)len), SEEK_SET) != 0
+		|| fread(buf, 1, len, f) != len)
+		len = 0;
+	fclose(f);
+	/* The anchor must start a line. */
+	if (len == 0 || buf[len - 1] != '\n')
+		return (-1);
+	h = 2166136261u;
+	i = 0;
+	while (i < len)
+	{
+		h ^= buf[i++];
+		h *= 16777619u;
+	}
+	return ((long long)h);
+}
+
+int	session_anchor_locate(const char *csv_path, long line, t_session_anchor *out)
+{
+	CsvIndexState		st;
+	t_hunt_csv_cursor	cur;
+	long				sz;
+
+	if (!out)
+		return (0);
+	out->line = (line < 0) ? 0 : line;
+	out->byte_offset = -1;
+	out->file_size = -1;
+	out->fingerprint = -1;
+	sz = (csv_path) ? fs_file_size(csv_path) : -1;
+	if (sz < 0)
+		return (0);
+	out->file_size = sz;
+	/* Fin du CSV (cas courant: nouvelle session): l'etat de l'index suffit. */
+	if (csv_index_state_load_ex(csv_path, &st, NULL)
+		&& st.bytes == (unsigned long long)sz
+		&& st.data_rows == (unsigned long long)out->line)
+		out->byte_offset = sz;
+	else if (hunt_csv_cursor_open(&cur, csv_path) == 0)
+	{
+		if (hunt_csv_cursor_goto(&cur, (unsigned long long)out->line, -1)
+			== (unsigned long long)out->line)
+			out->byte_offset = (long long)hunt_csv_cursor_tell(&cur);
+		hunt_csv_cursor_close(&cur);
+	}
+	if (out->byte_offset < 0)
+		return (0);
+	out->fingerprint = anchor_fingerprint(csv_path, out->byte_offset);
+	return (1);
+}
+
+long long	session_anchor_resolve(const char *csv_path,
+				const t_session_anchor *a)
+{
+	long	sz;
+
+	if (!csv_path || !a || a->byte_offset <= 0
+		|| a->byte_offset > a->file_size || a->byte_offset > LONG_MAX)
+		return (-1);
+	sz = fs_file_size(csv_path);
+	if (sz < 0 || (long long)sz < a->file_size || a->fingerprint < 0)
+		return (-1);
+	/* Same size or larger is not enough: the CSV may have been emptied. */
+	if (anchor_fingerprint(csv_path, a->byte_offset) != a->fingerprint)
+		return (-1);
+	return (a->byte_offset);
+}
+
+static void	anchor_unknown(t_session_anchor *a, long line)
+{
+	a->line = (line < 0) ? 0 : line;
+	a->byte_offset = -1;
+	a->file_size = -1;
+	a->fingerprint = -1;
+}
+
+int	session_load_offset_anchor(const char *path, t_session_anchor *out)
+{
+	FILE		*f;
+	long		line;
+	long long	b;
+	long long	sz;
+	long long	fp;
+
+	if (!out)
+		return (0);
+	anchor_unknown(out, 0);
+	if (!path)
+		return (0);
+	f = fopen(path, "rb");
+	if (!f)
+		return (0);
+	line = 0;
+	b = -1;
+	sz = -1;
+	fp = -1;
+	if (fscanf(f, "%ld %lld %lld %lld", &line, &b, &sz, &fp) < 4)
+		b = -1;
+	fclose(f);
+	anchor_unknown(out, line);
+	if (b >= 0 && sz >= b && fp >= 0)
+	{
+		out->byte_offset = b;
+		out->file_size = sz;
+		out->fingerprint = fp;
+	}
+	return (1);
+}
+
+int	session_save_offset_ex(const char *path, const char *csv_path, long offset)
+{
+	t_session_anchor	a;
+	FILE				*f;
+
+	if (!path)
+		return (-1);
+	if (!session_anchor_locate(csv_path, offset, &a))
+		return (session_save_offset(path, offset));
+	f = fopen(path, "wb");
+	if (!f)
+		return (-1);
+	fprintf(f, "%ld %lld %lld %lld", a.line, a.byte_offset, a.file_size,
+		a.fingerprint);
+	fclose(f);
+	return (0);
+}
+
+int	session_load_range_anchor(const char *path, t_session_anchor *out_start,
+		long *out_end)
+{
+	FILE		*f;
+	long		s;
+	long		e;
+	long long	b;
+	long long	sz;
+	long long	fp;
+
+	if (out_start)
+		anchor_unknown(out_start, 0);
+	if (out_end)
+		*out_end = -1;
+	if (!path || !out_start || !out_end)
+		return (0);
+	f = fopen(path, "rb");
+	if (!f)
+		return (0);
+	s = 0;
+	e = -1;
+	b = -1;
+	sz = -1;
+	fp = -1;
+	if (fscanf(f, "%ld %ld %lld %lld %lld", &s, &e, &b, &sz, &fp) < 1)
+	{
+		fclose(f);
+		return (0);
+	}
+	fclose(f);
+	if (s < 0)
+		s = 0;
+	if (e >= 0 && e < s)
+		e = s;
+	anchor_unknown(out_start, s);
+	if (b >= 0 && sz >= b && fp >= 0)
+	{
+		out_start->byte_offset = b;
+		out_start->file_size = sz;
+		out_start->fingerprint = fp;
+	}
+	*out_end = e;
+	return (1);
+}
+
+int	session_save_range_ex(const char *path, const char *csv_path,
+		long start, long end)
+{
+	t_session_anchor	a;
+	FILE				*f;
+
+	if (!path)
+		return (-1);
+	if (start < 0)
+		start = 0;
+	if (end >= 0 && end < start)
+		end = start;
+	if (!session_anchor_locate(csv_path, start, &a))
+		return (session_save_range(path, start, end));
+	f = fopen(path, "wb");
+	if (!f)
+		return (-1);
+	fprintf(f, "%ld %ld %lld %lld %lld\n", start, end, a.byte_offset,
+		a.file_size, a.fingerprint);
+	fclose(f);
+	return (0);
+}
+
 long	session_load_offset(const char *path)
 {
 	FILE	*f;
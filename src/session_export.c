@@ -17,6 +17,7 @@
 #include "core_paths.h"
 #include "hunt_csv.h"
 #include "mob_selected.h"
+#include "tm_fmt.h"
 #include "tm_money.h"
 
 #include <stdio.h>
@@ -54,74 +55,55 @@ static void	init_out_ranges(char *out_start, char *out_end)
         out_end[0] = '\0';
 }
 
-static int	looks_like_hunt_csv_header(const char *line)
+static int	format_ts_from_hunt_row(int64_t ts_unix, char *out, size_t outsz)
 {
-	if (!line)
-		return (0);
-	if (strstr(line, "timestamp")
-		&& (strstr(line, "event_type") || strstr(line, ",type,")))
-		return (1);
-	return (0);
-}
-
-static int	format_ts_from_hunt_row(char *line, char *out, size_t outsz)
-{
-	t_hunt_csv_row_view	row;
-	char				ts[64];
+	char	ts[64];
 
-	if (!line || !out || outsz == 0)
+	if (!out || outsz == 0)
 		return (0);
-	if (!hunt_csv_parse_row_inplace(line, &row))
+	if (ts_unix <= 0)
 		return (0);
-	if (row.ts_unix <= 0)
-		return (0);
-	hunt_csv_format_ts_local(ts, sizeof(ts), row.ts_unix);
+	hunt_csv_format_ts_local(ts, sizeof(ts), ts_unix);
 	if (ts[0] == '\0')
-		snprintf(ts, sizeof(ts), "%lld", (long long)row.ts_unix);
+		tm_fmt_i64(ts, sizeof(ts), ts_unix);
 	str_copy(out, outsz, ts);
 	return (1);
 }
 
-
-static void	process_range_file_ex(FILE *f, long start_offset, long end_offset,
+/* Only the first and last valid timestamps are formatted (localtime is slow). */
+static void	process_range_file_ex(t_hunt_csv_cursor *cur,
+							  long start_offset, long end_offset,
 							  char *out_start, size_t out_start_sz,
 							  char *out_end, size_t out_end_sz)
 {
-	char	line[1024];
-	char	work[1024];
-	long	data_idx;
-	int		first;
-	int		first_data_seen;
-
-	data_idx = 0;
-	first = 1;
-	first_data_seen = 0;
-	while (fgets(line, sizeof(line), f))
+	t_hunt_csv_row_view	row;
+	long				data_idx;
+	int					rc;
+	int64_t				first_ts;
+	int64_t				last_ts;
+
+	first_ts = 0;
+	last_ts = 0;
+	data_idx = (long)hunt_csv_cursor_goto(cur, (unsigned long long)start_offset,
+			-1);
+	while (end_offset < 0 || data_idx < end_offset)
 	{
-		if (first)
-		{
-			first = 0;
-			if (looks_like_hunt_csv_header(line))
-				continue ;
-		}
-		if (data_idx < start_offset)
-		{
-			data_idx++;
-			continue ;
-		}
-		if (end_offset >= 0 && data_idx >= end_offset)
+		rc = hunt_csv_cursor_next_row(cur, &row);
+		if (rc < 0)
 			break ;
-		str_copy(work, sizeof(work), line);
-		if (format_ts_from_hunt_row(work, out_end, out_end_sz))
+		if (rc == 1 && row.ts_unix > 0)
 		{
-			if (!first_data_seen)
-			{
-				first_data_seen = 1;
-				str_copy(out_start, out_start_sz, out_end);
-			}
+			if (first_ts == 0)
+				first_ts = row.ts_unix;
+			last_ts = row.ts_unix;
 		}
 		data_idx++;
 	}
+	if (format_ts_from_hunt_row(first_ts, out_end, out_end_sz))
+	{
+		str_copy(out_start, out_start_sz, out_end);
+		(void)format_ts_from_hunt_row(last_ts, out_end, out_end_sz);
+	}
 }
 
 int	session_extract_range_timestamps_ex(const char *hunt_csv_path,
@@ -129,8 +111,8 @@ int	session_extract_range_timestamps_ex(const char *hunt_csv_path,
 							 char *out_start, size_t out_start_sz,
 							 char *out_end, size_t out_end_sz)
 {
-    FILE	*f;
-    
+	t_hunt_csv_cursor	cur;
+
     init_out_ranges(out_start, out_end);
 	if (!hunt_csv_path)
         return (0);
@@ -138,14 +120,11 @@ int	session_extract_range_timestamps_ex(const char *hunt_csv_path,
 		start_offset = 0;
 	if (end_offset >= 0 && end_offset < start_offset)
 		end_offset = start_offset;
-	f = fopen(hunt_csv_path, "rb");
-	if (!f)
-	{
+	if (hunt_csv_cursor_open(&cur, hunt_csv_path) != 0)
 		return (0);
-	}
-	process_range_file_ex(f, start_offset, end_offset, out_start, out_start_sz,
-					   out_end, out_end_sz);
-	fclose(f);
+	process_range_file_ex(&cur, start_offset, end_offset,
+					   out_start, out_start_sz, out_end, out_end_sz);
+	hunt_csv_cursor_close(&cur);
 	return (1);
 }
 
@@ -182,19 +161,19 @@ static double	safe_return_pct(tm_money_t loot, tm_money_t expense)
 static void	build_session_bufs_ex(const t_hunt_stats *s, t_session_bufs *b,
 							 long start_offset, long end_offset)
 {
-    snprintf(b->kills, sizeof(b->kills), "%ld", (long)s->kills);
-    snprintf(b->shots, sizeof(b->shots), "%ld", (long)s->shots);
+	tm_fmt_i64(b->kills, sizeof(b->kills), (int64_t)s->kills);
+	tm_fmt_i64(b->shots, sizeof(b->shots), (int64_t)s->shots);
 	tm_money_format_ped4(b->loot, sizeof(b->loot), s->loot_ped);
 	tm_money_format_ped4(b->exp, sizeof(b->exp), s->expense_used);
 	tm_money_format_ped4(b->net, sizeof(b->net), s->net_ped);
     snprintf(b->ret, sizeof(b->ret), "%.2f",
              safe_return_pct(s->loot_ped, s->expense_used));
 	if (start_offset >= 0)
-		snprintf(b->start_off, sizeof(b->start_off), "%ld", start_offset);
+		tm_fmt_i64(b->start_off, sizeof(b->start_off), (int64_t)start_offset);
 	else
 		b->start_off[0] = '\0';
 	if (end_offset >= 0)
-		snprintf(b->end_off, sizeof(b->end_off), "%ld", end_offset);
+		tm_fmt_i64(b->end_off, sizeof(b->end_off), (int64_t)end_offset);
 	else
 		b->end_off[0] = '\0';
 }
@@ -0,0 +1,265 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats_table.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                   +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/21                                #+#    #+#             */
+/*   Updated: 2026/02/21                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "stats_table.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define STATS_ARENA_BLOCK 4096
+
+static uint32_t	key_hash(const char *s, size_t *len)
+{
+	uint32_t	h;
+	size_t		n;
+
+	h = 2166136261u;
+	n = 0;
+	while (s[n])
+	{
+		h ^= (unsigned char)s[n++];
+		h *= 16777619u;
+	}
+	*len = n;
+	return (h);
+}
+
+/* ---------------------------------- arena --------------------------------- */
+
+static const char	*arena_intern(t_stats_table *t, const char *s, size_t len)
+{
+	t_stats_arena	*a;
+	size_t			cap;
+	char			*p;
+
+	a = t->arena;
+	if (!a || a->cap - a->used < len + 1)
+	{
+		cap = (len + 1 > STATS_ARENA_BLOCK) ? len + 1 : STATS_ARENA_BLOCK;
+		a = (t_stats_arena *)malloc(sizeof(*a) + cap);
+		if (!a)
+			return (NULL);
+		a->next = t->arena;
+		a->used = 0;
+		a->cap = cap;
+		t->arena = a;
+	}
+	p = a->data + a->used;
+	memcpy(p, s, len + 1);
+	a->used += len + 1;
+	return (p);
+}
+
+/* ---------------------------------- table --------------------------------- */
+
+static int	slots_grow(t_stats_table *t)
+{
+	uint32_t	*ns;
+	size_t		n;
+	size_t		i;
+	size_t		h;
+
+	n = t->nslots ? t->nslots * 2 : 64;
+	ns = (uint32_t *)calloc(n, sizeof(*ns));
+	if (!ns)
+		return (-1);
+	i = 0;
+	while (i < t->len)
+	{
+		h = t->v[i].hash & (n - 1);
+		while (ns[h])
+			h = (h + 1) & (n - 1);
+		ns[h] = (uint32_t)(i + 1);
+		i++;
+	}
+	free(t->slots);
+	t->slots = ns;
+	t->nslots = n;
+	return (0);
+}
+
+static t_stats_entry	*table_push(t_stats_table *t, const char *key,
+							size_t len, uint32_t hash)
+{
+	t_stats_entry	*nv;
+	t_stats_entry	*e;
+	size_t			ncap;
+
+	if (t->len == t->cap)
+	{
+		ncap = t->cap ? t->cap * 2 : 32;
+		nv = (t_stats_entry *)realloc(t->v, ncap * sizeof(*nv));
+		if (!nv)
+			return (NULL);
+		t->v = nv;
+		t->cap = ncap;
+	}
+	e = &t->v[t->len];
+	memset(e, 0, sizeof(*e));
+	e->key = arena_intern(t, key, len);
+	if (!e->key)
+		return (NULL);
+	e->hash = hash;
+	e->seq = (uint32_t)t->len;
+	t->len++;
+	return (e);
+}
+
+t_stats_entry	*stats_table_get(t_stats_table *t, const char *key)
+{
+	uint32_t	hash;
+	size_t		len;
+	size_t		h;
+	uint32_t	id;
+
+	if (!t)
+		return (NULL);
+	if (!key || !key[0])
+		key = "(unknown)";
+	if ((t->len + 1) * 2 > t->nslots && slots_grow(t) != 0)
+		return (NULL);
+	hash = key_hash(key, &len);
+	h = hash & (t->nslots - 1);
+	while (t->slots[h])
+	{
+		id = t->slots[h] - 1;
+		if (t->v[id].hash == hash && strcmp(t->v[id].key, key) == 0)
+			return (&t->v[id]);
+		h = (h + 1) & (t->nslots - 1);
+	}
+	if (!table_push(t, key, len, hash))
+		return (NULL);
+	t->slots[h] = (uint32_t)t->len;
+	return (&t->v[t->len - 1]);
+}
+
+void	stats_table_free(t_stats_table *t)
+{
+	t_stats_arena	*a;
+	t_stats_arena	*next;
+
+	if (!t)
+		return ;
+	a = t->arena;
+	while (a)
+	{
+		next = a->next;
+		free(a);
+		a = next;
+	}
+	free(t->v);
+	free(t->slots);
+	memset(t, 0, sizeof(*t));
+}
+
+/* ---------------------------------- top-N --------------------------------- */
+
+int	stats_rank_count(const t_stats_entry *a, const t_stats_entry *b)
+{
+	if (a->count != b->count)
+		return ((a->count > b->count) ? 1 : -1);
+	return (strcmp(b->key, a->key));
+}
+
+int	stats_rank_final(const t_stats_entry *a, const t_stats_entry *b)
+{
+	if (a->final_sum != b->final_sum)
+		return ((a->final_sum > b->final_sum) ? 1 : -1);
+	if (a->seq != b->seq)
+		return ((a->seq < b->seq) ? 1 : -1);
+	return (0);
+}
+
+int	stats_rank_sum(const t_stats_entry *a, const t_stats_entry *b)
+{
+	if (a->sum != b->sum)
+		return ((a->sum > b->sum) ? 1 : -1);
+	return (stats_rank_count(a, b));
+}
+
+/* Tas "pire en haut": h[0] est la moins bonne des entrees retenues. */
+static void	heap_down(const t_stats_entry **h, size_t n, size_t i,
+				t_stats_rank rank)
+{
+	const t_stats_entry	*tmp;
+	size_t				w;
+	size_t				c;
+
+	while (1)
+	{
+		w = i;
+		c = 2 * i + 1;
+		if (c < n && rank(h[w], h[c]) > 0)
+			w = c;
+		if (c + 1 < n && rank(h[w], h[c + 1]) > 0)
+			w = c + 1;
+		if (w == i)
+			return ;
+		tmp = h[i];
+		h[i] = h[w];
+		h[w] = tmp;
+		i = w;
+	}
+}
+
+static void	heap_up(const t_stats_entry **h, size_t i, t_stats_rank rank)
+{
+	const t_stats_entry	*tmp;
+	size_t				p;
+
+	while (i > 0)
+	{
+		p = (i - 1) / 2;
+		if (rank(h[p], h[i]) <= 0)
+			return ;
+		tmp = h[i];
+		h[i] = h[p];
+		h[p] = tmp;
+		i = p;
+	}
+}
+
+size_t	stats_table_top(const t_stats_table *t, t_stats_rank rank,
+			const t_stats_entry **out, size_t max)
+{
+	const t_stats_entry	*tmp;
+	size_t				n;
+	size_t				i;
+
+	if (!t || !out || !max)
+		return (0);
+	n = 0;
+	i = 0;
+	while (i < t->len)
+	{
+		if (n < max)
+		{
+			out[n] = &t->v[i];
+			heap_up(out, n++, rank);
+		}
+		else if (rank(&t->v[i], out[0]) > 0)
+		{
+			out[0] = &t->v[i];
+			heap_down(out, n, 0, rank);
+		}
+		i++;
+	}
+	i = n;
+	while (i > 1)
+	{
+		tmp = out[0];
+		out[0] = out[--i];
+		out[i] = tmp;
+		heap_down(out, i, 0, rank);
+	}
+	return (n);
+}
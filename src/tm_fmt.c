@@ -0,0 +1,138 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   tm_fmt.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                   +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/22                                #+#    #+#             */
+/*   Updated: 2026/02/22                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "tm_fmt.h"
+
+#include <string.h>
+
+static const char	g_digits2[201] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+static const uint64_t	g_pow10[] = {
+	1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+	10000000ULL, 100000000ULL, 1000000000ULL
+};
+
+#define POW10_MAX ((int)(sizeof(g_pow10) / sizeof(g_pow10[0])) - 1)
+
+/* Digits of v right-aligned in tmp[0..20), returns the first index. */
+static int	u64_digits(char tmp[20], uint64_t v)
+{
+	unsigned	r;
+	int			i;
+
+	i = 20;
+	while (v >= 100)
+	{
+		r = (unsigned)(v % 100) * 2u;
+		v /= 100;
+		tmp[--i] = g_digits2[r + 1];
+		tmp[--i] = g_digits2[r];
+	}
+	if (v >= 10)
+	{
+		r = (unsigned)v * 2u;
+		tmp[--i] = g_digits2[r + 1];
+		tmp[--i] = g_digits2[r];
+	}
+	else
+		tmp[--i] = (char)('0' + (int)v);
+	return (i);
+}
+
+size_t	tm_fmt_u64_raw(char *dst, uint64_t v)
+{
+	char	tmp[20];
+	int		i;
+
+	if (v < 10)
+	{
+		dst[0] = (char)('0' + (int)v);
+		return (1);
+	}
+	i = u64_digits(tmp, v);
+	memcpy(dst, tmp + i, (size_t)(20 - i));
+	return ((size_t)(20 - i));
+}
+
+static uint64_t	uabs64(int64_t v)
+{
+	/* INT64_MIN cannot be negated in signed space */
+	return (v < 0) ? (uint64_t)0 - (uint64_t)v : (uint64_t)v;
+}
+
+size_t	tm_fmt_i64_raw(char *dst, int64_t v)
+{
+	if (v >= 0)
+		return (tm_fmt_u64_raw(dst, (uint64_t)v));
+	dst[0] = '-';
+	return (1 + tm_fmt_u64_raw(dst + 1, uabs64(v)));
+}
+
+size_t	tm_fmt_fixed_raw(char *dst, int64_t v, int scale_digits, int decimals)
+{
+	uint64_t	a;
+	uint64_t	div;
+	uint64_t	frac;
+	size_t		n;
+	int			k;
+
+	if (scale_digits < 0 || scale_digits > POW10_MAX)
+		scale_digits = 0;
+	if (decimals < 0 || decimals > scale_digits)
+		decimals = scale_digits;
+	n = 0;
+	if (v < 0)
+		dst[n++] = '-';
+	a = uabs64(v);
+	if (decimals < scale_digits)
+	{
+		div = g_pow10[scale_digits - decimals];
+		a = a / div + (a % div >= div / 2);
+	}
+	if (decimals == 0)
+		return (n + tm_fmt_u64_raw(dst + n, a));
+	n += tm_fmt_u64_raw(dst + n, a / g_pow10[decimals]);
+	dst[n++] = '.';
+	frac = a % g_pow10[decimals];
+	k = decimals;
+	while (k-- > 0)
+	{
+		dst[n + (size_t)k] = (char)('0' + (int)(frac % 10));
+		frac /= 10;
+	}
+	return (n + (size_t)decimals);
+}
+
+size_t	tm_fmt_i64(char *dst, size_t cap, int64_t v)
+{
+	char	tmp[TM_FMT_I64_MAX];
+	size_t	n;
+	size_t	c;
+
+	n = tm_fmt_i64_raw(tmp, v);
+	if (!dst || cap == 0)
+		return (n);
+	c = (n < cap) ? n : cap - 1;
+	memcpy(dst, tmp, c);
+	dst[c] = '\0';
+	return (n);
+}
@@ -11,11 +11,12 @@
 /* ************************************************************************** */
 
 #include "tm_money.h"
+#include "tm_fmt.h"
 
 #include <ctype.h>
 #include <limits.h>
 #include <math.h>
-#include <stdio.h>
+#include <string.h>
 
 static int	is_space(int c)
 {
@@ -198,38 +199,17 @@ long long	tm_money_to_pec_round(tm_money_t v)
 
 static void	format_ped(char *dst, size_t cap, tm_money_t v, int decimals)
 {
-	char		buf[64];
-	tm_money_t	abs_v;
-	tm_money_t	ip;
-	tm_money_t	frac;
-	int			neg;
-	long long	f;
-	long long	scale;
-	long long	round;
+	char	buf[TM_FMT_MONEY_MAX];
+	size_t	n;
 
 	if (!dst || cap == 0)
 		return ;
-	neg = (v < 0);
-	abs_v = neg ? -v : v;
-	if (decimals == 2)
-	{
-		scale = 100;
-		round = 50;
-		abs_v = (abs_v + round) / scale;
-		ip = abs_v / 100;
-		frac = abs_v % 100;
-		snprintf(buf, sizeof(buf), "%s%lld.%02lld", neg ? "-" : "",
-				 (long long)ip, (long long)frac);
-	}
-	else
-	{
-		ip = abs_v / TM_MONEY_SCALE;
-		frac = abs_v % TM_MONEY_SCALE;
-		f = (long long)frac;
-		snprintf(buf, sizeof(buf), "%s%lld.%04lld", neg ? "-" : "",
-				 (long long)ip, f);
-	}
-	snprintf(dst, cap, "%s", buf);
+	/* "%s%lld.%0*lld" by hand: money labels are redrawn every frame. */
+	n = tm_fmt_fixed_raw(buf, (int64_t)v, 4, decimals);
+	if (n >= cap)
+		n = cap - 1;
+	memcpy(dst, buf, n);
+	dst[n] = '\0';
 }
 
 void	tm_money_format_ped4(char *dst, size_t cap, tm_money_t v)
@@ -0,0 +1,168 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   tm_time.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                   +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/22                                #+#    #+#             */
+/*   Updated: 2026/02/22                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "tm_time.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*
+** Cache slot (1 mot atomique, pas de verrou):
+**   bit 63     : slot valide
+**   bit 62     : jour de changement d'heure (=> mktime)
+**   bits 32-54 : cle du jour (y * 512 + m * 32 + d)
+**   bits 0-31  : decalage local - UTC du jour, en secondes (int32)
+*/
+#define DAY_SLOTS    16
+#define SLOT_VALID   (1ULL << 63)
+#define SLOT_SWITCH  (1ULL << 62)
+#define KEY_MASK     0x7FFFFFULL
+
+static _Atomic uint64_t	g_day[DAY_SLOTS];
+
+/* Ancien chemin: tout "%d-%d-%d %d:%d:%d", normalise par mktime. */
+static int	ts_mktime(const char *ts, int64_t *out)
+{
+	struct tm	tm;
+	int			yr, mo, da, ho, mi, se;
+	time_t		t;
+
+	memset(&tm, 0, sizeof(tm));
+	if (sscanf(ts, "%d-%d-%d %d:%d:%d", &yr, &mo, &da, &ho, &mi, &se) != 6)
+		return (0);
+	tm.tm_year = yr - 1900;
+	tm.tm_mon = mo - 1;
+	tm.tm_mday = da;
+	tm.tm_hour = ho;
+	tm.tm_min = mi;
+	tm.tm_sec = se;
+	tm.tm_isdst = -1;
+	t = mktime(&tm);
+	if (t == (time_t)-1)
+		return (0);
+	*out = (int64_t)t;
+	return (1);
+}
+
+static int	dig2(const char *s)
+{
+	if (s[0] < '0' || s[0] > '9' || s[1] < '0' || s[1] > '9')
+		return (-1);
+	return ((s[0] - '0') * 10 + (s[1] - '0'));
+}
+
+static int	days_in_month(int y, int m)
+{
+	static const int	dm[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31,
+		30, 31};
+
+	if (m == 2 && (y % 4 == 0) && (y % 100 != 0 || y % 400 == 0))
+		return (29);
+	return (dm[m - 1]);
+}
+
+/* Jours depuis 1970-01-01 (calendrier gregorien proleptique, y >= 1). */
+static int64_t	days_from_civil(int y, int m, int d)
+{
+	int64_t	era;
+	int64_t	yoe;
+	int64_t	doy;
+
+	y -= (m <= 2);
+	era = y / 400;
+	yoe = y - era * 400;
+	doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+	return (era * 146097 + yoe * 365 + yoe / 4 - yoe / 100 + doy - 719468);
+}
+
+static int	midnight_offset(int y, int m, int d, int64_t days, int64_t *off)
+{
+	struct tm	tm;
+	time_t		t;
+
+	memset(&tm, 0, sizeof(tm));
+	tm.tm_year = y - 1900;
+	tm.tm_mon = m - 1;
+	tm.tm_mday = d;
+	tm.tm_isdst = -1;
+	t = mktime(&tm);
+	if (t == (time_t)-1)
+		return (0);
+	*off = days * 86400 - (int64_t)t;
+	return (1);
+}
+
+/* Slot du jour: decalage a ce minuit et au suivant (differents = DST). */
+static uint64_t	day_slot(int y, int m, int d, int64_t days, uint64_t key)
+{
+	int64_t		off0;
+	int64_t		off1;
+	uint64_t	v;
+
+	v = SLOT_VALID | (key << 32);
+	if (!midnight_offset(y, m, d, days, &off0)
+		|| !midnight_offset(y, m, d + 1, days + 1, &off1)
+		|| off0 != off1 || off0 < INT32_MIN || off0 > INT32_MAX)
+		return (v | SLOT_SWITCH);
+	return (v | (uint64_t)(uint32_t)(int32_t)off0);
+}
+
+int	tm_time_local_to_unix(const char *ts, int64_t *out)
+{
+	_Atomic uint64_t	*slot;
+	uint64_t			v;
+	uint64_t			key;
+	int64_t				days;
+	int					f[6];
+
+	if (!out)
+		return (0);
+	*out = 0;
+	if (!ts || strlen(ts) < 19)
+		return (0);
+	/* Format fixe uniquement, toute autre ecriture garde le chemin sscanf. */
+	f[0] = dig2(ts) * 100 + dig2(ts + 2);
+	f[1] = dig2(ts + 5);
+	f[2] = dig2(ts + 8);
+	f[3] = dig2(ts + 11);
+	f[4] = dig2(ts + 14);
+	f[5] = dig2(ts + 17);
+	if (ts[4] != '-' || ts[7] != '-' || ts[10] != ' ' || ts[13] != ':'
+		|| ts[16] != ':' || dig2(ts) < 0 || dig2(ts + 2) < 0
+		|| f[0] < 1900 || f[1] < 1 || f[1] > 12 || f[2] < 1
+		|| f[2] > days_in_month(f[0], f[1]) || f[3] < 0 || f[3] > 23
+		|| f[4] < 0 || f[4] > 59 || f[5] < 0 || f[5] > 59)
+		return (ts_mktime(ts, out));
+	days = days_from_civil(f[0], f[1], f[2]);
+	key = ((uint64_t)f[0] * 512u + (uint64_t)f[1] * 32u + (uint64_t)f[2])
+		& KEY_MASK;
+	slot = &g_day[(uint64_t)days % DAY_SLOTS];
+	v = atomic_load_explicit(slot, memory_order_relaxed);
+	if (!(v & SLOT_VALID) || ((v >> 32) & KEY_MASK) != key)
+	{
+		v = day_slot(f[0], f[1], f[2], days, key);
+		atomic_store_explicit(slot, v, memory_order_relaxed);
+	}
+	if (v & SLOT_SWITCH)
+		return (ts_mktime(ts, out));
+	*out = days * 86400 + f[3] * 3600 + f[4] * 60 + f[5]
+		- (int64_t)(int32_t)(uint32_t)(v & 0xFFFFFFFFULL);
+	/* (time_t)-1 is mktime's error value: same answer. */
+	if (*out == -1)
+	{
+		*out = 0;
+		return (0);
+	}
+	return (1);
+}
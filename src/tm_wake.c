@@ -0,0 +1,32 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   tm_wake.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                   +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17                                #+#    #+#             */
+/*   Updated: 2026/10/17                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "tm_wake.h"
+
+#include <stddef.h>
+
+/* Ecrit une fois par le thread UI, avant que les threads ne le lisent. */
+static t_tm_wake_fn	g_notify = NULL;
+
+void	tm_wake_set_notify(t_tm_wake_fn fn)
+{
+	g_notify = fn;
+}
+
+void	tm_wake(void)
+{
+	t_tm_wake_fn	fn;
+
+	fn = g_notify;
+	if (fn)
+		fn();
+}
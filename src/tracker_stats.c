@@ -11,6 +11,7 @@
 /* ************************************************************************** */
 
 #include "tracker_stats.h"
+#include "stats_table.h"
 #include "config_arme.h"
 #include "core_paths.h"
 #include "hunt_csv.h"
@@ -29,100 +30,22 @@
 #include <stddef.h>
 #include <string.h>
 
-typedef struct s_kv
-{
-	char	*key;
-	long	count;
-}	t_kv;
-
-typedef struct s_kv_loot
-{
-	char	*key;
-	long	events;
-	tm_money_t	tt_sum;
-	tm_money_t	final_sum;
-}	t_kv_loot;
-
-
 static void	stats_zero(t_hunt_stats *s)
 {
 	tm_zero(s, sizeof(*s));
 }
 
-static char	*xstrdup(const char *s)
-{
-	size_t	len;
-	char	*p;
-	
-	if (!s)
-		return (NULL);
-	len = strlen(s) + 1;
-	p = (char *)malloc(len);
-	if (!p)
-		return (NULL);
-	memcpy(p, s, len);
-	return (p);
-}
-
-static const char	*kv_key_safe(const char *key)
+static void	loot_add(t_stats_table *loot, const char *key,
+				tm_money_t tt, tm_money_t final)
 {
-	if (!key || !key[0])
-		return ("(unknown)");
-	return (key);
-}
+	t_stats_entry	*e;
 
-static void	kv_loot_push(t_kv_loot **arr, size_t *len,
-						const char *key, tm_money_t tt, tm_money_t final)
-{
-	t_kv_loot	*tmp;
-
-	tmp = (t_kv_loot *)realloc(*arr, (*len + 1) * sizeof(**arr));
-	if (!tmp)
+	e = stats_table_get(loot, key);
+	if (!e)
 		return ;
-	*arr = tmp;
-	(*arr)[*len].key = xstrdup(key);
-	(*arr)[*len].events = 1;
-	(*arr)[*len].tt_sum = tt;
-	(*arr)[*len].final_sum = final;
-	(*len)++;
-}
-
-static void	kv_loot_add(t_kv_loot **arr, size_t *len,
-						const char *key, tm_money_t tt, tm_money_t final)
-{
-	size_t	i;
-
-	key = kv_key_safe(key);
-	i = 0;
-	while (i < *len)
-	{
-		if ((*arr)[i].key && strcmp((*arr)[i].key, key) == 0)
-		{
-			(*arr)[i].events++;
-			(*arr)[i].tt_sum += tt;
-			(*arr)[i].final_sum += final;
-			return ;
-		}
-		i++;
-	}
-	kv_loot_push(arr, len, key, tt, final);
-}
-
-static void	kv_loot_free(t_kv_loot **arr, size_t *len)
-{
-	size_t	i;
-
-	if (!arr || !*arr)
-		return ;
-	i = 0;
-	while (i < *len)
-	{
-		free((*arr)[i].key);
-		i++;
-	}
-	free(*arr);
-	*arr = NULL;
-	*len = 0;
+	e->count++;
+	e->tt_sum += tt;
+	e->final_sum += final;
 }
 
 static int	str_icontains(const char *hay, const char *needle)
@@ -146,55 +69,6 @@ static int	str_icontains(const char *hay, const char *needle)
 	}
 	return (0);
 }
-static void	kv_inc(t_kv **arr, size_t *len, const char *key)
-{
-	t_kv	*tmp;
-	size_t	i;
-	
-	if (!key || !key[0])
-		key = "(unknown)";
-	i = 0;
-	while (i < *len)
-	{
-		if ((*arr)[i].key && strcmp((*arr)[i].key, key) == 0)
-		{
-			(*arr)[i].count++;
-			return ;
-		}
-		i++;
-	}
-	tmp = (t_kv *)realloc(*arr, (*len + 1) * sizeof(**arr));
-	if (!tmp)
-		return ;
-	*arr = tmp;
-	(*arr)[*len].key = xstrdup(key);
-	(*arr)[*len].count = 1;
-	(*len)++;
-}
-
-static int	kv_cmp_desc(const void *a, const void *b)
-{
-	const t_kv	*ka;
-	const t_kv	*kb;
-	
-	ka = (const t_kv *)a;
-	kb = (const t_kv *)b;
-	if (ka->count < kb->count)
-		return (1);
-	if (ka->count > kb->count)
-		return (-1);
-	if (!ka->key)
-		return (1);
-	if (!kb->key)
-		return (-1);
-	return (strcmp(ka->key, kb->key));
-}
-
-static void	kv_free(t_kv *arr, size_t len)
-{
-	tm_free_str_key_array(arr, len, sizeof(*arr), offsetof(t_kv, key));
-}
-
 static void	weapon_defaults(t_hunt_stats *out)
 {
 	out->has_weapon = 0;
@@ -307,22 +181,16 @@ static int	load_markup_db(t_markup_db *mu)
 }
 
 static tm_money_t	apply_markup_value(const t_markup_db *mu,
-								   const char *item_name, tm_money_t tt_value)
+										const char *item_name, tm_money_t tt_value)
 {
-	t_markup_rule	r;
-	int64_t			mu_mul_1e4;
-	
+	long	rule;
+
 	if (!mu || !item_name || !item_name[0])
 		return (tt_value);
-	if (!markup_db_get(mu, item_name, &r))
-		r = markup_default_rule();
-	if (r.type == MARKUP_TT_PLUS)
-		return (tt_value + tm_money_from_ped_double(r.value));
-	/* percent => multiplier TT (ex: 1.025 or 45.357) */
-	mu_mul_1e4 = (int64_t)llround(r.value * 10000.0);
-	if (mu_mul_1e4 <= 0)
-		mu_mul_1e4 = 10000;
-	return (tm_money_mul_mu(tt_value, mu_mul_1e4));
+	rule = markup_db_find(mu, item_name);
+	if (rule < 0)
+		return (tt_value);
+	return (markup_rule_apply_money(&mu->items[rule], tt_value));
 }
 
 static void	maybe_init_markup_fields(t_hunt_stats *out)
@@ -349,23 +217,15 @@ static void	maybe_add_markup_fields(t_hunt_stats *out, tm_money_t tt, tm_money_t
 	#endif
 }
 
-/* trim helpers are centralized in utils.c (tm_trim_eol) */
-
-static int	looks_like_header(const char *line)
+static void	stats_on_kill(t_hunt_stats *out, t_stats_table *mobs,
+						  const char *name)
 {
-	if (!line)
-		return (0);
-	if (strstr(line, "timestamp")
-		&& (strstr(line, "event_type") || strstr(line, ",type,")))
-		return (1);
-	return (0);
-}
+	t_stats_entry	*e;
 
-static void	stats_on_kill(t_hunt_stats *out, t_kv **mobs,
-						  size_t *mobs_len, const char *name)
-{
 	out->kills++;
-	kv_inc(mobs, mobs_len, name);
+	e = stats_table_get(mobs, name);
+	if (e)
+		e->count++;
 }
 
 static void	stats_on_shot(t_hunt_stats *out, long qty)
@@ -379,8 +239,7 @@ static void	stats_on_shot(t_hunt_stats *out, long qty)
 }
 
 static void	stats_on_sweat(t_hunt_stats *out, const t_markup_db *mu,
-					t_kv_loot **loot, size_t *loot_len,
-					long qty, tm_money_t value_uPED, int has_value)
+					t_stats_table *loot, long qty, tm_money_t value_uPED, int has_value)
 {
 	long		q;
 	tm_money_t	v;
@@ -397,7 +256,7 @@ static void	stats_on_sweat(t_hunt_stats *out, const t_markup_db *mu,
 	/* Treat sweat as a loot item for MU estimation */
 	final = apply_markup_value(mu, "Vibrant Sweat", v);
 	maybe_add_markup_fields(out, v, final);
-	kv_loot_add(loot, loot_len, "Vibrant Sweat", v, final);
+	loot_add(loot, "Vibrant Sweat", v, final);
 }
 
 static int	is_loot_type(const char *type)
@@ -431,8 +290,7 @@ static int	is_expense_type(const char *type)
 }
 
 static void	stats_add_loot(t_hunt_stats *out, const t_markup_db *mu,
-						t_kv_loot **loot, size_t *loot_len,
-						const char *type, const char *name, tm_money_t v)
+						t_stats_table *loot, const char *type, const char *name, tm_money_t v)
 {
 	tm_money_t	final;
 	
@@ -442,7 +300,7 @@ static void	stats_add_loot(t_hunt_stats *out, const t_markup_db *mu,
 	{
 		final = apply_markup_value(mu, name, v);
 		maybe_add_markup_fields(out, v, final);
-		kv_loot_add(loot, loot_len, name, v, final);
+		loot_add(loot, name, v, final);
 	}
 }
 
@@ -460,8 +318,7 @@ static int	row_has_value(const t_hunt_csv_row_view *row)
 }
 
 static void	process_row_view(t_hunt_stats *out, const t_markup_db *mu,
-				   t_kv_loot **loot, size_t *loot_len,
-				   t_kv **mobs, size_t *mobs_len,
+				   t_stats_table *loot, t_stats_table *mobs,
 				   const t_hunt_csv_row_view *row,
 				   int sweat_enabled)
 {
@@ -475,7 +332,7 @@ static void	process_row_view(t_hunt_stats *out, const t_markup_db *mu,
 		return ;
 	if (strncmp(row->type, "KILL", 4) == 0)
 	{
-		stats_on_kill(out, mobs, mobs_len, row->name);
+		stats_on_kill(out, mobs, row->name);
 		return ;
 	}
 	if (strcmp(row->type, "SHOT") == 0)
@@ -486,7 +343,7 @@ static void	process_row_view(t_hunt_stats *out, const t_markup_db *mu,
 	if (strcmp(row->type, "SWEAT") == 0)
 	{
 		has_v = row_has_value(row);
-		stats_on_sweat(out, mu, loot, loot_len, row->qty, row->value_uPED, has_v);
+		stats_on_sweat(out, mu, loot, row->qty, row->value_uPED, has_v);
 		return ;
 	}
 	has_v = row_has_value(row);
@@ -495,70 +352,47 @@ static void	process_row_view(t_hunt_stats *out, const t_markup_db *mu,
 	v = row->value_uPED;
 	expense = is_expense_type(row->type);
 	if (is_loot_type(row->type) || (!expense && v > 0))
-		stats_add_loot(out, mu, loot, loot_len, row->type, row->name, v);
+		stats_add_loot(out, mu, loot, row->type, row->name, v);
 	else if (expense)
 		stats_add_expense(out, v);
 }
 
 
-static void	finalize_top_mobs(t_hunt_stats *out, t_kv *mobs, size_t mobs_len)
+static void	finalize_top_mobs(t_hunt_stats *out, const t_stats_table *mobs)
 {
-	size_t	i;
-	size_t	max;
-	
-	out->mobs_unique = mobs_len;
-	if (!mobs_len)
-		return ;
-	qsort(mobs, mobs_len, sizeof(mobs[0]), kv_cmp_desc);
-	max = (mobs_len < (size_t)TM_TOP_MOBS) ? mobs_len : (size_t)TM_TOP_MOBS;
+	const t_stats_entry	*top[TM_TOP_MOBS];
+	size_t				i;
+	size_t				max;
+
+	out->mobs_unique = mobs->len;
+	max = stats_table_top(mobs, stats_rank_count, top, (size_t)TM_TOP_MOBS);
 	out->top_mobs_count = max;
 	i = 0;
 	while (i < max)
 	{
-		out->top_mobs[i].name[0] = '\0';
-		if (mobs[i].key)
-			snprintf(out->top_mobs[i].name,
-					 sizeof(out->top_mobs[i].name), "%s", mobs[i].key);
-		out->top_mobs[i].kills = mobs[i].count;
+		snprintf(out->top_mobs[i].name,
+				 sizeof(out->top_mobs[i].name), "%s", top[i]->key);
+		out->top_mobs[i].kills = top[i]->count;
 		i++;
 	}
 }
 
-static int	kv_loot_cmp_desc_total(const void *a, const void *b)
-{
-	const t_kv_loot	*ka;
-	const t_kv_loot	*kb;
-
-	ka = (const t_kv_loot *)a;
-	kb = (const t_kv_loot *)b;
-	if (ka->final_sum < kb->final_sum)
-		return (1);
-	if (ka->final_sum > kb->final_sum)
-		return (-1);
-	return (0);
-}
-
-static void	finalize_top_loot(t_hunt_stats *out, t_kv_loot *loot, size_t loot_len)
+static void	finalize_top_loot(t_hunt_stats *out, const t_stats_table *loot)
 {
-	size_t	i;
-	size_t	max;
+	const t_stats_entry	*top[TM_TOP_LOOT];
+	size_t				i;
+	size_t				max;
 
-	out->top_loot_count = 0;
-	if (!loot_len)
-		return ;
-	qsort(loot, loot_len, sizeof(loot[0]), kv_loot_cmp_desc_total);
-	max = (loot_len < (size_t)TM_TOP_LOOT) ? loot_len : (size_t)TM_TOP_LOOT;
+	max = stats_table_top(loot, stats_rank_final, top, (size_t)TM_TOP_LOOT);
 	out->top_loot_count = max;
 	i = 0;
 	while (i < max)
 	{
-		out->top_loot[i].name[0] = '\0';
-		if (loot[i].key)
-			snprintf(out->top_loot[i].name, sizeof(out->top_loot[i].name), "%s", loot[i].key);
-		out->top_loot[i].tt_ped = loot[i].tt_sum;
-		out->top_loot[i].total_mu_ped = loot[i].final_sum;
-		out->top_loot[i].mu_ped = loot[i].final_sum - loot[i].tt_sum;
-		out->top_loot[i].events = loot[i].events;
+		snprintf(out->top_loot[i].name, sizeof(out->top_loot[i].name), "%s", top[i]->key);
+		out->top_loot[i].tt_ped = top[i]->tt_sum;
+		out->top_loot[i].total_mu_ped = top[i]->final_sum;
+		out->top_loot[i].mu_ped = top[i]->final_sum - top[i]->tt_sum;
+		out->top_loot[i].events = top[i]->count;
 		i++;
 	}
 }
@@ -598,17 +432,14 @@ static void	compute_costs(t_hunt_stats *out)
 
 typedef struct s_stats_ctx
 {
-	FILE			*f;
+	t_hunt_csv_cursor	cur;
 	t_markup_db	mu;
-	t_kv_loot		*loot;
-	size_t		loot_len;
-	t_kv			*mobs;
-	size_t		mobs_len;
+	t_stats_table	loot;
+	t_stats_table	mobs;
 	long			data_idx;
 	long			start_line;
+	long long		start_byte;
 	long			end_line;
-	int			stop;
-	int			is_first_line;
 	int			sweat_enabled;
 	t_hunt_stats	*out;
 }	t_stats_ctx;
@@ -619,8 +450,6 @@ static void	ctx_init(t_stats_ctx *c, t_hunt_stats *out, long start_line, long en
 	c->out = out;
 	c->start_line = start_line;
 	c->end_line = end_line;
-	c->stop = 0;
-	c->is_first_line = 1;
 	{
 		int	enabled;
 	
@@ -636,85 +465,56 @@ static void	ctx_init(t_stats_ctx *c, t_hunt_stats *out, long start_line, long en
 static int	ctx_open(t_stats_ctx *c, const char *csv_path)
 {
 	(void)load_markup_db(&c->mu);
-	c->f = fopen(csv_path, "rb");
-	if (!c->f)
+	if (hunt_csv_cursor_open(&c->cur, csv_path) != 0)
 	{
 		markup_db_free(&c->mu);
 		return (-1);
 	}
+	c->out->csv_has_header = c->cur.has_header;
 	return (0);
 }
 
-static int	ctx_consume_header(t_stats_ctx *c, const char *line)
-{
-	if (!c->is_first_line)
-		return (0);
-	c->is_first_line = 0;
-	if (looks_like_header(line))
-	{
-		c->out->csv_has_header = 1;
-		return (1);
-	}
-	return (0);
-}
-
-static int	ctx_skip_start(t_stats_ctx *c)
-{
-	if (c->data_idx < c->start_line)
-	{
-		c->data_idx++;
-		return (1);
-	}
-	return (0);
-}
-
-static void	ctx_process_line(t_stats_ctx *c, char *buf)
+/* Rows before start_line are only counted (memchr), never parsed. */
+static void	ctx_process_stream(t_stats_ctx *c)
 {
 	t_hunt_csv_row_view	row;
-	
-	tm_trim_eol(buf);
-	if (ctx_consume_header(c, buf))
-		return ;
-	if (ctx_skip_start(c))
-		return ;
-	if (c->end_line >= 0 && c->data_idx >= c->end_line)
-	{
-		c->stop = 1;
-		return ;
-	}
-	c->out->data_lines_read++;
-	if (hunt_csv_parse_row_inplace(buf, &row))
-		process_row_view(c->out, &c->mu, &c->loot, &c->loot_len,
-					 &c->mobs, &c->mobs_len, &row, c->sweat_enabled);
-	c->data_idx++;
-}
+	int					rc;
 
-static void	ctx_process_stream(t_stats_ctx *c)
-{
-	char	buf[8192];
-	
-	while (fgets(buf, (int)sizeof(buf), c->f))
+	c->data_idx = (long)hunt_csv_cursor_goto(&c->cur,
+			(unsigned long long)c->start_line, c->start_byte);
+	while (c->end_line < 0 || c->data_idx < c->end_line)
 	{
-		ctx_process_line(c, buf);
-		if (c->stop)
+		rc = hunt_csv_cursor_next_row(&c->cur, &row);
+		if (rc < 0)
 			break ;
+		c->out->data_lines_read++;
+		if (rc == 1)
+			process_row_view(c->out, &c->mu, &c->loot, &c->mobs, &row,
+				c->sweat_enabled);
+		c->data_idx++;
 	}
 }
 
 static void	ctx_finish(t_stats_ctx *c)
 {
-	if (c->f)
-		fclose(c->f);
-	finalize_top_loot(c->out, c->loot, c->loot_len);
-	finalize_top_mobs(c->out, c->mobs, c->mobs_len);
+	hunt_csv_cursor_close(&c->cur);
+	finalize_top_loot(c->out, &c->loot);
+	finalize_top_mobs(c->out, &c->mobs);
 	compute_costs(c->out);
-	kv_loot_free(&c->loot, &c->loot_len);
-	kv_free(c->mobs, c->mobs_len);
+	stats_table_free(&c->loot);
+	stats_table_free(&c->mobs);
 	markup_db_free(&c->mu);
 }
 
 int	tracker_stats_compute_range(const char *csv_path, long start_line,
 							  long end_line, t_hunt_stats *out)
+{
+	return (tracker_stats_compute_range_at(csv_path, start_line, -1,
+			end_line, out));
+}
+
+int	tracker_stats_compute_range_at(const char *csv_path, long start_line,
+		long long start_byte, long end_line, t_hunt_stats *out)
 {
 	t_stats_ctx	c;
 
@@ -725,6 +525,7 @@ int	tracker_stats_compute_range(const char *csv_path, long start_line,
 	if (end_line >= 0 && end_line < start_line)
 		end_line = start_line;
 	ctx_init(&c, out, start_line, end_line);
+	c.start_byte = start_byte;
 	if (ctx_open(&c, csv_path) != 0)
 		return (-1);
 	ctx_process_stream(&c);
@@ -732,12 +533,12 @@ int	tracker_stats_compute_range(const char *csv_path, long start_line,
 	 * Best-effort: if we reached EOF (end_line == -1), persist an O(1) row count
 	 * for other modules (sessions picker, range resolution, etc.).
 	 */
-	if (end_line < 0 && c.f)
+	if (end_line < 0)
 	{
 		CsvIndexState	st;
 
 		st.data_rows = (unsigned long long)c.data_idx;
-		st.bytes = (unsigned long long)ftell(c.f);
+		st.bytes = hunt_csv_cursor_tell(&c.cur);
 		st.last_ts = 0;
 		(void)csv_index_state_store_ex(csv_path, &st, NULL);
 	}
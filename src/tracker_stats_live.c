@@ -11,11 +11,14 @@
 /* ************************************************************************** */
 
 #include "tracker_stats_live.h"
+#include "stats_table.h"
 
 #include "core_paths.h"
 #include "fs_utils.h"
 #include "session.h"
 #include "hunt_csv.h"
+#include "hunt_bin.h"
+#include "hunt_bus.h"
 #include "csv_index.h"
 #include "markup.h"
 #include "weapon_selected.h"
@@ -37,28 +40,17 @@
  * It mirrors tracker_stats.c logic, but updates from appended CSV lines only.
  */
 
-typedef struct s_kv
-{
-	char	*key;
-	long	count;
-} 	t_kv;
-
-typedef struct s_kv_loot
-{
-	char		*key;
-	long		events;
-	tm_money_t	tt_sum;
-	tm_money_t	final_sum;
-} 	t_kv_loot;
-
 typedef struct s_stats_live
 {
 	/* Incremental cursor */
 	int		initialized;
 	long		start_offset;
+	long long	start_byte;    /* anchor of start_offset, -1 = unknown */
 	long		file_pos;
 	long		last_file_size;
 	long		data_idx;
+	int64_t		last_ts;       /* of the last row read (index state) */
+	int		state_pending; /* index state to store once the CSV has file_pos */
 
 	/* Config cache */
 	int		sweat_enabled;
@@ -66,17 +58,21 @@ typedef struct s_stats_live
 
 	/* Accumulators */
 	t_markup_db	mu;
-	t_kv_loot	*loot;
-	size_t		loot_len;
-	t_kv		*mobs;
-	size_t		mobs_len;
+	long		mu_sweat;      /* rule of "Vibrant Sweat", -1 = none */
+	uint32_t	*mu_by_id;     /* sidecar name_id -> rule + 2 (1 = none, 0 = ?) */
+	size_t		mu_by_id_len;
+	uint32_t	mu_by_id_gen;  /* sidecar generation mu_by_id belongs to */
+	t_stats_table	loot;
+	t_stats_table	mobs;
+
+	/* Binary sidecar (pre-parsed rows), CSV is the fallback */
+	t_hunt_bin_reader	bin;
 
 	/* Output */
 	t_hunt_stats	stats;
 
-	/* Finalization throttling */
+	/* Top lists to rebuild */
 	int		dirty;
-	uint64_t	last_finalize_ms;
 } 	t_stats_live;
 
 static t_stats_live	g_live;
@@ -96,21 +92,6 @@ static void	stats_zero(t_hunt_stats *s)
 	tm_zero(s, sizeof(*s));
 }
 
-static char	*xstrdup(const char *s)
-{
-	size_t	len;
-	char	*p;
-
-	if (!s)
-		return (NULL);
-	len = strlen(s) + 1;
-	p = (char *)malloc(len);
-	if (!p)
-		return (NULL);
-	memcpy(p, s, len);
-	return (p);
-}
-
 static int	str_icontains(const char *hay, const char *needle)
 {
 	size_t	nlen;
@@ -133,107 +114,17 @@ static int	str_icontains(const char *hay, const char *needle)
 	return (0);
 }
 
-static const char	*kv_key_safe(const char *key)
-{
-	if (!key || !key[0])
-		return ("(unknown)");
-	return (key);
-}
-
-static void	kv_inc(t_kv **arr, size_t *len, const char *key)
-{
-	t_kv	*tmp;
-	size_t	i;
-
-	key = kv_key_safe(key);
-	i = 0;
-	while (i < *len)
-	{
-		if ((*arr)[i].key && strcmp((*arr)[i].key, key) == 0)
-		{
-			(*arr)[i].count++;
-			return ;
-		}
-		i++;
-	}
-	tmp = (t_kv *)realloc(*arr, (*len + 1) * sizeof(**arr));
-	if (!tmp)
-		return ;
-	*arr = tmp;
-	(*arr)[*len].key = xstrdup(key);
-	(*arr)[*len].count = 1;
-	(*len)++;
-}
-
-static void	kv_free(t_kv **arr, size_t *len)
-{
-	size_t	i;
-
-	if (!arr || !*arr)
-		return ;
-	i = 0;
-	while (i < *len)
-	{
-		free((*arr)[i].key);
-		i++;
-	}
-	free(*arr);
-	*arr = NULL;
-	*len = 0;
-}
-
-static void	kv_loot_push(t_kv_loot **arr, size_t *len,
-						const char *key, tm_money_t tt, tm_money_t final)
-{
-	t_kv_loot	*tmp;
-
-	tmp = (t_kv_loot *)realloc(*arr, (*len + 1) * sizeof(**arr));
-	if (!tmp)
-		return ;
-	*arr = tmp;
-	(*arr)[*len].key = xstrdup(key);
-	(*arr)[*len].events = 1;
-	(*arr)[*len].tt_sum = tt;
-	(*arr)[*len].final_sum = final;
-	(*len)++;
-}
-
-static void	kv_loot_add(t_kv_loot **arr, size_t *len,
-					const char *key, tm_money_t tt, tm_money_t final)
+static void	loot_add(t_stats_table *loot, const char *key,
+				tm_money_t tt, tm_money_t final)
 {
-	size_t	i;
+	t_stats_entry	*e;
 
-	key = kv_key_safe(key);
-	i = 0;
-	while (i < *len)
-	{
-		if ((*arr)[i].key && strcmp((*arr)[i].key, key) == 0)
-		{
-			(*arr)[i].events++;
-			(*arr)[i].tt_sum += tt;
-			(*arr)[i].final_sum += final;
-			return ;
-		}
-		i++;
-	}
-	kv_loot_push(arr, len, key, tt, final);
-}
-
-static void	kv_loot_free(t_kv_loot **arr, size_t *len)
-{
-	size_t	i;
-
-	if (!arr || !*arr)
+	e = stats_table_get(loot, key);
+	if (!e)
 		return ;
-	i = 0;
-	while (i < *len)
-	{
-		free((*arr)[i].key);
-		i++;
-	}
-	free(*arr);
-	*arr = NULL;
-	*len = 0;
+	e->count++;
+	e->tt_sum += tt;
+	e->final_sum += final;
 }
 
 /* ---------------- Weapon + Markup (mirrors tracker_stats.c) ------------- */
@@ -371,22 +262,39 @@ static void	maybe_add_markup_fields(t_hunt_stats *out, tm_money_t tt, tm_money_t
 #endif
 }
 
-static tm_money_t	apply_markup_value(const t_markup_db *mu,
+/* rule = index in mu->items (markup_db_find), -1 = default (x1). */
+static tm_money_t	apply_markup_value(const t_markup_db *mu, long rule,
 										const char *item_name, tm_money_t tt_value)
 {
-	t_markup_rule	r;
-	int64_t			mu_mul_1e4;
-
-	if (!mu || !item_name || !item_name[0])
+	if (!mu || !item_name || !item_name[0] || rule < 0)
 		return (tt_value);
-	if (!markup_db_get(mu, item_name, &r))
-		r = markup_default_rule();
-	if (r.type == MARKUP_TT_PLUS)
-		return (tt_value + tm_money_from_ped_double(r.value));
-	mu_mul_1e4 = (int64_t)llround(r.value * 10000.0);
-	if (mu_mul_1e4 <= 0)
-		mu_mul_1e4 = 10000;
-	return (tm_money_mul_mu(tt_value, mu_mul_1e4));
+	return (markup_rule_apply_money(&mu->items[rule], tt_value));
+}
+
+/* Markup rule of a sidecar name id, resolved once per id (no hash per row). */
+static long	markup_rule_for_id(t_stats_live *st, uint32_t id, const char *name)
+{
+	uint32_t	*tmp;
+	size_t		n;
+
+	if (id == HUNT_BIN_NO_NAME)
+		return (-1);
+	if (id >= st->mu_by_id_len)
+	{
+		n = st->mu_by_id_len ? st->mu_by_id_len : 256;
+		while (n <= id)
+			n *= 2;
+		tmp = (uint32_t *)realloc(st->mu_by_id, n * sizeof(*tmp));
+		if (!tmp)
+			return (markup_db_find(&st->mu, name));
+		memset(tmp + st->mu_by_id_len, 0,
+			(n - st->mu_by_id_len) * sizeof(*tmp));
+		st->mu_by_id = tmp;
+		st->mu_by_id_len = n;
+	}
+	if (!st->mu_by_id[id])
+		st->mu_by_id[id] = (uint32_t)(markup_db_find(&st->mu, name) + 2);
+	return ((long)st->mu_by_id[id] - 2);
 }
 
 /* ---------------- Core processing (mirrors tracker_stats.c) -------------- */
@@ -401,11 +309,15 @@ static int	looks_like_hunt_csv_header(const char *line)
 	return (0);
 }
 
-static void	stats_on_kill(t_hunt_stats *out, t_kv **mobs,
-						size_t *mobs_len, const char *name)
+static void	stats_on_kill(t_hunt_stats *out, t_stats_table *mobs,
+						const char *name)
 {
+	t_stats_entry	*e;
+
 	out->kills++;
-	kv_inc(mobs, mobs_len, name);
+	e = stats_table_get(mobs, name);
+	if (e)
+		e->count++;
 }
 
 static void	stats_on_shot(t_hunt_stats *out, long qty)
@@ -458,18 +370,18 @@ static int	row_has_value(const t_hunt_csv_row_view *row)
 }
 
 static void	stats_add_loot(t_hunt_stats *out, const t_markup_db *mu,
-						t_kv_loot **loot, size_t *loot_len,
-						const char *type, const char *name, tm_money_t v)
+						t_stats_table *loot, int loot_item, long rule,
+						const char *name, tm_money_t v)
 {
 	tm_money_t	final;
 
 	out->loot_ped += v;
 	out->loot_events++;
-	if (is_loot_type(type))
+	if (loot_item)
 	{
-		final = apply_markup_value(mu, name, v);
+		final = apply_markup_value(mu, rule, name, v);
 		maybe_add_markup_fields(out, v, final);
-		kv_loot_add(loot, loot_len, name, v, final);
+		loot_add(loot, name, v, final);
 	}
 }
 
@@ -480,7 +392,7 @@ static void	stats_add_expense(t_hunt_stats *out, tm_money_t v)
 }
 
 static void	stats_on_sweat(t_hunt_stats *out, const t_markup_db *mu,
-						t_kv_loot **loot, size_t *loot_len,
+						t_stats_table *loot, long rule,
 						long qty, tm_money_t value_uPED, int has_value)
 {
 	long		q;
@@ -496,9 +408,9 @@ static void	stats_on_sweat(t_hunt_stats *out, const t_markup_db *mu,
 			: ((tm_money_t)q * (tm_money_t)EU_SWEAT_uPED_PER_BOTTLE));
 	out->loot_ped += v;
 	out->loot_events++;
-	final = apply_markup_value(mu, "Vibrant Sweat", v);
+	final = apply_markup_value(mu, rule, "Vibrant Sweat", v);
 	maybe_add_markup_fields(out, v, final);
-	kv_loot_add(loot, loot_len, "Vibrant Sweat", v, final);
+	loot_add(loot, "Vibrant Sweat", v, final);
 }
 
 static void	process_row_view(t_stats_live *st, const t_hunt_csv_row_view *row)
@@ -513,7 +425,7 @@ static void	process_row_view(t_stats_live *st, const t_hunt_csv_row_view *row)
 		return ;
 	if (strncmp(row->type, "KILL", 4) == 0)
 	{
-		stats_on_kill(&st->stats, &st->mobs, &st->mobs_len, row->name);
+		stats_on_kill(&st->stats, &st->mobs, row->name);
 		return ;
 	}
 	if (strcmp(row->type, "SHOT") == 0)
@@ -524,7 +436,7 @@ static void	process_row_view(t_stats_live *st, const t_hunt_csv_row_view *row)
 	if (strcmp(row->type, "SWEAT") == 0)
 	{
 		has_v = row_has_value(row);
-		stats_on_sweat(&st->stats, &st->mu, &st->loot, &st->loot_len,
+		stats_on_sweat(&st->stats, &st->mu, &st->loot, st->mu_sweat,
 			row->qty, row->value_uPED, has_v);
 		return ;
 	}
@@ -534,87 +446,91 @@ static void	process_row_view(t_stats_live *st, const t_hunt_csv_row_view *row)
 	v = row->value_uPED;
 	expense = is_expense_type(row->type);
 	if (is_loot_type(row->type) || (!expense && v > 0))
-		stats_add_loot(&st->stats, &st->mu, &st->loot, &st->loot_len, row->type, row->name, v);
+		stats_add_loot(&st->stats, &st->mu, &st->loot,
+			is_loot_type(row->type), markup_db_find(&st->mu, row->name),
+			row->name, v);
 	else if (expense)
 		stats_add_expense(&st->stats, v);
 }
 
-static int	kv_cmp_desc(const void *a, const void *b)
-{
-	const t_kv	*ka;
-	const t_kv	*kb;
-
-	ka = (const t_kv *)a;
-	kb = (const t_kv *)b;
-	if (ka->count < kb->count)
-		return (1);
-	if (ka->count > kb->count)
-		return (-1);
-	if (!ka->key)
-		return (1);
-	if (!kb->key)
-		return (-1);
-	return (strcmp(ka->key, kb->key));
-}
-
-static int	kv_loot_cmp_desc_total(const void *a, const void *b)
+/* Same rules as process_row_view(), dispatched on the sidecar type enum. */
+static void	process_bin_rec(t_stats_live *st, const t_hunt_bin_rec *rec)
 {
-	const t_kv_loot	*ka;
-	const t_kv_loot	*kb;
+	t_hunt_csv_row_view	row;
+	const char			*name;
 
-	ka = (const t_kv_loot *)a;
-	kb = (const t_kv_loot *)b;
-	if (ka->final_sum < kb->final_sum)
-		return (1);
-	if (ka->final_sum > kb->final_sum)
-		return (-1);
-	return (0);
+	if (rec->type == HUNT_BIN_INVALID)
+		return ;
+	if (rec->type == HUNT_BIN_SHOT)
+		stats_on_shot(&st->stats, rec->qty);
+	else if (rec->type == HUNT_BIN_KILL)
+		stats_on_kill(&st->stats, &st->mobs,
+			hunt_bin_reader_name(&st->bin, rec->name_id));
+	else if (rec->type == HUNT_BIN_SWEAT)
+	{
+		if (st->sweat_enabled)
+			stats_on_sweat(&st->stats, &st->mu, &st->loot, st->mu_sweat,
+				rec->qty, rec->value_uPED, rec->has_value || (rec->flags & 1u));
+	}
+	else if (rec->type == HUNT_BIN_OTHER)
+	{
+		memset(&row, 0, sizeof(row));
+		row.type = hunt_bin_reader_name(&st->bin, rec->type_name_id);
+		row.name = hunt_bin_reader_name(&st->bin, rec->name_id);
+		row.qty = rec->qty;
+		row.value_uPED = rec->value_uPED;
+		row.has_value = rec->has_value;
+		row.flags = rec->flags;
+		process_row_view(st, &row);
+	}
+	else if ((rec->has_value || (rec->flags & 1u))
+		&& (rec->type == HUNT_BIN_LOOT_ITEM
+			|| rec->type == HUNT_BIN_RECEIVED_OTHER || rec->value_uPED > 0))
+	{
+		name = hunt_bin_reader_name(&st->bin, rec->name_id);
+		stats_add_loot(&st->stats, &st->mu, &st->loot,
+			rec->type != HUNT_BIN_GLOBAL && rec->type != HUNT_BIN_HOF
+			&& rec->type != HUNT_BIN_ATH,
+			markup_rule_for_id(st, rec->name_id, name), name, rec->value_uPED);
+	}
 }
 
 static void	finalize_top_mobs(t_stats_live *st)
 {
-	size_t	i;
-	size_t	max;
+	const t_stats_entry	*top[TM_TOP_MOBS];
+	size_t				i;
+	size_t				max;
 
-	st->stats.mobs_unique = st->mobs_len;
-	st->stats.top_mobs_count = 0;
-	if (!st->mobs_len)
-		return ;
-	qsort(st->mobs, st->mobs_len, sizeof(st->mobs[0]), kv_cmp_desc);
-	max = (st->mobs_len < (size_t)TM_TOP_MOBS) ? st->mobs_len : (size_t)TM_TOP_MOBS;
+	st->stats.mobs_unique = st->mobs.len;
+	max = stats_table_top(&st->mobs, stats_rank_count, top,
+			(size_t)TM_TOP_MOBS);
 	st->stats.top_mobs_count = max;
 	i = 0;
 	while (i < max)
 	{
-		st->stats.top_mobs[i].name[0] = '\0';
-		if (st->mobs[i].key)
-			snprintf(st->stats.top_mobs[i].name, sizeof(st->stats.top_mobs[i].name), "%s", st->mobs[i].key);
-		st->stats.top_mobs[i].kills = st->mobs[i].count;
+		snprintf(st->stats.top_mobs[i].name, sizeof(st->stats.top_mobs[i].name), "%s", top[i]->key);
+		st->stats.top_mobs[i].kills = top[i]->count;
 		i++;
 	}
 }
 
 static void	finalize_top_loot(t_stats_live *st)
 {
-	size_t	i;
-	size_t	max;
+	const t_stats_entry	*top[TM_TOP_LOOT];
+	size_t				i;
+	size_t				max;
 
-	st->stats.top_loot_count = 0;
-	if (!st->loot_len)
-		return ;
-	qsort(st->loot, st->loot_len, sizeof(st->loot[0]), kv_loot_cmp_desc_total);
-	max = (st->loot_len < (size_t)TM_TOP_LOOT) ? st->loot_len : (size_t)TM_TOP_LOOT;
+	max = stats_table_top(&st->loot, stats_rank_final, top,
+			(size_t)TM_TOP_LOOT);
 	st->stats.top_loot_count = max;
 	i = 0;
 	while (i < max)
 	{
-		st->stats.top_loot[i].name[0] = '\0';
-		if (st->loot[i].key)
-			snprintf(st->stats.top_loot[i].name, sizeof(st->stats.top_loot[i].name), "%s", st->loot[i].key);
-		st->stats.top_loot[i].tt_ped = st->loot[i].tt_sum;
-		st->stats.top_loot[i].total_mu_ped = st->loot[i].final_sum;
-		st->stats.top_loot[i].mu_ped = st->loot[i].final_sum - st->loot[i].tt_sum;
-		st->stats.top_loot[i].events = st->loot[i].events;
+		snprintf(st->stats.top_loot[i].name, sizeof(st->stats.top_loot[i].name), "%s", top[i]->key);
+		st->stats.top_loot[i].tt_ped = top[i]->tt_sum;
+		st->stats.top_loot[i].total_mu_ped = top[i]->final_sum;
+		st->stats.top_loot[i].mu_ped = top[i]->final_sum - top[i]->tt_sum;
+		st->stats.top_loot[i].events = top[i]->count;
 		i++;
 	}
 }
@@ -652,36 +568,23 @@ static void	compute_costs(t_hunt_stats *out)
 	out->net_ped = out->loot_ped - out->expense_used;
 }
 
-static long	skip_header_and_offset(FILE *f, long start_offset, t_hunt_stats *out)
+/* Byte offset of data row start_offset (header skipped), EOF if shorter. */
+static long	skip_header_and_offset(const char *csv_path, long start_offset,
+				long long start_byte, t_hunt_stats *out)
 {
-	char	buf[4096];
-	long	data_lines;
-	int		first;
-	long	pos_before;
+	t_hunt_csv_cursor	cur;
+	long				pos;
 
-	data_lines = 0;
-	first = 1;
-	while (f && fgets(buf, (int)sizeof(buf), f))
-	{
-		pos_before = ftell(f) - (long)strlen(buf);
-		if (first)
-		{
-			first = 0;
-			if (looks_like_hunt_csv_header(buf))
-			{
-				if (out)
-					out->csv_has_header = 1;
-				continue ;
-			}
-		}
-		if (data_lines == start_offset)
-		{
-			fseek(f, pos_before, SEEK_SET);
-			break ;
-		}
-		data_lines++;
-	}
-	return (ftell(f));
+	if (hunt_csv_cursor_open(&cur, csv_path) != 0)
+		return (0);
+	if (out && cur.has_header)
+		out->csv_has_header = 1;
+	if (start_offset > 0)
+		(void)hunt_csv_cursor_goto(&cur, (unsigned long long)start_offset,
+			start_byte);
+	pos = (long)hunt_csv_cursor_tell(&cur);
+	hunt_csv_cursor_close(&cur);
+	return (pos);
 }
 
 static void	stats_live_clear(t_stats_live *st)
@@ -689,17 +592,24 @@ static void	stats_live_clear(t_stats_live *st)
 	if (!st)
 		return ;
 	markup_db_free(&st->mu);
-	kv_loot_free(&st->loot, &st->loot_len);
-	kv_free(&st->mobs, &st->mobs_len);
+	hunt_bin_reader_free(&st->bin);
+	free(st->mu_by_id);
+	st->mu_by_id = NULL;
+	st->mu_by_id_len = 0;
+	st->mu_by_id_gen = 0;
+	stats_table_free(&st->loot);
+	stats_table_free(&st->mobs);
 	st->initialized = 0;
 	st->file_pos = 0;
 	st->last_file_size = -1;
 	st->data_idx = 0;
+	st->last_ts = 0;
+	st->state_pending = 0;
 	st->dirty = 0;
-	st->last_finalize_ms = 0;
 }
 
-static void	stats_live_reset(t_stats_live *st, long start_offset)
+static void	stats_live_reset(t_stats_live *st, long start_offset,
+				long long start_byte)
 {
 	int enabled;
 
@@ -710,16 +620,120 @@ static void	stats_live_reset(t_stats_live *st, long start_offset)
 	maybe_init_markup_fields(&st->stats);
 	load_weapon_model(&st->stats);
 	(void)load_markup_db(&st->mu);
+	st->mu_sweat = markup_db_find(&st->mu, "Vibrant Sweat");
 	enabled = 0;
 	sweat_option_load(tm_path_options_cfg(), &enabled);
 	st->sweat_enabled = enabled;
 	st->weapon_selected[0] = '\0';
 	weapon_selected_load(tm_path_weapon_selected(), st->weapon_selected, sizeof(st->weapon_selected));
 	st->start_offset = start_offset;
+	st->start_byte = start_byte;
 	st->data_idx = 0;
 	st->stats.csv_has_header = 0;
 }
 
+/*
+ * Fast path: consume the rows already mirrored in the binary sidecar
+ * (record i = data row i), then let the CSV loop pick up whatever is left.
+ */
+static int	stats_live_update_bin(t_stats_live *st, const char *csv_path,
+						int64_t *last_ts)
+{
+	const t_hunt_bin_rec	*recs;
+	long long				count;
+	size_t					n;
+	size_t					i;
+	int						done;
+
+	if (hunt_bin_reader_open(&st->bin, csv_path) != 0)
+		return (0);
+	if (st->mu_by_id_gen != hunt_bin_reader_generation(&st->bin))
+	{
+		if (st->mu_by_id)
+			memset(st->mu_by_id, 0, st->mu_by_id_len * sizeof(*st->mu_by_id));
+		st->mu_by_id_gen = hunt_bin_reader_generation(&st->bin);
+	}
+	done = 0;
+	count = hunt_bin_reader_count(&st->bin);
+	if (!st->initialized && count > st->start_offset)
+	{
+		if (hunt_bin_reader_read(&st->bin, 0, 1, &recs) != 1)
+			count = -1;
+		else
+			st->stats.csv_has_header = (recs[0].csv_off > 0);
+		if (count > 0 && hunt_bin_reader_read(&st->bin,
+				(unsigned long long)st->start_offset, 1, &recs) == 1)
+		{
+			st->file_pos = (long)recs[0].csv_off;
+			st->data_idx = st->start_offset;
+			st->initialized = 1;
+		}
+	}
+	while (st->initialized && count > st->data_idx)
+	{
+		n = hunt_bin_reader_read(&st->bin, (unsigned long long)st->data_idx,
+				(size_t)(count - st->data_idx), &recs);
+		if (n == 0)
+			break ;
+		i = 0;
+		while (i < n)
+		{
+			st->stats.data_lines_read++;
+			if (recs[i].type != HUNT_BIN_INVALID)
+			{
+				process_bin_rec(st, &recs[i]);
+				*last_ts = recs[i].ts_unix;
+				done++;
+			}
+			(void)csv_index_maybe_append_checkpoint_ex(csv_path, 1024,
+				(unsigned long long)st->data_idx, (long long)recs[i].ts_unix,
+				(unsigned long long)recs[i].csv_off, NULL);
+			st->file_pos = (long)(recs[i].csv_off + recs[i].csv_len);
+			st->data_idx++;
+			i++;
+		}
+	}
+	hunt_bin_reader_close(&st->bin);
+	return (done);
+}
+
+typedef struct s_bus_ctx
+{
+	t_stats_live	*st;
+	const char		*csv_path;
+	int				rows;
+}	t_bus_ctx;
+
+/* Row published by the LIVE parser, starting at st->file_pos. */
+static void	bus_apply_row(void *ctx, const t_hunt_csv_row_view *row,
+				long long csv_off)
+{
+	t_bus_ctx		*b;
+	t_stats_live	*st;
+
+	b = (t_bus_ctx *)ctx;
+	st = b->st;
+	(void)csv_index_maybe_append_checkpoint_ex(b->csv_path, 1024,
+		(unsigned long long)st->data_idx, (long long)row->ts_unix,
+		(unsigned long long)csv_off, NULL);
+	st->stats.data_lines_read++;
+	st->data_idx++;
+	process_row_view(st, row);
+	st->last_ts = row->ts_unix;
+	b->rows++;
+}
+
+static int	stats_live_drain_bus(t_stats_live *st, const char *csv_path)
+{
+	t_bus_ctx	b;
+
+	b.st = st;
+	b.csv_path = csv_path;
+	b.rows = 0;
+	(void)hunt_bus_drain(HUNT_BUS_STATS, &st->file_pos, bus_apply_row, &b);
+	return (b.rows);
+}
+
 static int	stats_live_update(t_stats_live *st, const char *csv_path)
 {
 	FILE				*f;
@@ -729,31 +743,36 @@ static int	stats_live_update(t_stats_live *st, const char *csv_path)
 	int				first;
 	t_hunt_csv_row_view	row;
 	int				lines_processed;
-	int64_t				last_ts;
 	const size_t		idx_stride = 1024;
 
 	if (!st || !csv_path)
 		return (0);
-	last_ts = 0;
 	sz = fs_file_size(csv_path);
-	if (sz >= 0 && st->file_pos > sz)
+	/* Past EOF but still in the parser's buffer (bus): not a truncation. */
+	if (sz >= 0 && st->file_pos > sz && !hunt_bus_covers(st->file_pos))
+	{
 		st->initialized = 0;
+		st->start_byte = -1;
+	}
+	lines_processed = 0;
+	if (st->initialized)
+		lines_processed += stats_live_drain_bus(st, csv_path);
+	lines_processed += stats_live_update_bin(st, csv_path, &st->last_ts);
 	f = fs_fopen_shared_read(csv_path);
 	if (!f)
 		return (0);
 	if (!st->initialized)
 	{
-		pos = skip_header_and_offset(f, st->start_offset, &st->stats);
+		pos = skip_header_and_offset(csv_path, st->start_offset,
+				st->start_byte, &st->stats);
 		if (pos < 0)
 			pos = 0;
 		st->file_pos = pos;
 		st->initialized = 1;
 		st->data_idx = st->start_offset;
 	}
-	else
-		fseek(f, st->file_pos, SEEK_SET);
+	fseek(f, st->file_pos, SEEK_SET);
 
-	lines_processed = 0;
 	first = 1;
 	while (fgets(line, (int)sizeof(line), f))
 	{
@@ -779,7 +798,7 @@ static int	stats_live_update(t_stats_live *st, const char *csv_path)
 		if (!hunt_csv_parse_row_inplace(line, &row))
 			continue ;
 		process_row_view(st, &row);
-		last_ts = row.ts_unix;
+		st->last_ts = row.ts_unix;
 		lines_processed++;
 		/* Best-effort sparse index maintenance for fast seeks & O(1) row counts. */
 		(void)csv_index_maybe_append_checkpoint_ex(
@@ -790,33 +809,36 @@ static int	stats_live_update(t_stats_live *st, const char *csv_path)
 	}
 	st->file_pos = ftell(f);
 	fclose(f);
+	/* Rows the parser published after the CSV was read. */
+	lines_processed += stats_live_drain_bus(st, csv_path);
 	if (lines_processed > 0)
+		st->dirty = 1;
+	/* The index state must match the file: wait until the rows are flushed. */
+	if (lines_processed > 0 || st->state_pending)
 	{
 		CsvIndexState	ist;
 
-		st->dirty = 1;
-		ist.data_rows = (unsigned long long)st->data_idx;
-		ist.bytes = (unsigned long long)st->file_pos;
-		ist.last_ts = (long long)last_ts;
-		(void)csv_index_state_store_ex(csv_path, &ist, NULL);
+		st->state_pending = (sz < 0 || st->file_pos > sz);
+		if (!st->state_pending)
+		{
+			ist.data_rows = (unsigned long long)st->data_idx;
+			ist.bytes = (unsigned long long)st->file_pos;
+			ist.last_ts = (long long)st->last_ts;
+			(void)csv_index_state_store_ex(csv_path, &ist, NULL);
+		}
 	}
 	st->last_file_size = sz;
 	return (1);
 }
 
+/* Top lists via a bounded heap: cheap enough to rebuild on every dirty tick. */
 static void	stats_live_finalize_if_needed(t_stats_live *st)
 {
-	uint64_t now;
-
 	if (!st)
 		return ;
 	compute_costs(&st->stats);
 	if (!st->dirty)
 		return ;
-	now = ft_time_ms();
-	if (st->last_finalize_ms != 0 && (now - st->last_finalize_ms) < 650)
-		return ;
-	st->last_finalize_ms = now;
 	finalize_top_mobs(st);
 	finalize_top_loot(st);
 	st->dirty = 0;
@@ -857,11 +879,12 @@ void	tracker_stats_live_tick(void)
 	int		ok;
 	int		enabled;
 	char		selected[128];
+	t_session_anchor	anchor;
 
 	/* Range mode (Sessions picker) */
-	r_start = 0;
-	r_end_raw = -1;
-	range_on = session_load_range(tm_path_session_range(), &r_start, &r_end_raw);
+	range_on = session_load_range_anchor(tm_path_session_range(), &anchor,
+			&r_end_raw);
+	r_start = anchor.line;
 	if (range_on)
 	{
 		range_normalize(&r_start, &r_end_raw);
@@ -877,7 +900,9 @@ void	tracker_stats_live_tick(void)
 				r_end_resolved = r_start;
 			stats_live_clear(&g_live);
 			stats_zero(&g_live.stats);
-			ok = (tracker_stats_compute_range(tm_path_hunt_csv(), r_start, r_end_resolved, &g_live.stats) == 0);
+			ok = (tracker_stats_compute_range_at(tm_path_hunt_csv(), r_start,
+					session_anchor_resolve(tm_path_hunt_csv(), &anchor),
+					r_end_resolved, &g_live.stats) == 0);
 			g_ready = ok ? 1 : 0;
 			g_last_mode = 1;
 			g_last_range_start = r_start;
@@ -892,10 +917,12 @@ void	tracker_stats_live_tick(void)
 	}
 
 	/* Live offset mode */
-	offset = session_load_offset(tm_path_session_offset());
+	(void)session_load_offset_anchor(tm_path_session_offset(), &anchor);
+	offset = anchor.line;
 	if (!g_ready || g_last_mode != 0 || offset != g_last_offset)
 	{
-		stats_live_reset(&g_live, offset);
+		stats_live_reset(&g_live, offset,
+			session_anchor_resolve(tm_path_hunt_csv(), &anchor));
 		g_last_offset = offset;
 		g_last_mode = 0;
 		g_last_range_start = -1;
@@ -910,7 +937,7 @@ void	tracker_stats_live_tick(void)
 	sweat_option_load(tm_path_options_cfg(), &enabled);
 	if (enabled != g_live.sweat_enabled)
 	{
-		stats_live_reset(&g_live, offset);
+		stats_live_reset(&g_live, offset, g_live.start_byte);
 		g_warn_text[0] = '\0';
 		g_live.sweat_enabled = enabled;
 	}
@@ -161,7 +161,7 @@ static void	screen_dashboard_globals_live(t_window *w)
 		double			refresh_acc;
 		int				first;
 
-		fl.target_ms = 16;
+		fl_init(&fl, 16);
 		last_ms = ft_time_ms();
 		refresh_acc = 1.0;
 		first = 1;
@@ -175,6 +175,7 @@ static void	screen_dashboard_globals_live(t_window *w)
 				dt = 0.0;
 
 			window_poll_events(w);
+			fl_mark(&fl, w->input_events > 0);
 		overlay_tick_auto_hunt();
 			if (w->key_escape)
 				break ;
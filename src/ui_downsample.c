@@ -2,6 +2,9 @@
 
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
+
+#define DS_CMP_BLOCK 512
 
 typedef struct s_ui_bucket
 {
@@ -38,6 +41,113 @@ static int	clamp_int(int v, int lo, int hi)
 	return (v);
 }
 
+/* Screen column of xv in [xmin..xmin + dt]. */
+static int	col_of(double xv, int xmin, double dt, int px_w)
+{
+	int	col;
+
+	col = (int)floor(((xv - (double)xmin) / dt) * (double)(px_w - 1) + 0.5);
+	return (clamp_int(col, 0, px_w - 1));
+}
+
+/* Screen row of v, already clamped to [vmin..vmin + dv]. */
+static int	py_of(double v, double vmin, double dv, t_rect plot)
+{
+	int	py;
+
+	py = plot.y + plot.h - (int)llround(((v - vmin) / dv) * (double)plot.h);
+	return (clamp_int(py, plot.y, plot.y + plot.h));
+}
+
+/* Shared column table (UI thread only), reset to empty. */
+static t_ui_bucket	*buckets_get(int px_w)
+{
+	static t_ui_bucket	*buckets;
+	static int			buckets_cap;
+	t_ui_bucket			*nb;
+	int					i;
+
+	if (buckets_cap < px_w)
+	{
+		nb = (t_ui_bucket *)realloc(buckets, sizeof(*buckets) * (size_t)px_w);
+		if (!nb)
+			return (NULL);
+		buckets = nb;
+		buckets_cap = px_w;
+	}
+	i = 0;
+	while (i < px_w)
+	{
+		buckets[i].valid = 0;
+		buckets[i].has_first = 0;
+		buckets[i].has_last = 0;
+		i++;
+	}
+	return (buckets);
+}
+
+/* Output arrays of one downsample call, filled left to right. */
+typedef struct s_ds_out
+{
+	t_point_i	*poly_pts;
+	int			*poly_idx;
+	int			poly_n;
+	int			poly_cap;
+	t_point_i	*rep_pts;
+	int			*rep_idx;
+	int			rep_n;
+	int			rep_cap;
+}	t_ds_out;
+
+static void	out_poly(t_ds_out *o, int x, int y, int idx)
+{
+	if (o->poly_n >= o->poly_cap)
+		return ;
+	o->poly_pts[o->poly_n] = (t_point_i){x, y};
+	o->poly_idx[o->poly_n] = idx;
+	o->poly_n++;
+}
+
+static void	emit_bucket(t_ds_out *o, const t_ui_bucket *b, int x)
+{
+	/* Representative: last point (for markers) */
+	if (o->rep_pts && o->rep_idx && o->rep_n < o->rep_cap)
+	{
+		o->rep_pts[o->rep_n] = (t_point_i){x, b->y_last};
+		o->rep_idx[o->rep_n] = b->idx_last;
+		o->rep_n++;
+	}
+	/* Polyline: first -> min -> max -> last (avoid duplicates) */
+	out_poly(o, x, b->y_first, b->idx_first);
+	if (b->y_min != b->y_first)
+		out_poly(o, x, b->y_min, b->idx_min);
+	if (b->y_max != b->y_min)
+		out_poly(o, x, b->y_max, b->idx_max);
+	if (b->y_last != b->y_max)
+		out_poly(o, x, b->y_last, b->idx_last);
+}
+
+static int	emit_buckets(const t_ui_bucket *buckets, int px_w, t_rect plot,
+				t_point_i *poly_pts, int *poly_idx, int poly_cap,
+				t_point_i *rep_pts, int *rep_idx, int rep_cap, int *out_rep_n)
+{
+	t_ds_out	o;
+	int			i;
+
+	o = (t_ds_out){poly_pts, poly_idx, 0, poly_cap,
+		rep_pts, rep_idx, 0, rep_cap};
+	i = 0;
+	while (i < px_w)
+	{
+		if (buckets[i].valid)
+			emit_bucket(&o, &buckets[i], plot.x + i);
+		i++;
+	}
+	if (out_rep_n)
+		*out_rep_n = o.rep_n;
+	return (o.poly_n);
+}
+
 int	ui_downsample_minmax_pixels(
 		const double *values,
 		const int *x_seconds,
@@ -55,15 +165,12 @@ int	ui_downsample_minmax_pixels(
 		int rep_cap,
 		int *out_rep_n)
 {
-	static t_ui_bucket	*buckets;
-	static int			buckets_cap;
+	t_ui_bucket			*buckets;
 	int					px_w;
 	int					px_h;
 	double					dt;
 	double					dv;
 	int					i;
-	int					poly_n;
-	int					rep_n;
 
 	if (out_rep_n)
 		*out_rep_n = 0;
@@ -80,19 +187,9 @@ int	ui_downsample_minmax_pixels(
 	if (dt <= 0.0 || dv <= 0.0)
 		return (0);
 
-	if (buckets_cap < px_w)
-	{
-		buckets = (t_ui_bucket *)realloc(buckets, sizeof(*buckets) * (size_t)px_w);
-		buckets_cap = px_w;
-	}
-	i = 0;
-	while (i < px_w)
-	{
-		buckets[i].valid = 0;
-		buckets[i].has_first = 0;
-		buckets[i].has_last = 0;
-		i++;
-	}
+	buckets = buckets_get(px_w);
+	if (!buckets)
+		return (0);
 
 	i = 0;
 	while (i < n)
@@ -126,10 +223,8 @@ int	ui_downsample_minmax_pixels(
 			i++;
 			continue ;
 		}
-		col = (int)floor(((xv - (double)xmin) / dt) * (double)(px_w - 1) + 0.5);
-		col = clamp_int(col, 0, px_w - 1);
-		py = plot.y + plot.h - (int)llround(((v - vmin) / dv) * (double)plot.h);
-		py = clamp_int(py, plot.y, plot.y + plot.h);
+		col = col_of(xv, xmin, dt, px_w);
+		py = py_of(v, vmin, dv, plot);
 
 		b = &buckets[col];
 		if (!b->valid)
@@ -165,59 +260,480 @@ int	ui_downsample_minmax_pixels(
 		i++;
 	}
 
-	poly_n = 0;
-	rep_n = 0;
-	i = 0;
-	while (i < px_w)
+	return (emit_buckets(buckets, px_w, plot, poly_pts, poly_idx, poly_cap,
+			rep_pts, rep_idx, rep_cap, out_rep_n));
+}
+
+/* ------------------------------- pyramid -------------------------------- */
+
+/* Index of the smaller value, a on ties (a is left of b); -1 = empty. */
+static int	pick_min(const double *v, int a, int b)
+{
+	if (a < 0)
+		return (b);
+	if (b < 0)
+		return (a);
+	return ((v[b] < v[a]) ? b : a);
+}
+
+static int	pick_max(const double *v, int a, int b)
+{
+	if (a < 0)
+		return (b);
+	if (b < 0)
+		return (a);
+	return ((v[b] > v[a]) ? b : a);
+}
+
+void	ui_ds_pyramid_free(t_ui_ds_pyramid *p)
+{
+	if (!p)
+		return ;
+	free(p->v);
+	free(p->x);
+	free(p->imin);
+	free(p->imax);
+	memset(p, 0, sizeof(*p));
+}
+
+static int	pyramid_grow(t_ui_ds_pyramid *p, int n)
+{
+	int	size;
+	int	k;
+
+	size = (p->size > 0) ? p->size : 1024;
+	while (size < n)
+		size *= 2;
+	ui_ds_pyramid_free(p);
+	p->v = (double *)malloc(sizeof(*p->v) * (size_t)size);
+	p->x = (int *)malloc(sizeof(*p->x) * (size_t)size);
+	p->imin = (int *)malloc(sizeof(*p->imin) * (size_t)size * 2);
+	p->imax = (int *)malloc(sizeof(*p->imax) * (size_t)size * 2);
+	if (!p->v || !p->x || !p->imin || !p->imax)
 	{
-		t_ui_bucket	*b;
-		int			x;
+		ui_ds_pyramid_free(p);
+		return (0);
+	}
+	p->size = size;
+	k = 0;
+	while (k < size * 2)
+	{
+		p->imin[k] = -1;
+		p->imax[k++] = -1;
+	}
+	return (1);
+}
 
-		b = &buckets[i];
-		if (!b->valid)
-		{
-			i++;
-			continue ;
-		}
-		x = plot.x + i;
+/* Leaves [from, to) changed: recompute their ancestors only. */
+static void	pyramid_update(t_ui_ds_pyramid *p, int from, int to)
+{
+	int	lo;
+	int	hi;
+	int	k;
 
-		/* Representative: last point (for markers) */
-		if (rep_pts && rep_idx && rep_n < rep_cap)
+	if (from >= to)
+		return ;
+	lo = (p->size + from) >> 1;
+	hi = (p->size + to - 1) >> 1;
+	while (lo >= 1)
+	{
+		k = lo;
+		while (k <= hi)
 		{
-			rep_pts[rep_n] = (t_point_i){x, b->y_last};
-			rep_idx[rep_n] = b->idx_last;
-			rep_n++;
+			p->imin[k] = pick_min(p->v, p->imin[2 * k], p->imin[2 * k + 1]);
+			p->imax[k] = pick_max(p->v, p->imax[2 * k], p->imax[2 * k + 1]);
+			k++;
 		}
+		lo >>= 1;
+		hi >>= 1;
+	}
+}
 
-		/* Polyline: first -> min -> max -> last (avoid duplicates) */
-		if (poly_n < poly_cap)
-		{
-			poly_pts[poly_n] = (t_point_i){x, b->y_first};
-			poly_idx[poly_n] = b->idx_first;
-			poly_n++;
-		}
-		if (b->y_min != b->y_first && poly_n < poly_cap)
+/*
+** First index < m where the series differs from the copy. Bitwise compare:
+** a NaN left in place is not a change. Whole blocks first (memcmp), the
+** live tail only rewrites the last few points.
+*/
+static int	first_change(const t_ui_ds_pyramid *p, const double *values,
+				const int *x_seconds, int m)
+{
+	int	from;
+
+	from = 0;
+	while (x_seconds && from + DS_CMP_BLOCK <= m
+		&& memcmp(p->v + from, values + from,
+			sizeof(double) * DS_CMP_BLOCK) == 0
+		&& memcmp(p->x + from, x_seconds + from,
+			sizeof(int) * DS_CMP_BLOCK) == 0)
+		from += DS_CMP_BLOCK;
+	while (from < m
+		&& memcmp(&p->v[from], &values[from], sizeof(double)) == 0
+		&& p->x[from] == (x_seconds ? x_seconds[from] : from))
+		from++;
+	return (from);
+}
+
+int	ui_ds_pyramid_sync_from(t_ui_ds_pyramid *p, const double *values,
+		const int *x_seconds, int n, int from)
+{
+	int	old_n;
+	int	i;
+
+	if (!p)
+		return (-1);
+	if (!values || n < 0)
+		n = 0;
+	if (n > p->size && !pyramid_grow(p, n))
+		return (-1);
+	old_n = p->n;
+	if (from > n)
+		from = n;
+	if (from > old_n)
+		from = old_n;
+	if (from < 0)
+		from = 0;
+	i = from;
+	while (i < n)
+	{
+		p->v[i] = values[i];
+		p->x[i] = x_seconds ? x_seconds[i] : i;
+		p->imin[p->size + i] = i;
+		p->imax[p->size + i] = i;
+		i++;
+	}
+	while (i < old_n)
+	{
+		p->imin[p->size + i] = -1;
+		p->imax[p->size + i++] = -1;
+	}
+	pyramid_update(p, from, (n > old_n) ? n : old_n);
+	p->n = n;
+	/* NaN (gap) or x going back: queries fall back to the linear walk. */
+	if (p->bad >= from || p->bad > n)
+	{
+		p->bad = from;
+		while (p->bad < n && !tm_isnan(p->v[p->bad])
+			&& (p->bad == 0 || p->x[p->bad] >= p->x[p->bad - 1]))
+			p->bad++;
+	}
+	return (from);
+}
+
+int	ui_ds_pyramid_sync(t_ui_ds_pyramid *p, const double *values,
+		const int *x_seconds, int n)
+{
+	if (!p)
+		return (-1);
+	if (!values || n < 0)
+		n = 0;
+	return (ui_ds_pyramid_sync_from(p, values, x_seconds, n,
+			first_change(p, values, x_seconds, (n < p->n) ? n : p->n)));
+}
+
+/* Leftmost extrema of [l, r] (inclusive). */
+static void	pyramid_query(const t_ui_ds_pyramid *p, int l, int r,
+				int *out_min, int *out_max)
+{
+	int	lmin;
+	int	lmax;
+	int	rmin;
+	int	rmax;
+
+	lmin = -1;
+	lmax = -1;
+	rmin = -1;
+	rmax = -1;
+	l += p->size;
+	r += p->size + 1;
+	while (l < r)
+	{
+		if (l & 1)
 		{
-			poly_pts[poly_n] = (t_point_i){x, b->y_min};
-			poly_idx[poly_n] = b->idx_min;
-			poly_n++;
+			lmin = pick_min(p->v, lmin, p->imin[l]);
+			lmax = pick_max(p->v, lmax, p->imax[l++]);
 		}
-		if (b->y_max != b->y_min && poly_n < poly_cap)
+		if (r & 1)
 		{
-			poly_pts[poly_n] = (t_point_i){x, b->y_max};
-			poly_idx[poly_n] = b->idx_max;
-			poly_n++;
+			r--;
+			rmin = pick_min(p->v, p->imin[r], rmin);
+			rmax = pick_max(p->v, p->imax[r], rmax);
 		}
-		if (b->y_last != b->y_max && poly_n < poly_cap)
+		l >>= 1;
+		r >>= 1;
+	}
+	*out_min = pick_min(p->v, lmin, rmin);
+	*out_max = pick_max(p->v, lmax, rmax);
+}
+
+/* First index in [lo, hi) with x > key (x sorted). */
+static int	upper_bound(const int *x, int lo, int hi, double key)
+{
+	int	mid;
+
+	while (lo < hi)
+	{
+		mid = lo + (hi - lo) / 2;
+		if ((double)x[mid] > key)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+	return (lo);
+}
+
+/* Last index in [s, hi] still in column c: gallop, then bisect. */
+static int	column_end(const t_ui_ds_pyramid *p, int s, int hi, int c,
+				int xmin, double dt, int px_w)
+{
+	int	step;
+	int	lo;
+	int	mid;
+
+	step = 1;
+	while (s + step <= hi
+		&& col_of((double)p->x[s + step], xmin, dt, px_w) == c)
+		step *= 2;
+	lo = s + step / 2;
+	hi = (s + step <= hi) ? s + step - 1 : hi;
+	while (lo < hi)
+	{
+		mid = lo + (hi - lo + 1) / 2;
+		if (col_of((double)p->x[mid], xmin, dt, px_w) == c)
+			lo = mid;
+		else
+			hi = mid - 1;
+	}
+	return (lo);
+}
+
+static double	clamp_v(double v, double vmin, double vmax)
+{
+	if (v < vmin)
+		return (vmin);
+	if (v > vmax)
+		return (vmax);
+	return (v);
+}
+
+void	ui_ds_columns_free(t_ui_ds_columns *c)
+{
+	if (!c)
+		return ;
+	free(c->col);
+	memset(c, 0, sizeof(*c));
+}
+
+/*
+** Refills the columns >= col_from from the pyramid (earlier columns are
+** kept). Column bounds by bisection on x, extrema by tree query.
+*/
+static void	columns_fill(t_ui_ds_columns *c, const t_ui_ds_pyramid *p,
+				int col_from)
+{
+	t_ui_ds_col	*col;
+	double		dt;
+	int			s;
+	int			e;
+	int			hi;
+	int			k;
+
+	k = col_from;
+	while (k < c->px_w)
+		c->col[k++].first = -1;
+	dt = (double)(c->xmax - c->xmin);
+	/* Points in [xmin..xmax]: one contiguous index range (x sorted). */
+	s = upper_bound(p->x, 0, p->n, (double)c->xmin - 1.0);
+	hi = upper_bound(p->x, s, p->n, (double)c->xmax) - 1;
+	/* First point of column col_from or later (col is monotonic in i). */
+	e = hi + 1;
+	while (col_from > 0 && s < e)
+	{
+		k = s + (e - s) / 2;
+		if (col_of((double)p->x[k], c->xmin, dt, c->px_w) >= col_from)
+			e = k;
+		else
+			s = k + 1;
+	}
+	while (s <= hi)
+	{
+		k = col_of((double)p->x[s], c->xmin, dt, c->px_w);
+		e = column_end(p, s, hi, k, c->xmin, dt, c->px_w);
+		col = &c->col[k];
+		col->first = s;
+		col->last = e;
+		pyramid_query(p, s, e, &col->imin, &col->imax);
+		s = e + 1;
+	}
+	c->n = p->n;
+}
+
+int	ui_ds_columns_build(t_ui_ds_columns *c, const t_ui_ds_pyramid *p,
+		int xmin, int xmax, int plot_w)
+{
+	t_ui_ds_col	*nc;
+
+	if (!c)
+		return (0);
+	c->px_w = 0;
+	if (!p || p->bad < p->n || plot_w + 1 <= 2)
+		return (0);
+	if (c->cap < plot_w + 1)
+	{
+		nc = (t_ui_ds_col *)realloc(c->col, sizeof(*nc) * (size_t)(plot_w + 1));
+		if (!nc)
+			return (0);
+		c->col = nc;
+		c->cap = plot_w + 1;
+	}
+	if (xmax <= xmin)
+		xmax = xmin + 1;
+	c->px_w = plot_w + 1;
+	c->xmin = xmin;
+	c->xmax = xmax;
+	columns_fill(c, p, 0);
+	return (1);
+}
+
+int	ui_ds_columns_update(t_ui_ds_columns *c, const t_ui_ds_pyramid *p,
+		int from)
+{
+	int	col_from;
+	int	k;
+
+	if (!c || c->px_w <= 0 || !p || p->bad < p->n)
+		return (-1);
+	/* Points past the old end were never in the columns. */
+	if (from > c->n)
+		from = c->n;
+	/* Columns holding an old point >= from (empty ones on the way too). */
+	col_from = c->px_w;
+	while (col_from > 0 && (c->col[col_from - 1].first < 0
+			|| c->col[col_from - 1].last >= from))
+		col_from--;
+	/* Column of the first new point, if it is in view. */
+	if (from < p->n && p->x[from] <= c->xmax)
+	{
+		k = 0;
+		if (p->x[from] >= c->xmin)
+			k = col_of((double)p->x[from], c->xmin,
+					(double)(c->xmax - c->xmin), c->px_w);
+		if (k < col_from)
+			col_from = k;
+	}
+	if (col_from < c->px_w)
+		columns_fill(c, p, col_from);
+	c->n = p->n;
+	return (col_from);
+}
+
+int	ui_ds_columns_emit(const t_ui_ds_columns *c, const t_ui_ds_pyramid *p,
+		int col_from, double vmin, double vmax, t_rect plot,
+		t_point_i *poly_pts, int *poly_idx, int poly_n, int poly_cap,
+		t_point_i *rep_pts, int *rep_idx, int *rep_n, int rep_cap)
+{
+	const t_ui_ds_col	*col;
+	t_ui_bucket			b;
+	t_ds_out			o;
+	double				dv;
+	int					k;
+
+	dv = vmax - vmin;
+	if (!c || !p || c->px_w != plot.w + 1 || c->n != p->n || plot.h + 1 <= 2
+		|| dv <= 0.0 || !poly_pts || !poly_idx || !rep_n
+		|| poly_n < 0 || poly_n > poly_cap || *rep_n < 0 || *rep_n > rep_cap)
+		return (-1);
+	if (col_from < 0)
+		col_from = 0;
+	/* Drop the output of the columns emitted again. */
+	while (poly_n > 0 && poly_pts[poly_n - 1].x >= plot.x + col_from)
+		poly_n--;
+	while (*rep_n > 0 && rep_pts && rep_pts[*rep_n - 1].x >= plot.x + col_from)
+		(*rep_n)--;
+	o = (t_ds_out){poly_pts, poly_idx, poly_n, poly_cap,
+		rep_pts, rep_idx, *rep_n, rep_cap};
+	k = col_from;
+	while (k < c->px_w)
+	{
+		col = &c->col[k];
+		if (col->first >= 0)
 		{
-			poly_pts[poly_n] = (t_point_i){x, b->y_last};
-			poly_idx[poly_n] = b->idx_last;
-			poly_n++;
+			b.idx_first = col->first;
+			b.idx_last = col->last;
+			/* Screen y grows downwards: max value = smallest y. */
+			b.idx_min = col->imax;
+			b.idx_max = col->imin;
+			b.y_first = py_of(clamp_v(p->v[col->first], vmin, vmax), vmin,
+					dv, plot);
+			b.y_last = py_of(clamp_v(p->v[col->last], vmin, vmax), vmin,
+					dv, plot);
+			b.y_min = py_of(clamp_v(p->v[col->imax], vmin, vmax), vmin,
+					dv, plot);
+			b.y_max = py_of(clamp_v(p->v[col->imin], vmin, vmax), vmin,
+					dv, plot);
+			emit_bucket(&o, &b, plot.x + k);
 		}
-		i++;
+		k++;
 	}
+	*rep_n = o.rep_n;
+	return (o.poly_n);
+}
 
+int	ui_downsample_minmax_pyramid(
+		const t_ui_ds_pyramid *p,
+		const double *values,
+		const int *x_seconds,
+		int n,
+		int xmin,
+		int xmax,
+		double vmin,
+		double vmax,
+		t_rect plot,
+		t_point_i *poly_pts,
+		int *poly_idx,
+		int poly_cap,
+		t_point_i *rep_pts,
+		int *rep_idx,
+		int rep_cap,
+		int *out_rep_n)
+{
+	static t_ui_ds_columns	cols;
+	int						rep_n;
+	int						poly_n;
+
+	if (!p || p->n != n || p->bad < n || n <= 0)
+		return (ui_downsample_minmax_pixels(values, x_seconds, n, xmin, xmax,
+				vmin, vmax, plot, poly_pts, poly_idx, poly_cap,
+				rep_pts, rep_idx, rep_cap, out_rep_n));
+	if (out_rep_n)
+		*out_rep_n = 0;
+	if (!ui_ds_columns_build(&cols, p, xmin, xmax, plot.w))
+		return (0);
+	rep_n = 0;
+	poly_n = ui_ds_columns_emit(&cols, p, 0, vmin, vmax, plot,
+			poly_pts, poly_idx, 0, poly_cap, rep_pts, rep_idx, &rep_n,
+			(rep_pts && rep_idx) ? rep_cap : 0);
+	if (poly_n < 0)
+		return (0);
 	if (out_rep_n)
 		*out_rep_n = rep_n;
 	return (poly_n);
 }
+
+int	ui_ds_pyramid_max(const t_ui_ds_pyramid *p, int x0, int x1, double *out)
+{
+	int	s;
+	int	e;
+	int	imin;
+	int	imax;
+
+	if (!p || !out || p->bad < p->n)
+		return (0);
+	*out = 0.0;
+	s = upper_bound(p->x, 0, p->n, (double)x0 - 1.0);
+	e = upper_bound(p->x, s, p->n, (double)x1) - 1;
+	if (s > e)
+		return (1);
+	pyramid_query(p, s, e, &imin, &imax);
+	*out = p->v[imax];
+	return (1);
+}
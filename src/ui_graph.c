@@ -40,18 +40,38 @@ typedef struct s_ui_graph_cache
 	int			rep_n;
 
 	/* Cache key (deterministic): recompute only when any key changes. */
-	uint32_t		series_version;
 	const double		*values;
 	const int		*x_seconds;
-	int			n;
 	int			xmin;
 	int			xmax;
 	double			vmin;
 	double			vmax;
 	t_rect			plot;
 	int			valid;
+	/* Series sync the output was computed at (append path). */
+	unsigned int		sync_seq;
+	/* Value-space columns of the x view; px_w = 0 when not usable. */
+	t_ui_ds_columns		cols;
 } 	t_ui_graph_cache;
 
+/*
+** Min/max pyramid of the plotted series, shared by the main and overview
+** caches: synced when the data changes, then zoom / resize only query it.
+*/
+typedef struct s_ui_graph_series
+{
+	t_ui_ds_pyramid	pyr;
+	uint32_t		series_version;
+	uint32_t		append_gen;
+	const double	*values;
+	const int		*x_seconds;
+	int				n;
+	int				valid;
+	/* Bumped by each sync; 'from' = first index changed by the last one. */
+	unsigned int	sync_seq;
+	int				from;
+} 	t_ui_graph_series;
+
 /* Forward declarations used by graph helpers inserted near the top. */
 static int	tm_isnan(double v);
 static int	clamp_int(int v, int lo, int hi);
@@ -83,41 +103,118 @@ static int	rect_eq(t_rect a, t_rect b)
 	return (a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h);
 }
 
+/*
+** append_gen: caller generation of the plotted series (0 = unknown). While
+** it holds, only the last point may change and points are appended, so the
+** pyramid resyncs from the old last point instead of comparing the copy.
+*/
+static void	graph_series_sync(t_ui_graph_series *gs,
+			const double *values, const int *x_seconds, int n,
+			uint32_t series_version, uint32_t append_gen)
+{
+	int	appended;
+
+	if (gs->valid
+		&& gs->series_version == series_version
+		&& gs->append_gen == append_gen
+		&& gs->values == values
+		&& gs->x_seconds == x_seconds
+		&& gs->n == n)
+		return ;
+	appended = (gs->valid && append_gen != 0
+		&& gs->append_gen == append_gen
+		&& gs->values == values
+		&& gs->x_seconds == x_seconds
+		&& gs->pyr.n == gs->n && n >= gs->n);
+	/* Out of memory: pyramid empty, queries walk the series. */
+	if (appended)
+		gs->from = ui_ds_pyramid_sync_from(&gs->pyr, values, x_seconds, n,
+				gs->n - 1);
+	else
+		gs->from = ui_ds_pyramid_sync(&gs->pyr, values, x_seconds, n);
+	if (gs->from < 0)
+		gs->from = 0;
+	gs->series_version = series_version;
+	gs->append_gen = append_gen;
+	gs->values = values;
+	gs->x_seconds = x_seconds;
+	gs->n = n;
+	gs->valid = 1;
+	gs->sync_seq++;
+}
+
+static double	max_in_range(const double *values, const int *x_seconds, int n,
+				int t0, int t1);
+
+/* max_in_range() through the pyramid: O(log n) per call. */
+static double	series_max_in_range(const t_ui_graph_series *gs,
+				const double *values, const int *x_seconds, int n,
+				int t0, int t1)
+{
+	double	m;
+
+	if (t1 < t0)
+	{
+		m = (double)t0;
+		t0 = t1;
+		t1 = (int)m;
+	}
+	if (gs->pyr.n != n || !ui_ds_pyramid_max(&gs->pyr, t0, t1, &m))
+		return (max_in_range(values, x_seconds, n, t0, t1));
+	return ((m <= 0.0) ? 1.0 : m);
+}
+
+/*
+** Columns of the x view, refilled from the first changed one (-1: the
+** pyramid cannot serve). Same view and one sync later: only the columns
+** from the first changed point on; same sync: none (y scale moved).
+*/
+static int	cache_columns(t_ui_graph_cache *c, const t_ui_graph_series *gs,
+			int same_x, int xmin, int xmax, t_rect plot)
+{
+	int	col_from;
+
+	col_from = -1;
+	if (same_x && c->cols.px_w > 0 && c->sync_seq == gs->sync_seq)
+		col_from = c->cols.px_w;
+	else if (same_x && c->cols.px_w > 0 && c->sync_seq + 1 == gs->sync_seq)
+		col_from = ui_ds_columns_update(&c->cols, &gs->pyr, gs->from);
+	if (col_from < 0 && ui_ds_columns_build(&c->cols, &gs->pyr,
+			xmin, xmax, plot.w))
+		col_from = 0;
+	return (col_from);
+}
+
+/*
+** The series is synced by the caller. The x view maps points to columns
+** (kept across appends), the y scale only projects them: a new vmax
+** re-projects the kept columns, O(px), without querying the pyramid.
+*/
 static void	ui_graph_cache_compute(t_ui_graph_cache *c,
+			const t_ui_graph_series *gs,
 			const double *values, const int *x_seconds, int n,
-			int xmin, int xmax, double vmin, double vmax, t_rect plot,
-			uint32_t series_version)
+			int xmin, int xmax, double vmin, double vmax, t_rect plot)
 {
 	int	need_poly;
 	int	need_rep;
 	int	poly_cap;
 	int	rep_cap;
+	int	same_x;
+	int	same_y;
+	int	col_from;
 
 	if (!c)
 		return ;
-	if (c->valid
-		&& c->series_version == series_version
+	same_x = (c->valid
 		&& c->values == values
 		&& c->x_seconds == x_seconds
-		&& c->n == n
 		&& c->xmin == xmin
 		&& c->xmax == xmax
-		&& fabs(c->vmin - vmin) < 1e-9
-		&& fabs(c->vmax - vmax) < 1e-9
-		&& rect_eq(c->plot, plot))
+		&& rect_eq(c->plot, plot));
+	same_y = (fabs(c->vmin - vmin) < 1e-9 && fabs(c->vmax - vmax) < 1e-9);
+	if (same_x && same_y && c->sync_seq == gs->sync_seq)
 		return ;
 
-	c->values = values;
-	c->x_seconds = x_seconds;
-	c->n = n;
-	c->xmin = xmin;
-	c->xmax = xmax;
-	c->vmin = vmin;
-	c->vmax = vmax;
-	c->plot = plot;
-	c->series_version = series_version;
-	c->valid = 1;
-
 	need_poly = (plot.w + 1) * 4 + 16;
 	need_rep = (plot.w + 1) + 16;
 	dsbuf_ensure_points(&c->buf.poly_pts, &c->buf.poly_pts_cap, need_poly);
@@ -132,11 +229,39 @@ static void	ui_graph_cache_compute(t_ui_graph_cache *c,
 	if (c->buf.rep_idx_cap < rep_cap)
 		rep_cap = c->buf.rep_idx_cap;
 
-	c->rep_n = 0;
-	c->poly_n = ui_downsample_minmax_pixels(values, x_seconds, n,
-		xmin, xmax, vmin, vmax, plot,
-		c->buf.poly_pts, c->buf.poly_idx, poly_cap,
-		c->buf.rep_pts, c->buf.rep_idx, rep_cap, &c->rep_n);
+	col_from = -1;
+	if (gs->pyr.n == n)
+		col_from = cache_columns(c, gs, same_x, xmin, xmax, plot);
+	if (col_from >= 0 && (!same_x || !same_y))
+		col_from = 0;
+	if (col_from == 0)
+	{
+		c->poly_n = 0;
+		c->rep_n = 0;
+	}
+	if (col_from >= 0)
+		c->poly_n = ui_ds_columns_emit(&c->cols, &gs->pyr, col_from,
+			vmin, vmax, plot, c->buf.poly_pts, c->buf.poly_idx, c->poly_n,
+			poly_cap, c->buf.rep_pts, c->buf.rep_idx, &c->rep_n, rep_cap);
+	if (col_from < 0 || c->poly_n < 0)
+	{
+		/* NaN gaps / unsorted x / out of memory: linear walk. */
+		c->cols.px_w = 0;
+		c->rep_n = 0;
+		c->poly_n = ui_downsample_minmax_pixels(values, x_seconds, n,
+			xmin, xmax, vmin, vmax, plot,
+			c->buf.poly_pts, c->buf.poly_idx, poly_cap,
+			c->buf.rep_pts, c->buf.rep_idx, rep_cap, &c->rep_n);
+	}
+	c->values = values;
+	c->x_seconds = x_seconds;
+	c->xmin = xmin;
+	c->xmax = xmax;
+	c->vmin = vmin;
+	c->vmax = vmax;
+	c->plot = plot;
+	c->valid = 1;
+	c->sync_seq = gs->sync_seq;
 }
 
 static int	graph_point_for_index(t_rect plot,
@@ -1129,8 +1254,13 @@ static double	max_in_range(const double *values, const int *x_seconds, int n,
 	return (m);
 }
 
+/*
+** The overview maps [full_xmin..ov_xmax] (padded past the data end), the
+** zoom window stays clamped to the data [full_xmin..full_xmax].
+*/
 static void	update_zoom_from_overview(t_window *w, t_rect ov_plot,
-				int full_xmin, int full_xmax, t_ui_graph_zoom *zoom)
+				int full_xmin, int full_xmax, int ov_xmax,
+				t_ui_graph_zoom *zoom)
 {
 	const int	handle_px = 8;
 	const int	dbl_ms = 350;
@@ -1144,6 +1274,8 @@ static void	update_zoom_from_overview(t_window *w, t_rect ov_plot,
 		return ;
 	if (full_xmax == full_xmin)
 		full_xmax = full_xmin + 1;
+	if (ov_xmax < full_xmax)
+		ov_xmax = full_xmax;
 	if (zoom->t1 <= zoom->t0)
 	{
 		zoom->t0 = full_xmin;
@@ -1169,7 +1301,7 @@ static void	update_zoom_from_overview(t_window *w, t_rect ov_plot,
 		if (zoom->mode == UI_GRAPH_ZOOM_MOVE)
 		{
 			double dt = ((double)(w->mouse_x - zoom->drag_start_x)
-				/ (double)ov_plot.w) * (double)(full_xmax - full_xmin);
+				/ (double)ov_plot.w) * (double)(ov_xmax - full_xmin);
 			int width = zoom->drag_t1 - zoom->drag_t0;
 			int nt0 = zoom->drag_t0 + (int)llround(dt);
 			int nt1 = nt0 + width;
@@ -1190,7 +1322,7 @@ static void	update_zoom_from_overview(t_window *w, t_rect ov_plot,
 		}
 		else if (zoom->mode == UI_GRAPH_ZOOM_RESIZE_L)
 		{
-			int nt0 = map_px_to_time(ov_plot, full_xmin, full_xmax, w->mouse_x);
+			int nt0 = map_px_to_time(ov_plot, full_xmin, ov_xmax, w->mouse_x);
 			if (nt0 < full_xmin)
 				nt0 = full_xmin;
 			if (nt0 > zoom->t1 - min_w)
@@ -1199,7 +1331,7 @@ static void	update_zoom_from_overview(t_window *w, t_rect ov_plot,
 		}
 		else if (zoom->mode == UI_GRAPH_ZOOM_RESIZE_R)
 		{
-			int nt1 = map_px_to_time(ov_plot, full_xmin, full_xmax, w->mouse_x);
+			int nt1 = map_px_to_time(ov_plot, full_xmin, ov_xmax, w->mouse_x);
 			if (nt1 > full_xmax)
 				nt1 = full_xmax;
 			if (nt1 < zoom->t0 + min_w)
@@ -1227,8 +1359,8 @@ static void	update_zoom_from_overview(t_window *w, t_rect ov_plot,
 	}
 	zoom->last_click_ms = now;
 
-	zx0 = map_time_to_px(ov_plot, full_xmin, full_xmax, zoom->t0);
-	zx1 = map_time_to_px(ov_plot, full_xmin, full_xmax, zoom->t1);
+	zx0 = map_time_to_px(ov_plot, full_xmin, ov_xmax, zoom->t0);
+	zx1 = map_time_to_px(ov_plot, full_xmin, ov_xmax, zoom->t1);
 	if (zx1 < zx0)
 	{
 		int t = zx0;
@@ -1259,7 +1391,7 @@ static void	update_zoom_from_overview(t_window *w, t_rect ov_plot,
 	if (!inside)
 	{
 		int width = zoom->t1 - zoom->t0;
-		int center = map_px_to_time(ov_plot, full_xmin, full_xmax, w->mouse_x);
+		int center = map_px_to_time(ov_plot, full_xmin, ov_xmax, w->mouse_x);
 		int nt0 = center - (width / 2);
 		int nt1 = nt0 + width;
 		if (width < min_w)
@@ -1294,7 +1426,8 @@ static void	ui_graph_timeseries_zoom_impl(t_window *w, t_ui_state *ui, t_rect r,
 					const char *unit,
 					unsigned int line_color,
 					t_ui_graph_zoom *zoom,
-					uint32_t series_version)
+					uint32_t series_version,
+					uint32_t append_gen)
 {
 	const int	pad_r = 18;
 	const int	pad_t = 48;
@@ -1327,6 +1460,10 @@ static void	ui_graph_timeseries_zoom_impl(t_window *w, t_ui_state *ui, t_rect r,
 	const char	*ylab;
 	static t_ui_graph_cache	cache_main;
 	static t_ui_graph_cache	cache_ov;
+	static t_ui_graph_series	series;
+	static int	ov_xmin;
+	static int	ov_xmax;
+	int		ov_pad;
 	int		hover_src;
 	int		hover_poly_i;
 	int		thresh2;
@@ -1345,10 +1482,19 @@ static void	ui_graph_timeseries_zoom_impl(t_window *w, t_ui_state *ui, t_rect r,
 	if (title)
 		ui_draw_text(w, r.x + 12, r.y + 10, title, ui->theme->text);
 
-	/* Full X range */
+	/* One sync per data change; zoom / resize / hover reuse the pyramid. */
+	graph_series_sync(&series, values, x_seconds, n, series_version,
+		append_gen);
+
+	/* Full X range (sorted x: the ends) */
 	xmin_full = 0;
 	xmax_full = (n > 0 ? (n - 1) : 0);
-	if (x_seconds)
+	if (series.pyr.n == n && series.pyr.bad >= n)
+	{
+		xmin_full = series.pyr.x[0];
+		xmax_full = series.pyr.x[n - 1];
+	}
+	else if (x_seconds)
 	{
 		xmin_full = x_seconds[0];
 		xmax_full = x_seconds[n - 1];
@@ -1371,6 +1517,21 @@ static void	ui_graph_timeseries_zoom_impl(t_window *w, t_ui_state *ui, t_rect r,
 	if (xmax_full == xmin_full)
 		xmax_full = xmin_full + 1;
 
+	/*
+	 * Overview x domain padded by 1/8 past the data end: LIVE points land in
+	 * columns already laid out (append path) instead of rescaling the whole
+	 * overview on every event. Laid out again once the data reaches the end.
+	 */
+	ov_pad = (xmax_full - xmin_full) / 8;
+	if (ov_pad < 1)
+		ov_pad = 1;
+	if (ov_xmin != xmin_full || ov_xmax < xmax_full
+		|| ov_xmax > xmax_full + 2 * ov_pad)
+	{
+		ov_xmin = xmin_full;
+		ov_xmax = xmax_full + ov_pad;
+	}
+
 	/*
 	 * Layout: keep the overview even on compact panels.
 	 *
@@ -1392,8 +1553,8 @@ static void	ui_graph_timeseries_zoom_impl(t_window *w, t_ui_state *ui, t_rect r,
 	if (ov_h > 0)
 	{
 		/* Left padding needs to fit the largest Y label (use full vmax). */
-		ymax_full = (vmax_in <= 0.0) ? max_in_range(values, x_seconds, n,
-				xmin_full, xmax_full) : vmax_in;
+		ymax_full = (vmax_in <= 0.0) ? series_max_in_range(&series, values,
+				x_seconds, n, xmin_full, xmax_full) : vmax_in;
 		snprintf(buf, sizeof(buf), "%.2f%s", ymax_full, unit ? unit : "");
 		text_w = ui_measure_text_w(buf, 14);
 		pad_l = 14 + text_w + 12;
@@ -1432,16 +1593,17 @@ static void	ui_graph_timeseries_zoom_impl(t_window *w, t_ui_state *ui, t_rect r,
 		zoom->t0 = xmin_full;
 		zoom->t1 = xmax_full;
 	}
-	update_zoom_from_overview(w, ov_plot, xmin_full, xmax_full, zoom);
+	update_zoom_from_overview(w, ov_plot, xmin_full, xmax_full, ov_xmax,
+		zoom);
 	xmin = zoom->t0;
 	xmax = zoom->t1;
 	if (xmax <= xmin)
 		xmax = xmin + 1;
 
 	/* Y range */
-	ymax_full = (vmax_in <= 0.0) ? max_in_range(values, x_seconds, n,
-			xmin_full, xmax_full) : vmax_in;
-	ymax = max_in_range(values, x_seconds, n, xmin, xmax);
+	ymax_full = (vmax_in <= 0.0) ? series_max_in_range(&series, values,
+			x_seconds, n, xmin_full, xmax_full) : vmax_in;
+	ymax = series_max_in_range(&series, values, x_seconds, n, xmin, xmax);
 	if (ymax <= 0.0)
 		ymax = 1.0;
 
@@ -1570,8 +1732,8 @@ static void	ui_graph_timeseries_zoom_impl(t_window *w, t_ui_state *ui, t_rect r,
 	}
 
 	/* Main series (cached downsample) */
-	ui_graph_cache_compute(&cache_main, values, x_seconds, n,
-		xmin, xmax, 0.0, ymax, plot, series_version);
+	ui_graph_cache_compute(&cache_main, &series, values, x_seconds, n,
+		xmin, xmax, 0.0, ymax, plot);
 	if (cache_main.poly_n >= 2)
 		window_draw_polyline(w, cache_main.buf.poly_pts, cache_main.poly_n,
 			(int)line_color);
@@ -1713,8 +1875,8 @@ static void	ui_graph_timeseries_zoom_impl(t_window *w, t_ui_state *ui, t_rect r,
 		unsigned int ov_line = ui_color_lerp(line_color, ui->theme->bg, 160);
 		unsigned int zoom_bd = 0xA6B0BF;
 		unsigned int zoom_fill = ui_color_lerp(zoom_bd, ui->theme->bg, 200);
-		int zx0 = map_time_to_px(ov_plot, xmin_full, xmax_full, zoom->t0);
-		int zx1 = map_time_to_px(ov_plot, xmin_full, xmax_full, zoom->t1);
+		int zx0 = map_time_to_px(ov_plot, xmin_full, ov_xmax, zoom->t0);
+		int zx1 = map_time_to_px(ov_plot, xmin_full, ov_xmax, zoom->t1);
 		if (zx1 < zx0)
 		{
 			int t = zx0;
@@ -1724,8 +1886,8 @@ static void	ui_graph_timeseries_zoom_impl(t_window *w, t_ui_state *ui, t_rect r,
 
 		ui_draw_panel(w, (t_rect){ov_plot.x - 2, ov_plot.y - 2, ov_plot.w + 4, ov_plot.h + 4},
 			ui->theme->surface, ui->theme->border);
-		ui_graph_cache_compute(&cache_ov, values, x_seconds, n,
-			xmin_full, xmax_full, 0.0, ymax_full, ov_plot, series_version);
+		ui_graph_cache_compute(&cache_ov, &series, values, x_seconds, n,
+			xmin_full, ov_xmax, 0.0, ymax_full, ov_plot);
 		if (cache_ov.poly_n >= 2)
 			window_draw_polyline(w, cache_ov.buf.poly_pts, cache_ov.poly_n,
 				(int)ov_line);
@@ -1755,10 +1917,12 @@ void	ui_graph_timeseries_zoom(t_window *w, t_ui_state *ui, t_rect r,
 				const char *unit,
 				unsigned int line_color,
 				t_ui_graph_zoom *zoom,
-				uint32_t series_version)
+				uint32_t series_version,
+				uint32_t append_gen)
 {
 	ui_graph_timeseries_zoom_impl(w, ui, r, title, values, x_seconds, NULL,
-		NULL, 0, n, vmax, y_label, unit, line_color, zoom, series_version);
+		NULL, 0, n, vmax, y_label, unit, line_color, zoom, series_version,
+		append_gen);
 }
 
 void	ui_graph_timeseries_zoom_badges(t_window *w, t_ui_state *ui, t_rect r,
@@ -1772,11 +1936,12 @@ void	ui_graph_timeseries_zoom_badges(t_window *w, t_ui_state *ui, t_rect r,
 				const char *unit,
 				unsigned int line_color,
 				t_ui_graph_zoom *zoom,
-				uint32_t series_version)
+				uint32_t series_version,
+				uint32_t append_gen)
 {
 	ui_graph_timeseries_zoom_impl(w, ui, r, title, values, x_seconds,
 		badge_counts, NULL, 0, n, vmax, y_label, unit, line_color, zoom,
-		series_version);
+		series_version, append_gen);
 }
 
 void	ui_graph_timeseries_zoom_annotations(t_window *w, t_ui_state *ui, t_rect r,
@@ -1791,10 +1956,12 @@ void	ui_graph_timeseries_zoom_annotations(t_window *w, t_ui_state *ui, t_rect r,
 				const t_ui_graph_annot *annots,
 				int annots_n,
 				t_ui_graph_zoom *zoom,
-				uint32_t series_version)
+				uint32_t series_version,
+				uint32_t append_gen)
 {
 	ui_graph_timeseries_zoom_impl(w, ui, r, title, values, x_seconds, NULL,
-		annots, annots_n, n, vmax, y_label, unit, line_color, zoom, series_version);
+		annots, annots_n, n, vmax, y_label, unit, line_color, zoom,
+		series_version, append_gen);
 }
 
 void	ui_graph_timeseries_zoom_badges_annotations(t_window *w, t_ui_state *ui, t_rect r,
@@ -1810,11 +1977,12 @@ void	ui_graph_timeseries_zoom_badges_annotations(t_window *w, t_ui_state *ui, t_
 				const t_ui_graph_annot *annots,
 				int annots_n,
 				t_ui_graph_zoom *zoom,
-				uint32_t series_version)
+				uint32_t series_version,
+				uint32_t append_gen)
 {
 	ui_graph_timeseries_zoom_impl(w, ui, r, title, values, x_seconds,
 		badge_counts, annots, annots_n, n, vmax, y_label, unit, line_color,
-		zoom, series_version);
+		zoom, series_version, append_gen);
 }
 
 void	ui_graph_timeseries(t_window *w, t_ui_state *ui, t_rect r,
@@ -138,6 +138,14 @@ uint64_t	ft_time_ms(void)
     return ((uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL);
 }
 
+uint64_t	ft_time_us(void)
+{
+    struct timespec	ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL);
+}
+
 #else
 
 # include <windows.h>
@@ -154,4 +162,17 @@ uint64_t	ft_time_ms(void)
     return ((uint64_t)GetTickCount64());
 }
 
+uint64_t	ft_time_us(void)
+{
+    LARGE_INTEGER	freq;
+    LARGE_INTEGER	now;
+
+    if (!QueryPerformanceFrequency(&freq) || freq.QuadPart <= 0
+        || !QueryPerformanceCounter(&now))
+        return (ft_time_ms() * 1000ULL);
+    return ((uint64_t)(now.QuadPart / freq.QuadPart) * 1000000ULL
+        + (uint64_t)(now.QuadPart % freq.QuadPart) * 1000000ULL
+        / (uint64_t)freq.QuadPart);
+}
+
 #endif
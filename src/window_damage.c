@@ -0,0 +1,162 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   window_damage.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                   +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/22                                #+#    #+#             */
+/*   Updated: 2026/02/22                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "window.h"
+
+#include <stddef.h>
+#include <string.h>
+
+static t_rect_i	rect_union(t_rect_i a, t_rect_i b)
+{
+	t_rect_i	r;
+	int			x1;
+	int			y1;
+
+	r.x = (a.x < b.x) ? a.x : b.x;
+	r.y = (a.y < b.y) ? a.y : b.y;
+	x1 = (a.x + a.w > b.x + b.w) ? a.x + a.w : b.x + b.w;
+	y1 = (a.y + a.h > b.y + b.h) ? a.y + a.h : b.y + b.h;
+	r.w = x1 - r.x;
+	r.h = y1 - r.y;
+	return (r);
+}
+
+static long	rect_area(t_rect_i r)
+{
+	return ((long)r.w * (long)r.h);
+}
+
+void	window_damage_all(t_window *w)
+{
+	if (!w)
+		return ;
+	w->damage_full = 1;
+	w->damage_n = 0;
+}
+
+int	window_has_damage(const t_window *w)
+{
+	return (w && (w->damage_full || w->damage_n > 0));
+}
+
+void	window_damage_clear(t_window *w)
+{
+	if (!w)
+		return ;
+	w->damage_full = 0;
+	w->damage_n = 0;
+}
+
+void	window_damage_add(t_window *w, int x, int y, int width, int height)
+{
+	t_rect_i	r;
+	t_rect_i	*d;
+	long		grow;
+	long		best_grow;
+	int			best;
+	int			i;
+
+	if (!w || w->damage_full || width <= 0 || height <= 0)
+		return ;
+	r.x = (x < 0) ? 0 : x;
+	r.y = (y < 0) ? 0 : y;
+	r.w = ((x > w->width - width) ? w->width : x + width) - r.x;
+	r.h = ((y > w->height - height) ? w->height : y + height) - r.y;
+	if (r.w <= 0 || r.h <= 0)
+		return ;
+	best = -1;
+	best_grow = 0;
+	i = -1;
+	while (++i < w->damage_n)
+	{
+		d = &w->damage[i];
+		/* Same column span right below: extend (tile rows of a diff). */
+		if (d->x == r.x && d->w == r.w && d->y + d->h == r.y)
+		{
+			d->h += r.h;
+			return ;
+		}
+		grow = rect_area(rect_union(*d, r)) - rect_area(*d);
+		if (grow <= 0)
+			return ;
+		if (best < 0 || grow < best_grow)
+		{
+			best = i;
+			best_grow = grow;
+		}
+	}
+	if (w->damage_n < WINDOW_DAMAGE_MAX)
+		w->damage[w->damage_n++] = r;
+	else
+		w->damage[best] = rect_union(w->damage[best], r);
+}
+
+/* 1 if the tile differs; then copies it into prev. */
+static int	tile_changed(const unsigned int *cur, unsigned int *prev,
+				int pitch, int tw, int th)
+{
+	int	y;
+
+	y = 0;
+	while (y < th && memcmp(cur + (size_t)y * (size_t)pitch,
+			prev + (size_t)y * (size_t)pitch, (size_t)tw * sizeof(*cur)) == 0)
+		y++;
+	if (y == th)
+		return (0);
+	while (y < th)
+	{
+		memcpy(prev + (size_t)y * (size_t)pitch,
+			cur + (size_t)y * (size_t)pitch, (size_t)tw * sizeof(*cur));
+		y++;
+	}
+	return (1);
+}
+
+void	window_damage_diff(t_window *w, unsigned int *prev)
+{
+	size_t	off;
+	int		tx;
+	int		ty;
+	int		th;
+	int		run;
+
+	if (!w || !w->pixels || !prev || w->damage_full)
+		return ;
+	ty = 0;
+	while (ty < w->height)
+	{
+		th = (w->height - ty < WINDOW_DAMAGE_TILE)
+			? w->height - ty : WINDOW_DAMAGE_TILE;
+		run = -1;
+		tx = 0;
+		while (tx < w->width)
+		{
+			off = (size_t)ty * (size_t)w->pitch + (size_t)tx;
+			if (tile_changed(w->pixels + off, prev + off, w->pitch,
+					(w->width - tx < WINDOW_DAMAGE_TILE)
+					? w->width - tx : WINDOW_DAMAGE_TILE, th))
+			{
+				if (run < 0)
+					run = tx;
+			}
+			else if (run >= 0)
+			{
+				window_damage_add(w, run, ty, tx - run, th);
+				run = -1;
+			}
+			tx += WINDOW_DAMAGE_TILE;
+		}
+		if (run >= 0)
+			window_damage_add(w, run, ty, w->width - run, th);
+		ty += th;
+	}
+}
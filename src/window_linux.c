@@ -13,13 +13,23 @@
 #ifndef _WIN32
 
 # include "window.h"
+# include "window_raster.h"
 # include <X11/Xlib.h>
 # include <X11/Xutil.h>
 # include <X11/Xatom.h>
 # include <X11/keysym.h>
+# ifdef TM_HAVE_XSHM
+#  include <X11/extensions/XShm.h>
+#  include <sys/ipc.h>
+#  include <sys/shm.h>
+# endif
+# include <fcntl.h>
+# include <poll.h>
+# include <stdatomic.h>
 # include <stdint.h>
 # include <stdlib.h>
 # include <string.h>
+# include <unistd.h>
 
 typedef struct s_x11_backend
 {
@@ -44,6 +54,26 @@ typedef struct s_x11_backend
         unsigned long   pixel;
     }               color_cache[256];
     int             color_cache_count;
+
+    /*
+    ** Software renderer (default on 24/32-bit TrueColor): everything is
+    ** drawn into w->pixels (= img->data) and the frame is sent with one
+    ** XShmPutImage / XPutImage in window_present(). 'back' is only used
+    ** by the Xlib fallback (TM_X11_RENDER=xlib or unsupported visual).
+    */
+    int             soft;
+    int             rgb_direct;     /* pixel value == 0xRRGGBB */
+    XImage          *img;
+    unsigned int    *prev;          /* last frame sent (damage diff) */
+    int             drawn;          /* drawn into since the last present */
+    t_raster        ras;
+    t_raster_font   glyphs;
+# ifdef TM_HAVE_XSHM
+    int             use_shm;
+    int             shm_busy;       /* last XShmPutImage not completed */
+    int             shm_event;      /* ShmCompletion event type */
+    XShmSegmentInfo shm;
+# endif
 }   t_x11_backend;
 
 static int  ft_mask_shift(unsigned long mask)
@@ -124,13 +154,270 @@ static unsigned long ft_x11_color(t_x11_backend *b, int rgb)
 }
 
 
+/* -------------------------------------------------------------------------- */
+/* Software renderer                                                          */
+/* -------------------------------------------------------------------------- */
+
+static uint32_t ft_soft_color(t_x11_backend *b, int rgb)
+{
+    if (b->rgb_direct)
+        return ((uint32_t)rgb & 0xFFFFFFu);
+    return ((uint32_t)ft_x11_color(b, rgb));
+}
+
 /*
-** Resize handler: recreate Pixmap backbuffer + XImage + pixel buffer so the
-** whole window remains drawable in fullscreen / maximized modes.
+** Server font -> bitmap cells: every byte value is drawn once into a
+** 1-bit pixmap and read back, so text keeps the exact "9x15" glyphs.
 */
+static int  ft_font_build(t_x11_backend *b)
+{
+    t_raster_font   *g;
+    Pixmap          pm;
+    GC              gc;
+    XImage          *img;
+    char            ch;
+    int             c;
+    int             x;
+    int             y;
+
+    g = &b->glyphs;
+    if (!b->font)
+        return (0);
+    g->origin_x = (b->font->min_bounds.lbearing < 0)
+        ? -b->font->min_bounds.lbearing : 0;
+    g->cell_w = g->origin_x + b->font->max_bounds.rbearing;
+    g->ascent = b->font->max_bounds.ascent;
+    g->cell_h = b->font->max_bounds.ascent + b->font->max_bounds.descent;
+    if (g->cell_w <= 0 || g->cell_w > RASTER_GLYPH_W_MAX
+        || g->cell_h <= 0 || g->cell_h > 64)
+        return (0);
+    g->rows = (uint32_t *)calloc((size_t)256 * (size_t)g->cell_h,
+        sizeof(*g->rows));
+    if (!g->rows)
+        return (0);
+    pm = XCreatePixmap(b->d, b->win, (unsigned int)(g->cell_w * 256),
+        (unsigned int)g->cell_h, 1);
+    gc = XCreateGC(b->d, pm, 0, NULL);
+    XSetFont(b->d, gc, b->font->fid);
+    XSetForeground(b->d, gc, 0);
+    XFillRectangle(b->d, pm, gc, 0, 0, (unsigned int)(g->cell_w * 256),
+        (unsigned int)g->cell_h);
+    XSetForeground(b->d, gc, 1);
+    c = 1;
+    while (c < 256)
+    {
+        ch = (char)c;
+        XDrawString(b->d, pm, gc, c * g->cell_w + g->origin_x, g->ascent,
+            &ch, 1);
+        x = XTextWidth(b->font, &ch, 1);
+        g->advance[c] = (unsigned char)((x < 0) ? 0 : (x > 255) ? 255 : x);
+        c++;
+    }
+    img = XGetImage(b->d, pm, 0, 0, (unsigned int)(g->cell_w * 256),
+        (unsigned int)g->cell_h, 1, XYPixmap);
+    XFreeGC(b->d, gc);
+    XFreePixmap(b->d, pm);
+    if (!img)
+        return (free(g->rows), g->rows = NULL, 0);
+    c = 1;
+    while (c < 256)
+    {
+        y = -1;
+        while (++y < g->cell_h)
+        {
+            x = -1;
+            while (++x < g->cell_w)
+                if (XGetPixel(img, c * g->cell_w + x, y))
+                    g->rows[c * g->cell_h + y] |= 0x80000000u >> x;
+        }
+        c++;
+    }
+    XDestroyImage(img);
+    return (1);
+}
+
+# ifdef TM_HAVE_XSHM
+
+static int  g_shm_failed;
+
+static int  ft_shm_error(Display *d, XErrorEvent *e)
+{
+    (void)d;
+    (void)e;
+    g_shm_failed = 1;
+    return (0);
+}
+
+static Bool ft_is_shm_done(Display *d, XEvent *ev, XPointer arg)
+{
+    t_x11_backend   *b;
+
+    (void)d;
+    b = (t_x11_backend *)arg;
+    return (ev->type == b->shm_event
+        && ((XShmCompletionEvent *)ev)->shmseg == b->shm.shmseg);
+}
+
+/* The server may still be reading the last frame: do not draw over it. */
+static void ft_shm_wait(t_x11_backend *b)
+{
+    XEvent  ev;
+
+    if (!b->shm_busy)
+        return ;
+    XIfEvent(b->d, &ev, ft_is_shm_done, (XPointer)b);
+    b->shm_busy = 0;
+}
+
+static int  ft_shm_image_create(t_x11_backend *b, int width, int height)
+{
+    int     (*old)(Display *, XErrorEvent *);
+
+    memset(&b->shm, 0, sizeof(b->shm));
+    b->img = XShmCreateImage(b->d, b->vis, (unsigned int)b->depth, ZPixmap,
+        NULL, &b->shm, (unsigned int)width, (unsigned int)height);
+    if (!b->img)
+        return (0);
+    if (b->img->bits_per_pixel != 32)
+        return (XDestroyImage(b->img), b->img = NULL, 0);
+    b->shm.shmid = shmget(IPC_PRIVATE,
+        (size_t)b->img->bytes_per_line * (size_t)height, IPC_CREAT | 0600);
+    if (b->shm.shmid < 0)
+        return (XDestroyImage(b->img), b->img = NULL, 0);
+    b->shm.shmaddr = (char *)shmat(b->shm.shmid, NULL, 0);
+    b->img->data = b->shm.shmaddr;
+    b->shm.readOnly = False;
+    g_shm_failed = (b->shm.shmaddr == (char *)-1);
+    if (!g_shm_failed)
+    {
+        /* Attach fails asynchronously (remote display): sync to know. */
+        old = XSetErrorHandler(ft_shm_error);
+        XShmAttach(b->d, &b->shm);
+        XSync(b->d, False);
+        XSetErrorHandler(old);
+    }
+    shmctl(b->shm.shmid, IPC_RMID, NULL);
+    if (g_shm_failed)
+    {
+        if (b->shm.shmaddr != (char *)-1)
+            shmdt(b->shm.shmaddr);
+        b->img->data = NULL;
+        XDestroyImage(b->img);
+        b->img = NULL;
+        return (0);
+    }
+    return (1);
+}
+
+# endif
+
+static int  ft_image_create(t_window *w, t_x11_backend *b, int width,
+                int height)
+{
+    union { uint32_t u; unsigned char c[4]; }   probe;
+    char                                        *data;
+
+    b->img = NULL;
+# ifdef TM_HAVE_XSHM
+    if (b->use_shm && !ft_shm_image_create(b, width, height))
+        b->use_shm = 0;
+# endif
+    if (!b->img)
+    {
+        data = (char *)malloc((size_t)width * (size_t)height * 4);
+        if (!data)
+            return (0);
+        b->img = XCreateImage(b->d, b->vis, (unsigned int)b->depth, ZPixmap,
+            0, data, (unsigned int)width, (unsigned int)height, 32, width * 4);
+        if (!b->img)
+            return (free(data), 0);
+        if (b->img->bits_per_pixel != 32)
+            return (XDestroyImage(b->img), b->img = NULL, 0);
+        /* Pixels are written as host uint32: let Xlib swap if needed. */
+        probe.u = 1;
+        b->img->byte_order = probe.c[0] ? LSBFirst : MSBFirst;
+    }
+    w->pixels = (unsigned int *)(void *)b->img->data;
+    w->pitch = b->img->bytes_per_line / 4;
+    b->prev = (unsigned int *)malloc((size_t)w->pitch * (size_t)height
+        * sizeof(*b->prev));
+    /* No copy of the last frame: every present sends the whole frame. */
+    window_damage_all(w);
+    b->ras.px = (uint32_t *)w->pixels;
+    b->ras.pitch = w->pitch;
+    b->ras.w = width;
+    b->ras.h = height;
+    return (1);
+}
+
+static void ft_image_destroy(t_window *w, t_x11_backend *b)
+{
+    if (!b->img)
+        return ;
+# ifdef TM_HAVE_XSHM
+    if (b->use_shm)
+    {
+        XShmDetach(b->d, &b->shm);
+        XSync(b->d, False);
+        shmdt(b->shm.shmaddr);
+        b->img->data = NULL;
+        b->shm_busy = 0;
+    }
+# endif
+    XDestroyImage(b->img);
+    b->img = NULL;
+    free(b->prev);
+    b->prev = NULL;
+    memset(&b->ras, 0, sizeof(b->ras));
+    w->pixels = NULL;
+    w->pitch = 0;
+}
+
+static int  ft_soft_init(t_window *w, t_x11_backend *b)
+{
+    const char  *v;
+
+    v = getenv("TM_X11_RENDER");
+    if (v && strcmp(v, "xlib") == 0)
+        return (0);
+    if (!b->vis || b->vis->class != TrueColor
+        || (b->depth != 24 && b->depth != 32))
+        return (0);
+    b->rgb_direct = (b->vis->red_mask == 0xFF0000UL
+        && b->vis->green_mask == 0x00FF00UL
+        && b->vis->blue_mask == 0x0000FFUL);
+    if (!ft_font_build(b))
+        return (0);
+# ifdef TM_HAVE_XSHM
+    v = getenv("TM_X11_SHM");
+    b->use_shm = !(v && strcmp(v, "0") == 0) && XShmQueryExtension(b->d);
+    if (b->use_shm)
+        b->shm_event = XShmGetEventBase(b->d) + ShmCompletion;
+# endif
+    if (!ft_image_create(w, b, w->width, w->height))
+        return (free(b->glyphs.rows), b->glyphs.rows = NULL, 0);
+    return (1);
+}
+
+/* Draw target of the software renderer, NULL in Xlib mode. */
+static const t_raster   *ft_soft_target(t_window *w)
+{
+    t_x11_backend   *b;
+
+    b = (t_x11_backend *)w->backend_1;
+    if (!b || !b->soft || !b->img)
+        return (NULL);
+# ifdef TM_HAVE_XSHM
+    ft_shm_wait(b);
+# endif
+    b->drawn = 1;
+    return (&b->ras);
+}
+
 /*
-** Resize handler: recreate Pixmap backbuffer so the whole window remains
-** drawable in fullscreen / maximized modes.
+** Resize handler: recreate the frame image (software renderer) or the
+** Pixmap backbuffer (Xlib mode) so the whole window remains drawable in
+** fullscreen / maximized modes.
 */
 static void ft_resize_buffers(t_window *w, int width, int height)
 {
@@ -145,6 +432,18 @@ static void ft_resize_buffers(t_window *w, int width, int height)
     if (width == w->width && height == w->height)
         return ;
 
+    if (b->soft)
+    {
+        ft_image_destroy(w, b);
+        if (ft_image_create(w, b, width, height))
+        {
+            w->width = width;
+            w->height = height;
+            return ;
+        }
+        /* Out of memory for the frame: keep going with server drawing. */
+        b->soft = 0;
+    }
     new_back = XCreatePixmap(b->d, b->win, (unsigned int)width,
                              (unsigned int)height, (unsigned int)b->depth);
     if (!new_back)
@@ -155,8 +454,90 @@ static void ft_resize_buffers(t_window *w, int width, int height)
 
     w->width = width;
     w->height = height;
+    window_damage_all(w);
+}
+
+
+/*
+** Idle wait: one X connection per window (main + overlay), plus a
+** self-pipe for window_wake(). The pipe lives as long as the process.
+** g_wake_pending coalesces wakes: one byte per wait at most.
+*/
+# define X11_WAIT_MAX 4
+
+static Display      *g_wait_d[X11_WAIT_MAX];
+static int          g_wake_rd = -1;
+static atomic_int   g_wake_wr = -1;
+static atomic_int   g_wake_pending;
+
+static void ft_wait_register(Display *d, int on)
+{
+    int fds[2];
+    int i;
+
+    i = 0;
+    while (i < X11_WAIT_MAX && g_wait_d[i] != (on ? NULL : d))
+        i++;
+    if (i < X11_WAIT_MAX)
+        g_wait_d[i] = on ? d : NULL;
+    if (!on || g_wake_rd >= 0 || pipe(fds) != 0)
+        return ;
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    fcntl(fds[1], F_SETFL, O_NONBLOCK);
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    g_wake_rd = fds[0];
+    atomic_store(&g_wake_wr, fds[1]);
+}
+
+void	window_wake(void)
+{
+    int fd;
+
+    fd = atomic_load(&g_wake_wr);
+    if (fd < 0 || atomic_exchange(&g_wake_pending, 1))
+        return ;
+    if (write(fd, "w", 1) < 0)
+        atomic_store(&g_wake_pending, 0);
 }
 
+int	window_wait_events(int timeout_ms)
+{
+    struct pollfd   pf[X11_WAIT_MAX + 1];
+    char            buf[64];
+    int             n;
+    int             i;
+    int             r;
+
+    n = 0;
+    i = -1;
+    while (++i < X11_WAIT_MAX)
+    {
+        if (!g_wait_d[i])
+            continue ;
+        /* Already read from the socket by Xlib: poll() would not see it. */
+        if (XEventsQueued(g_wait_d[i], QueuedAfterFlush) > 0)
+            return (1);
+        pf[n].fd = ConnectionNumber(g_wait_d[i]);
+        pf[n].events = POLLIN;
+        pf[n++].revents = 0;
+    }
+    if (g_wake_rd >= 0)
+    {
+        pf[n].fd = g_wake_rd;
+        pf[n].events = POLLIN;
+        pf[n++].revents = 0;
+    }
+    r = poll(pf, (nfds_t)n, timeout_ms > 0 ? timeout_ms : 0);
+    if (g_wake_rd >= 0 && (pf[n - 1].revents & POLLIN))
+    {
+        /* Reset first: a wake after this point writes a new byte. */
+        atomic_store(&g_wake_pending, 0);
+        while (read(g_wake_rd, buf, sizeof(buf)) > 0)
+            ;
+    }
+    return (r > 0);
+}
 
 int	window_init(t_window *w, const char *title, int width, int height)
 {
@@ -173,6 +554,7 @@ int	window_init(t_window *w, const char *title, int width, int height)
     b->d = XOpenDisplay(NULL);
     if (!b->d)
         return (free(b), 1);
+    ft_wait_register(b->d, 1);
     b->screen = DefaultScreen(b->d);
     b->vis = DefaultVisual(b->d, b->screen);
     b->depth = DefaultDepth(b->d, b->screen);
@@ -198,10 +580,6 @@ int	window_init(t_window *w, const char *title, int width, int height)
     if (b->font)
         XSetFont(b->d, b->gc, b->font->fid);
 
-    /* Pixmap backbuffer to eliminate flicker when redrawing */
-    b->back = XCreatePixmap(b->d, b->win, (unsigned int)width,
-                            (unsigned int)height, (unsigned int)b->depth);
-
     w->running = 1;
     w->title = title;
     w->width = width;
@@ -226,6 +604,12 @@ int	window_init(t_window *w, const char *title, int width, int height)
     w->backend_1 = (void *)b;
     w->backend_2 = NULL;
     w->backend_3 = NULL;
+
+    b->soft = ft_soft_init(w, b);
+    /* Xlib mode: Pixmap backbuffer to eliminate flicker when redrawing */
+    if (!b->soft)
+        b->back = XCreatePixmap(b->d, b->win, (unsigned int)width,
+                                (unsigned int)height, (unsigned int)b->depth);
     return (0);
 }
 
@@ -300,6 +684,7 @@ void	window_poll_events(t_window *w)
     w->key_escape = 0;
     w->mouse_left_click = 0;
     w->mouse_wheel = 0;
+    w->input_events = 0;
 	w->text_len = 0;
 	w->text_input[0] = '\0';
 	w->key_backspace = 0;
@@ -313,8 +698,18 @@ void	window_poll_events(t_window *w)
     while (XPending(b->d) > 0)
     {
         XNextEvent(b->d, &ev);
+# ifdef TM_HAVE_XSHM
+        if (b->shm_busy && ft_is_shm_done(b->d, &ev, (XPointer)b))
+            b->shm_busy = 0;
+# endif
+        if (ev.type == KeyPress || ev.type == KeyRelease
+            || ev.type == ButtonPress || ev.type == ButtonRelease
+            || ev.type == MotionNotify || ev.type == ConfigureNotify)
+            w->input_events++;
         if (ev.type == DestroyNotify)
             w->running = 0;
+        else if (ev.type == Expose)
+            window_damage_all(w);
         else if (ev.type == ClientMessage)
         {
             if ((Atom)ev.xclient.data.l[0] == b->wm_delete)
@@ -416,12 +811,20 @@ void	window_clear(t_window *w, int color)
     t_x11_backend	*b;
     unsigned long	pix;
     Drawable		dst;
+    const t_raster	*r;
     
     if (!w)
         return ;
     b = (t_x11_backend *)w->backend_1;
     if (!b || !b->d || !b->gc)
         return ;
+    r = ft_soft_target(w);
+    if (r)
+    {
+        raster_fill_rect(r, 0, 0, r->w, r->h, ft_soft_color(b, color));
+        return ;
+    }
+    window_damage_all(w);
     dst = (w->use_buffer && b->back) ? b->back : b->win;
     pix = ft_x11_color(b, color);
     XSetForeground(b->d, b->gc, pix);
@@ -435,12 +838,20 @@ void	window_fill_rect(t_window *w, int x, int y, int width, int height,
     t_x11_backend	*b;
     unsigned long	pix;
     Drawable		dst;
+    const t_raster	*r;
     
     if (!w || width <= 0 || height <= 0)
         return ;
     b = (t_x11_backend *)w->backend_1;
     if (!b || !b->d || !b->gc)
         return ;
+    r = ft_soft_target(w);
+    if (r)
+    {
+        raster_fill_rect(r, x, y, width, height, ft_soft_color(b, color));
+        return ;
+    }
+    window_damage_all(w);
     dst = (w->use_buffer && b->back) ? b->back : b->win;
     pix = ft_x11_color(b, color);
     XSetForeground(b->d, b->gc, pix);
@@ -453,12 +864,20 @@ void	window_draw_text(t_window *w, int x, int y, const char *text, int color)
     t_x11_backend	*b;
     unsigned long	pix;
     Drawable		dst;
+    const t_raster	*r;
     
     if (!w || !text)
         return ;
     b = (t_x11_backend *)w->backend_1;
     if (!b || !b->d || !b->gc)
         return ;
+    r = ft_soft_target(w);
+    if (r)
+    {
+        raster_text(r, &b->glyphs, x, y + 16, text, ft_soft_color(b, color));
+        return ;
+    }
+    window_damage_all(w);
     dst = (w->use_buffer && b->back) ? b->back : b->win;
     pix = ft_x11_color(b, color);
     XSetForeground(b->d, b->gc, pix);
@@ -470,12 +889,20 @@ void	window_draw_line(t_window *w, int x0, int y0, int x1, int y1, int color)
 	t_x11_backend	*b;
 	unsigned long	pix;
 	Drawable		dst;
+	const t_raster	*r;
 
 	if (!w)
 		return ;
 	b = (t_x11_backend *)w->backend_1;
 	if (!b || !b->d || !b->gc)
 		return ;
+	r = ft_soft_target(w);
+	if (r)
+	{
+		raster_line(r, x0, y0, x1, y1, ft_soft_color(b, color));
+		return ;
+	}
+	window_damage_all(w);
 	dst = (w->use_buffer && b->back) ? b->back : b->win;
 	pix = ft_x11_color(b, color);
 	XSetForeground(b->d, b->gc, pix);
@@ -489,14 +916,22 @@ void	window_draw_polyline(t_window *w, const t_point_i *pts, int n, int color)
 	Drawable		dst;
 	XPoint			xp[1024];
 	int				i;
+	const t_raster	*r;
 
 	if (!w || !pts || n < 2)
 		return ;
 	b = (t_x11_backend *)w->backend_1;
 	if (!b || !b->d || !b->gc)
 		return ;
+	r = ft_soft_target(w);
+	if (r)
+	{
+		raster_polyline(r, pts, n, ft_soft_color(b, color));
+		return ;
+	}
 	if (n > (int)(sizeof(xp) / sizeof(xp[0])))
 		n = (int)(sizeof(xp) / sizeof(xp[0]));
+	window_damage_all(w);
 	dst = (w->use_buffer && b->back) ? b->back : b->win;
 	pix = ft_x11_color(b, color);
 	XSetForeground(b->d, b->gc, pix);
@@ -510,20 +945,87 @@ void	window_draw_polyline(t_window *w, const t_point_i *pts, int n, int color)
 	XDrawLines(b->d, dst, b->gc, xp, n, CoordModeOrigin);
 }
 
+/* Sends one rectangle of the frame (software renderer). */
+static void ft_put_rect(t_x11_backend *b, t_rect_i r, int last)
+{
+# ifdef TM_HAVE_XSHM
+    if (b->use_shm)
+    {
+        /* Completion only for the last one: requests complete in order. */
+        XShmPutImage(b->d, b->win, b->gc, b->img, r.x, r.y, r.x, r.y,
+            (unsigned int)r.w, (unsigned int)r.h, last ? True : False);
+        if (last)
+            b->shm_busy = 1;
+        return ;
+    }
+# endif
+    (void)last;
+    XPutImage(b->d, b->win, b->gc, b->img, r.x, r.y, r.x, r.y,
+        (unsigned int)r.w, (unsigned int)r.h);
+}
+
+static void ft_present_soft(t_window *w, t_x11_backend *b)
+{
+    int i;
+
+    if (b->drawn && !b->prev)
+        window_damage_all(w);
+    else if (b->drawn)
+        window_damage_diff(w, b->prev);
+    b->drawn = 0;
+    if (!window_has_damage(w))
+        return ;
+# ifdef TM_HAVE_XSHM
+    ft_shm_wait(b);
+# endif
+    if (w->damage_full)
+    {
+        if (b->prev)
+            memcpy(b->prev, w->pixels, (size_t)w->pitch * (size_t)w->height
+                * sizeof(*b->prev));
+        ft_put_rect(b, (t_rect_i){0, 0, w->width, w->height}, 1);
+    }
+    i = 0;
+    while (!w->damage_full && i < w->damage_n)
+    {
+        ft_put_rect(b, w->damage[i], i == w->damage_n - 1);
+        i++;
+    }
+    window_damage_clear(w);
+    XFlush(b->d);
+}
+
 void	window_present(t_window *w)
 {
     t_x11_backend	*b;
+    int             i;
 
     if (!w)
         return ;
     b = (t_x11_backend *)w->backend_1;
     if (!b || !b->d)
         return ;
-    if (w->use_buffer && b->back)
+    if (b->soft && b->img)
+    {
+        ft_present_soft(w, b);
+        return ;
+    }
+    if (!window_has_damage(w))
+        return ;
+    if (w->use_buffer && b->back && w->damage_full)
     {
         XCopyArea(b->d, b->back, b->win, b->gc, 0, 0,
                   (unsigned int)w->width, (unsigned int)w->height, 0, 0);
     }
+    i = 0;
+    while (w->use_buffer && b->back && !w->damage_full && i < w->damage_n)
+    {
+        XCopyArea(b->d, b->back, b->win, b->gc, w->damage[i].x,
+            w->damage[i].y, (unsigned int)w->damage[i].w,
+            (unsigned int)w->damage[i].h, w->damage[i].x, w->damage[i].y);
+        i++;
+    }
+    window_damage_clear(w);
     XFlush(b->d);
 }
 
@@ -536,6 +1038,8 @@ void	window_destroy(t_window *w)
     b = (t_x11_backend *)w->backend_1;
     if (b)
     {
+        ft_image_destroy(w, b);
+        free(b->glyphs.rows);
         if (b->back)
             XFreePixmap(b->d, b->back);
         if (b->font)
@@ -545,7 +1049,10 @@ void	window_destroy(t_window *w)
         if (b->win)
             XDestroyWindow(b->d, b->win);
         if (b->d)
+        {
+            ft_wait_register(b->d, 0);
             XCloseDisplay(b->d);
+        }
         free(b);
     }
     w->backend_1 = NULL;
@@ -0,0 +1,163 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   window_raster.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: tracker_loot                                   +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/22                                #+#    #+#             */
+/*   Updated: 2026/02/22                                ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "window_raster.h"
+
+#include <stddef.h>
+
+void	raster_fill_rect(const t_raster *r, int x, int y, int w, int h,
+			uint32_t c)
+{
+	uint32_t	*row;
+	int			x1;
+	int			y1;
+	int			i;
+
+	if (!r || !r->px || w <= 0 || h <= 0)
+		return ;
+	x1 = (x > r->w - w) ? r->w : x + w;
+	y1 = (y > r->h - h) ? r->h : y + h;
+	if (x < 0)
+		x = 0;
+	if (y < 0)
+		y = 0;
+	if (x >= x1 || y >= y1)
+		return ;
+	while (y < y1)
+	{
+		row = r->px + (size_t)y * (size_t)r->pitch;
+		i = x;
+		while (i < x1)
+			row[i++] = c;
+		y++;
+	}
+}
+
+static void	put_px(const t_raster *r, long x, long y, uint32_t c)
+{
+	if (x >= 0 && y >= 0 && x < r->w && y < r->h)
+		r->px[(size_t)y * (size_t)r->pitch + (size_t)x] = c;
+}
+
+void	raster_line(const t_raster *r, int x0, int y0, int x1, int y1,
+			uint32_t c)
+{
+	long	dx;
+	long	dy;
+	long	err;
+	long	e2;
+	long	x;
+	long	y;
+
+	if (!r || !r->px)
+		return ;
+	if (y0 == y1 || x0 == x1)
+	{
+		raster_fill_rect(r, (x0 < x1) ? x0 : x1, (y0 < y1) ? y0 : y1,
+			((x0 < x1) ? x1 - x0 : x0 - x1) + 1,
+			((y0 < y1) ? y1 - y0 : y0 - y1) + 1, c);
+		return ;
+	}
+	/* Entirely on one side of the buffer: nothing to walk. */
+	if ((x0 < 0 && x1 < 0) || (y0 < 0 && y1 < 0)
+		|| (x0 >= r->w && x1 >= r->w) || (y0 >= r->h && y1 >= r->h))
+		return ;
+	x = x0;
+	y = y0;
+	dx = (x1 > x0) ? (long)x1 - x0 : (long)x0 - x1;
+	dy = -((y1 > y0) ? (long)y1 - y0 : (long)y0 - y1);
+	err = dx + dy;
+	while (1)
+	{
+		put_px(r, x, y, c);
+		if (x == x1 && y == y1)
+			break ;
+		e2 = 2 * err;
+		if (e2 >= dy)
+		{
+			err += dy;
+			x += (x0 < x1) ? 1 : -1;
+		}
+		if (e2 <= dx)
+		{
+			err += dx;
+			y += (y0 < y1) ? 1 : -1;
+		}
+	}
+}
+
+void	raster_polyline(const t_raster *r, const t_point_i *pts, int n,
+			uint32_t c)
+{
+	int	i;
+
+	if (!pts || n < 2)
+		return ;
+	i = 1;
+	while (i < n)
+	{
+		raster_line(r, pts[i - 1].x, pts[i - 1].y, pts[i].x, pts[i].y, c);
+		i++;
+	}
+}
+
+static void	glyph(const t_raster *r, const t_raster_font *f, int x0, int y0,
+			unsigned char ch, uint32_t c)
+{
+	const uint32_t	*rows;
+	uint32_t		*dst;
+	uint32_t		m;
+	int				y;
+	int				i;
+
+	rows = f->rows + (size_t)ch * (size_t)f->cell_h;
+	y = 0;
+	while (y < f->cell_h)
+	{
+		m = rows[y];
+		if (m && y0 + y >= 0 && y0 + y < r->h)
+		{
+			dst = r->px + (size_t)(y0 + y) * (size_t)r->pitch;
+			i = 0;
+			while (m)
+			{
+				if ((m & 0x80000000u) && x0 + i >= 0 && x0 + i < r->w)
+					dst[x0 + i] = c;
+				m <<= 1;
+				i++;
+			}
+		}
+		y++;
+	}
+}
+
+void	raster_text(const t_raster *r, const t_raster_font *f, int x,
+		int baseline, const char *s, uint32_t c)
+{
+	int	pen;
+	int	top;
+
+	if (!r || !r->px || !f || !f->rows || !s)
+		return ;
+	pen = x;
+	top = baseline - f->ascent;
+	if (top >= r->h || top + f->cell_h <= 0)
+		return ;
+	while (*s)
+	{
+		if (pen - f->origin_x >= r->w)
+			break ;
+		glyph(r, f, pen - f->origin_x, top, (unsigned char)*s, c);
+		pen += f->advance[(unsigned char)*s];
+		s++;
+	}
+}
@@ -87,6 +87,7 @@ static void	ft_resize_buffers(t_window *w, int width, int height)
 		ReleaseDC(b->hwnd, hdc);
 		b->back_old_bmp = (HBITMAP)SelectObject(b->back_dc, b->back_bmp);
 	}
+	window_damage_all(w);
 }
 
 static HFONT	ft_create_mono_font(HDC hdc)
@@ -180,6 +181,20 @@ static LRESULT CALLBACK	ft_wndproc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lp
         SetWindowLongPtr(hwnd, GWLP_USERDATA, (LONG_PTR)w);
         return (0);
     }
+    if (w && (msg == WM_KEYDOWN || msg == WM_KEYUP || msg == WM_CHAR
+        || msg == WM_MOUSEMOVE || msg == WM_LBUTTONDOWN
+        || msg == WM_LBUTTONUP || msg == WM_MOUSEWHEEL || msg == WM_SIZE))
+        w->input_events++;
+    /* Uncovered / restored: the back buffer still holds the last frame. */
+    if (msg == WM_PAINT && w)
+    {
+        PAINTSTRUCT	ps;
+
+        BeginPaint(hwnd, &ps);
+        EndPaint(hwnd, &ps);
+        window_damage_all(w);
+        return (0);
+    }
     if (msg == WM_KEYDOWN && w)
         return (ft_set_key(w, wparam), 0);
     if (msg == WM_KEYUP && w)
@@ -318,6 +333,44 @@ static void	ft_clear_buf(t_window *w, unsigned int color)
     }
 }
 
+/*
+** Idle wait: the thread message queue covers every window (main + overlay);
+** window_wake() signals an auto-reset event (several wakes = one).
+*/
+static HANDLE volatile	g_wake_event = NULL;
+
+static void	ft_wake_create(void)
+{
+    HANDLE	e;
+
+    if (g_wake_event)
+        return ;
+    e = CreateEventA(NULL, FALSE, FALSE, NULL);
+    if (e)
+        InterlockedExchangePointer((PVOID volatile *)&g_wake_event, e);
+}
+
+void	window_wake(void)
+{
+    HANDLE	e;
+
+    e = g_wake_event;
+    if (e)
+        SetEvent(e);
+}
+
+int	window_wait_events(int timeout_ms)
+{
+    HANDLE	e;
+    DWORD	r;
+
+    e = g_wake_event;
+    r = MsgWaitForMultipleObjectsEx(e ? 1 : 0, e ? &e : NULL,
+            (DWORD)(timeout_ms > 0 ? timeout_ms : 0), QS_ALLINPUT,
+            MWMO_INPUTAVAILABLE);
+    return (r != WAIT_TIMEOUT && r != WAIT_FAILED);
+}
+
 int	window_init(t_window *w, const char *title, int width, int height)
 {
     t_win_backend	*b;
@@ -333,6 +386,7 @@ int	window_init(t_window *w, const char *title, int width, int height)
      ** So we zero-init the struct up-front to make it safe.
      */
     memset(w, 0, sizeof(*w));
+    ft_wake_create();
     b = (t_win_backend *)malloc(sizeof(*b));
     if (!b)
         return (1);
@@ -520,6 +574,7 @@ void	window_poll_events(t_window *w)
 	w->key_escape = 0;
 	w->mouse_left_click = 0;
 	w->mouse_wheel = 0;
+	w->input_events = 0;
 	w->text_len = 0;
 	w->text_input[0] = '\0';
 	w->key_backspace = 0;
@@ -567,6 +622,7 @@ void	window_clear(t_window *w, int color)
     b = (t_win_backend *)w->backend_1;
     if (!b || !b->hwnd)
         return ;
+    window_damage_all(w);
     GetClientRect(b->hwnd, &rc);
     brush = CreateSolidBrush(ft_win_color(color));
     if (w->use_buffer && b->back_dc)
@@ -593,6 +649,7 @@ void	window_fill_rect(t_window *w, int x, int y, int width, int height,
     b = (t_win_backend *)w->backend_1;
     if (!b || !b->hwnd)
         return ;
+    window_damage_all(w);
     rc.left = x;
     rc.top = y;
     rc.right = x + width;
@@ -620,6 +677,7 @@ void	window_draw_text(t_window *w, int x, int y, const char *text, int color)
     b = (t_win_backend *)w->backend_1;
     if (!b || !b->hwnd)
         return ;
+    window_damage_all(w);
     if (w->use_buffer && b->back_dc)
         hdc = b->back_dc;
     else
@@ -648,6 +706,7 @@ void	window_draw_line(t_window *w, int x0, int y0, int x1, int y1, int color)
 	b = (t_win_backend *)w->backend_1;
 	if (!b || !b->hwnd)
 		return ;
+	window_damage_all(w);
 	if (w->use_buffer && b->back_dc)
 		hdc = b->back_dc;
 	else
@@ -677,6 +736,7 @@ void	window_draw_polyline(t_window *w, const t_point_i *pts, int n, int color)
 		return ;
 	if (n > (int)(sizeof(wp) / sizeof(wp[0])))
 		n = (int)(sizeof(wp) / sizeof(wp[0]));
+	window_damage_all(w);
 	if (w->use_buffer && b->back_dc)
 		hdc = b->back_dc;
 	else
@@ -701,19 +761,29 @@ void	window_present(t_window *w)
 {
     t_win_backend	*b;
     HDC			hdc;
+    int			i;
     
     if (!w)
         return ;
     b = (t_win_backend *)w->backend_1;
-    if (!b || !b->hwnd)
+    if (!b || !b->hwnd || !window_has_damage(w))
         return ;
     hdc = GetDC(b->hwnd);
-    if (w->use_buffer && b->back_dc && b->back_bmp)
+    if (w->use_buffer && b->back_dc && b->back_bmp && !w->damage_full)
+    {
+        i = -1;
+        while (++i < w->damage_n)
+            BitBlt(hdc, w->damage[i].x, w->damage[i].y, w->damage[i].w,
+                w->damage[i].h, b->back_dc, w->damage[i].x, w->damage[i].y,
+                SRCCOPY);
+    }
+    else if (w->use_buffer && b->back_dc && b->back_bmp)
         BitBlt(hdc, 0, 0, w->width, w->height, b->back_dc, 0, 0, SRCCOPY);
     else if (w->use_buffer && w->pixels)
         StretchDIBits(hdc, 0, 0, w->width, w->height, 0, 0, w->width, w->height,
                       w->pixels, &b->bmi, DIB_RGB_COLORS, SRCCOPY);
     ReleaseDC(b->hwnd, hdc);
+    window_damage_clear(w);
 }
 
 void	window_destroy(t_window *w)
@@ -0,0 +1,378 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_downsample.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: login <login@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/22 00:00:00 by login             #+#    #+#             */
+/*   Updated: 2026/02/22 00:00:00 by login            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+ * Benchmark: graph downsampling, linear walk vs min/max pyramid.
+ *
+ *   make bench WERROR=0 && ./bin/bench_downsample [points]
+ *
+ * First a check: the series grows by random appends (plus rewritten
+ * points, like the last loot packet being regrouped), the pyramid is
+ * synced after each step and random zoom windows / plot sizes must give
+ * the same polyline and markers as ui_downsample_minmax_pixels().
+ * poly_idx may differ on ties (ui_downsample.h): the pyramid's index must
+ * then project to that same pixel; the number of such ties is printed.
+ * Any mismatch is printed and the exit status is 1.
+ * The append path as the graph cache runs it (ui_ds_pyramid_sync_from,
+ * ui_ds_columns_update, ui_ds_columns_emit, vmax moving now and then) must
+ * match the linear walk after every growth step.
+ * Then the cost of one downsample (full range and 5% zoom) for both, and
+ * of one LIVE append: full pass (memcmp sync + pyramid downsample) against
+ * the append path, with a fixed vmax and with vmax moving on every point.
+ */
+
+#include "ui_downsample.h"
+#include "utils.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define POLY_CAP 8192
+#define REP_CAP 2048
+
+typedef struct s_out
+{
+	t_point_i	poly[POLY_CAP];
+	int			poly_idx[POLY_CAP];
+	t_point_i	rep[REP_CAP];
+	int			rep_idx[REP_CAP];
+	int			poly_n;
+	int			rep_n;
+}	t_out;
+
+static uint64_t	g_rng = 0x9E3779B97F4A7C15ULL;
+static long		g_ties;
+
+static uint32_t	next_u32(void)
+{
+	g_rng ^= g_rng << 13;
+	g_rng ^= g_rng >> 7;
+	g_rng ^= g_rng << 17;
+	return ((uint32_t)(g_rng >> 16));
+}
+
+/* Loot-like series: mostly small values, rare spikes, repeated values. */
+static void	make_series(double *v, int *x, int n)
+{
+	int	t;
+	int	i;
+
+	t = 0;
+	i = 0;
+	while (i < n)
+	{
+		t += (int)(next_u32() % 20u);
+		x[i] = t;
+		if (i > 0 && next_u32() % 6u == 0)
+			v[i] = v[i - 1];
+		else if (next_u32() % 200u == 0)
+			v[i] = (double)(next_u32() % 50000u) / 100.0;
+		else
+			v[i] = (double)(next_u32() % 3000u) / 100.0;
+		i++;
+	}
+}
+
+static void	run(t_out *o, const t_ui_ds_pyramid *p, const double *v,
+				const int *x, int n, int xmin, int xmax, double vmax, t_rect pl)
+{
+	if (p)
+		o->poly_n = ui_downsample_minmax_pyramid(p, v, x, n, xmin, xmax,
+				0.0, vmax, pl, o->poly, o->poly_idx, POLY_CAP,
+				o->rep, o->rep_idx, REP_CAP, &o->rep_n);
+	else
+		o->poly_n = ui_downsample_minmax_pixels(v, x, n, xmin, xmax,
+				0.0, vmax, pl, o->poly, o->poly_idx, POLY_CAP,
+				o->rep, o->rep_idx, REP_CAP, &o->rep_n);
+}
+
+static int	same(const t_out *a, const t_out *b)
+{
+	return (a->poly_n == b->poly_n && a->rep_n == b->rep_n
+		&& memcmp(a->poly, b->poly, sizeof(*a->poly) * (size_t)a->poly_n) == 0
+		&& memcmp(a->rep, b->rep, sizeof(*a->rep) * (size_t)a->rep_n) == 0
+		&& memcmp(a->rep_idx, b->rep_idx,
+			sizeof(*a->rep_idx) * (size_t)a->rep_n) == 0);
+}
+
+/* Pixel of point i, projected as the downsamplers do (vmin = 0). */
+static t_point_i	pixel_of(const double *v, const int *x, int i, int xmin,
+						int xmax, double vmax, t_rect pl)
+{
+	double	c;
+	int		col;
+
+	c = v[i];
+	if (c < 0.0)
+		c = 0.0;
+	if (c > vmax)
+		c = vmax;
+	col = (int)floor(((double)(x[i] - xmin) / (double)(xmax - xmin))
+			* (double)pl.w + 0.5);
+	return ((t_point_i){pl.x + col,
+		pl.y + pl.h - (int)llround((c / vmax) * (double)pl.h)});
+}
+
+/* b (pyramid) vs a (linear): a differing poly_idx must name the same pixel. */
+static int	same_pixels(const t_out *a, const t_out *b, const double *v,
+				const int *x, int xmin, int xmax, double vmax, t_rect pl)
+{
+	t_point_i	q;
+	int			i;
+
+	i = 0;
+	while (i < b->poly_n)
+	{
+		if (a->poly_idx[i] != b->poly_idx[i])
+		{
+			q = pixel_of(v, x, b->poly_idx[i], xmin, xmax, vmax, pl);
+			if (q.x != b->poly[i].x || q.y != b->poly[i].y)
+				return (0);
+			g_ties++;
+		}
+		i++;
+	}
+	return (1);
+}
+
+static long	check(double *v, int *x, int total, t_out *a, t_out *b)
+{
+	t_ui_ds_pyramid	p;
+	t_rect			pl;
+	double			vmax;
+	long			bad;
+	int				n;
+	int				z;
+	int				xmin;
+	int				xmax;
+
+	memset(&p, 0, sizeof(p));
+	bad = 0;
+	n = 0;
+	while (n < total)
+	{
+		n += 1 + (int)(next_u32() % 2000u);
+		if (n > total)
+			n = total;
+		if (n > 2 && next_u32() % 3u == 0)
+			v[n - 2] += 1.0;
+		ui_ds_pyramid_sync(&p, v, x, n);
+		z = 0;
+		while (z++ < 8)
+		{
+			pl = (t_rect){10, 20, 100 + (int)(next_u32() % 1000u),
+				60 + (int)(next_u32() % 400u)};
+			xmin = x[next_u32() % (uint32_t)n] - 30;
+			xmax = xmin + 1 + (int)(next_u32() % (uint32_t)(x[n - 1] + 1));
+			vmax = (z & 1) ? 40.0 : 600.0;
+			run(a, NULL, v, x, n, xmin, xmax, vmax, pl);
+			run(b, &p, v, x, n, xmin, xmax, vmax, pl);
+			if ((!same(a, b)
+					|| !same_pixels(a, b, v, x, xmin, xmax, vmax, pl))
+				&& ++bad <= 10)
+				printf("mismatch: n=%d x=[%d..%d] plot %dx%d\n", n, xmin,
+					xmax, pl.w, pl.h);
+		}
+	}
+	ui_ds_pyramid_free(&p);
+	return (bad);
+}
+
+/*
+** One graph cache step: refill the columns changed since the last sync
+** (or build them), re-project all of them when vmax moved.
+*/
+static void	append_step(t_out *o, t_ui_ds_columns *c, const t_ui_ds_pyramid *p,
+				int from, int xmax, double vmax, int vmax_moved, t_rect pl)
+{
+	int	col;
+
+	col = ui_ds_columns_update(c, p, from);
+	if (col < 0)
+		col = ui_ds_columns_build(c, p, 0, xmax, pl.w) ? 0 : -1;
+	if (col < 0)
+	{
+		run(o, NULL, p->v, p->x, p->n, 0, xmax, vmax, pl);
+		return ;
+	}
+	if (vmax_moved)
+		col = 0;
+	if (col == 0)
+	{
+		o->poly_n = 0;
+		o->rep_n = 0;
+	}
+	o->poly_n = ui_ds_columns_emit(c, p, col, 0.0, vmax, pl, o->poly,
+			o->poly_idx, o->poly_n, POLY_CAP, o->rep, o->rep_idx, &o->rep_n,
+			REP_CAP);
+}
+
+/* Fixed view, growing series: append path == linear walk after each step. */
+static long	check_append(double *v, int *x, int total, t_out *a, t_out *b,
+				int xmax)
+{
+	t_ui_ds_pyramid	p;
+	t_ui_ds_columns	c;
+	t_rect			pl;
+	double			vmax;
+	long			bad;
+	int				moved;
+	int				from;
+	int				old_n;
+	int				n;
+
+	memset(&p, 0, sizeof(p));
+	memset(&c, 0, sizeof(c));
+	pl = (t_rect){10, 20, 700, 300};
+	vmax = 600.0;
+	bad = 0;
+	n = 0;
+	while (n < total)
+	{
+		old_n = n;
+		n += 1 + (int)(next_u32() % ((n < total - 3000) ? 2000u : 3u));
+		if (n > total)
+			n = total;
+		/* The last point may be rewritten (loot packet regrouped). */
+		if (old_n > 1 && next_u32() % 3u == 0)
+			v[old_n - 1] += 1.0;
+		from = ui_ds_pyramid_sync_from(&p, v, x, n, old_n - 1);
+		moved = (next_u32() % 4u == 0);
+		if (moved)
+			vmax += 50.0;
+		append_step(a, &c, &p, from, xmax, vmax, moved, pl);
+		run(b, NULL, v, x, n, 0, xmax, vmax, pl);
+		if ((!same(b, a) || !same_pixels(b, a, v, x, 0, xmax, vmax, pl))
+			&& ++bad <= 10)
+			printf("append mismatch: n=%d from=%d x=[0..%d]\n", n, from,
+				xmax);
+	}
+	ui_ds_columns_free(&c);
+	ui_ds_pyramid_free(&p);
+	return (bad);
+}
+
+/*
+** LIVE: the last 'k' points appended one by one to a series of n points,
+** view padded past the data end (as the overview). Returns us / point.
+*/
+static double	time_append(t_ui_ds_pyramid *p, t_out *o, const double *v,
+					const int *x, int n, int k, int full, int vmax_moves)
+{
+	t_ui_ds_columns	c;
+	t_rect			pl;
+	uint64_t		t0;
+	double			vmax;
+	int				from;
+	int				xmax;
+	int				m;
+
+	memset(&c, 0, sizeof(c));
+	pl = (t_rect){0, 0, 700, 300};
+	xmax = x[n - 1] + x[n - 1] / 8;
+	vmax = 600.0;
+	ui_ds_pyramid_sync_from(p, v, x, n - k, n - k);
+	append_step(o, &c, p, 0, xmax, vmax, 1, pl);
+	t0 = ft_time_us();
+	m = n - k;
+	while (m++ < n)
+	{
+		if (vmax_moves)
+			vmax += 1.0;
+		if (full)
+		{
+			ui_ds_pyramid_sync(p, v, x, m);
+			run(o, p, v, x, m, 0, xmax, vmax, pl);
+			continue ;
+		}
+		from = ui_ds_pyramid_sync_from(p, v, x, m, m - 2);
+		append_step(o, &c, p, from, xmax, vmax, vmax_moves, pl);
+	}
+	ui_ds_columns_free(&c);
+	return ((double)(ft_time_us() - t0) / (double)k);
+}
+
+int	main(int argc, char **argv)
+{
+	t_ui_ds_pyramid	p;
+	double			*v;
+	int				*x;
+	t_out			*a;
+	t_out			*b;
+	uint64_t		t0;
+	long			bad;
+	int				n;
+	int				k;
+	int				z;
+	int				xmin;
+	int				xmax;
+	t_rect			pl;
+
+	n = (argc > 1) ? atoi(argv[1]) : 16384;
+	if (n < 16)
+		n = 16;
+	v = (double *)malloc(sizeof(*v) * (size_t)n);
+	x = (int *)malloc(sizeof(*x) * (size_t)n);
+	a = (t_out *)malloc(sizeof(*a));
+	b = (t_out *)malloc(sizeof(*b));
+	if (!v || !x || !a || !b)
+		return (1);
+	make_series(v, x, n);
+	bad = check(v, x, n, a, b);
+	bad += check_append(v, x, n, a, b, x[n - 1]);
+	bad += check_append(v, x, n, a, b, x[n / 3]);
+	printf("check: %ld mismatch(es), %ld poly_idx tie(s) on the same pixel\n",
+		bad, g_ties);
+
+	memset(&p, 0, sizeof(p));
+	t0 = ft_time_us();
+	ui_ds_pyramid_sync(&p, v, x, n);
+	printf("pyramid build (%d points): %llu us\n", n,
+		(unsigned long long)(ft_time_us() - t0));
+	pl = (t_rect){0, 0, 700, 300};
+	z = 0;
+	while (z < 2)
+	{
+		xmin = (z == 0) ? 0 : x[n / 2];
+		xmax = (z == 0) ? x[n - 1] : xmin + x[n - 1] / 20;
+		t0 = ft_time_us();
+		k = 0;
+		while (k++ < 1000)
+			run(a, NULL, v, x, n, xmin + (k & 1), xmax, 600.0, pl);
+		printf("%-5s linear : %8.1f us / downsample\n", z ? "zoom" : "full",
+			(double)(ft_time_us() - t0) / 1000.0);
+		t0 = ft_time_us();
+		k = 0;
+		while (k++ < 1000)
+			run(b, &p, v, x, n, xmin + (k & 1), xmax, 600.0, pl);
+		printf("%-5s pyramid: %8.1f us / downsample\n", z ? "zoom" : "full",
+			(double)(ft_time_us() - t0) / 1000.0);
+		z++;
+	}
+	/* LIVE: points appended one by one, view unchanged. */
+	k = (n < 1000) ? n / 2 : 1000;
+	printf("append full pass   : %8.1f us / point (vmax moves)\n",
+		time_append(&p, a, v, x, n, k, 1, 1));
+	printf("append path        : %8.1f us / point (same vmax)\n",
+		time_append(&p, a, v, x, n, k, 0, 0));
+	printf("append path        : %8.1f us / point (vmax moves)\n",
+		time_append(&p, a, v, x, n, k, 0, 1));
+	ui_ds_pyramid_free(&p);
+	free(v);
+	free(x);
+	free(a);
+	free(b);
+	return (bad != 0);
+}
@@ -0,0 +1,269 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_hunt_csv.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: login <login@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/20 00:00:00 by login             #+#    #+#             */
+/*   Updated: 2026/02/20 00:00:00 by login            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+ * Benchmark: hunt_log.csv range scans (stats / series rebuilds, session bounds).
+ *
+ *   make bench WERROR=0 && ./bin/bench_hunt_csv path/to/hunt_log.csv [rows]
+ *
+ * If the file does not exist, a synthetic V2 log of 'rows' data lines
+ * (default 10M) is written there first.
+ * Compares rows/sec of:
+ *  - the former fgets(4096) + ftell() loops (copied below) for skip and parse,
+ *  - t_hunt_csv_cursor skip / next_row,
+ *  - the three range scanners built on the cursor.
+ * The series rebuild runs over the whole file (event columns grow in
+ * chunks, no cap), once cold and once reusing the same series.
+ * Both skips must land on the same byte offset (reported).
+ */
+
+#include "fs_utils.h"
+#include "hunt_csv.h"
+#include "hunt_series.h"
+#include "session_export.h"
+#include "tracker_stats.h"
+#include "utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* -------------------------------------------------------------------------- */
+/* Former fgets loops (reference)                                             */
+/* -------------------------------------------------------------------------- */
+
+static int	legacy_is_header(const char *line)
+{
+	return (strstr(line, "timestamp")
+		&& (strstr(line, "event_type") || strstr(line, ",type,")));
+}
+
+static long	legacy_skip(const char *path, long start_offset)
+{
+	FILE	*f;
+	char	buf[4096];
+	long	data_lines;
+	int		first;
+	long	pos_before;
+	long	pos;
+
+	f = fopen(path, "rb");
+	if (!f)
+		return (-1);
+	data_lines = 0;
+	first = 1;
+	while (fgets(buf, (int)sizeof(buf), f))
+	{
+		pos_before = ftell(f) - (long)strlen(buf);
+		if (first)
+		{
+			first = 0;
+			if (legacy_is_header(buf))
+				continue ;
+		}
+		if (data_lines == start_offset)
+		{
+			fseek(f, pos_before, SEEK_SET);
+			break ;
+		}
+		data_lines++;
+	}
+	pos = ftell(f);
+	fclose(f);
+	return (pos);
+}
+
+static unsigned long long	legacy_parse(const char *path, size_t *rows)
+{
+	FILE				*f;
+	char				buf[4096];
+	t_hunt_csv_row_view	row;
+	unsigned long long	sink;
+	int					first;
+
+	f = fopen(path, "rb");
+	if (!f)
+		return (0);
+	sink = 0;
+	first = 1;
+	while (fgets(buf, (int)sizeof(buf), f))
+	{
+		tm_trim_eol(buf);
+		if (first && legacy_is_header(buf))
+		{
+			first = 0;
+			continue ;
+		}
+		first = 0;
+		(*rows)++;
+		if (hunt_csv_parse_row_inplace(buf, &row))
+			sink += (unsigned long long)row.value_uPED;
+	}
+	fclose(f);
+	return (sink);
+}
+
+/* -------------------------------------------------------------------------- */
+/* Cursor                                                                     */
+/* -------------------------------------------------------------------------- */
+
+static long	cursor_skip(const char *path, long start_offset)
+{
+	t_hunt_csv_cursor	cur;
+	long				pos;
+
+	if (hunt_csv_cursor_open(&cur, path) != 0)
+		return (-1);
+	(void)hunt_csv_cursor_skip(&cur, (unsigned long long)start_offset);
+	pos = (long)hunt_csv_cursor_tell(&cur);
+	hunt_csv_cursor_close(&cur);
+	return (pos);
+}
+
+static unsigned long long	cursor_parse(const char *path, size_t *rows)
+{
+	t_hunt_csv_cursor	cur;
+	t_hunt_csv_row_view	row;
+	unsigned long long	sink;
+	int					rc;
+
+	if (hunt_csv_cursor_open(&cur, path) != 0)
+		return (0);
+	sink = 0;
+	while ((rc = hunt_csv_cursor_next_row(&cur, &row)) >= 0)
+	{
+		(*rows)++;
+		if (rc == 1)
+			sink += (unsigned long long)row.value_uPED;
+	}
+	hunt_csv_cursor_close(&cur);
+	return (sink);
+}
+
+/* -------------------------------------------------------------------------- */
+/* Driver                                                                     */
+/* -------------------------------------------------------------------------- */
+
+static int	generate(const char *path, long rows)
+{
+	static const char	*mobs[] = {"Atrox Young", "Daikiba Mature",
+		"Feffoid Guardian", "Merp Old"};
+	FILE				*f;
+	long				i;
+	long long			ts;
+	long				kill_id;
+
+	f = fopen(path, "wb");
+	if (!f)
+		return (-1);
+	hunt_csv_ensure_header_v2(f);
+	ts = 1740823200;
+	kill_id = 0;
+	for (i = 0; i < rows; i++)
+	{
+		ts += (i % 3 == 0);
+		if (i % 8 == 7)
+			fprintf(f, "%lld,KILL,%s,0,0,%ld,0,%lld [System] [] You killed"
+				" %s\n", ts, mobs[i % 4], ++kill_id, ts, mobs[i % 4]);
+		else if (i % 8 == 6)
+			fprintf(f, "%lld,LOOT_ITEM,Shrapnel,%ld,%ld,%ld,0,%lld [System] []"
+				" You received Shrapnel x (%ld) Value: 0.%04ld PED\n", ts,
+				i % 900 + 100, (i % 900 + 100) * 100, kill_id + 1, ts,
+				i % 900 + 100, i % 900 + 100);
+		else
+			fprintf(f, "%lld,SHOT,,1,0,0,0,%lld [System] [] You inflicted"
+				" %ld.0 points of damage\n", ts, ts, i % 97 + 20);
+	}
+	return (fclose(f));
+}
+
+static void	report(const char *name, size_t rows, uint64_t ms,
+				unsigned long long sink)
+{
+	printf("%-34s %12.0f rows/s  (%llu ms, check %llu)\n", name,
+		ms ? (double)rows * 1000.0 / (double)ms : 0.0,
+		(unsigned long long)ms, sink);
+}
+
+int	main(int argc, char **argv)
+{
+	t_hunt_series		*series;
+	t_hunt_stats		st;
+	char				a[64];
+	char				b[64];
+	uint64_t			t0;
+	size_t				n;
+	unsigned long long	sink;
+	long				rows;
+	long				pl;
+	long				pc;
+
+	if (argc < 2)
+	{
+		fprintf(stderr, "usage: %s hunt_log.csv [rows]\n", argv[0]);
+		return (2);
+	}
+	rows = (argc > 2) ? atol(argv[2]) : 10000000L;
+	if (rows < 1)
+		rows = 1;
+	if (fs_file_size(argv[1]) < 0)
+	{
+		printf("generating %ld rows in %s\n", rows, argv[1]);
+		if (generate(argv[1], rows) != 0)
+		{
+			fprintf(stderr, "cannot write %s\n", argv[1]);
+			return (1);
+		}
+	}
+	series = (t_hunt_series *)calloc(1, sizeof(*series));
+	if (!series)
+		return (1);
+	n = 0;
+	t0 = ft_time_ms();
+	sink = legacy_parse(argv[1], &n);
+	report("fgets + parse", n, ft_time_ms() - t0, sink);
+	rows = (long)n;
+	n = 0;
+	t0 = ft_time_ms();
+	sink = cursor_parse(argv[1], &n);
+	report("cursor next_row", n, ft_time_ms() - t0, sink);
+	t0 = ft_time_ms();
+	pl = legacy_skip(argv[1], rows - 1);
+	report("fgets + ftell skip", (size_t)rows, ft_time_ms() - t0,
+		(unsigned long long)pl);
+	t0 = ft_time_ms();
+	pc = cursor_skip(argv[1], rows - 1);
+	report("cursor skip", (size_t)rows, ft_time_ms() - t0,
+		(unsigned long long)pc);
+	printf("skip offsets %s\n", (pl == pc) ? "match" : "DIFFER");
+	memset(&st, 0, sizeof(st));
+	t0 = ft_time_ms();
+	(void)tracker_stats_compute_range(argv[1], 0, -1, &st);
+	report("tracker_stats_compute_range", (size_t)rows, ft_time_ms() - t0,
+		(unsigned long long)st.kills);
+	t0 = ft_time_ms();
+	(void)hunt_series_rebuild_range(series, argv[1], 0, -1, 60);
+	report("hunt_series_rebuild_range", (size_t)rows,
+		ft_time_ms() - t0, (unsigned long long)series->kills_total);
+	t0 = ft_time_ms();
+	(void)hunt_series_rebuild_range(series, argv[1], 0, -1, 60);
+	report("hunt_series_rebuild_range (again)", (size_t)rows,
+		ft_time_ms() - t0, (unsigned long long)series->kills_total);
+	t0 = ft_time_ms();
+	(void)session_extract_range_timestamps_ex(argv[1], 0, -1,
+		a, sizeof(a), b, sizeof(b));
+	report("session_extract_range_timestamps", (size_t)rows,
+		ft_time_ms() - t0, (unsigned long long)strlen(b));
+	hunt_series_free(series);
+	free(series);
+	return (0);
+}
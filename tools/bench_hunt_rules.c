@@ -0,0 +1,246 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_hunt_rules.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: login <login@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/20 00:00:00 by login             #+#    #+#             */
+/*   Updated: 2026/02/20 00:00:00 by login            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+ * Benchmark: hunt_rules line classification on a recorded chat.log.
+ *
+ *   make bench WERROR=0 && ./bin/bench_hunt_rules path/to/chat.log [passes]
+ *
+ * Compares lines/sec of:
+ *  - the former strstr() cascade (copied below, one strstr per pattern),
+ *  - hunt_classify_line() (single pass pattern_set automaton),
+ *  - hunt_should_ignore_line() + hunt_decode_line(): the former engine
+ *    path, two automaton passes per line (reference),
+ *  - hunt_decode_line(): what the REPLAY workers run per line,
+ *  - hunt_rules_ctx_parse_line(): what the LIVE engine runs per line.
+ * Both classifiers must agree on every line, and the engine paths must
+ * agree with the reference (mismatches are reported).
+ */
+
+#include "hunt_rules.h"
+#include "line_reader.h"
+#include "utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* -------------------------------------------------------------------------- */
+/* Former strstr cascade (reference)                                          */
+/* -------------------------------------------------------------------------- */
+
+static int	contains_any(const char *line, const char *const *pats, size_t n)
+{
+	size_t	i;
+
+	for (i = 0; i < n; i++)
+		if (strstr(line, pats[i]))
+			return (1);
+	return (0);
+}
+
+static const char	*find_after_token(const char *line, const char *const *tok,
+						size_t n)
+{
+	size_t		i;
+	const char	*p;
+
+	for (i = 0; i < n; i++)
+	{
+		p = strstr(line, tok[i]);
+		if (p)
+			return (p + strlen(tok[i]));
+	}
+	return (NULL);
+}
+
+static t_hunt_line_kind	legacy_classify(const char *line)
+{
+	static const char *const	ign[] = {"[Rookie]", "[Débutant]", "[#",
+		"[ROCKtropia", "[HyperStim"};
+	static const char *const	shot[] = {"You inflicted ",
+		"Vous avez infligé ", "The target Dodged your attack",
+		"The target Evaded your attack", "La cible a esquivé votre attaque",
+		"La cible a évité votre attaque", "You missed", "Vous avez raté",
+		"Vous manquez votre cible"};
+	static const char *const	rcv[] = {"You received ", "Vous avez reçu "};
+	static const char *const	kill[] = {"You killed ", "Vous avez tué ",
+		"Vous tuez "};
+
+	if (!line || !*line || contains_any(line, ign, 5))
+		return (HUNT_LINE_NONE);
+	if (contains_any(line, shot, 9))
+		return (HUNT_LINE_SHOT);
+	if ((strstr(line, "Critical hit") || strstr(line, "Coup critique"))
+		&& (strstr(line, "You inflicted ")
+			|| strstr(line, "Vous avez infligé ")))
+		return (HUNT_LINE_SHOT);
+	if (find_after_token(line, rcv, 2))
+		return (HUNT_LINE_RECEIVED);
+	if (find_after_token(line, kill, 3))
+		return (HUNT_LINE_KILL);
+	return (HUNT_LINE_NONE);
+}
+
+/* -------------------------------------------------------------------------- */
+/* Driver                                                                     */
+/* -------------------------------------------------------------------------- */
+
+typedef struct s_lines
+{
+	char	**v;
+	size_t	n;
+	size_t	cap;
+}	t_lines;
+
+static int	load_lines(const char *path, t_lines *ls)
+{
+	FILE			*f;
+	t_line_reader	lr;
+	t_line_view		lv;
+	char			**nv;
+
+	f = fopen(path, "rb");
+	if (!f || line_reader_init(&lr, f, 0) != 0)
+	{
+		if (f)
+			fclose(f);
+		return (-1);
+	}
+	while (line_reader_next(&lr, &lv) > 0)
+	{
+		if (ls->n == ls->cap)
+		{
+			ls->cap = ls->cap ? ls->cap * 2 : 4096;
+			nv = (char **)realloc(ls->v, ls->cap * sizeof(*nv));
+			if (!nv)
+				break ;
+			ls->v = nv;
+		}
+		ls->v[ls->n] = (char *)malloc(lv.len + 1);
+		if (!ls->v[ls->n])
+			break ;
+		memcpy(ls->v[ls->n], lv.ptr, lv.len + 1);
+		ls->n++;
+	}
+	line_reader_free(&lr);
+	fclose(f);
+	return (0);
+}
+
+static void	report(const char *name, size_t lines, uint64_t ms,
+				unsigned long long sink)
+{
+	printf("%-28s %10.0f lines/s  (%llu ms, check %llu)\n", name,
+		ms ? (double)lines * 1000.0 / (double)ms : 0.0,
+		(unsigned long long)ms, sink);
+}
+
+/* Former engine path: channel filter, then decode (two passes). */
+static t_hunt_line_kind	two_pass_kind(const char *line, t_hunt_decoded *d)
+{
+	if (hunt_should_ignore_line(line))
+		return (HUNT_LINE_NONE);
+	hunt_decode_line(line, d);
+	return (d->kind);
+}
+
+int	main(int argc, char **argv)
+{
+	t_lines				ls;
+	t_hunt_decoded		d;
+	t_hunt_rules_ctx	ctx;
+	t_hunt_event		ev;
+	uint64_t			t0;
+	unsigned long long	sink;
+	size_t				i;
+	size_t				mism;
+	int					pass;
+	int					passes;
+
+	if (argc < 2)
+	{
+		fprintf(stderr, "usage: %s chat.log [passes]\n", argv[0]);
+		return (2);
+	}
+	passes = (argc > 2) ? atoi(argv[2]) : 5;
+	if (passes < 1)
+		passes = 1;
+	memset(&ls, 0, sizeof(ls));
+	if (load_lines(argv[1], &ls) != 0 || ls.n == 0)
+	{
+		fprintf(stderr, "cannot read %s\n", argv[1]);
+		return (1);
+	}
+	mism = 0;
+	for (i = 0; i < ls.n; i++)
+	{
+		if (legacy_classify(ls.v[i]) != hunt_classify_line(ls.v[i]))
+			mism++;
+		hunt_decode_line(ls.v[i], &d);
+		if (two_pass_kind(ls.v[i], &d) != (d.ignored ? HUNT_LINE_NONE : d.kind)
+			|| d.ignored != hunt_should_ignore_line(ls.v[i]))
+			mism++;
+	}
+	printf("%zu lines x %d passes, mismatches: %zu\n",
+		ls.n, passes, mism);
+	sink = 0;
+	t0 = ft_time_ms();
+	for (pass = 0; pass < passes; pass++)
+		for (i = 0; i < ls.n; i++)
+			sink += (unsigned long long)legacy_classify(ls.v[i]);
+	report("strstr cascade", ls.n * (size_t)passes, ft_time_ms() - t0, sink);
+	sink = 0;
+	t0 = ft_time_ms();
+	for (pass = 0; pass < passes; pass++)
+		for (i = 0; i < ls.n; i++)
+			sink += (unsigned long long)hunt_classify_line(ls.v[i]);
+	report("hunt_classify_line", ls.n * (size_t)passes, ft_time_ms() - t0, sink);
+	sink = 0;
+	t0 = ft_time_ms();
+	for (pass = 0; pass < passes; pass++)
+		for (i = 0; i < ls.n; i++)
+			sink += (unsigned long long)two_pass_kind(ls.v[i], &d);
+	report("ignore + decode (2 passes)", ls.n * (size_t)passes,
+		ft_time_ms() - t0, sink);
+	sink = 0;
+	t0 = ft_time_ms();
+	for (pass = 0; pass < passes; pass++)
+	{
+		for (i = 0; i < ls.n; i++)
+		{
+			hunt_decode_line(ls.v[i], &d);
+			sink += (unsigned long long)(d.ignored ? 0 : d.kind);
+		}
+	}
+	report("hunt_decode_line (REPLAY)", ls.n * (size_t)passes,
+		ft_time_ms() - t0, sink);
+	sink = 0;
+	t0 = ft_time_ms();
+	for (pass = 0; pass < passes; pass++)
+	{
+		hunt_rules_ctx_init(&ctx);
+		for (i = 0; i < ls.n; i++)
+		{
+			sink += (unsigned long long)(hunt_rules_ctx_parse_line(&ctx,
+						ls.v[i], &ev) + 1);
+			while (hunt_rules_ctx_pending_pop(&ctx, &ev))
+				sink++;
+		}
+	}
+	report("ctx_parse_line (LIVE)", ls.n * (size_t)passes,
+		ft_time_ms() - t0, sink);
+	for (i = 0; i < ls.n; i++)
+		free(ls.v[i]);
+	free(ls.v);
+	return (mism != 0);
+}
@@ -0,0 +1,206 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_tm_fmt.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: login <login@student.42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/02/22 00:00:00 by login             #+#    #+#             */
+/*   Updated: 2026/02/22 00:00:00 by login            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+ * Benchmark: integer / money formatting (tm_fmt) against snprintf.
+ *
+ *   make bench WERROR=0 && ./bin/bench_tm_fmt [count]
+ *
+ * First a round-trip check on 'count' pseudo-random values (default 10M,
+ * plus the int64 edges):
+ *  - tm_fmt_i64_raw == "%lld",
+ *  - tm_money_format_ped4/ped2 == the former snprintf formatter (copied
+ *    below),
+ *  - tm_money_parse_ped(ped4(v)) == v, tm_money_parse_ped(ped2(v)) == v
+ *    rounded half away from zero to 0.01 PED.
+ * Any mismatch is printed and the exit status is 1.
+ * Then values/sec of each formatter, and rows/sec of hunt_csv_format_v2()
+ * on SHOT-like rows.
+ */
+
+#include "hunt_csv.h"
+#include "tm_fmt.h"
+#include "tm_money.h"
+#include "utils.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* -------------------------------------------------------------------------- */
+/* Former snprintf formatter (reference)                                      */
+/* -------------------------------------------------------------------------- */
+
+static void	legacy_ped(char *dst, size_t cap, tm_money_t v, int decimals)
+{
+	long long	abs_v;
+	int			neg;
+
+	neg = (v < 0);
+	abs_v = neg ? -(long long)v : (long long)v;
+	if (decimals == 2)
+	{
+		abs_v = (abs_v + 50) / 100;
+		snprintf(dst, cap, "%s%lld.%02lld", neg ? "-" : "",
+			abs_v / 100, abs_v % 100);
+	}
+	else
+		snprintf(dst, cap, "%s%lld.%04lld", neg ? "-" : "",
+			abs_v / 10000, abs_v % 10000);
+}
+
+/* -------------------------------------------------------------------------- */
+/* Round-trip check                                                           */
+/* -------------------------------------------------------------------------- */
+
+static uint64_t	g_rng = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t	next_u64(void)
+{
+	g_rng ^= g_rng << 13;
+	g_rng ^= g_rng >> 7;
+	g_rng ^= g_rng << 17;
+	return (g_rng);
+}
+
+/* Mix of magnitudes: mostly loot-sized values, sometimes anything. */
+static int64_t	next_value(void)
+{
+	uint64_t	r;
+	int			bits;
+
+	r = next_u64();
+	bits = (int)(r & 63u);
+	r = next_u64();
+	if (bits < 63)
+		r &= ((1ULL << bits) - 1ULL);
+	return ((int64_t)r);
+}
+
+static int	check_one(int64_t v, long *bad)
+{
+	char		a[64];
+	char		b[64];
+	size_t		n;
+	tm_money_t	back;
+	int64_t		r2;
+
+	n = tm_fmt_i64_raw(a, v);
+	a[n] = '\0';
+	snprintf(b, sizeof(b), "%lld", (long long)v);
+	if (strcmp(a, b) != 0)
+		return (printf("i64  %s != %s\n", a, b), ++*bad);
+	/* Beyond this the former formatter overflowed (-INT64_MIN). */
+	if (v < -INT64_MAX + 50)
+		return (0);
+	tm_money_format_ped4(a, sizeof(a), v);
+	legacy_ped(b, sizeof(b), v, 4);
+	if (strcmp(a, b) != 0 || !tm_money_parse_ped(a, &back) || back != v)
+		return (printf("ped4 %lld: %s (ref %s)\n", (long long)v, a, b),
+			++*bad);
+	if (v > INT64_MAX - 50)
+		return (0);
+	tm_money_format_ped2(a, sizeof(a), v);
+	legacy_ped(b, sizeof(b), v, 2);
+	r2 = (v < 0) ? -((-v + 50) / 100) * 100 : ((v + 50) / 100) * 100;
+	if (strcmp(a, b) != 0 || !tm_money_parse_ped(a, &back) || back != r2)
+		return (printf("ped2 %lld: %s (ref %s)\n", (long long)v, a, b),
+			++*bad);
+	return (0);
+}
+
+static long	round_trip(long count)
+{
+	static const int64_t	edges[] = {0, 1, -1, 9, 10, 49, 50, 99, 100,
+		-50, -9999, 9999, 10000, -10000, 123456789, INT64_MAX,
+		INT64_MIN, INT64_MAX - 50, -INT64_MAX + 50};
+	long					bad;
+	long					i;
+
+	bad = 0;
+	for (i = 0; i < (long)(sizeof(edges) / sizeof(edges[0])); i++)
+		check_one(edges[i], &bad);
+	for (i = 0; i < count && bad < 20; i++)
+		check_one(next_value(), &bad);
+	return (bad);
+}
+
+/* -------------------------------------------------------------------------- */
+/* Driver                                                                     */
+/* -------------------------------------------------------------------------- */
+
+static void	report(const char *name, long n, uint64_t ms, unsigned long long sink)
+{
+	printf("%-28s %12.0f /s  (%llu ms, check %llu)\n", name,
+		ms ? (double)n * 1000.0 / (double)ms : 0.0,
+		(unsigned long long)ms, sink);
+}
+
+int	main(int argc, char **argv)
+{
+	int64_t				*vals;
+	char				buf[512];
+	unsigned long long	sink;
+	uint64_t			t0;
+	long				count;
+	long				bad;
+	long				i;
+
+	count = (argc > 1) ? atol(argv[1]) : 10000000L;
+	if (count < 1)
+		count = 1;
+	bad = round_trip(count);
+	printf("round-trip: %ld values, %ld mismatch%s\n", count, bad,
+		bad == 1 ? "" : "es");
+	vals = (int64_t *)malloc((size_t)count * sizeof(*vals));
+	if (!vals)
+		return (1);
+	for (i = 0; i < count; i++)
+		vals[i] = next_value() % 100000000000LL;
+	sink = 0;
+	t0 = ft_time_ms();
+	for (i = 0; i < count; i++)
+		sink += (unsigned)snprintf(buf, sizeof(buf), "%lld", (long long)vals[i]);
+	report("snprintf %lld", count, ft_time_ms() - t0, sink);
+	sink = 0;
+	t0 = ft_time_ms();
+	for (i = 0; i < count; i++)
+		sink += tm_fmt_i64_raw(buf, vals[i]);
+	report("tm_fmt_i64_raw", count, ft_time_ms() - t0, sink);
+	sink = 0;
+	t0 = ft_time_ms();
+	for (i = 0; i < count; i++)
+	{
+		legacy_ped(buf, sizeof(buf), vals[i], 4);
+		sink += (unsigned char)buf[0];
+	}
+	report("snprintf ped4", count, ft_time_ms() - t0, sink);
+	sink = 0;
+	t0 = ft_time_ms();
+	for (i = 0; i < count; i++)
+	{
+		tm_money_format_ped4(buf, sizeof(buf), vals[i]);
+		sink += (unsigned char)buf[0];
+	}
+	report("tm_money_format_ped4", count, ft_time_ms() - t0, sink);
+	sink = 0;
+	t0 = ft_time_ms();
+	for (i = 0; i < count; i++)
+		sink += (unsigned)hunt_csv_format_v2(buf, sizeof(buf),
+			1740823200 + i / 3, "SHOT", "", 1, vals[i] & 0xFFFF, 0, 0,
+			"2025-03-01 10:00:00 [System] [] You inflicted 42.0 points of"
+			" damage");
+	report("hunt_csv_format_v2 (rows)", count, ft_time_ms() - t0, sink);
+	free(vals);
+	return (bad ? 1 : 0);
+}